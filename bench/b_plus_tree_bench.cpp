@@ -0,0 +1,123 @@
+#include <buffer/buffer_pool_manager.hpp>
+#include <storage/disk_manager.hpp>
+#include <storage/index/b_plus_tree.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+static std::filesystem::path file_name("b_plus_tree_bench.db");
+const size_t FRAMES = 4096;
+const size_t SCAN_LENGTH = 100;
+const auto ROUND_TIME = std::chrono::milliseconds(1000);
+
+using Tree = BPlusTree<int64_t, int64_t>;
+
+// Runs op on num_threads threads for ROUND_TIME and returns operations/sec
+template <typename Op>
+double RunRound(size_t num_threads, Op op) {
+  std::atomic<bool> stop{false};
+  std::atomic<size_t> total{0};
+  std::vector<std::thread> threads;
+
+  for (size_t t = 0; t < num_threads; t++) {
+    threads.emplace_back([&, t]() {
+      std::mt19937_64 rng(t);
+      size_t ops = 0;
+      while (!stop.load(std::memory_order_relaxed)) {
+        op(rng);
+        ops++;
+      }
+      total.fetch_add(ops);
+    });
+  }
+
+  std::this_thread::sleep_for(ROUND_TIME);
+  stop.store(true);
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  return total.load() / std::chrono::duration<double>(ROUND_TIME).count();
+}
+
+int main(int argc, char** argv) {
+  const int64_t num_keys = argc > 1 ? std::stoll(argv[1]) : 200000;
+  const size_t max_threads =
+      argc > 2 ? std::stoul(argv[2])
+               : std::max(1u, std::thread::hardware_concurrency());
+
+  auto disk_manager = std::make_shared<DiskManager>(file_name);
+  auto bpm = std::make_shared<BufferPoolManager>(FRAMES, disk_manager.get());
+  Tree tree(bpm->NewPage(), bpm.get());
+
+  std::vector<int64_t> keys(num_keys);
+  for (int64_t i = 0; i < num_keys; i++) {
+    keys[i] = i;
+  }
+  std::shuffle(keys.begin(), keys.end(), std::mt19937_64(0));
+
+  auto start = std::chrono::steady_clock::now();
+  for (const auto key : keys) {
+    tree.Insert(key, key);
+  }
+  std::chrono::duration<double> load_time =
+      std::chrono::steady_clock::now() - start;
+  std::cout << "inserted " << num_keys << " keys in " << load_time.count()
+            << " s\n";
+
+  {
+    Tree loaded(bpm->NewPage(), bpm.get());
+    std::vector<std::pair<int64_t, int64_t>> entries;
+    for (const auto key : keys) {
+      entries.emplace_back(key, key);
+    }
+    start = std::chrono::steady_clock::now();
+    loaded.BulkLoad(std::move(entries));
+    load_time = std::chrono::steady_clock::now() - start;
+    std::cout << "bulk loaded " << num_keys << " keys in " << load_time.count()
+              << " s\n";
+  }
+
+  std::cout << "threads\tlatched lookups/s\tlookups/s\tscans/s ("
+            << SCAN_LENGTH << " keys)\tmixed ops/s (10% updates)\n";
+  for (size_t threads = 1; threads <= max_threads; threads *= 2) {
+    auto lookup = [&](std::mt19937_64& rng) {
+      tree.GetValue(static_cast<int64_t>(rng() % num_keys));
+    };
+    tree.SetOptimisticReads(false);
+    double latched = RunRound(threads, lookup);
+    tree.SetOptimisticReads(true);
+    double lookups = RunRound(threads, lookup);
+    double scans = RunRound(threads, [&](std::mt19937_64& rng) {
+      auto it = tree.Begin(static_cast<int64_t>(rng() % num_keys));
+      for (size_t i = 0; i < SCAN_LENGTH && !it.IsEnd(); i++) {
+        ++it;
+      }
+    });
+    // Updates remove and reinsert a key, so leaves split and merge
+    double mixed = RunRound(threads, [&](std::mt19937_64& rng) {
+      auto key = static_cast<int64_t>(rng() % num_keys);
+      if (rng() % 10 == 0) {
+        tree.Remove(key);
+        tree.Insert(key, key);
+      } else {
+        tree.GetValue(key);
+      }
+    });
+    std::cout << threads << "\t" << static_cast<size_t>(latched) << "\t"
+              << static_cast<size_t>(lookups) << "\t"
+              << static_cast<size_t>(scans) << "\t"
+              << static_cast<size_t>(mixed) << "\n";
+  }
+
+  disk_manager->ShutDown();
+  remove(file_name);
+  remove(disk_manager->GetLogFileName());
+}
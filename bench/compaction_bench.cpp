@@ -0,0 +1,59 @@
+#include <storage/disk_manager.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+static std::filesystem::path file_name("compaction_bench.db");
+
+int main(int argc, char** argv) {
+  const size_t num_pages = argc > 1 ? std::stoul(argv[1]) : 65536;
+  std::cout << num_pages << " pages\n";
+  std::cout << "deleted\tmax pages\tpages/s\tpages moved\tMiB copied\t"
+               "MiB reclaimed\tMiB punched\tms\n";
+  // Unlimited, throttled, and stopped early so that holes remain
+  const std::pair<size_t, size_t> limits[] = {
+      {SIZE_MAX, 0}, {SIZE_MAX, 10000}, {num_pages / 20, 0}};
+  for (double deleted : {0.5, 0.9}) {
+    for (auto [max_pages, pages_per_second] : limits) {
+      auto disk_manager = std::make_shared<DiskManager>(file_name);
+      std::vector<char> page(DB_PAGE_SIZE, 'x');
+      std::vector<std::pair<PageId_t, const char*>> batch;
+      for (size_t i = 0; i < num_pages; i++) {
+        batch.push_back({static_cast<PageId_t>(i), page.data()});
+      }
+      disk_manager->WritePages(batch);
+      std::mt19937 rng(0);
+      for (size_t i = 0; i < num_pages; i++) {
+        if (rng() % 1000 < deleted * 1000) {
+          disk_manager->DeletePage(i);
+        }
+      }
+
+      auto start = std::chrono::steady_clock::now();
+      CompactionResult result =
+          disk_manager->Compact(max_pages, pages_per_second);
+      std::chrono::duration<double, std::milli> time =
+          std::chrono::steady_clock::now() - start;
+      std::cout << deleted << "\t"
+                << (max_pages == SIZE_MAX ? "-" : std::to_string(max_pages))
+                << "\t\t" << pages_per_second << "\t"
+                << result.pages_moved << "\t\t"
+                << result.bytes_copied / (1 << 20) << "\t\t"
+                << (result.file_size_before - result.file_size_after +
+                    result.bytes_punched) /
+                       (1 << 20)
+                << "\t\t" << result.bytes_punched / (1 << 20) << "\t\t"
+                << time.count() << "\n";
+
+      disk_manager->ShutDown();
+      remove(file_name);
+      remove(disk_manager->GetLogFileName());
+    }
+  }
+}
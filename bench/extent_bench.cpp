@@ -0,0 +1,74 @@
+#include <buffer/buffer_pool_manager.hpp>
+#include <storage/disk_manager.hpp>
+#include <storage/table/pax_table.hpp>
+
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+static std::filesystem::path file_name("extent_bench.db");
+const size_t FRAMES = 256;
+const size_t NUM_TABLES = 4;
+
+// Runs of adjacent slots the pages are read in, in page order
+static size_t CountRuns(DiskManager& disk_manager,
+                        const std::vector<PageId_t>& page_ids) {
+  size_t runs = 0;
+  size_t next_offset = SIZE_MAX;
+  for (PageId_t page_id : page_ids) {
+    size_t offset = *disk_manager.GetPageOffset(page_id);
+    if (offset != next_offset) {
+      runs++;
+    }
+    next_offset = offset + DB_PAGE_SIZE;
+  }
+  return runs;
+}
+
+int main(int argc, char** argv) {
+  // Tables filled in turns, as concurrent loads or an append heavy workload
+  // grow them, so their pages are allocated interleaved
+  const size_t num_pages = argc > 1 ? std::stoul(argv[1]) : 4096;
+  std::cout << NUM_TABLES << " tables of " << num_pages
+            << " pages grown in turns\n";
+  std::cout << "allocation\tpages/read\n";
+  for (bool extents : {false, true}) {
+    auto disk_manager = std::make_shared<DiskManager>(file_name);
+    auto bpm = std::make_shared<BufferPoolManager>(FRAMES, disk_manager.get());
+    std::vector<std::vector<PageId_t>> tables(NUM_TABLES);
+    std::vector<PageId_t> next(NUM_TABLES, INVALID_PAGE_ID);
+    for (size_t i = 0; i < num_pages; i++) {
+      for (size_t t = 0; t < NUM_TABLES; t++) {
+        PageId_t page_id;
+        if (!extents) {
+          page_id = bpm->NewPage();
+        } else {
+          if (i % TABLE_EXTENT_PAGES == 0) {
+            next[t] = bpm->NewPages(TABLE_EXTENT_PAGES);
+          }
+          page_id = next[t]++;
+        }
+        memset(bpm->WritePage(page_id).GetDataMut(), static_cast<int>(t),
+               DB_PAGE_SIZE);
+        tables[t].push_back(page_id);
+      }
+    }
+    bpm->FlushAllPages();
+
+    // A scan of a table reads each run of adjacent slots sequentially
+    size_t runs = 0;
+    for (const auto& page_ids : tables) {
+      runs += CountRuns(*disk_manager, page_ids);
+    }
+    std::cout << (extents ? "extents" : "pages") << "\t\t"
+              << static_cast<double>(NUM_TABLES * num_pages) / runs << "\n";
+
+    disk_manager->ShutDown();
+    remove(file_name);
+    remove(disk_manager->GetLogFileName());
+  }
+}
@@ -0,0 +1,89 @@
+#include <buffer/buffer_pool_manager.hpp>
+#include <execution/external_sort.hpp>
+#include <execution/pax_scan.hpp>
+#include <storage/disk_manager.hpp>
+#include <storage/table/pax_table.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+static std::filesystem::path file_name("external_sort_bench.db");
+const size_t FRAMES = 2048;
+
+int main(int argc, char** argv) {
+  // Input of about 10 times the buffer pool
+  const size_t pool_bytes = FRAMES * DB_PAGE_SIZE;
+  const size_t row_size = 32;
+  const size_t num_rows =
+      argc > 1 ? std::stoul(argv[1]) : 10 * pool_bytes / row_size;
+  const size_t budget = argc > 2 ? std::stoul(argv[2]) : SORT_FRAME_BUDGET;
+
+  auto disk_manager = std::make_shared<DiskManager>(file_name);
+  auto bpm = std::make_shared<BufferPoolManager>(FRAMES, disk_manager.get());
+  PaxTable table(bpm.get(), Schema({Column("key", TypeId::Int64),
+                                    Column("value", TypeId::Int64),
+                                    Column("payload", TypeId::Char, 16)}));
+
+  std::mt19937_64 rng(0);
+  std::vector<int64_t> keys;
+  char row[row_size] = {};
+  for (size_t i = 0; i < num_rows; i++) {
+    int64_t key = rng();
+    int64_t value = i;
+    memcpy(row, &key, 8);
+    memcpy(row + 8, &value, 8);
+    table.InsertTuple(Tuple(row, sizeof(row)));
+    keys.push_back(key);
+  }
+  bpm->FlushAllPages();
+
+  auto start = std::chrono::steady_clock::now();
+  ExternalSort sort(
+      std::make_unique<PaxScan>(&table, std::vector<size_t>{0, 1, 2}),
+      bpm.get(), 0, false, budget);
+  Batch batch(sort.GetColumns());
+  size_t rows = 0;
+  int64_t last = INT64_MIN;
+  bool ordered = true;
+  while (sort.Next(batch)) {
+    const int64_t* out = batch.GetColumn(0).Data<int64_t>();
+    for (size_t i = 0; i < batch.GetSize(); i++) {
+      ordered = ordered && out[i] >= last;
+      last = out[i];
+    }
+    rows += batch.GetSize();
+  }
+  std::chrono::duration<double> sort_time =
+      std::chrono::steady_clock::now() - start;
+
+  // The same keys sorted in memory, for reference
+  start = std::chrono::steady_clock::now();
+  std::sort(keys.begin(), keys.end());
+  std::chrono::duration<double> memory_time =
+      std::chrono::steady_clock::now() - start;
+
+  if (!ordered || rows != num_rows) {
+    std::cerr << "output is not sorted\n";
+    return 1;
+  }
+
+  std::cout << num_rows << " rows of " << row_size << " bytes, "
+            << num_rows * row_size / pool_bytes << "x the pool of " << FRAMES
+            << " frames, sort budget " << budget << " frames\n";
+  std::cout << "runs\tmerge passes\trows/s\tin memory keys/s\n";
+  std::cout << sort.GetRunCount() << "\t" << sort.GetMergePasses() << "\t"
+            << static_cast<size_t>(num_rows / sort_time.count()) << "\t"
+            << static_cast<size_t>(num_rows / memory_time.count()) << "\n";
+
+  disk_manager->ShutDown();
+  remove(file_name);
+  remove(disk_manager->GetLogFileName());
+}
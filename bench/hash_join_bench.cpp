@@ -0,0 +1,80 @@
+#include <buffer/buffer_pool_manager.hpp>
+#include <execution/hash_join.hpp>
+#include <execution/pax_scan.hpp>
+#include <storage/disk_manager.hpp>
+#include <storage/table/pax_table.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+static std::filesystem::path file_name("hash_join_bench.db");
+const size_t FRAMES = 1024;
+
+static void Fill(PaxTable& table, size_t num_rows, size_t num_keys,
+                 uint64_t seed) {
+  std::mt19937_64 rng(seed);
+  char row[16];
+  for (size_t i = 0; i < num_rows; i++) {
+    int64_t key = rng() % num_keys;
+    int64_t value = i;
+    memcpy(row, &key, 8);
+    memcpy(row + 8, &value, 8);
+    table.InsertTuple(Tuple(row, sizeof(row)));
+  }
+}
+
+int main(int argc, char** argv) {
+  // Build inputs of a fraction to a multiple of the buffer pool, probed by as
+  // many rows
+  const size_t budget = argc > 1 ? std::stoul(argv[1]) : JOIN_FRAME_BUDGET;
+  const size_t pool_bytes = FRAMES * DB_PAGE_SIZE;
+  const size_t row_size = 16;
+  const double multiples[] = {0.125, 0.25, 1, 2, 4};
+
+  std::cout << "pool of " << FRAMES << " frames, join budget " << budget
+            << " frames, " << row_size << " byte rows\n";
+  std::cout << "build/pool\tbuild rows\tpartitions\tlevels\toutput rows\t"
+               "input rows/s\n";
+  for (double multiple : multiples) {
+    auto disk_manager = std::make_shared<DiskManager>(file_name);
+    auto bpm =
+        std::make_shared<BufferPoolManager>(FRAMES, disk_manager.get());
+    const Schema schema(
+        {Column("key", TypeId::Int64), Column("value", TypeId::Int64)});
+    PaxTable build_table(bpm.get(), schema);
+    PaxTable probe_table(bpm.get(), schema);
+    const size_t num_rows = multiple * pool_bytes / row_size;
+    Fill(build_table, num_rows, num_rows, 1);
+    Fill(probe_table, num_rows, num_rows, 2);
+    bpm->FlushAllPages();
+
+    auto start = std::chrono::steady_clock::now();
+    HashJoin join(
+        std::make_unique<PaxScan>(&build_table, std::vector<size_t>{0, 1}),
+        std::make_unique<PaxScan>(&probe_table, std::vector<size_t>{0, 1}),
+        0, 0, bpm.get(), budget);
+    Batch batch(join.GetColumns());
+    size_t output = 0;
+    while (join.Next(batch)) {
+      output += batch.GetSize();
+    }
+    std::chrono::duration<double> time =
+        std::chrono::steady_clock::now() - start;
+
+    std::cout << multiple << "\t\t" << num_rows << "\t\t"
+              << join.GetPartitionCount() << "\t\t" << join.GetMaxLevel()
+              << "\t" << output << "\t\t"
+              << static_cast<size_t>(2 * num_rows / time.count()) << "\n";
+
+    disk_manager->ShutDown();
+    remove(file_name);
+    remove(disk_manager->GetLogFileName());
+  }
+}
@@ -0,0 +1,73 @@
+#include <storage/index/key_search.hpp>
+#include <storage/page/b_plus_tree_internal_page.hpp>
+#include <storage/page/b_plus_tree_leaf_page.hpp>
+
+#include <x86intrin.h>
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+const size_t NUM_PROBES = 1 << 20;
+const int ROUNDS = 8;
+
+// Average cycles and nanoseconds per call of search over the probes
+template <typename T, typename Search>
+void Measure(const char* name, const std::vector<T>& probes, Search search) {
+  size_t sum = 0;
+  auto start = std::chrono::steady_clock::now();
+  uint64_t start_cycles = __rdtsc();
+  for (int round = 0; round < ROUNDS; round++) {
+    for (const T probe : probes) {
+      sum += search(probe);
+    }
+  }
+  uint64_t cycles = __rdtsc() - start_cycles;
+  std::chrono::duration<double, std::nano> time =
+      std::chrono::steady_clock::now() - start;
+
+  const double calls = static_cast<double>(probes.size()) * ROUNDS;
+  std::cout << "\t" << name << "\t" << cycles / calls << " cycles\t"
+            << time.count() / calls << " ns\t(" << sum % 10 << ")\n";
+}
+
+template <typename T>
+void RunSize(const char* type, int size) {
+  std::mt19937_64 rng(size);
+  std::vector<T> keys(size);
+  for (auto& key : keys) {
+    key = static_cast<T>(rng());
+  }
+  std::sort(keys.begin(), keys.end());
+  std::vector<T> probes(NUM_PROBES);
+  for (auto& probe : probes) {
+    probe = static_cast<T>(rng());
+  }
+
+  std::cout << type << " node of " << size << " keys\n";
+  Measure("std::lower_bound", probes, [&](T probe) {
+    return std::lower_bound(keys.begin(), keys.end(), probe) - keys.begin();
+  });
+  for (int kernel = 0; kernel <= static_cast<int>(DetectSearchKernel());
+       kernel++) {
+    auto k = static_cast<SearchKernel>(kernel);
+    Measure(SearchKernelName(k), probes, [&](T probe) {
+      return KeyLowerBound(keys.data(), size, probe, k);
+    });
+  }
+}
+
+int main() {
+  std::cout << "detected kernel: " << SearchKernelName(DetectSearchKernel())
+            << "\n";
+  for (int size : {16, 64, BPlusTreeLeafPage<int64_t, int64_t>::CAPACITY,
+                   BPlusTreeInternalPage<int64_t>::CAPACITY}) {
+    RunSize<int64_t>("int64", size);
+  }
+  for (int size : {64, BPlusTreeLeafPage<int32_t, int32_t>::CAPACITY}) {
+    RunSize<int32_t>("int32", size);
+  }
+}
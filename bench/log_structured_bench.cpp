@@ -0,0 +1,71 @@
+#include <buffer/buffer_pool_manager.hpp>
+#include <storage/disk_manager.hpp>
+#include <storage/log_structured_disk_manager.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+static std::filesystem::path file_name("log_structured_bench.db");
+const size_t FRAMES = 1024;
+
+// Updates every page once, in page id order or at random, and returns the
+// write-back throughput in MiB/s, including the final flush
+static double UpdatePages(BufferPoolManager& bpm, DiskManager& disk_manager,
+                          const std::vector<PageId_t>& page_ids,
+                          bool random) {
+  std::mt19937 rng(0);
+  int writes = disk_manager.GetNumWrites();
+  auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < page_ids.size(); i++) {
+    PageId_t page_id = random ? page_ids[rng() % page_ids.size()] : page_ids[i];
+    auto guard = bpm.WritePage(page_id);
+    guard.GetDataMut()[i % DB_PAGE_SIZE]++;
+  }
+  bpm.FlushAllPages();
+  std::chrono::duration<double> time =
+      std::chrono::steady_clock::now() - start;
+  return (disk_manager.GetNumWrites() - writes) * DB_PAGE_SIZE /
+         time.count() / (1 << 20);
+}
+
+template <typename Manager>
+static void Run(const char* name, size_t num_pages) {
+  auto disk_manager = std::make_shared<Manager>(file_name);
+  auto bpm = std::make_shared<BufferPoolManager>(FRAMES, disk_manager.get());
+  std::vector<PageId_t> page_ids;
+  for (size_t i = 0; i < num_pages; i++) {
+    page_ids.push_back(bpm->NewPage());
+    bpm->WritePage(page_ids.back());
+  }
+  bpm->FlushAllPages();
+
+  double sequential = UpdatePages(*bpm, *disk_manager, page_ids, false);
+  double random = 0;
+  for (int round = 0; round < 3; round++) {
+    random += UpdatePages(*bpm, *disk_manager, page_ids, true) / 3;
+  }
+  std::cout << name << "\t" << sequential << "\t\t" << random << "\t\t"
+            << disk_manager->GetDbFileSize() / (1 << 20) << "\n";
+  disk_manager->ShutDown();
+  remove(file_name);
+  remove(disk_manager->GetLogFileName());
+  if constexpr (std::is_same_v<Manager, LogStructuredDiskManager>) {
+    remove(disk_manager->GetCheckpointFileName());
+  }
+}
+
+int main(int argc, char** argv) {
+  const size_t num_pages = argc > 1 ? std::stoul(argv[1]) : 32768;
+  std::cout << num_pages << " pages, pool of " << FRAMES << " frames\n";
+  std::cout << "disk manager\tsequential MiB/s\trandom MiB/s\tfile MiB\n";
+
+  Run<DiskManager>("in place", num_pages);
+  Run<LogStructuredDiskManager>("log structured", num_pages);
+}
@@ -0,0 +1,127 @@
+#include <buffer/buffer_pool_manager.hpp>
+#include <storage/disk_manager.hpp>
+#include <storage/index/b_plus_tree.hpp>
+#include <storage/lsm/lsm_tree.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+static std::filesystem::path file_name("lsm_tree_bench.db");
+// A pool of 4 MiB, a fraction of either index
+const size_t FRAMES = 1024;
+const size_t NUM_LOOKUPS = 100000;
+
+using Tree = BPlusTree<int64_t, int64_t>;
+
+// Big endian so that byte order is key order
+static std::string EncodeKey(int64_t key) {
+  char bytes[8];
+  for (int i = 0; i < 8; i++) {
+    bytes[i] = static_cast<char>(key >> (56 - 8 * i));
+  }
+  return std::string(bytes, sizeof(bytes));
+}
+
+struct Result {
+  double inserts_per_sec;
+  double writes_per_insert;
+  double reads_per_lookup;
+};
+
+static void Print(const char* name, const Result& result) {
+  std::cout << name << "\t" << static_cast<size_t>(result.inserts_per_sec)
+            << "\t\t" << result.writes_per_insert << "\t\t"
+            << result.reads_per_lookup << "\n";
+}
+
+template <typename Insert, typename Finish, typename Lookup>
+static Result Run(const std::vector<int64_t>& keys, DiskManager& disk_manager,
+                  Insert insert, Finish finish, Lookup lookup) {
+  int writes = disk_manager.GetNumWrites();
+  auto start = std::chrono::steady_clock::now();
+  for (int64_t key : keys) {
+    insert(key);
+  }
+  finish();
+  std::chrono::duration<double> time =
+      std::chrono::steady_clock::now() - start;
+  double writes_per_insert =
+      static_cast<double>(disk_manager.GetNumWrites() - writes) / keys.size();
+
+  std::mt19937_64 rng(1);
+  int reads = disk_manager.GetNumReads();
+  for (size_t i = 0; i < NUM_LOOKUPS; i++) {
+    if (!lookup(keys[rng() % keys.size()])) {
+      std::cerr << "lookup missed an inserted key\n";
+      exit(1);
+    }
+  }
+  double reads_per_lookup =
+      static_cast<double>(disk_manager.GetNumReads() - reads) / NUM_LOOKUPS;
+  return {keys.size() / time.count(), writes_per_insert, reads_per_lookup};
+}
+
+int main(int argc, char** argv) {
+  const size_t num_keys = argc > 1 ? std::stoul(argv[1]) : 2000000;
+  std::vector<int64_t> keys(num_keys);
+  std::mt19937_64 rng(0);
+  for (auto& key : keys) {
+    key = static_cast<int64_t>(rng() >> 1);
+  }
+
+  std::cout << num_keys << " random 8 byte keys and values, pool of "
+            << FRAMES << " frames, " << NUM_LOOKUPS << " lookups\n";
+  std::cout << "index\tinserts/s\twrites/insert\tdisk reads/lookup\n";
+  {
+    auto disk_manager = std::make_shared<DiskManager>(file_name);
+    auto bpm =
+        std::make_shared<BufferPoolManager>(FRAMES, disk_manager.get());
+    Tree tree(bpm->NewPage(), bpm.get());
+    Result result = Run(
+        keys, *disk_manager, [&](int64_t key) { tree.Insert(key, key); },
+        [&]() { bpm->FlushAllPages(); },
+        [&](int64_t key) { return tree.GetValue(key).has_value(); });
+    Print("b+tree", result);
+    disk_manager->ShutDown();
+    remove(file_name);
+    remove(disk_manager->GetLogFileName());
+  }
+  {
+    auto disk_manager = std::make_shared<DiskManager>(file_name);
+    auto bpm =
+        std::make_shared<BufferPoolManager>(FRAMES, disk_manager.get());
+    LsmTree tree(bpm.get(), disk_manager.get());
+    size_t block_reads = 0;
+    Result result = Run(
+        keys, *disk_manager,
+        [&](int64_t key) {
+          char value[8];
+          memcpy(value, &key, sizeof(value));
+          tree.Put(EncodeKey(key), std::string_view(value, sizeof(value)));
+        },
+        [&]() {
+          tree.Flush();
+          block_reads = tree.GetBlockReads();
+        },
+        [&](int64_t key) { return tree.Get(EncodeKey(key)).has_value(); });
+    Print("lsm", result);
+    std::cout << "lsm run pages read per lookup "
+              << static_cast<double>(tree.GetBlockReads() - block_reads) /
+                     NUM_LOOKUPS
+              << ", runs per level";
+    for (size_t level = 0; level < LsmTree::MAX_LEVELS; level++) {
+      std::cout << " " << tree.GetRunCount(level);
+    }
+    std::cout << ", " << tree.GetCompactionCount() << " compactions\n";
+    disk_manager->ShutDown();
+    remove(file_name);
+    remove(disk_manager->GetLogFileName());
+  }
+}
@@ -0,0 +1,130 @@
+#include <buffer/buffer_pool_manager.hpp>
+#include <execution/aggregate.hpp>
+#include <execution/filter.hpp>
+#include <execution/morsel_scan.hpp>
+#include <execution/morsel_scheduler.hpp>
+#include <execution/projection.hpp>
+#include <storage/disk_manager.hpp>
+#include <storage/table/pax_table.hpp>
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+static std::filesystem::path file_name("morsel_scan_bench.db");
+const size_t FRAMES = 32768;
+// Smaller than the default so that small tables still have a few morsels
+const size_t BENCH_MORSEL_PAGES = 256;
+
+// quantity, extendedprice, discount, returnflag, shipdate and a payload
+static Schema MakeSchema() {
+  return Schema({Column("quantity", TypeId::Float64),
+                 Column("extendedprice", TypeId::Float64),
+                 Column("discount", TypeId::Float64),
+                 Column("returnflag", TypeId::Char, 1),
+                 Column("shipdate", TypeId::Date),
+                 Column("comment", TypeId::Char, 40)});
+}
+
+// sum(price * (1 - discount)), avg(quantity), count(*) by returnflag over
+// rows shipped before a cutoff
+static std::unique_ptr<Aggregate> Pipeline(
+    std::unique_ptr<VectorOperator> scan) {
+  // 0 returnflag, 1 quantity, 2 extendedprice, 3 discount, 4 shipdate
+  scan = std::make_unique<Filter<int32_t, CompareOp::Lt>>(std::move(scan), 4,
+                                                          2000);
+  scan = std::make_unique<Projection<double, ArithOp::Sub>>(
+      std::move(scan), Operand<double>::OfConstant(1.0),
+      Operand<double>::OfColumn(3), "one_minus_disc");
+  scan = std::make_unique<Projection<double, ArithOp::Mul>>(
+      std::move(scan), Operand<double>::OfColumn(2),
+      Operand<double>::OfColumn(5), "disc_price");
+  return std::make_unique<Aggregate>(
+      std::move(scan), std::vector<size_t>{0},
+      std::vector<AggregateExpr>{{AggregateType::Sum, 6, "sum_disc_price"},
+                                 {AggregateType::Avg, 1, "avg_qty"},
+                                 {AggregateType::Count, 0, "count_order"}});
+}
+
+int main(int argc, char** argv) {
+  const size_t num_rows = argc > 1 ? std::stoul(argv[1]) : 1000000;
+  const size_t max_workers =
+      std::max<size_t>(8, std::thread::hardware_concurrency());
+  const int rounds = 5;
+
+  auto disk_manager = std::make_shared<DiskManager>(file_name);
+  auto bpm = std::make_shared<BufferPoolManager>(FRAMES, disk_manager.get());
+  Schema schema = MakeSchema();
+  PaxTable table(bpm.get(), schema);
+
+  std::mt19937_64 rng(0);
+  std::vector<char> row(schema.GetTupleSize());
+  for (size_t i = 0; i < num_rows; i++) {
+    double quantity = 1 + rng() % 50;
+    double price = quantity * (900 + rng() % 100000 / 100.0);
+    double discount = (rng() % 11) / 100.0;
+    char flag = "ARN"[rng() % 3];
+    int32_t shipdate = rng() % 2527;
+    memcpy(row.data() + schema.GetOffset(0), &quantity, 8);
+    memcpy(row.data() + schema.GetOffset(1), &price, 8);
+    memcpy(row.data() + schema.GetOffset(2), &discount, 8);
+    memcpy(row.data() + schema.GetOffset(3), &flag, 1);
+    memcpy(row.data() + schema.GetOffset(4), &shipdate, 4);
+    table.InsertTuple(Tuple(row.data(), row.size()));
+  }
+  const std::vector<size_t> columns = {3, 0, 1, 2, 4};
+
+  std::cout << num_rows << " rows on " << table.GetPageIds().size()
+            << " pages, " << std::thread::hardware_concurrency()
+            << " hardware threads\n";
+  std::cout << "workers\trows/s\tspeedup\n";
+
+  double base_rate = 0;
+  double base_sum = 0;
+  for (size_t workers = 1; workers <= max_workers; workers *= 2) {
+    MorselScheduler scheduler(workers);
+    double sum = 0;
+    auto query = [&]() {
+      auto result = ParallelAggregate(&scheduler, &table, columns, Pipeline,
+                                      BENCH_MORSEL_PAGES);
+      Batch batch(result->GetColumns());
+      sum = 0;
+      while (result->Next(batch)) {
+        for (size_t i = 0; i < batch.GetSize(); i++) {
+          sum += batch.GetColumn(1).Data<double>()[i];
+        }
+      }
+    };
+
+    query();
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; r++) {
+      query();
+    }
+    std::chrono::duration<double> time =
+        std::chrono::steady_clock::now() - start;
+    double rate = static_cast<double>(num_rows) * rounds / time.count();
+
+    if (workers == 1) {
+      base_rate = rate;
+      base_sum = sum;
+    } else if (std::abs(sum - base_sum) > 1e-9 * std::abs(base_sum)) {
+      std::cerr << "results differ\n";
+      return 1;
+    }
+    std::cout << workers << "\t" << static_cast<size_t>(rate) << "\t"
+              << rate / base_rate << "\n";
+  }
+
+  disk_manager->ShutDown();
+  remove(file_name);
+  remove(disk_manager->GetLogFileName());
+}
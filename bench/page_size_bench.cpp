@@ -0,0 +1,84 @@
+#include <buffer/buffer_pool_manager.hpp>
+#include <execution/pax_scan.hpp>
+#include <storage/disk_manager.hpp>
+#include <storage/table/pax_table.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+static std::filesystem::path file_name("page_size_bench.db");
+// Pool of 8 MiB whatever the page size
+const size_t POOL_BYTES = 8 << 20;
+
+int main(int argc, char** argv) {
+  // A table of 8 times the pool, scanned cold through the pool
+  const size_t num_rows = argc > 1 ? std::stoul(argv[1]) : 2000000;
+  const int rounds = 3;
+  std::cout << num_rows << " rows of 32 bytes, pool of " << (POOL_BYTES >> 20)
+            << " MiB\n";
+  std::cout << "page KiB\tpages\tload rows/s\tscan rows/s\tscan MiB/s\n";
+  for (size_t page_size : {size_t{4} << 10, size_t{16} << 10,
+                           size_t{64} << 10}) {
+    auto disk_manager = std::make_shared<DiskManager>(file_name, page_size);
+    auto bpm = std::make_shared<BufferPoolManager>(POOL_BYTES / page_size,
+                                                   disk_manager.get());
+    PaxTable table(bpm.get(), Schema({Column("key", TypeId::Int64),
+                                      Column("cents", TypeId::Int64),
+                                      Column("comment", TypeId::Char, 16)}));
+
+    std::mt19937_64 rng(0);
+    char row[32] = {};
+    int64_t expected = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < num_rows; i++) {
+      int64_t key = i;
+      int64_t cents = rng() % 100000;
+      memcpy(row, &key, 8);
+      memcpy(row + 8, &cents, 8);
+      table.InsertTuple(Tuple(row, sizeof(row)));
+      expected += cents;
+    }
+    bpm->FlushAllPages();
+    std::chrono::duration<double> load_time =
+        std::chrono::steady_clock::now() - start;
+
+    start = std::chrono::steady_clock::now();
+    for (int round = 0; round < rounds; round++) {
+      PaxScan scan(&table, {0, 1});
+      Batch batch(scan.GetColumns());
+      int64_t sum = 0;
+      while (scan.Next(batch)) {
+        const int64_t* cents = batch.GetColumn(1).Data<int64_t>();
+        for (size_t i = 0; i < batch.GetSize(); i++) {
+          sum += cents[i];
+        }
+      }
+      if (sum != expected) {
+        std::cerr << "scan lost rows\n";
+        return 1;
+      }
+    }
+    std::chrono::duration<double> scan_time =
+        std::chrono::steady_clock::now() - start;
+
+    const size_t num_pages = table.GetPageIds().size();
+    const double scanned = static_cast<double>(rounds) * num_rows;
+    std::cout << (page_size >> 10) << "\t\t" << num_pages << "\t"
+              << static_cast<size_t>(num_rows / load_time.count()) << "\t\t"
+              << static_cast<size_t>(scanned / scan_time.count()) << "\t"
+              << rounds * num_pages * page_size / scan_time.count() /
+                     (1 << 20)
+              << "\n";
+
+    disk_manager->ShutDown();
+    remove(file_name);
+    remove(disk_manager->GetLogFileName());
+  }
+}
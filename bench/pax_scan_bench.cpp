@@ -0,0 +1,205 @@
+#include <buffer/buffer_pool_manager.hpp>
+#include <storage/disk_manager.hpp>
+#include <storage/page/pax_page.hpp>
+#include <storage/page/table_page.hpp>
+#include <storage/table/pax_table.hpp>
+#include <storage/table/table_heap.hpp>
+
+#include <bit>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+static std::filesystem::path file_name("pax_scan_bench.db");
+const size_t FRAMES = 32768;
+const size_t NUM_COLUMNS = 40;
+const size_t LINE_SIZE = 64;
+// Columns summed by the query, one of each type
+const std::vector<size_t> PROJECTION = {3, 16, 29};
+
+static_assert(DB_PAGE_SIZE / LINE_SIZE <= 64);
+
+static Schema MakeSchema() {
+  const TypeId types[] = {TypeId::Int64, TypeId::Int32, TypeId::Float64};
+  std::vector<Column> columns;
+  for (size_t i = 0; i < NUM_COLUMNS; i++) {
+    columns.emplace_back(std::string("c").append(std::to_string(i)),
+                         types[i % 3]);
+  }
+  return Schema(std::move(columns));
+}
+
+// Adds the value at data to the sum of its column's type
+static void Accumulate(TypeId type, const char* data, int64_t& ints,
+                       double& floats) {
+  if (type == TypeId::Int64) {
+    int64_t value;
+    memcpy(&value, data, sizeof(value));
+    ints += value;
+  } else if (type == TypeId::Int32) {
+    int32_t value;
+    memcpy(&value, data, sizeof(value));
+    ints += value;
+  } else {
+    double value;
+    memcpy(&value, data, sizeof(value));
+    floats += value;
+  }
+}
+
+// Minipages hold naturally aligned values, so they can be summed as arrays
+template <typename T>
+static T SumMinipage(const char* minipage, uint32_t rows) {
+  const T* values = reinterpret_cast<const T*>(minipage);
+  T sum = 0;
+  for (uint32_t i = 0; i < rows; i++) {
+    sum += values[i];
+  }
+  return sum;
+}
+
+// Cache lines of a page covered by [offset, offset + size)
+static uint64_t Lines(size_t offset, size_t size) {
+  uint64_t lines = 0;
+  size_t last = (offset + size - 1) / LINE_SIZE;
+  for (size_t line = offset / LINE_SIZE; line <= last; line++) {
+    lines |= uint64_t{1} << line;
+  }
+  return lines;
+}
+
+int main(int argc, char** argv) {
+  const size_t num_rows = argc > 1 ? std::stoul(argv[1]) : 200000;
+  const int rounds = 5;
+
+  auto disk_manager = std::make_shared<DiskManager>(file_name);
+  auto bpm = std::make_shared<BufferPoolManager>(FRAMES, disk_manager.get());
+  Schema schema = MakeSchema();
+  TableHeap heap(bpm.get());
+  PaxTable pax(bpm.get(), schema);
+
+  std::mt19937_64 rng(0);
+  std::vector<char> row(schema.GetTupleSize());
+  for (size_t i = 0; i < num_rows; i++) {
+    for (size_t c = 0; c < NUM_COLUMNS; c++) {
+      int64_t ivalue = rng() % 1000;
+      double fvalue = ivalue * 0.25;
+      const void* value = schema.GetColumn(c).type == TypeId::Float64
+                              ? static_cast<const void*>(&fvalue)
+                              : static_cast<const void*>(&ivalue);
+      memcpy(row.data() + schema.GetOffset(c), value, schema.GetColumn(c).size);
+    }
+    Tuple tuple(row.data(), row.size());
+    heap.InsertTuple(tuple);
+    pax.InsertTuple(tuple);
+  }
+
+  // Row format, reading the fields straight from the slotted pages
+  int64_t row_ints = 0;
+  double row_floats = 0;
+  auto row_scan = [&](size_t* touched_lines) {
+    PageId_t page_id = heap.GetFirstPageId();
+    while (page_id != INVALID_PAGE_ID) {
+      auto guard = bpm->ReadPage(page_id, AccessType::Scan);
+      const auto* page = guard.As<TablePage>();
+      uint64_t lines = 0;
+      for (uint32_t slot = 0; slot < page->GetNumSlots(); slot++) {
+        const char* tuple = page->GetTuple(slot)->first;
+        for (size_t c : PROJECTION) {
+          const char* value = tuple + schema.GetOffset(c);
+          Accumulate(schema.GetColumn(c).type, value, row_ints, row_floats);
+          if (touched_lines != nullptr) {
+            lines |= Lines(value - guard.GetData(), schema.GetColumn(c).size);
+          }
+        }
+      }
+      if (touched_lines != nullptr) {
+        *touched_lines += std::popcount(lines);
+      }
+      page_id = page->GetNextPageId();
+    }
+  };
+
+  // PAX format through the projecting iterator, a page at a time
+  int64_t pax_ints = 0;
+  double pax_floats = 0;
+  auto pax_scan = [&]() {
+    for (auto it = pax.Scan(PROJECTION); !it.IsEnd(); it.NextPage()) {
+      for (size_t i = 0; i < PROJECTION.size(); i++) {
+        TypeId type = schema.GetColumn(PROJECTION[i]).type;
+        const char* minipage = it.GetMinipage(i);
+        if (type == TypeId::Int64) {
+          pax_ints += SumMinipage<int64_t>(minipage, it.GetPageRows());
+        } else if (type == TypeId::Int32) {
+          pax_ints += SumMinipage<int32_t>(minipage, it.GetPageRows());
+        } else {
+          pax_floats += SumMinipage<double>(minipage, it.GetPageRows());
+        }
+      }
+    }
+  };
+
+  size_t row_pages = 0;
+  size_t row_lines = 0;
+  row_scan(&row_lines);
+  for (PageId_t id = heap.GetFirstPageId(); id != INVALID_PAGE_ID;
+       id = bpm->ReadPage(id).As<TablePage>()->GetNextPageId()) {
+    row_pages++;
+  }
+
+  size_t pax_pages = 0;
+  size_t pax_lines = 0;
+  for (PageId_t id = pax.GetFirstPageId(); id != INVALID_PAGE_ID;) {
+    auto guard = bpm->ReadPage(id);
+    const auto* page = guard.As<PaxPage>();
+    for (size_t c : PROJECTION) {
+      pax_lines += std::popcount(
+          Lines(page->GetMinipage(c) - guard.GetData(),
+                page->GetNumRows() * schema.GetColumn(c).size));
+    }
+    pax_pages++;
+    id = page->GetNextPageId();
+  }
+  pax_scan();
+
+  auto start = std::chrono::steady_clock::now();
+  for (int r = 0; r < rounds; r++) {
+    row_scan(nullptr);
+  }
+  std::chrono::duration<double> row_time =
+      std::chrono::steady_clock::now() - start;
+
+  start = std::chrono::steady_clock::now();
+  for (int r = 0; r < rounds; r++) {
+    pax_scan();
+  }
+  std::chrono::duration<double> pax_time =
+      std::chrono::steady_clock::now() - start;
+
+  if (row_ints != pax_ints || row_floats != pax_floats) {
+    std::cerr << "results differ\n";
+    return 1;
+  }
+
+  const double scanned = static_cast<double>(num_rows) * rounds;
+  const double rows = num_rows;
+  std::cout << num_rows << " rows of " << schema.GetTupleSize()
+            << " bytes, summing " << PROJECTION.size() << " of "
+            << NUM_COLUMNS << " columns\n";
+  std::cout << "format\tpages\tbytes touched/row\trows/s\n";
+  std::cout << "row\t" << row_pages << "\t" << row_lines * LINE_SIZE / rows
+            << "\t"
+            << static_cast<size_t>(scanned / row_time.count()) << "\n";
+  std::cout << "pax\t" << pax_pages << "\t" << pax_lines * LINE_SIZE / rows
+            << "\t"
+            << static_cast<size_t>(scanned / pax_time.count()) << "\n";
+
+  disk_manager->ShutDown();
+  remove(file_name);
+  remove(disk_manager->GetLogFileName());
+}
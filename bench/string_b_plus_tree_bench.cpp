@@ -0,0 +1,77 @@
+#include <buffer/buffer_pool_manager.hpp>
+#include <storage/disk_manager.hpp>
+#include <storage/index/string_b_plus_tree.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+static std::filesystem::path file_name("string_b_plus_tree_bench.db");
+const size_t FRAMES = 16384;
+const auto ROUND_TIME = std::chrono::milliseconds(1000);
+
+// Crawl like URLs: few hosts, a handful of path sections, numeric ids
+static std::vector<std::string> MakeUrls(size_t count) {
+  const std::vector<std::string> hosts = {
+      "https://www.wikipedia.org/wiki/", "https://en.m.wikipedia.org/wiki/",
+      "https://github.com/", "https://news.ycombinator.com/item?id=",
+      "https://www.amazon.com/dp/", "http://example.org/blog/"};
+  const std::vector<std::string> sections = {
+      "articles/", "users/", "2023/11/", "2024/02/", "products/electronics/",
+      "issues/", "pull/", "tree/main/src/"};
+  std::mt19937_64 rng(1);
+  std::vector<std::string> urls;
+  for (size_t i = 0; i < count; i++) {
+    std::string url = hosts[rng() % hosts.size()];
+    url += sections[rng() % sections.size()];
+    url += std::to_string(rng() % 100000000);
+    if (rng() % 2 == 0) {
+      url += "/index.html";
+    }
+    urls.push_back(std::move(url));
+  }
+  return urls;
+}
+
+int main(int argc, char** argv) {
+  const size_t num_keys = argc > 1 ? std::stoul(argv[1]) : 500000;
+  const auto urls = MakeUrls(num_keys);
+
+  std::cout << "compress\theight\tload s\tlookups/s\n";
+  for (const bool compress : {false, true}) {
+    auto disk_manager = std::make_shared<DiskManager>(file_name);
+    auto bpm = std::make_shared<BufferPoolManager>(FRAMES, disk_manager.get());
+    StringBPlusTree<int64_t> tree(bpm->NewPage(), bpm.get(), compress);
+
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < urls.size(); i++) {
+      tree.Insert(urls[i], i);
+    }
+    std::chrono::duration<double> load_time =
+        std::chrono::steady_clock::now() - start;
+
+    std::mt19937_64 rng(2);
+    size_t lookups = 0;
+    start = std::chrono::steady_clock::now();
+    while (std::chrono::steady_clock::now() - start < ROUND_TIME) {
+      for (int i = 0; i < 1000; i++) {
+        tree.GetValue(urls[rng() % urls.size()]);
+      }
+      lookups += 1000;
+    }
+    std::chrono::duration<double> lookup_time =
+        std::chrono::steady_clock::now() - start;
+
+    std::cout << compress << "\t" << tree.GetHeight() << "\t"
+              << load_time.count() << "\t"
+              << static_cast<size_t>(lookups / lookup_time.count()) << "\n";
+
+    disk_manager->ShutDown();
+    remove(file_name);
+    remove(disk_manager->GetLogFileName());
+  }
+}
@@ -0,0 +1,55 @@
+#include <buffer/buffer_pool_manager.hpp>
+#include <storage/disk_manager.hpp>
+#include <storage/table/table_heap.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <vector>
+
+static std::filesystem::path file_name("table_heap_bench.db");
+const size_t FRAMES = 1024;
+
+int main(int argc, char** argv) {
+  const size_t num_tuples = argc > 1 ? std::stoul(argv[1]) : 1000000;
+  const size_t tuple_size = argc > 2 ? std::stoul(argv[2]) : 100;
+
+  auto disk_manager = std::make_shared<DiskManager>(file_name);
+  auto bpm = std::make_shared<BufferPoolManager>(FRAMES, disk_manager.get());
+  TableHeap heap(bpm.get());
+
+  std::vector<char> data(tuple_size, 'x');
+  auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < num_tuples; i++) {
+    memcpy(data.data(), &i, std::min(sizeof(i), tuple_size));
+    heap.InsertTuple(Tuple(data.data(), data.size()));
+  }
+  std::chrono::duration<double> insert_time =
+      std::chrono::steady_clock::now() - start;
+
+  start = std::chrono::steady_clock::now();
+  size_t scanned = 0;
+  size_t bytes = 0;
+  for (auto it = heap.Begin(); it != heap.End(); ++it) {
+    scanned++;
+    bytes += (*it).GetSize();
+  }
+  std::chrono::duration<double> scan_time =
+      std::chrono::steady_clock::now() - start;
+
+  const double mb = num_tuples * tuple_size / (1024.0 * 1024.0);
+  std::cout << "tuples " << num_tuples << " x " << tuple_size << " bytes\n";
+  std::cout << "insert\t"
+            << static_cast<size_t>(num_tuples / insert_time.count())
+            << " tuples/s\t" << mb / insert_time.count() << " MB/s\n";
+  std::cout << "scan\t" << static_cast<size_t>(scanned / scan_time.count())
+            << " tuples/s\t" << bytes / (1024.0 * 1024.0) / scan_time.count()
+            << " MB/s\n";
+
+  disk_manager->ShutDown();
+  remove(file_name);
+  remove(disk_manager->GetLogFileName());
+}
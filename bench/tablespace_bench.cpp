@@ -0,0 +1,94 @@
+#include <buffer/buffer_pool_manager.hpp>
+#include <storage/tablespace.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+static std::filesystem::path file_name("tablespace_bench.db");
+const size_t FRAMES = 4096;
+// Pages of a read-ahead batch
+const size_t BATCH_PAGES = 256;
+
+int main(int argc, char** argv) {
+  // tablespace_bench [pages] [directory...], directories on different devices
+  // show the parallelism of the files, by default they are made in the
+  // working directory
+  const size_t num_pages = argc > 1 ? std::stoul(argv[1]) : 65536;
+  std::vector<std::filesystem::path> all_directories;
+  for (int i = 2; i < argc; i++) {
+    all_directories.push_back(argv[i]);
+  }
+  if (all_directories.empty()) {
+    for (size_t i = 0; i < 4; i++) {
+      all_directories.push_back("tablespace_bench_" + std::to_string(i));
+    }
+  }
+  for (const auto& directory : all_directories) {
+    std::filesystem::create_directories(directory);
+  }
+
+  std::cout << num_pages << " pages, pool of " << FRAMES << " frames, "
+            << BATCH_PAGES << " page batches\n";
+  std::cout << "files\twrite MiB/s\tread MiB/s\n";
+  for (size_t files = 1; files <= all_directories.size(); files *= 2) {
+    std::vector<std::filesystem::path> directories(
+        all_directories.begin(), all_directories.begin() + files);
+    auto tablespace = std::make_shared<Tablespace>(file_name, directories);
+    auto bpm = std::make_shared<BufferPoolManager>(FRAMES, tablespace.get());
+
+    // A pool full of dirty pages at a time is flushed, the writes of a flush
+    // are queued at once and spread over the files by extent
+    auto start = std::chrono::steady_clock::now();
+    PageId_t next = INVALID_PAGE_ID;
+    for (size_t i = 0; i < num_pages; i++) {
+      if (i % TABLE_EXTENT_PAGES == 0) {
+        next = bpm->NewPages(TABLE_EXTENT_PAGES);
+      }
+      memset(bpm->WritePage(next++).GetDataMut(), static_cast<int>(i),
+             DB_PAGE_SIZE);
+      if ((i + 1) % (FRAMES / 2) == 0) {
+        bpm->FlushAllPages();
+      }
+    }
+    bpm->FlushAllPages();
+    tablespace->Sync();
+    std::chrono::duration<double> write_time =
+        std::chrono::steady_clock::now() - start;
+
+    // Read-ahead of random pages, each batch is read by all files at once
+    std::mt19937_64 rng(0);
+    std::vector<PageId_t> batch(BATCH_PAGES);
+    start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < num_pages / BATCH_PAGES; i++) {
+      for (auto& page_id : batch) {
+        page_id = rng() % num_pages;
+      }
+      bpm->PrefetchPages(batch);
+    }
+    std::chrono::duration<double> read_time =
+        std::chrono::steady_clock::now() - start;
+
+    const double mib = num_pages * DB_PAGE_SIZE / (1024.0 * 1024.0);
+    std::cout << files << "\t" << mib / write_time.count() << "\t\t"
+              << mib / read_time.count() << "\n";
+
+    bpm.reset();
+    tablespace->ShutDown();
+    for (size_t i = 0; i < files; i++) {
+      remove(tablespace->GetFileName(i));
+    }
+    remove(tablespace->GetLogFileName());
+  }
+  if (argc <= 2) {
+    for (const auto& directory : all_directories) {
+      std::filesystem::remove_all(directory);
+    }
+  }
+}
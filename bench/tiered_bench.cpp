@@ -0,0 +1,67 @@
+#include <buffer/buffer_pool_manager.hpp>
+#include <storage/tiered_disk_manager.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+
+static std::filesystem::path file_name("tiered_bench.db");
+static std::filesystem::path fast_directory("tiered_bench_fast");
+static std::filesystem::path slow_directory("tiered_bench_slow");
+const size_t FRAMES = 64;
+const size_t NUM_PAGES = 4096;
+// The fast tier holds an eighth of the pages
+const size_t FAST_PAGES = NUM_PAGES / 8;
+const auto SLOW_LATENCY = std::chrono::microseconds(200);
+
+int main(int argc, char** argv) {
+  // 90% of the reads go to a hot set of 5% of the pages, loaded last so it
+  // starts out on the slow tier
+  const size_t num_reads = argc > 1 ? std::stoul(argv[1]) : 20000;
+  std::cout << NUM_PAGES << " pages, " << FAST_PAGES << " fast, pool of "
+            << FRAMES << " frames, slow tier latency "
+            << SLOW_LATENCY.count() << "us\n";
+  std::cout << "migration\treads/s\tpromotions\tdemotions\n";
+  for (size_t pages_per_second : {size_t{0}, TIER_MIGRATION_PAGES_PER_SECOND}) {
+    std::filesystem::create_directories(fast_directory);
+    std::filesystem::create_directories(slow_directory);
+    auto disk_manager = std::make_shared<TieredDiskManager>(
+        file_name, fast_directory, slow_directory, FAST_PAGES,
+        pages_per_second, SLOW_LATENCY);
+    auto bpm = std::make_shared<BufferPoolManager>(FRAMES, disk_manager.get());
+    for (size_t i = 0; i < NUM_PAGES; i++) {
+      memset(bpm->WritePage(bpm->NewPage()).GetDataMut(), static_cast<int>(i),
+             DB_PAGE_SIZE);
+    }
+    bpm->FlushAllPages();
+
+    const size_t hot_pages = NUM_PAGES / 20;
+    std::mt19937_64 rng(0);
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < num_reads; i++) {
+      PageId_t page_id = rng() % 10 < 9
+                             ? NUM_PAGES - 1 - rng() % hot_pages
+                             : rng() % NUM_PAGES;
+      bpm->ReadPage(page_id);
+    }
+    std::chrono::duration<double> time =
+        std::chrono::steady_clock::now() - start;
+
+    std::cout << (pages_per_second > 0 ? "on" : "off") << "\t\t"
+              << static_cast<size_t>(num_reads / time.count()) << "\t"
+              << disk_manager->GetNumPromotions() << "\t\t"
+              << disk_manager->GetNumDemotions() << "\n";
+
+    disk_manager->ShutDown();
+    std::filesystem::remove_all(fast_directory);
+    std::filesystem::remove_all(slow_directory);
+    remove(disk_manager->GetLogFileName());
+    remove(disk_manager->GetCheckpointFileName());
+  }
+}
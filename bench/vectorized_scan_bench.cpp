@@ -0,0 +1,283 @@
+#include <buffer/buffer_pool_manager.hpp>
+#include <execution/aggregate.hpp>
+#include <execution/filter.hpp>
+#include <execution/kernels.hpp>
+#include <execution/pax_scan.hpp>
+#include <execution/projection.hpp>
+#include <storage/disk_manager.hpp>
+#include <storage/table/pax_table.hpp>
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+static std::filesystem::path file_name("vectorized_scan_bench.db");
+const size_t FRAMES = 32768;
+
+// TPC-H lineitem, dates are days since 1992-01-01
+enum LineitemColumn : size_t {
+  ORDERKEY,
+  QUANTITY,
+  EXTENDEDPRICE,
+  DISCOUNT,
+  TAX,
+  RETURNFLAG,
+  LINESTATUS,
+  SHIPDATE,
+  COMMITDATE,
+  RECEIPTDATE,
+  SHIPMODE,
+  COMMENT,
+};
+
+const int32_t LAST_SHIPDATE = 2526;
+// 1998-12-01 - 90 days
+const int32_t Q1_SHIPDATE = 2436;
+// [1994-01-01, 1995-01-01)
+const int32_t Q6_SHIPDATE_BEGIN = 731;
+const int32_t Q6_SHIPDATE_END = 1096;
+
+static Schema MakeSchema() {
+  return Schema({Column("orderkey", TypeId::Int64),
+                 Column("quantity", TypeId::Float64),
+                 Column("extendedprice", TypeId::Float64),
+                 Column("discount", TypeId::Float64),
+                 Column("tax", TypeId::Float64),
+                 Column("returnflag", TypeId::Char, 1),
+                 Column("linestatus", TypeId::Char, 1),
+                 Column("shipdate", TypeId::Date),
+                 Column("commitdate", TypeId::Date),
+                 Column("receiptdate", TypeId::Date),
+                 Column("shipmode", TypeId::Char, 10),
+                 Column("comment", TypeId::Char, 27)});
+}
+
+template <typename T>
+static void Put(std::vector<char>& row, const Schema& schema, size_t column,
+                T value) {
+  memcpy(row.data() + schema.GetOffset(column), &value, sizeof(T));
+}
+
+struct Q1Group {
+  double sum_qty = 0;
+  double sum_base_price = 0;
+  double sum_disc_price = 0;
+  double sum_charge = 0;
+  double sum_disc = 0;
+  int64_t count = 0;
+};
+
+static std::unique_ptr<VectorOperator> Q1Plan(PaxTable* table) {
+  // 0 returnflag, 1 linestatus, 2 quantity, 3 extendedprice, 4 discount,
+  // 5 tax, 6 shipdate
+  std::unique_ptr<VectorOperator> plan = std::make_unique<PaxScan>(
+      table, std::vector<size_t>{RETURNFLAG, LINESTATUS, QUANTITY,
+                                 EXTENDEDPRICE, DISCOUNT, TAX, SHIPDATE});
+  plan = std::make_unique<Filter<int32_t, CompareOp::Le>>(std::move(plan), 6,
+                                                          Q1_SHIPDATE);
+  // 7 1 - discount, 8 disc_price, 9 1 + tax, 10 charge
+  plan = std::make_unique<Projection<double, ArithOp::Sub>>(
+      std::move(plan), Operand<double>::OfConstant(1.0),
+      Operand<double>::OfColumn(4), "one_minus_disc");
+  plan = std::make_unique<Projection<double, ArithOp::Mul>>(
+      std::move(plan), Operand<double>::OfColumn(3),
+      Operand<double>::OfColumn(7), "disc_price");
+  plan = std::make_unique<Projection<double, ArithOp::Add>>(
+      std::move(plan), Operand<double>::OfConstant(1.0),
+      Operand<double>::OfColumn(5), "one_plus_tax");
+  plan = std::make_unique<Projection<double, ArithOp::Mul>>(
+      std::move(plan), Operand<double>::OfColumn(8),
+      Operand<double>::OfColumn(9), "charge");
+  return std::make_unique<Aggregate>(
+      std::move(plan), std::vector<size_t>{0, 1},
+      std::vector<AggregateExpr>{{AggregateType::Sum, 2, "sum_qty"},
+                                 {AggregateType::Sum, 3, "sum_base_price"},
+                                 {AggregateType::Sum, 8, "sum_disc_price"},
+                                 {AggregateType::Sum, 10, "sum_charge"},
+                                 {AggregateType::Avg, 2, "avg_qty"},
+                                 {AggregateType::Avg, 3, "avg_price"},
+                                 {AggregateType::Avg, 4, "avg_disc"},
+                                 {AggregateType::Count, 0, "count_order"}});
+}
+
+static std::unique_ptr<VectorOperator> Q6Plan(PaxTable* table) {
+  // 0 shipdate, 1 discount, 2 quantity, 3 extendedprice
+  std::unique_ptr<VectorOperator> plan = std::make_unique<PaxScan>(
+      table,
+      std::vector<size_t>{SHIPDATE, DISCOUNT, QUANTITY, EXTENDEDPRICE});
+  plan = std::make_unique<Filter<int32_t, CompareOp::Ge>>(std::move(plan), 0,
+                                                          Q6_SHIPDATE_BEGIN);
+  plan = std::make_unique<Filter<int32_t, CompareOp::Lt>>(std::move(plan), 0,
+                                                          Q6_SHIPDATE_END);
+  plan = std::make_unique<Filter<double, CompareOp::Ge>>(std::move(plan), 1,
+                                                         0.05);
+  plan = std::make_unique<Filter<double, CompareOp::Le>>(std::move(plan), 1,
+                                                         0.07);
+  plan = std::make_unique<Filter<double, CompareOp::Lt>>(std::move(plan), 2,
+                                                         24.0);
+  plan = std::make_unique<Projection<double, ArithOp::Mul>>(
+      std::move(plan), Operand<double>::OfColumn(3),
+      Operand<double>::OfColumn(1), "revenue");
+  return std::make_unique<Aggregate>(
+      std::move(plan), std::vector<size_t>{},
+      std::vector<AggregateExpr>{{AggregateType::Sum, 4, "revenue"}});
+}
+
+static bool Close(double a, double b) {
+  return std::abs(a - b) <= 1e-9 * std::max(std::abs(a), std::abs(b));
+}
+
+// Runs query rounds times and returns rows/s
+static double Measure(size_t num_rows, int rounds,
+                      const std::function<void()>& query) {
+  query();
+  auto start = std::chrono::steady_clock::now();
+  for (int r = 0; r < rounds; r++) {
+    query();
+  }
+  std::chrono::duration<double> time = std::chrono::steady_clock::now() - start;
+  return static_cast<double>(num_rows) * rounds / time.count();
+}
+
+int main(int argc, char** argv) {
+  const size_t num_rows = argc > 1 ? std::stoul(argv[1]) : 500000;
+  const int rounds = 5;
+
+  auto disk_manager = std::make_shared<DiskManager>(file_name);
+  auto bpm = std::make_shared<BufferPoolManager>(FRAMES, disk_manager.get());
+  Schema schema = MakeSchema();
+  PaxTable table(bpm.get(), schema);
+
+  std::mt19937_64 rng(0);
+  std::vector<char> row(schema.GetTupleSize());
+  for (size_t i = 0; i < num_rows; i++) {
+    int32_t shipdate = rng() % (LAST_SHIPDATE + 1);
+    double quantity = 1 + rng() % 50;
+    Put<int64_t>(row, schema, ORDERKEY, i / 4);
+    Put<double>(row, schema, QUANTITY, quantity);
+    Put<double>(row, schema, EXTENDEDPRICE,
+                quantity * (900 + rng() % 100000 / 100.0));
+    Put<double>(row, schema, DISCOUNT, (rng() % 11) / 100.0);
+    Put<double>(row, schema, TAX, (rng() % 9) / 100.0);
+    Put<char>(row, schema, RETURNFLAG, "ARN"[rng() % 3]);
+    Put<char>(row, schema, LINESTATUS, shipdate > 1263 ? 'O' : 'F');
+    Put<int32_t>(row, schema, SHIPDATE, shipdate);
+    Put<int32_t>(row, schema, COMMITDATE, shipdate + rng() % 60);
+    Put<int32_t>(row, schema, RECEIPTDATE, shipdate + 1 + rng() % 30);
+    memset(row.data() + schema.GetOffset(SHIPMODE), 'M', 10);
+    memset(row.data() + schema.GetOffset(COMMENT), 'c', 27);
+    table.InsertTuple(Tuple(row.data(), row.size()));
+  }
+
+  // Tuple at a time through the projecting iterator
+  std::unordered_map<uint16_t, Q1Group> q1_rows;
+  auto q1_tuples = [&]() {
+    q1_rows.clear();
+    for (auto it = table.Scan({RETURNFLAG, LINESTATUS, QUANTITY,
+                               EXTENDEDPRICE, DISCOUNT, TAX, SHIPDATE});
+         !it.IsEnd(); ++it) {
+      if (it.Get<int32_t>(6) > Q1_SHIPDATE) {
+        continue;
+      }
+      uint16_t key = static_cast<uint8_t>(it.Get<char>(0)) << 8 |
+                     static_cast<uint8_t>(it.Get<char>(1));
+      Q1Group& group = q1_rows[key];
+      double quantity = it.Get<double>(2);
+      double price = it.Get<double>(3);
+      double discount = it.Get<double>(4);
+      double disc_price = price * (1 - discount);
+      group.sum_qty += quantity;
+      group.sum_base_price += price;
+      group.sum_disc_price += disc_price;
+      group.sum_charge += disc_price * (1 + it.Get<double>(5));
+      group.sum_disc += discount;
+      group.count++;
+    }
+  };
+
+  double q6_rows = 0;
+  auto q6_tuples = [&]() {
+    q6_rows = 0;
+    for (auto it = table.Scan({SHIPDATE, DISCOUNT, QUANTITY, EXTENDEDPRICE});
+         !it.IsEnd(); ++it) {
+      int32_t shipdate = it.Get<int32_t>(0);
+      double discount = it.Get<double>(1);
+      if (shipdate >= Q6_SHIPDATE_BEGIN && shipdate < Q6_SHIPDATE_END &&
+          discount >= 0.05 && discount <= 0.07 && it.Get<double>(2) < 24.0) {
+        q6_rows += it.Get<double>(3) * discount;
+      }
+    }
+  };
+
+  // Vectorized, a batch of column vectors at a time
+  std::unordered_map<uint16_t, Q1Group> q1_vectors;
+  auto q1_batches = [&]() {
+    q1_vectors.clear();
+    auto plan = Q1Plan(&table);
+    Batch batch(plan->GetColumns());
+    while (plan->Next(batch)) {
+      for (size_t i = 0; i < batch.GetSize(); i++) {
+        uint16_t key =
+            static_cast<uint8_t>(batch.GetColumn(0).GetData()[i]) << 8 |
+            static_cast<uint8_t>(batch.GetColumn(1).GetData()[i]);
+        Q1Group& group = q1_vectors[key];
+        group.sum_qty = batch.GetColumn(2).Data<double>()[i];
+        group.sum_base_price = batch.GetColumn(3).Data<double>()[i];
+        group.sum_disc_price = batch.GetColumn(4).Data<double>()[i];
+        group.sum_charge = batch.GetColumn(5).Data<double>()[i];
+        group.count = batch.GetColumn(9).Data<int64_t>()[i];
+        group.sum_disc = batch.GetColumn(8).Data<double>()[i] * group.count;
+      }
+    }
+  };
+
+  double q6_vectors = 0;
+  auto q6_batches = [&]() {
+    auto plan = Q6Plan(&table);
+    Batch batch(plan->GetColumns());
+    plan->Next(batch);
+    q6_vectors = batch.GetColumn(0).Data<double>()[0];
+  };
+
+  double q1_tuple_rate = Measure(num_rows, rounds, q1_tuples);
+  double q1_vector_rate = Measure(num_rows, rounds, q1_batches);
+  double q6_tuple_rate = Measure(num_rows, rounds, q6_tuples);
+  double q6_vector_rate = Measure(num_rows, rounds, q6_batches);
+
+  bool same = q1_rows.size() == q1_vectors.size() && Close(q6_rows, q6_vectors);
+  for (const auto& [key, group] : q1_rows) {
+    auto it = q1_vectors.find(key);
+    same = same && it != q1_vectors.end() &&
+           group.count == it->second.count &&
+           Close(group.sum_qty, it->second.sum_qty) &&
+           Close(group.sum_base_price, it->second.sum_base_price) &&
+           Close(group.sum_disc_price, it->second.sum_disc_price) &&
+           Close(group.sum_charge, it->second.sum_charge) &&
+           Close(group.sum_disc, it->second.sum_disc);
+  }
+  if (!same) {
+    std::cerr << "results differ\n";
+    return 1;
+  }
+
+  std::cout << num_rows << " lineitem rows, "
+            << VectorKernelName(DetectVectorKernel()) << " kernels\n";
+  std::cout << "query\ttuples rows/s\tvectors rows/s\n";
+  std::cout << "Q1\t" << static_cast<size_t>(q1_tuple_rate) << "\t"
+            << static_cast<size_t>(q1_vector_rate) << "\n";
+  std::cout << "Q6\t" << static_cast<size_t>(q6_tuple_rate) << "\t"
+            << static_cast<size_t>(q6_vector_rate) << "\n";
+
+  disk_manager->ShutDown();
+  remove(file_name);
+  remove(disk_manager->GetLogFileName());
+}
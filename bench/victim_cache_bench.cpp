@@ -0,0 +1,59 @@
+#include <buffer/buffer_pool_manager.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+
+static std::filesystem::path file_name("victim_cache_bench.db");
+const size_t FRAMES = 64;
+const size_t NUM_PAGES = 1024;
+
+int main(int argc, char** argv) {
+  // Uniform reads over pages of text rows, four times as many as the pool
+  // holds, with the pool alone and with a cache of half the raw page bytes
+  const size_t num_reads = argc > 1 ? std::stoul(argv[1]) : 50000;
+  const size_t cache_bytes = NUM_PAGES / 2 * DB_PAGE_SIZE;
+  std::cout << NUM_PAGES << " pages, pool of " << FRAMES << " frames\n";
+  std::cout << "cache KiB\treads/s\t\tdisk reads\thit ratio\tcompression\n";
+  for (size_t budget : {size_t{0}, cache_bytes}) {
+    auto disk_manager = std::make_shared<DiskManager>(file_name);
+    auto bpm = std::make_shared<BufferPoolManager>(FRAMES, disk_manager.get(),
+                                                   budget);
+    for (size_t i = 0; i < NUM_PAGES; i++) {
+      std::string text;
+      for (size_t row = 0; text.size() < DB_PAGE_SIZE; row++) {
+        text += std::to_string(i * 100 + row) + "|customer|" +
+                std::to_string(row % 7) + "|regular account|";
+      }
+      memcpy(bpm->WritePage(bpm->NewPage()).GetDataMut(), text.data(),
+             DB_PAGE_SIZE);
+    }
+    bpm->FlushAllPages();
+
+    int reads = disk_manager->GetNumReads();
+    std::mt19937_64 rng(0);
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < num_reads; i++) {
+      bpm->ReadPage(rng() % NUM_PAGES);
+    }
+    std::chrono::duration<double> time =
+        std::chrono::steady_clock::now() - start;
+
+    const VictimCache* cache = bpm->GetVictimCache();
+    std::cout << budget / 1024 << "\t\t"
+              << static_cast<size_t>(num_reads / time.count()) << "\t\t"
+              << disk_manager->GetNumReads() - reads << "\t\t"
+              << (cache != nullptr ? cache->GetHitRatio() : 0) << "\t\t"
+              << (cache != nullptr ? cache->GetCompressionRatio() : 1)
+              << "\n";
+
+    disk_manager->ShutDown();
+    remove(file_name);
+    remove(disk_manager->GetLogFileName());
+  }
+}
@@ -0,0 +1,94 @@
+#include <buffer/buffer_pool_manager.hpp>
+#include <execution/filter.hpp>
+#include <execution/pax_scan.hpp>
+#include <storage/disk_manager.hpp>
+#include <storage/table/pax_table.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+static std::filesystem::path file_name("zone_map_scan_bench.db");
+const size_t FRAMES = 1024;
+// Ten years of orders
+const int32_t NUM_DAYS = 3650;
+
+// Rows with a date in [first_day, last_day] counted by a filtered scan of the
+// given pages
+static size_t CountRange(PaxTable& table, std::vector<PageId_t> page_ids,
+                         int32_t first_day, int32_t last_day) {
+  std::unique_ptr<VectorOperator> plan = std::make_unique<PaxScan>(
+      &table, std::vector<size_t>{0, 1}, std::move(page_ids));
+  plan = std::make_unique<Filter<int32_t, CompareOp::Ge>>(std::move(plan), 0,
+                                                          first_day);
+  plan = std::make_unique<Filter<int32_t, CompareOp::Le>>(std::move(plan), 0,
+                                                          last_day);
+  Batch batch(plan->GetColumns());
+  size_t count = 0;
+  while (plan->Next(batch)) {
+    count += batch.GetSelectedCount();
+  }
+  return count;
+}
+
+int main(int argc, char** argv) {
+  // Orders arrive in date order, a table of about 8 times the buffer pool
+  const size_t num_rows = argc > 1 ? std::stoul(argv[1]) : 1000000;
+  auto disk_manager = std::make_shared<DiskManager>(file_name);
+  auto bpm = std::make_shared<BufferPoolManager>(FRAMES, disk_manager.get());
+  PaxTable table(bpm.get(), Schema({Column("orderdate", TypeId::Date),
+                                    Column("amount", TypeId::Float64),
+                                    Column("comment", TypeId::Char, 20)}));
+  table.AddZoneMap(0);
+
+  std::mt19937 rng(0);
+  char row[32] = {};
+  for (size_t i = 0; i < num_rows; i++) {
+    int32_t day = static_cast<int32_t>(i * NUM_DAYS / num_rows);
+    double amount = rng() % 100000 / 100.0;
+    memcpy(row, &day, 4);
+    memcpy(row + 4, &amount, 8);
+    table.InsertTuple(Tuple(row, sizeof(row)));
+  }
+  bpm->FlushAllPages();
+  const size_t num_pages = table.GetPageIds().size();
+
+  std::cout << num_rows << " rows on " << num_pages << " pages, pool of "
+            << FRAMES << " frames\n";
+  std::cout << "days\tpages read\tfull scan ms\tzone map ms\trows\n";
+  for (int32_t days : {1, 30, 365, NUM_DAYS}) {
+    int32_t first_day = NUM_DAYS / 2;
+    int32_t last_day = first_day + days - 1;
+
+    auto start = std::chrono::steady_clock::now();
+    size_t full = CountRange(table, table.GetPageIds(), first_day, last_day);
+    std::chrono::duration<double, std::milli> full_time =
+        std::chrono::steady_clock::now() - start;
+
+    start = std::chrono::steady_clock::now();
+    auto page_ids =
+        table.GetPageIds(0, reinterpret_cast<const char*>(&first_day),
+                         reinterpret_cast<const char*>(&last_day));
+    size_t pages_read = page_ids.size();
+    size_t pruned = CountRange(table, std::move(page_ids), first_day, last_day);
+    std::chrono::duration<double, std::milli> pruned_time =
+        std::chrono::steady_clock::now() - start;
+
+    if (full != pruned) {
+      std::cerr << "zone map scan lost rows\n";
+      return 1;
+    }
+    std::cout << days << "\t" << pages_read << "\t\t" << full_time.count()
+              << "\t\t" << pruned_time.count() << "\t\t" << pruned << "\n";
+  }
+
+  disk_manager->ShutDown();
+  remove(file_name);
+  remove(disk_manager->GetLogFileName());
+}
@@ -1,6 +1,7 @@
 #include <buffer/arc_replacer.hpp>
 
 #include <stdexcept>
+#include <vector>
 
 FrameStatus::FrameStatus(PageId_t page_id, FrameId_t frame_id, bool ev,
                          ArcStatus status)
@@ -8,7 +9,9 @@ FrameStatus::FrameStatus(PageId_t page_id, FrameId_t frame_id, bool ev,
 
 ArcReplacer::ArcReplacer(size_t size) : replacer_size_(size) {}
 
-std::optional<FrameId_t> ArcReplacer::EvictOneList_(bool is_mru) {
+std::optional<FrameId_t> ArcReplacer::EvictOneList_(
+    bool is_mru, const std::function<bool(FrameId_t)>& take_reference,
+    bool& passed) {
   std::list<FrameId_t>::reverse_iterator it, end;
   if (is_mru) {
     it = mru_.rbegin();
@@ -18,6 +21,8 @@ std::optional<FrameId_t> ArcReplacer::EvictOneList_(bool is_mru) {
     end = mfu_.rend();
   }
 
+  std::vector<FrameId_t> referenced;
+  std::optional<FrameId_t> victim;
   for (; it != end; it++) {
     FrameId_t frame_id = *it;
     auto status_it = alive_map_.find(frame_id);
@@ -26,6 +31,10 @@ std::optional<FrameId_t> ArcReplacer::EvictOneList_(bool is_mru) {
     FrameStatus status = status_it->second;
     if (!status.evictable)
       continue;
+    if (take_reference && take_reference(frame_id)) {
+      referenced.push_back(frame_id);
+      continue;
+    }
 
     if (is_mru)
       status.arc_status = ArcStatus::MRU_GHOST;
@@ -43,32 +52,43 @@ std::optional<FrameId_t> ArcReplacer::EvictOneList_(bool is_mru) {
       mru_map_.erase(frame_id);
       mru_ghost_.push_front(status.page_id);
       mru_ghost_map_[status.page_id] = mru_ghost_.begin();
-      return frame_id;
     } else {
       mfu_.erase(erase_it);
       mfu_map_.erase(frame_id);
       mfu_ghost_.push_front(status.page_id);
       mfu_ghost_map_[status.page_id] = mfu_ghost_.begin();
-      return frame_id;
     }
+    victim = frame_id;
+    break;
   }
 
-  return std::nullopt;
+  // Frames read since they were last passed over count as accessed now
+  for (FrameId_t frame_id : referenced) {
+    RecordAccessExists_(frame_id, AccessType::Unknown);
+  }
+  passed = passed || !referenced.empty();
+  return victim;
 }
 
-std::optional<FrameId_t> ArcReplacer::Evict() {
+std::optional<FrameId_t> ArcReplacer::Evict(
+    const std::function<bool(FrameId_t)>& take_reference) {
   std::lock_guard<std::mutex> l(mutex_);
   std::optional<FrameId_t> ret;
 
-  if (mru_.size() >= mru_target_size_) {
-    if ((ret = EvictOneList_(true)) != std::nullopt)
+  // A round that passed over referenced frames took their references, the
+  // next one can evict them
+  bool passed;
+  do {
+    passed = false;
+    bool is_mru = mru_.size() >= mru_target_size_;
+    if ((ret = EvictOneList_(is_mru, take_reference, passed)) !=
+        std::nullopt)
       return ret;
-    return EvictOneList_(false);
-  } else {
-    if ((ret = EvictOneList_(false)) != std::nullopt)
+    if ((ret = EvictOneList_(!is_mru, take_reference, passed)) !=
+        std::nullopt)
       return ret;
-    return EvictOneList_(true);
-  }
+  } while (passed);
+  return std::nullopt;
 }
 
 bool ArcReplacer::RecordAccessExists_(FrameId_t frame_id,
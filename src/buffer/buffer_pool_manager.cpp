@@ -1,9 +1,11 @@
 #include <buffer/buffer_pool_manager.hpp>
 
+#include <algorithm>
+#include <bit>
 #include <iostream>
 
-FrameHeader::FrameHeader(FrameId_t frame_id)
-    : frame_id_(frame_id), data_(DB_PAGE_SIZE, 0) {
+FrameHeader::FrameHeader(FrameId_t frame_id, size_t page_size)
+    : frame_id_(frame_id), data_(page_size, 0) {
   Reset();
 }
 
@@ -16,14 +18,16 @@ char* FrameHeader::GetDataMut() {
 }
 
 void FrameHeader::Reset() {
-  std::fill(data_.begin(), data_.end(), 0);
+  ZeroPage(data_.data(), data_.size());
   pin_count_.store(0);
   is_dirty_ = false;
 }
 
 BufferPoolManager::BufferPoolManager(size_t num_frames,
-                                     DiskManager* disk_manager)
+                                     DiskManager* disk_manager,
+                                     size_t victim_cache_bytes)
     : num_frames_(num_frames),
+      page_size_(disk_manager->GetPageSize()),
       next_page_id_(0),
       mutex_(std::make_shared<std::mutex>()),
       replacer_(std::make_shared<ArcReplacer>(num_frames)),
@@ -34,9 +38,19 @@ BufferPoolManager::BufferPoolManager(size_t num_frames,
   page_table_.reserve(num_frames_);
   rev_page_table_.reserve(num_frames_);
   for (size_t i = 0; i < num_frames_; i++) {
-    frames_.push_back(std::make_shared<FrameHeader>(i));
+    frames_.push_back(
+        std::make_shared<FrameHeader>(i, disk_manager->GetPageSize()));
     free_frames_.push_back(static_cast<int>(i));
   }
+  frame_hints_ = std::vector<std::atomic<FrameId_t>>(
+      std::bit_ceil(std::max<size_t>(num_frames_ * 2, 1)));
+  for (auto& hint : frame_hints_) {
+    hint.store(INVALID_FRAME_ID);
+  }
+  if (victim_cache_bytes > 0) {
+    victim_cache_ =
+        std::make_shared<VictimCache>(victim_cache_bytes, page_size_);
+  }
 }
 
 BufferPoolManager::~BufferPoolManager() = default;
@@ -45,44 +59,48 @@ size_t BufferPoolManager::Size() const {
   return num_frames_;
 }
 
+size_t BufferPoolManager::GetPageSize() const {
+  return page_size_;
+}
+
 PageId_t BufferPoolManager::NewPage() {
   return next_page_id_.fetch_add(1);
 }
 
+PageId_t BufferPoolManager::NewPages(size_t count, PageId_t owner) {
+  PageId_t first_page_id = next_page_id_.fetch_add(count);
+  disk_scheduler_->AllocateExtent(first_page_id, count, owner);
+  return first_page_id;
+}
+
+PageId_t BufferPoolManager::NewTempPage() {
+  PageId_t page_id = next_page_id_.fetch_add(1);
+  std::unique_lock<std::mutex> l(*mutex_);
+  temp_pages_[page_id] = false;
+  return page_id;
+}
+
 bool BufferPoolManager::DeletePage(PageId_t page_id) {
+  if (page_id < 0 || page_id >= next_page_id_.load()) {
+    return false;
+  }
   std::unique_lock<std::mutex> l(*mutex_);
+  FinishDeletes_();
+  if (IsDeleted_(page_id)) {
+    return false;
+  }
 
   auto page_it = page_table_.find(page_id);
   if (page_it != page_table_.end()) {
     // Page is in memory
     FrameId_t frame_id = page_it->second;
-    auto frame = frames_[frame_id];
-    if (frame->pin_count_.load() > 0)
-      return false;
-
-    page_table_.erase(page_id);
-    rev_page_table_.erase(frame_id);
-    replacer_->Remove(frame_id);
-
-    if (frame->is_dirty_) {
-      DiskRequest req{.is_write = true,
-                      .data = frame->data_.data(),
-                      .page_id = page_id,
-                      .cb = disk_scheduler_->CreatePromise()};
-      auto fut = req.cb.get_future();
-      std::vector<DiskRequest> v;
-      v.push_back(std::move(req));
-      disk_scheduler_->Schedule(v);
-      fut.get();
-      frame->is_dirty_ = false;
+    if (frames_[frame_id]->pin_count_.load() > 0) {
+      pending_deletes_.insert(page_id);
+      return true;
     }
-
-    frame->Reset();
-    free_frames_.push_back(frame_id);
+    DropFrame_(page_id, frame_id);
   }
-  
-  disk_scheduler_->DeallocatePage(page_id);
-  
+  ReleasePage_(page_id);
   return true;
 }
 
@@ -100,6 +118,7 @@ std::optional<WritePageGuard> BufferPoolManager::CheckedWritePage(
 
     replacer_->RecordAccess(frame_id, page_id, access_type);
     replacer_->SetEvictable(frame_id, false);
+    frame_hints_[HintSlot_(page_id)].store(frame_id);
 
     l.unlock();
     WritePageGuard guard(page_id, frame, replacer_, mutex_, disk_scheduler_);
@@ -107,47 +126,31 @@ std::optional<WritePageGuard> BufferPoolManager::CheckedWritePage(
   }
 
   // We need to load the page into memory
-  FrameId_t frame_id = -1;
-  if (free_frames_.empty()) {
-    // No free frames, try to evict
-    auto frame_id_opt = replacer_->Evict();
-    if (!frame_id_opt.has_value()) {
-      return std::nullopt;
-    }
-    frame_id = frame_id_opt.value();
-    auto frame = frames_[frame_id];
-
-    PageId_t evicted_page = rev_page_table_[frame_id];
-    page_table_.erase(evicted_page);
-    rev_page_table_.erase(frame_id);
-
-    if (frame->is_dirty_) {
-      DiskRequest req{.is_write = true,
-                      .data = frame->data_.data(),
-                      .page_id = evicted_page,
-                      .cb = disk_scheduler_->CreatePromise()};
-      auto fut = req.cb.get_future();
-      std::vector<DiskRequest> v;
-      v.push_back(std::move(req));
-      disk_scheduler_->Schedule(v);
-      fut.get();
-      frame->is_dirty_ = false;
-    }
-  } else {
-    frame_id = free_frames_.front();
-    free_frames_.pop_front();
+  if (IsDeleted_(page_id)) {
+    return std::nullopt;
   }
+  std::vector<DiskRequest> v;
+  std::vector<std::future<bool>> futures;
+  auto frame_id_opt = AllocateFrame_(v, futures);
+  if (!frame_id_opt.has_value()) {
+    return std::nullopt;
+  }
+  FrameId_t frame_id = frame_id_opt.value();
 
+  // The version stays odd while the frame is switched to the new page
   auto frame = frames_[frame_id];
-  DiskRequest req{.is_write = false,
-                  .data = frame->data_.data(),
-                  .page_id = page_id,
-                  .cb = disk_scheduler_->CreatePromise()};
-  auto fut = req.cb.get_future();
-  std::vector<DiskRequest> v;
-  v.push_back(std::move(req));
+  frame->version_.fetch_add(1);
+  frame->page_id_.store(page_id);
+  bool read = QueueRead_(page_id, *frame, v, futures);
   disk_scheduler_->Schedule(v);
-  fut.get();
+  for (auto& fut : futures) {
+    fut.get();
+  }
+  if (!read) {
+    ZeroPage(frame->data_.data(), frame->data_.size());
+  }
+  frame->version_.fetch_add(1);
+  frame_hints_[HintSlot_(page_id)].store(frame_id);
 
   frame->pin_count_.fetch_add(1);
 
@@ -174,6 +177,7 @@ std::optional<ReadPageGuard> BufferPoolManager::CheckedReadPage(
 
     replacer_->RecordAccess(frame_id, page_id, access_type);
     replacer_->SetEvictable(frame_id, false);
+    frame_hints_[HintSlot_(page_id)].store(frame_id);
 
     l.unlock();
     ReadPageGuard guard(page_id, frame, replacer_, mutex_, disk_scheduler_);
@@ -181,47 +185,31 @@ std::optional<ReadPageGuard> BufferPoolManager::CheckedReadPage(
   }
 
   // We need to load the page into memory
-  FrameId_t frame_id = -1;
-  if (free_frames_.empty()) {
-    // No free frames, try to evict
-    auto frame_id_opt = replacer_->Evict();
-    if (!frame_id_opt.has_value()) {
-      return std::nullopt;
-    }
-    frame_id = frame_id_opt.value();
-    auto frame = frames_[frame_id];
-
-    PageId_t evicted_page = rev_page_table_[frame_id];
-    page_table_.erase(evicted_page);
-    rev_page_table_.erase(frame_id);
-
-    if (frame->is_dirty_) {
-      DiskRequest req{.is_write = true,
-                      .data = frame->data_.data(),
-                      .page_id = evicted_page,
-                      .cb = disk_scheduler_->CreatePromise()};
-      auto fut = req.cb.get_future();
-      std::vector<DiskRequest> v;
-      v.push_back(std::move(req));
-      disk_scheduler_->Schedule(v);
-      fut.get();
-      frame->is_dirty_ = false;
-    }
-  } else {
-    frame_id = free_frames_.front();
-    free_frames_.pop_front();
+  if (IsDeleted_(page_id)) {
+    return std::nullopt;
+  }
+  std::vector<DiskRequest> v;
+  std::vector<std::future<bool>> futures;
+  auto frame_id_opt = AllocateFrame_(v, futures);
+  if (!frame_id_opt.has_value()) {
+    return std::nullopt;
   }
+  FrameId_t frame_id = frame_id_opt.value();
 
+  // The version stays odd while the frame is switched to the new page
   auto frame = frames_[frame_id];
-  DiskRequest req{.is_write = false,
-                  .data = frame->data_.data(),
-                  .page_id = page_id,
-                  .cb = disk_scheduler_->CreatePromise()};
-  auto fut = req.cb.get_future();
-  std::vector<DiskRequest> v;
-  v.push_back(std::move(req));
+  frame->version_.fetch_add(1);
+  frame->page_id_.store(page_id);
+  bool read = QueueRead_(page_id, *frame, v, futures);
   disk_scheduler_->Schedule(v);
-  fut.get();
+  for (auto& fut : futures) {
+    fut.get();
+  }
+  if (!read) {
+    ZeroPage(frame->data_.data(), frame->data_.size());
+  }
+  frame->version_.fetch_add(1);
+  frame_hints_[HintSlot_(page_id)].store(frame_id);
 
   frame->pin_count_.fetch_add(1);
 
@@ -245,6 +233,25 @@ WritePageGuard BufferPoolManager::WritePage(PageId_t page_id,
   return std::move(guard_opt).value();
 }
 
+std::optional<OptimisticPageGuard> BufferPoolManager::OptimisticReadPage(
+    PageId_t page_id) {
+  FrameId_t frame_id = frame_hints_[HintSlot_(page_id)].load();
+  if (frame_id == INVALID_FRAME_ID) {
+    return std::nullopt;
+  }
+
+  FrameHeader* frame = frames_[frame_id].get();
+  uint64_t version = frame->version_.load(std::memory_order_acquire);
+  if ((version & 1) || frame->page_id_.load() != page_id) {
+    return std::nullopt;
+  }
+  // Checked first so that readers of a hot page do not keep writing the line
+  if (!frame->referenced_.load(std::memory_order_relaxed)) {
+    frame->referenced_.store(true, std::memory_order_relaxed);
+  }
+  return OptimisticPageGuard(page_id, frame, version);
+}
+
 ReadPageGuard BufferPoolManager::ReadPage(PageId_t page_id,
                                           AccessType access_type) {
   auto guard_opt = CheckedReadPage(page_id, access_type);
@@ -256,29 +263,74 @@ ReadPageGuard BufferPoolManager::ReadPage(PageId_t page_id,
   return std::move(guard_opt).value();
 }
 
+void BufferPoolManager::PrefetchPages(const std::vector<PageId_t>& page_ids) {
+  std::unique_lock<std::mutex> l(*mutex_);
+
+  std::vector<DiskRequest> v;
+  std::vector<std::future<bool>> futures;
+  std::vector<std::pair<PageId_t, FrameId_t>> loaded;
+  for (PageId_t page_id : page_ids) {
+    auto temp_it = temp_pages_.find(page_id);
+    if (page_table_.count(page_id) > 0 || IsDeleted_(page_id) ||
+        (temp_it != temp_pages_.end() && !temp_it->second)) {
+      continue;
+    }
+    // Frames loaded by this call stay pinned until all reads are done, so
+    // they are not evicted for later pages of the same batch
+    auto frame_id_opt = AllocateFrame_(v, futures);
+    if (!frame_id_opt.has_value()) {
+      break;
+    }
+    FrameId_t frame_id = frame_id_opt.value();
+    auto frame = frames_[frame_id];
+    frame->version_.fetch_add(1);
+    frame->page_id_.store(page_id);
+    QueueRead_(page_id, *frame, v, futures);
+
+    page_table_[page_id] = frame_id;
+    rev_page_table_[frame_id] = page_id;
+    replacer_->RecordAccess(frame_id, page_id, AccessType::Scan);
+    replacer_->SetEvictable(frame_id, false);
+    loaded.emplace_back(page_id, frame_id);
+  }
+
+  if (loaded.empty()) {
+    return;
+  }
+  disk_scheduler_->Schedule(v);
+  for (auto& fut : futures) {
+    fut.get();
+  }
+  for (auto [page_id, frame_id] : loaded) {
+    frames_[frame_id]->version_.fetch_add(1);
+    frame_hints_[HintSlot_(page_id)].store(frame_id);
+    replacer_->SetEvictable(frame_id, true);
+  }
+}
+
 bool BufferPoolManager::FlushPageUnsafe(PageId_t page_id) {
   std::unique_lock<std::mutex> l(*mutex_);
   auto page_it = page_table_.find(page_id);
   if (page_it == page_table_.end())
     return false;
+  if (IsTemp_(page_id)) {
+    return true;
+  }
 
   FrameId_t frame_id = page_it->second;
   auto frame = frames_[frame_id];
 
   if (frame->is_dirty_) {
     frame->pin_count_.fetch_add(1);
+    replacer_->SetEvictable(frame_id, false);
     l.unlock();
-    DiskRequest req{.is_write = true,
-                    .data = frame->data_.data(),
-                    .page_id = page_id,
-                    .cb = disk_scheduler_->CreatePromise()};
-    auto fut = req.cb.get_future();
-    std::vector<DiskRequest> v;
-    v.push_back(std::move(req));
-    disk_scheduler_->Schedule(v);
-    fut.get();
+    // No latch is taken, a concurrent writer can still race with the copy but
+    // no longer with the whole device write.
+    auto fut = disk_scheduler_->ScheduleWriteCopy(page_id, frame->GetData());
     frame->is_dirty_ = false;
-    frame->pin_count_.fetch_sub(1);
+    fut.get();
+    DirtyFrames frames{{page_id, frame}};
+    UnpinFrames_(frames);
   }
 
   return true;
@@ -289,92 +341,106 @@ bool BufferPoolManager::FlushPage(PageId_t page_id) {
   auto page_it = page_table_.find(page_id);
   if (page_it == page_table_.end())
     return false;
+  if (IsTemp_(page_id)) {
+    return true;
+  }
 
   FrameId_t frame_id = page_it->second;
   auto frame = frames_[frame_id];
 
   if (frame->is_dirty_) {
     frame->pin_count_.fetch_add(1);
+    replacer_->SetEvictable(frame_id, false);
     l.unlock();
-    std::shared_lock<std::shared_mutex>(frame->rw_mutex_);
-    DiskRequest req{.is_write = true,
-                    .data = frame->data_.data(),
-                    .page_id = page_id,
-                    .cb = disk_scheduler_->CreatePromise()};
-    auto fut = req.cb.get_future();
-    std::vector<DiskRequest> v;
-    v.push_back(std::move(req));
-    disk_scheduler_->Schedule(v);
+    std::future<bool> fut;
+    {
+      std::shared_lock<std::shared_mutex> frame_latch(frame->rw_mutex_);
+      fut = disk_scheduler_->ScheduleWriteCopy(page_id, frame->GetData());
+      frame->is_dirty_ = false;
+    }
     fut.get();
-    frame->is_dirty_ = false;
-    frame->pin_count_.fetch_sub(1);
+    DirtyFrames frames{{page_id, frame}};
+    UnpinFrames_(frames);
   }
 
   return true;
 }
 
 void BufferPoolManager::FlushAllPagesUnsafe() {
+  auto frames = PinDirtyFrames_();
+  FlushFrames_(frames, false);
+  UnpinFrames_(frames);
+}
+
+void BufferPoolManager::FlushAllPages() {
+  auto frames = PinDirtyFrames_();
+  FlushFrames_(frames, true);
+  UnpinFrames_(frames);
+}
+
+std::future<void> BufferPoolManager::FlushAllPagesAsync() {
+  auto frames = PinDirtyFrames_();
+  return std::async(std::launch::async, [this, frames]() mutable {
+    FlushFrames_(frames, true);
+    UnpinFrames_(frames);
+  });
+}
+
+BufferPoolManager::DirtyFrames BufferPoolManager::PinDirtyFrames_() {
   std::unique_lock<std::mutex> l(*mutex_);
-  std::vector<std::pair<PageId_t, std::shared_ptr<FrameHeader>>> headers;
+  DirtyFrames frames;
   for (const auto& kv : page_table_) {
     PageId_t page_id = kv.first;
     FrameId_t frame_id = kv.second;
     auto frame = frames_[frame_id];
 
-    if (frame->is_dirty_) {
+    if (frame->is_dirty_ && !IsTemp_(page_id) &&
+        pending_deletes_.count(page_id) == 0) {
       frame->pin_count_.fetch_add(1);
-      headers.push_back({page_id, frame});
+      replacer_->SetEvictable(frame_id, false);
+      frames.push_back({page_id, frame});
     }
   }
   l.unlock();
 
-  for (auto& page_frame_pair : headers) {
-    PageId_t page_id = page_frame_pair.first;
-    auto frame = page_frame_pair.second;
-    DiskRequest req{.is_write = true,
-                    .data = frame->data_.data(),
-                    .page_id = page_id,
-                    .cb = disk_scheduler_->CreatePromise()};
-    auto fut = req.cb.get_future();
-    std::vector<DiskRequest> v;
-    v.push_back(std::move(req));
-    disk_scheduler_->Schedule(v);
-    fut.get();
-    frame->is_dirty_ = false;
-    frame->pin_count_.fetch_sub(1);
-  }
+  std::sort(frames.begin(), frames.end(),
+            [](const auto& a, const auto& b) { return a.first < b.first; });
+  return frames;
 }
 
-void BufferPoolManager::FlushAllPages() {
-  std::unique_lock<std::mutex> l(*mutex_);
-  std::vector<std::pair<PageId_t, std::shared_ptr<FrameHeader>>> headers;
-  for (const auto& kv : page_table_) {
-    PageId_t page_id = kv.first;
-    FrameId_t frame_id = kv.second;
-    auto frame = frames_[frame_id];
-
-    if (frame->is_dirty_) {
-      frame->pin_count_.fetch_add(1);
-      headers.push_back({page_id, frame});
+void BufferPoolManager::FlushFrames_(DirtyFrames& frames, bool latch) {
+  // Each frame is latched only while its image is copied into a staging
+  // buffer, all writes are queued before waiting on any of them so the disk
+  // thread can coalesce them.
+  std::vector<std::future<bool>> futures;
+  futures.reserve(frames.size());
+
+  for (auto& [page_id, frame] : frames) {
+    std::shared_lock<std::shared_mutex> frame_latch(frame->rw_mutex_,
+                                                    std::defer_lock);
+    if (latch) {
+      frame_latch.lock();
     }
+    futures.push_back(
+        disk_scheduler_->ScheduleWriteCopy(page_id, frame->GetData()));
+    frame->is_dirty_ = false;
   }
-  l.unlock();
 
-  for (auto& page_frame_pair : headers) {
-    PageId_t page_id = page_frame_pair.first;
-    auto frame = page_frame_pair.second;
-    std::shared_lock<std::shared_mutex>(frame->rw_mutex_);
-    DiskRequest req{.is_write = true,
-                    .data = frame->data_.data(),
-                    .page_id = page_id,
-                    .cb = disk_scheduler_->CreatePromise()};
-    auto fut = req.cb.get_future();
-    std::vector<DiskRequest> v;
-    v.push_back(std::move(req));
-    disk_scheduler_->Schedule(v);
+  for (auto& fut : futures) {
     fut.get();
-    frame->is_dirty_ = false;
-    frame->pin_count_.fetch_sub(1);
+  }
+
+  if (!frames.empty()) {
+    disk_scheduler_->Sync();
+  }
+}
+
+void BufferPoolManager::UnpinFrames_(DirtyFrames& frames) {
+  std::unique_lock<std::mutex> l(*mutex_);
+  for (auto& [page_id, frame] : frames) {
+    if (frame->pin_count_.fetch_sub(1) == 1) {
+      replacer_->SetEvictable(frame->frame_id_, true);
+    }
   }
 }
 
@@ -387,3 +453,174 @@ std::optional<size_t> BufferPoolManager::GetPinCount(PageId_t page_id) {
   FrameId_t frame_id = it->second;
   return std::optional<size_t>(frames_[frame_id]->pin_count_.load());
 }
+
+// Takes a free frame or evicts one, the write back of a dirty victim is
+// queued in requests. A disk thread handles its requests in order, so the
+// frame can be reused right away by a read queued after the write. With
+// several queues the read may run first, and with a victim cache the frame
+// may be filled from the cache at once, the write back is staged then. A
+// victim that is not temporary goes to the victim cache.
+std::optional<FrameId_t> BufferPoolManager::AllocateFrame_(
+    std::vector<DiskRequest>& requests,
+    std::vector<std::future<bool>>& futures) {
+  if (!free_frames_.empty()) {
+    FrameId_t frame_id = free_frames_.front();
+    free_frames_.pop_front();
+    frames_[frame_id]->referenced_.store(false);
+    return frame_id;
+  }
+
+  auto frame_id_opt = replacer_->Evict([this](FrameId_t frame_id) {
+    return frames_[frame_id]->referenced_.exchange(false);
+  });
+  if (!frame_id_opt.has_value()) {
+    return std::nullopt;
+  }
+  FrameId_t frame_id = frame_id_opt.value();
+  auto frame = frames_[frame_id];
+  frame->referenced_.store(false);
+
+  PageId_t evicted_page = rev_page_table_[frame_id];
+  page_table_.erase(evicted_page);
+  rev_page_table_.erase(frame_id);
+
+  // A page deleted while it was pinned is dropped instead of written back
+  if (pending_deletes_.erase(evicted_page) > 0) {
+    frame->is_dirty_ = false;
+    ReleasePage_(evicted_page);
+    return frame_id;
+  }
+
+  auto temp_it = temp_pages_.find(evicted_page);
+  bool is_temp = temp_it != temp_pages_.end();
+  if (frame->is_dirty_) {
+    if (is_temp) {
+      temp_it->second = true;
+    }
+    if (disk_scheduler_->GetQueueCount() > 1 || victim_cache_ != nullptr) {
+      futures.push_back(disk_scheduler_->ScheduleWriteCopy(
+          evicted_page, frame->data_.data(), is_temp));
+    } else {
+      DiskRequest req{.is_write = true,
+                      .data = frame->data_.data(),
+                      .page_id = evicted_page,
+                      .cb = disk_scheduler_->CreatePromise(),
+                      .is_temp = is_temp};
+      futures.push_back(req.cb.get_future());
+      requests.push_back(std::move(req));
+    }
+    frame->is_dirty_ = false;
+  }
+  if (victim_cache_ != nullptr && !is_temp) {
+    victim_cache_->Put(evicted_page, frame->data_.data());
+  }
+  return frame_id;
+}
+
+// A temporary page that was never spilled has no copy to read, the caller
+// zeroes the frame once the queued write back of its old page is done. A
+// page in the victim cache is filled in right away, the frame's old page is
+// never written from the frame then.
+bool BufferPoolManager::QueueRead_(PageId_t page_id, FrameHeader& frame,
+                                   std::vector<DiskRequest>& requests,
+                                   std::vector<std::future<bool>>& futures) {
+  auto temp_it = temp_pages_.find(page_id);
+  if (temp_it != temp_pages_.end() && !temp_it->second) {
+    return false;
+  }
+  if (temp_it == temp_pages_.end() && victim_cache_ != nullptr &&
+      victim_cache_->Get(page_id, frame.data_.data())) {
+    return true;
+  }
+  DiskRequest req{.is_write = false,
+                  .data = frame.data_.data(),
+                  .page_id = page_id,
+                  .cb = disk_scheduler_->CreatePromise(),
+                  .is_temp = temp_it != temp_pages_.end()};
+  futures.push_back(req.cb.get_future());
+  requests.push_back(std::move(req));
+  return true;
+}
+
+const VictimCache* BufferPoolManager::GetVictimCache() const {
+  return victim_cache_.get();
+}
+
+size_t BufferPoolManager::HintSlot_(PageId_t page_id) const {
+  return static_cast<size_t>(page_id) & (frame_hints_.size() - 1);
+}
+
+// Ids are never reused, a stale id kept by an optimistic reader must not load
+// a deleted page back with a fresh disk slot
+bool BufferPoolManager::IsDeleted_(PageId_t page_id) const {
+  auto it = deleted_ranges_.upper_bound(page_id);
+  return it != deleted_ranges_.begin() && page_id < std::prev(it)->second;
+}
+
+// Adds the page to the range before or after it if they touch
+void BufferPoolManager::AddDeleted_(PageId_t page_id) {
+  auto next = deleted_ranges_.upper_bound(page_id);
+  PageId_t end = page_id + 1;
+  if (next != deleted_ranges_.end() && next->first == end) {
+    end = next->second;
+    next = deleted_ranges_.erase(next);
+  }
+  if (next != deleted_ranges_.begin() &&
+      std::prev(next)->second == page_id) {
+    std::prev(next)->second = end;
+  } else {
+    deleted_ranges_.emplace_hint(next, page_id, end);
+  }
+}
+
+// Drops the pages whose delete waited for their last pin to go away
+void BufferPoolManager::FinishDeletes_() {
+  for (auto it = pending_deletes_.begin(); it != pending_deletes_.end();) {
+    PageId_t page_id = *it;
+    auto page_it = page_table_.find(page_id);
+    if (page_it != page_table_.end() &&
+        frames_[page_it->second]->pin_count_.load() > 0) {
+      ++it;
+      continue;
+    }
+    if (page_it != page_table_.end()) {
+      DropFrame_(page_id, page_it->second);
+    }
+    ReleasePage_(page_id);
+    it = pending_deletes_.erase(it);
+  }
+}
+
+// Frees the unpinned frame of a page, its contents are dropped dirty or not
+void BufferPoolManager::DropFrame_(PageId_t page_id, FrameId_t frame_id) {
+  auto frame = frames_[frame_id];
+  page_table_.erase(page_id);
+  rev_page_table_.erase(frame_id);
+  replacer_->Remove(frame_id);
+  frame->version_.fetch_add(1);
+  frame->page_id_.store(INVALID_PAGE_ID);
+  frame->Reset();
+  frame->version_.fetch_add(1);
+  free_frames_.push_back(frame_id);
+}
+
+// Marks a page that is no longer in memory deleted and frees its disk copy
+void BufferPoolManager::ReleasePage_(PageId_t page_id) {
+  AddDeleted_(page_id);
+  auto temp_it = temp_pages_.find(page_id);
+  if (temp_it == temp_pages_.end()) {
+    if (victim_cache_ != nullptr) {
+      victim_cache_->Erase(page_id);
+    }
+    disk_scheduler_->DeallocatePage(page_id);
+  } else {
+    if (temp_it->second) {
+      disk_scheduler_->DeallocateTempPage(page_id);
+    }
+    temp_pages_.erase(temp_it);
+  }
+}
+
+bool BufferPoolManager::IsTemp_(PageId_t page_id) const {
+  return temp_pages_.count(page_id) > 0;
+}
@@ -0,0 +1,191 @@
+#include <buffer/page_codec.hpp>
+
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+
+namespace {
+
+enum Format : char { PATTERN = 0, LZ = 1, RAW = 2 };
+
+const size_t PATTERN_SIZE = 8;
+const size_t MIN_MATCH = 4;
+const size_t HASH_BITS = 12;
+
+uint32_t Load32(const char* p) {
+  uint32_t value;
+  memcpy(&value, p, 4);
+  return value;
+}
+
+uint32_t Hash(uint32_t value) {
+  return (value * 2654435761u) >> (32 - HASH_BITS);
+}
+
+// Lengths of 15 or more continue in bytes of 255 and a final smaller one
+char* PutLength(char* op, size_t length) {
+  for (length -= 15; length >= 255; length -= 255) {
+    *op++ = static_cast<char>(255);
+  }
+  *op++ = static_cast<char>(length);
+  return op;
+}
+
+size_t GetLength(const char*& ip, const char* end, size_t nibble) {
+  size_t length = nibble;
+  if (nibble == 15) {
+    uint8_t byte;
+    do {
+      if (ip >= end) {
+        throw std::runtime_error("Corrupt compressed page");
+      }
+      byte = static_cast<uint8_t>(*ip++);
+      length += byte;
+    } while (byte == 255);
+  }
+  return length;
+}
+
+// A sequence takes its literals and at most 5 bytes plus one per 255 bytes
+// of length for token, offset and lengths, false if it does not fit before
+// limit
+bool PutSequence(char*& op, const char* limit, const char* literals,
+                 size_t literal_length, size_t offset, size_t match_length) {
+  size_t worst = literal_length + 5 + (literal_length + match_length) / 255;
+  if (op + worst > limit) {
+    return false;
+  }
+  char* token = op++;
+  size_t match_nibble = match_length == 0 ? 0 : match_length - MIN_MATCH;
+  *token = static_cast<char>(
+      ((literal_length < 15 ? literal_length : 15) << 4) |
+      (match_nibble < 15 ? match_nibble : 15));
+  if (literal_length >= 15) {
+    op = PutLength(op, literal_length);
+  }
+  memcpy(op, literals, literal_length);
+  op += literal_length;
+  if (match_length == 0) {
+    return true;
+  }
+  *op++ = static_cast<char>(offset & 0xff);
+  *op++ = static_cast<char>(offset >> 8);
+  if (match_nibble >= 15) {
+    op = PutLength(op, match_nibble);
+  }
+  return true;
+}
+
+// Size of the LZ stream after the format byte, 0 if it is not smaller than
+// the page
+size_t CompressLz(const char* page, size_t page_size, char* out) {
+  uint32_t table[1 << HASH_BITS] = {};
+  const char* ip = page;
+  const char* anchor = page;
+  const char* end = page + page_size;
+  char* op = out;
+  const char* limit = out + page_size - 1;
+
+  while (ip + MIN_MATCH <= end) {
+    uint32_t value = Load32(ip);
+    uint32_t& slot = table[Hash(value)];
+    const char* ref = slot != 0 ? page + slot - 1 : nullptr;
+    slot = static_cast<uint32_t>(ip - page) + 1;
+    if (ref == nullptr || ip - ref > 0xffff || Load32(ref) != value) {
+      ip++;
+      continue;
+    }
+    size_t length = MIN_MATCH;
+    while (ip + length < end && ip[length] == ref[length]) {
+      length++;
+    }
+    if (!PutSequence(op, limit, anchor, ip - anchor, ip - ref, length)) {
+      return 0;
+    }
+    ip += length;
+    anchor = ip;
+  }
+  if (!PutSequence(op, limit, anchor, end - anchor, 0, 0)) {
+    return 0;
+  }
+  return op - out;
+}
+
+}  // namespace
+
+size_t CompressPage(const char* page, size_t page_size,
+                    std::vector<char>& out) {
+  if (memcmp(page, page + PATTERN_SIZE, page_size - PATTERN_SIZE) == 0) {
+    out.resize(1 + PATTERN_SIZE);
+    out[0] = PATTERN;
+    memcpy(out.data() + 1, page, PATTERN_SIZE);
+    return out.size();
+  }
+
+  out.resize(1 + page_size);
+  size_t size = CompressLz(page, page_size, out.data() + 1);
+  if (size == 0) {
+    out[0] = RAW;
+    memcpy(out.data() + 1, page, page_size);
+    return out.size();
+  }
+  out[0] = LZ;
+  out.resize(1 + size);
+  return out.size();
+}
+
+void DecompressPage(const char* data, size_t size, char* page,
+                    size_t page_size) {
+  const char* ip = data + 1;
+  const char* end = data + size;
+  switch (data[0]) {
+    case PATTERN:
+      for (size_t i = 0; i < page_size; i += PATTERN_SIZE) {
+        memcpy(page + i, ip, PATTERN_SIZE);
+      }
+      return;
+    case RAW:
+      memcpy(page, ip, page_size);
+      return;
+    default:
+      break;
+  }
+
+  char* op = page;
+  char* page_end = page + page_size;
+  while (ip < end) {
+    uint8_t token = static_cast<uint8_t>(*ip++);
+    size_t literal_length = GetLength(ip, end, token >> 4);
+    if (literal_length > static_cast<size_t>(end - ip) ||
+        literal_length > static_cast<size_t>(page_end - op)) {
+      throw std::runtime_error("Corrupt compressed page");
+    }
+    memcpy(op, ip, literal_length);
+    op += literal_length;
+    ip += literal_length;
+    if (ip == end) {
+      break;
+    }
+
+    if (end - ip < 2) {
+      throw std::runtime_error("Corrupt compressed page");
+    }
+    size_t offset = static_cast<uint8_t>(ip[0]) |
+                    static_cast<size_t>(static_cast<uint8_t>(ip[1])) << 8;
+    ip += 2;
+    size_t match_length = GetLength(ip, end, token & 15) + MIN_MATCH;
+    if (offset == 0 || offset > static_cast<size_t>(op - page) ||
+        match_length > static_cast<size_t>(page_end - op)) {
+      throw std::runtime_error("Corrupt compressed page");
+    }
+    // Matches may overlap the bytes they produce
+    const char* ref = op - offset;
+    for (size_t i = 0; i < match_length; i++) {
+      op[i] = ref[i];
+    }
+    op += match_length;
+  }
+  if (op != page_end) {
+    throw std::runtime_error("Corrupt compressed page");
+  }
+}
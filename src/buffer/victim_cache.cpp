@@ -0,0 +1,93 @@
+#include <buffer/victim_cache.hpp>
+
+#include <buffer/page_codec.hpp>
+
+VictimCache::VictimCache(size_t budget_bytes, size_t page_size)
+    : budget_(budget_bytes), page_size_(page_size) {}
+
+void VictimCache::Put(PageId_t page_id, const char* page) {
+  std::scoped_lock lock(mutex_);
+  auto it = entries_.find(page_id);
+  if (it != entries_.end()) {
+    Erase_(it);
+  }
+
+  size_t size = CompressPage(page, page_size_, buffer_);
+  bytes_in_ += page_size_;
+  bytes_stored_ += size;
+  if (size > budget_) {
+    return;
+  }
+  while (size_ + size > budget_) {
+    Erase_(entries_.find(lru_.back()));
+  }
+  lru_.push_front(page_id);
+  entries_.emplace(page_id, Entry{std::vector<char>(buffer_.begin(),
+                                                    buffer_.end()),
+                                  lru_.begin()});
+  size_ += size;
+}
+
+bool VictimCache::Get(PageId_t page_id, char* page) {
+  std::scoped_lock lock(mutex_);
+  auto it = entries_.find(page_id);
+  if (it == entries_.end()) {
+    misses_++;
+    return false;
+  }
+  hits_++;
+  DecompressPage(it->second.data.data(), it->second.data.size(), page,
+                 page_size_);
+  Erase_(it);
+  return true;
+}
+
+void VictimCache::Erase(PageId_t page_id) {
+  std::scoped_lock lock(mutex_);
+  auto it = entries_.find(page_id);
+  if (it != entries_.end()) {
+    Erase_(it);
+  }
+}
+
+size_t VictimCache::GetBudget() const {
+  return budget_;
+}
+
+size_t VictimCache::GetSize() const {
+  std::scoped_lock lock(mutex_);
+  return size_;
+}
+
+size_t VictimCache::GetPageCount() const {
+  std::scoped_lock lock(mutex_);
+  return entries_.size();
+}
+
+size_t VictimCache::GetHits() const {
+  std::scoped_lock lock(mutex_);
+  return hits_;
+}
+
+size_t VictimCache::GetMisses() const {
+  std::scoped_lock lock(mutex_);
+  return misses_;
+}
+
+double VictimCache::GetHitRatio() const {
+  std::scoped_lock lock(mutex_);
+  size_t lookups = hits_ + misses_;
+  return lookups == 0 ? 0 : static_cast<double>(hits_) / lookups;
+}
+
+double VictimCache::GetCompressionRatio() const {
+  std::scoped_lock lock(mutex_);
+  return bytes_stored_ == 0 ? 0
+                            : static_cast<double>(bytes_in_) / bytes_stored_;
+}
+
+void VictimCache::Erase_(std::unordered_map<PageId_t, Entry>::iterator it) {
+  size_ -= it->second.data.size();
+  lru_.erase(it->second.lru);
+  entries_.erase(it);
+}
@@ -0,0 +1,387 @@
+#include <execution/aggregate.hpp>
+#include <execution/kernels.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace {
+
+// Partial values per group
+const size_t LANES = 4;
+
+template <typename S>
+S InitialValue(AggregateType type) {
+  if (type == AggregateType::Min) {
+    return std::numeric_limits<S>::max();
+  }
+  if (type == AggregateType::Max) {
+    return std::numeric_limits<S>::lowest();
+  }
+  return 0;
+}
+
+template <typename S>
+S Fold(AggregateType type, S a, S b) {
+  if (type == AggregateType::Min) {
+    return std::min(a, b);
+  }
+  if (type == AggregateType::Max) {
+    return std::max(a, b);
+  }
+  return a + b;
+}
+
+uint64_t HashKey(uint64_t key) {
+  key *= 0x9e3779b97f4a7c15;
+  return key ^ key >> 32;
+}
+
+// ORs the width byte values of the selected rows into keys at shift bits
+template <size_t WIDTH>
+void GatherKey(const char* data, const uint32_t* selection, size_t count,
+               size_t shift, uint64_t* keys) {
+  using Word = std::conditional_t<
+      WIDTH == 1, uint8_t,
+      std::conditional_t<WIDTH == 2, uint16_t,
+                         std::conditional_t<WIDTH == 4, uint32_t, uint64_t>>>;
+  for (size_t i = 0; i < count; i++) {
+    size_t row = selection != nullptr ? selection[i] : i;
+    Word value;
+    memcpy(&value, data + row * WIDTH, WIDTH);
+    keys[i] |= static_cast<uint64_t>(value) << shift;
+  }
+}
+
+void GatherKey(const char* data, size_t width, const uint32_t* selection,
+               size_t count, size_t shift, uint64_t* keys) {
+  switch (width) {
+    case 1:
+      return GatherKey<1>(data, selection, count, shift, keys);
+    case 2:
+      return GatherKey<2>(data, selection, count, shift, keys);
+    case 4:
+      return GatherKey<4>(data, selection, count, shift, keys);
+    case 8:
+      return GatherKey<8>(data, selection, count, shift, keys);
+  }
+  for (size_t i = 0; i < count; i++) {
+    size_t row = selection != nullptr ? selection[i] : i;
+    uint64_t value = 0;
+    memcpy(&value, data + row * width, width);
+    keys[i] |= value << shift;
+  }
+}
+
+// One switch per batch, the loops are specialized on the aggregate. groups
+// holds the state slot of each row.
+template <typename T, typename S>
+void UpdateGrouped(AggregateType type, const T* values,
+                   const uint32_t* selection, size_t count,
+                   const uint32_t* groups, S* state) {
+  auto update = [&](auto op) {
+    if (selection == nullptr) {
+      for (size_t i = 0; i < count; i++) {
+        S& value = state[groups[i]];
+        value = op(value, static_cast<S>(values[i]));
+      }
+      return;
+    }
+    for (size_t i = 0; i < count; i++) {
+      S& value = state[groups[i]];
+      value = op(value, static_cast<S>(values[selection[i]]));
+    }
+  };
+  switch (type) {
+    case AggregateType::Sum:
+    case AggregateType::Avg:
+      update([](S a, S b) { return a + b; });
+      break;
+    case AggregateType::Min:
+      update([](S a, S b) { return std::min(a, b); });
+      break;
+    case AggregateType::Max:
+      update([](S a, S b) { return std::max(a, b); });
+      break;
+    case AggregateType::Count:
+      break;
+  }
+}
+
+template <typename T, typename S>
+void UpdateSingle(AggregateType type, const T* values,
+                  const uint32_t* selection, size_t count, S* state) {
+  if (type == AggregateType::Sum || type == AggregateType::Avg) {
+    *state += selection != nullptr ? Sum(values, selection, count)
+                                   : Sum(values, count);
+    return;
+  }
+  static const std::vector<uint32_t> lanes = [] {
+    std::vector<uint32_t> lanes(VECTOR_SIZE);
+    for (size_t i = 0; i < VECTOR_SIZE; i++) {
+      lanes[i] = i % LANES;
+    }
+    return lanes;
+  }();
+  UpdateGrouped(type, values, selection, count, lanes.data(), state);
+}
+
+template <typename T, typename S>
+void Update(AggregateType type, const T* values, const uint32_t* selection,
+            size_t count, const uint32_t* groups, S* state) {
+  if (groups == nullptr) {
+    UpdateSingle(type, values, selection, count, state);
+  } else {
+    UpdateGrouped(type, values, selection, count, groups, state);
+  }
+}
+
+}  // namespace
+
+Aggregate::Aggregate(std::unique_ptr<VectorOperator> child,
+                     std::vector<size_t> group_by,
+                     std::vector<AggregateExpr> aggregates)
+    : child_(std::move(child)),
+      group_by_(std::move(group_by)),
+      aggregates_(std::move(aggregates)),
+      input_(child_->GetColumns()),
+      slot_keys_(16),
+      slot_groups_(16, UINT32_MAX),
+      row_keys_(VECTOR_SIZE),
+      groups_(VECTOR_SIZE) {
+  const auto& input = child_->GetColumns();
+  size_t key_size = 0;
+  for (size_t column : group_by_) {
+    columns_.push_back(input.at(column));
+    key_size += input[column].size;
+  }
+  if (key_size > sizeof(uint64_t)) {
+    throw std::runtime_error("Group by columns wider than 8 bytes");
+  }
+
+  for (const auto& aggregate : aggregates_) {
+    if (aggregate.type == AggregateType::Count) {
+      columns_.emplace_back(aggregate.name, TypeId::Int64);
+      states_.push_back(State{false, {}, {}});
+      continue;
+    }
+    const Column& column = input.at(aggregate.column);
+    if (column.type == TypeId::Char) {
+      throw std::runtime_error("Char columns can only be counted");
+    }
+    bool is_float = column.type == TypeId::Float64;
+    if (aggregate.type == AggregateType::Avg) {
+      columns_.emplace_back(aggregate.name, TypeId::Float64);
+    } else if (aggregate.type == AggregateType::Sum) {
+      columns_.emplace_back(aggregate.name,
+                            is_float ? TypeId::Float64 : TypeId::Int64);
+    } else {
+      columns_.emplace_back(aggregate.name, column.type);
+    }
+    states_.push_back(State{is_float, {}, {}});
+  }
+
+  if (group_by_.empty()) {
+    AddGroup_(0);
+  }
+}
+
+const std::vector<Column>& Aggregate::GetColumns() const {
+  return columns_;
+}
+
+bool Aggregate::Next(Batch& batch) {
+  ConsumeInput();
+
+  size_t rows = std::min(VECTOR_SIZE, keys_.size() - emitted_);
+  if (rows == 0) {
+    return false;
+  }
+  for (size_t row = 0; row < rows; row++) {
+    Emit_(batch, emitted_ + row, row);
+  }
+  emitted_ += rows;
+  batch.SetSize(rows);
+  return true;
+}
+
+void Aggregate::Merge(Aggregate& other) {
+  ConsumeInput();
+  other.ConsumeInput();
+  for (size_t group = 0; group < other.keys_.size(); group++) {
+    uint32_t into = FindGroup_(other.keys_[group]);
+    counts_[into] += other.counts_[group];
+    for (size_t i = 0; i < aggregates_.size(); i++) {
+      AggregateType type = aggregates_[i].type;
+      State& state = states_[i];
+      const State& other_state = other.states_[i];
+      if (state.is_float) {
+        double& value = state.floats[into * LANES];
+        value = Fold(type, value, Combine_(type, other_state.floats, group));
+      } else {
+        int64_t& value = state.ints[into * LANES];
+        value = Fold(type, value, Combine_(type, other_state.ints, group));
+      }
+    }
+  }
+}
+
+void Aggregate::ConsumeInput() {
+  if (consumed_) {
+    return;
+  }
+  while (child_->Next(input_)) {
+    Consume_(input_);
+  }
+  consumed_ = true;
+}
+
+uint32_t Aggregate::FindGroup_(uint64_t key) {
+  size_t mask = slot_keys_.size() - 1;
+  for (size_t slot = HashKey(key) & mask;; slot = (slot + 1) & mask) {
+    if (slot_groups_[slot] == UINT32_MAX) {
+      return AddGroup_(key);
+    }
+    if (slot_keys_[slot] == key) {
+      return slot_groups_[slot];
+    }
+  }
+}
+
+uint32_t Aggregate::AddGroup_(uint64_t key) {
+  uint32_t group = keys_.size();
+  keys_.push_back(key);
+
+  // The table is kept at most half full, growing it rehashes every key
+  size_t first = group;
+  if (2 * keys_.size() > slot_keys_.size()) {
+    slot_keys_.assign(2 * slot_keys_.size(), 0);
+    slot_groups_.assign(slot_keys_.size(), UINT32_MAX);
+    first = 0;
+  }
+  size_t mask = slot_keys_.size() - 1;
+  for (size_t i = first; i < keys_.size(); i++) {
+    size_t slot = HashKey(keys_[i]) & mask;
+    while (slot_groups_[slot] != UINT32_MAX) {
+      slot = (slot + 1) & mask;
+    }
+    slot_keys_[slot] = keys_[i];
+    slot_groups_[slot] = i;
+  }
+
+  counts_.push_back(0);
+  for (size_t i = 0; i < aggregates_.size(); i++) {
+    State& state = states_[i];
+    if (state.is_float) {
+      state.floats.resize(state.floats.size() + LANES,
+                          InitialValue<double>(aggregates_[i].type));
+    } else {
+      state.ints.resize(state.ints.size() + LANES,
+                        InitialValue<int64_t>(aggregates_[i].type));
+    }
+  }
+  return group;
+}
+
+void Aggregate::Consume_(const Batch& batch) {
+  size_t count = batch.GetSelectedCount();
+  const uint32_t* selection =
+      batch.IsFiltered() ? batch.GetSelection() : nullptr;
+
+  const uint32_t* groups = nullptr;
+  if (group_by_.empty()) {
+    counts_[0] += count;
+  } else {
+    std::fill_n(row_keys_.begin(), count, 0);
+    size_t shift = 0;
+    for (size_t column : group_by_) {
+      const ColumnVector& vector = batch.GetColumn(column);
+      GatherKey(vector.GetData(), vector.GetWidth(), selection, count, shift,
+                row_keys_.data());
+      shift += vector.GetWidth() * 8;
+    }
+
+    // Consecutive rows often share their group, the last one is cached
+    uint64_t last_key = 0;
+    uint32_t last_group = UINT32_MAX;
+    for (size_t i = 0; i < count; i++) {
+      uint64_t key = row_keys_[i];
+      if (last_group == UINT32_MAX || key != last_key) {
+        last_group = FindGroup_(key);
+        last_key = key;
+      }
+      counts_[last_group]++;
+      groups_[i] = last_group * LANES + i % LANES;
+    }
+    groups = groups_.data();
+  }
+
+  for (size_t i = 0; i < aggregates_.size(); i++) {
+    const AggregateExpr& aggregate = aggregates_[i];
+    if (aggregate.type == AggregateType::Count) {
+      continue;
+    }
+    const ColumnVector& vector = batch.GetColumn(aggregate.column);
+    State& state = states_[i];
+    switch (vector.GetType()) {
+      case TypeId::Int32:
+      case TypeId::Date:
+        Update(aggregate.type, vector.Data<int32_t>(), selection, count,
+               groups, state.ints.data());
+        break;
+      case TypeId::Int64:
+        Update(aggregate.type, vector.Data<int64_t>(), selection, count,
+               groups, state.ints.data());
+        break;
+      case TypeId::Float64:
+        Update(aggregate.type, vector.Data<double>(), selection, count,
+               groups, state.floats.data());
+        break;
+      case TypeId::Char:
+        break;
+    }
+  }
+}
+
+void Aggregate::Emit_(Batch& batch, size_t group, size_t row) const {
+  size_t offset = 0;
+  for (size_t i = 0; i < group_by_.size(); i++) {
+    size_t width = columns_[i].size;
+    memcpy(batch.GetColumn(i).GetData() + row * width,
+           reinterpret_cast<const char*>(&keys_[group]) + offset, width);
+    offset += width;
+  }
+
+  for (size_t i = 0; i < aggregates_.size(); i++) {
+    ColumnVector& out = batch.GetColumn(group_by_.size() + i);
+    const State& state = states_[i];
+    AggregateType type = aggregates_[i].type;
+    if (type == AggregateType::Count) {
+      out.Data<int64_t>()[row] = counts_[group];
+    } else if (type == AggregateType::Avg) {
+      double sum = state.is_float ? Combine_(type, state.floats, group)
+                                  : Combine_(type, state.ints, group);
+      out.Data<double>()[row] =
+          counts_[group] == 0 ? 0 : sum / counts_[group];
+    } else if (out.GetType() == TypeId::Float64) {
+      out.Data<double>()[row] = Combine_(type, state.floats, group);
+    } else if (out.GetType() == TypeId::Int64) {
+      out.Data<int64_t>()[row] = Combine_(type, state.ints, group);
+    } else {
+      out.Data<int32_t>()[row] = Combine_(type, state.ints, group);
+    }
+  }
+}
+
+template <typename S>
+S Aggregate::Combine_(AggregateType type, const std::vector<S>& values,
+                      size_t group) const {
+  S result = values[group * LANES];
+  for (size_t lane = 1; lane < LANES; lane++) {
+    result = Fold(type, result, values[group * LANES + lane]);
+  }
+  return result;
+}
@@ -0,0 +1,238 @@
+#include <execution/external_sort.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+ExternalSort::ExternalSort(std::unique_ptr<VectorOperator> child,
+                           BufferPoolManager* bpm, size_t key_column,
+                           bool descending, size_t frame_budget)
+    : child_(std::move(child)),
+      bpm_(bpm),
+      layout_(child_->GetColumns(), key_column),
+      descending_(descending),
+      frame_budget_(std::max<size_t>(frame_budget, 1)),
+      fan_in_(std::max<size_t>(frame_budget_ / (1 + SPILL_READ_AHEAD_PAGES),
+                               2)),
+      input_(child_->GetColumns()) {
+  if (SpillWriter::EntriesPerPage(layout_.GetSize()) == 0) {
+    throw std::runtime_error("Sorted rows do not fit in a page");
+  }
+  buffer_.resize(frame_budget_ * DB_PAGE_SIZE / layout_.GetSize() *
+                 layout_.GetSize());
+}
+
+ExternalSort::~ExternalSort() {
+  merging_.clear();
+  for (const auto& pages : runs_) {
+    for (PageId_t page_id : pages) {
+      bpm_->DeletePage(page_id);
+    }
+  }
+}
+
+const std::vector<Column>& ExternalSort::GetColumns() const {
+  return child_->GetColumns();
+}
+
+bool ExternalSort::Next(Batch& batch) {
+  if (!sorted_) {
+    Sort_();
+    sorted_ = true;
+  }
+
+  size_t rows = 0;
+  auto emit = [&](const char* entry) { layout_.Scatter(entry, batch, rows); };
+  if (in_memory_) {
+    for (; rows < VECTOR_SIZE && emitted_ < buffered_; rows++) {
+      emit(buffer_.data() + order_[emitted_++] * layout_.GetSize());
+    }
+  } else {
+    for (; rows < VECTOR_SIZE && Pop_(emit); rows++) {
+    }
+  }
+  batch.SetSize(rows);
+  return rows > 0;
+}
+
+size_t ExternalSort::GetRunCount() const {
+  return run_count_;
+}
+
+size_t ExternalSort::GetMergePasses() const {
+  return merge_passes_;
+}
+
+void ExternalSort::Sort_() {
+  while (child_->Next(input_)) {
+    Append_(input_);
+  }
+  SortBuffer_();
+  if (runs_.empty()) {
+    in_memory_ = true;
+    return;
+  }
+  if (buffered_ > 0) {
+    runs_.push_back(Spill_());
+  }
+  buffer_ = {};
+  order_ = {};
+  run_count_ = runs_.size();
+
+  while (runs_.size() > fan_in_) {
+    std::vector<std::vector<PageId_t>> merged;
+    for (size_t i = 0; i < runs_.size(); i += fan_in_) {
+      size_t end = std::min(i + fan_in_, runs_.size());
+      if (end - i == 1) {
+        merged.push_back(std::move(runs_[i]));
+        continue;
+      }
+      StartMerge_({std::make_move_iterator(runs_.begin() + i),
+                   std::make_move_iterator(runs_.begin() + end)});
+      SpillWriter writer(bpm_, layout_.GetSize());
+      while (Pop_([&](const char* entry) { writer.Append(entry); })) {
+      }
+      merging_.clear();
+      merged.push_back(writer.Finish());
+    }
+    runs_ = std::move(merged);
+    merge_passes_++;
+  }
+
+  StartMerge_(std::move(runs_));
+  runs_.clear();
+}
+
+void ExternalSort::Append_(const Batch& batch) {
+  const size_t entry_size = layout_.GetSize();
+  const size_t count = batch.GetSelectedCount();
+  const size_t capacity = buffer_.size() / entry_size;
+
+  // Gathered in chunks that fit the buffer
+  for (size_t done = 0; done < count;) {
+    if (buffered_ == capacity) {
+      SortBuffer_();
+      runs_.push_back(Spill_());
+      buffered_ = 0;
+    }
+    size_t chunk = std::min(count - done, capacity - buffered_);
+    char* entries = buffer_.data() + buffered_ * entry_size;
+    layout_.Gather(batch, done, chunk, entries);
+    if (descending_) {
+      for (size_t i = 0; i < chunk; i++) {
+        uint64_t key = ~layout_.GetKey(entries + i * entry_size);
+        memcpy(entries + i * entry_size, &key, sizeof(key));
+      }
+    }
+    buffered_ += chunk;
+    done += chunk;
+  }
+}
+
+// LSD radix sort of the buffered entries by key, a byte per pass. Passes
+// over bytes that all keys share are skipped, so short keys take few passes.
+void ExternalSort::SortBuffer_() {
+  struct Item {
+    uint64_t key;
+    uint32_t index;
+  };
+  std::vector<Item> items(buffered_);
+  std::vector<Item> scratch(buffered_);
+  size_t counts[sizeof(uint64_t)][256] = {};
+  for (size_t i = 0; i < buffered_; i++) {
+    items[i] = {layout_.GetKey(buffer_.data() + i * layout_.GetSize()),
+                static_cast<uint32_t>(i)};
+    for (size_t b = 0; b < sizeof(uint64_t); b++) {
+      counts[b][items[i].key >> (8 * b) & 0xff]++;
+    }
+  }
+
+  for (size_t b = 0; b < sizeof(uint64_t) && buffered_ > 0; b++) {
+    const size_t shift = 8 * b;
+    if (counts[b][items[0].key >> shift & 0xff] == buffered_) {
+      continue;
+    }
+    size_t offsets[256];
+    size_t offset = 0;
+    for (size_t d = 0; d < 256; d++) {
+      offsets[d] = offset;
+      offset += counts[b][d];
+    }
+    for (const Item& item : items) {
+      scratch[offsets[item.key >> shift & 0xff]++] = item;
+    }
+    std::swap(items, scratch);
+  }
+
+  order_.resize(buffered_);
+  for (size_t i = 0; i < buffered_; i++) {
+    order_[i] = items[i].index;
+  }
+}
+
+std::vector<PageId_t> ExternalSort::Spill_() {
+  SpillWriter writer(bpm_, layout_.GetSize());
+  for (size_t i = 0; i < buffered_; i++) {
+    writer.Append(buffer_.data() + order_[i] * layout_.GetSize());
+  }
+  return writer.Finish();
+}
+
+// Every run starts with a leaf in the tree that is less than any key, so
+// replaying each run once leaves the losers in the nodes
+void ExternalSort::StartMerge_(std::vector<std::vector<PageId_t>> runs) {
+  merging_.clear();
+  for (auto& pages : runs) {
+    merging_.push_back(std::make_unique<SpillReader>(bpm_, layout_.GetSize(),
+                                                     std::move(pages)));
+  }
+  tree_.assign(merging_.size(), merging_.size());
+  for (size_t i = 0; i < merging_.size(); i++) {
+    Replay_(i);
+  }
+}
+
+// Index merging_.size() stands for a key less than any other, exhausted runs
+// are greater than any key and ties go to the earlier run
+bool ExternalSort::Less_(size_t a, size_t b) const {
+  const size_t min = merging_.size();
+  if (a == min || b == min) {
+    return a == min && b != min;
+  }
+  const char* left = merging_[a]->Peek();
+  const char* right = merging_[b]->Peek();
+  if (left == nullptr || right == nullptr) {
+    return right == nullptr && left != nullptr;
+  }
+  uint64_t left_key = layout_.GetKey(left);
+  uint64_t right_key = layout_.GetKey(right);
+  return left_key < right_key || (left_key == right_key && a < b);
+}
+
+// Plays the run's new head against the losers on its path to the root
+void ExternalSort::Replay_(size_t run) {
+  size_t winner = run;
+  for (size_t node = (run + merging_.size()) / 2; node > 0; node /= 2) {
+    if (Less_(tree_[node], winner)) {
+      std::swap(tree_[node], winner);
+    }
+  }
+  tree_[0] = winner;
+}
+
+template <typename Emit>
+bool ExternalSort::Pop_(const Emit& emit) {
+  if (merging_.empty()) {
+    return false;
+  }
+  size_t winner = tree_[0];
+  const char* entry = merging_[winner]->Peek();
+  if (entry == nullptr) {
+    return false;
+  }
+  emit(entry);
+  merging_[winner]->Advance();
+  Replay_(winner);
+  return true;
+}
@@ -0,0 +1,304 @@
+#include <execution/hash_join.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+namespace {
+
+// Most partitions written at once
+const size_t MAX_PARTITION_BITS = 5;
+
+uint64_t HashKey(uint64_t key) {
+  key *= 0x9e3779b97f4a7c15;
+  return key ^ key >> 32;
+}
+
+void DeletePages(BufferPoolManager* bpm, const std::vector<PageId_t>& pages) {
+  for (PageId_t page_id : pages) {
+    bpm->DeletePage(page_id);
+  }
+}
+
+}  // namespace
+
+HashJoin::HashJoin(std::unique_ptr<VectorOperator> build,
+                   std::unique_ptr<VectorOperator> probe, size_t build_key,
+                   size_t probe_key, BufferPoolManager* bpm,
+                   size_t frame_budget)
+    : build_(std::move(build)),
+      probe_(std::move(probe)),
+      bpm_(bpm),
+      build_layout_(build_->GetColumns(), build_key),
+      probe_layout_(probe_->GetColumns(), probe_key),
+      columns_(probe_->GetColumns()),
+      build_input_(build_->GetColumns()),
+      probe_input_(probe_->GetColumns()),
+      probe_buffer_(VECTOR_SIZE * probe_layout_.GetSize()) {
+  if (build_->GetColumns()[build_key].type !=
+      probe_->GetColumns()[probe_key].type) {
+    throw std::runtime_error("Join key type mismatch");
+  }
+  if (SpillWriter::EntriesPerPage(build_layout_.GetSize()) == 0 ||
+      SpillWriter::EntriesPerPage(probe_layout_.GetSize()) == 0) {
+    throw std::runtime_error("Joined rows do not fit in a page");
+  }
+  for (const auto& column : build_->GetColumns()) {
+    columns_.push_back(column);
+  }
+
+  // Every partition being written pins a page, half the budget at most
+  frame_budget = std::max<size_t>(frame_budget, 1);
+  capacity_ = frame_budget * DB_PAGE_SIZE / build_layout_.GetSize();
+  partition_bits_ = 1;
+  while (partition_bits_ < MAX_PARTITION_BITS &&
+         size_t{4} << partition_bits_ <= frame_budget) {
+    partition_bits_++;
+  }
+}
+
+HashJoin::~HashJoin() {
+  probe_reader_.reset();
+  for (const auto& partition : pending_) {
+    DeletePages(bpm_, partition.build.pages);
+    DeletePages(bpm_, partition.probe.pages);
+  }
+}
+
+const std::vector<Column>& HashJoin::GetColumns() const {
+  return columns_;
+}
+
+bool HashJoin::Next(Batch& batch) {
+  if (!built_) {
+    Build_();
+    built_ = true;
+  }
+
+  size_t rows = 0;
+  while (!Probe_(batch, rows) && !exhausted_) {
+    exhausted_ = !StageProbe_();
+  }
+  batch.SetSize(rows);
+  return rows > 0;
+}
+
+size_t HashJoin::GetPartitionCount() const {
+  return partition_count_;
+}
+
+size_t HashJoin::GetMaxLevel() const {
+  return max_level_;
+}
+
+void HashJoin::Build_() {
+  const size_t entry_size = build_layout_.GetSize();
+  while (build_->Next(build_input_)) {
+    size_t count = build_input_.GetSelectedCount();
+    if (buffered_ + count > capacity_) {
+      Spill_();
+      return;
+    }
+    buffer_.resize((buffered_ + count) * entry_size);
+    build_layout_.Gather(build_input_, 0, count,
+                         buffer_.data() + buffered_ * entry_size);
+    buffered_ += count;
+  }
+  BuildTable_();
+}
+
+void HashJoin::BuildTable_() {
+  size_t slots = 1;
+  while (slots < 2 * buffered_) {
+    slots *= 2;
+  }
+  heads_.assign(slots, UINT32_MAX);
+  next_.resize(buffered_);
+  const size_t entry_size = build_layout_.GetSize();
+  for (size_t i = 0; i < buffered_; i++) {
+    uint64_t key = build_layout_.GetKey(buffer_.data() + i * entry_size);
+    uint32_t& head = heads_[HashKey(key) & (slots - 1)];
+    next_[i] = head;
+    head = static_cast<uint32_t>(i);
+  }
+}
+
+// The build input overflowed with the batch in build_input_ not yet buffered
+void HashJoin::Spill_() {
+  const size_t build_size = build_layout_.GetSize();
+  auto build = Partition_(build_layout_, 0, [&](const auto& emit) {
+    for (size_t i = 0; i < buffered_; i++) {
+      emit(buffer_.data() + i * build_size);
+    }
+    buffer_ = {};
+    std::vector<char> entries(VECTOR_SIZE * build_size);
+    do {
+      size_t count = build_input_.GetSelectedCount();
+      build_layout_.Gather(build_input_, 0, count, entries.data());
+      for (size_t i = 0; i < count; i++) {
+        emit(entries.data() + i * build_size);
+      }
+    } while (build_->Next(build_input_));
+  });
+
+  const size_t probe_size = probe_layout_.GetSize();
+  auto probe = Partition_(probe_layout_, 0, [&](const auto& emit) {
+    while (probe_->Next(probe_input_)) {
+      size_t count = probe_input_.GetSelectedCount();
+      probe_layout_.Gather(probe_input_, 0, count, probe_buffer_.data());
+      for (size_t i = 0; i < count; i++) {
+        emit(probe_buffer_.data() + i * probe_size);
+      }
+    }
+  });
+
+  for (size_t p = 0; p < build.size(); p++) {
+    pending_.push_back({std::move(build[p]), std::move(probe[p]), 1});
+  }
+  buffered_ = 0;
+  partitioned_ = true;
+}
+
+template <typename Source>
+std::vector<HashJoin::Side> HashJoin::Partition_(const EntryLayout& layout,
+                                                 size_t level,
+                                                 const Source& source) {
+  const size_t shift = 64 - partition_bits_ * (level + 1);
+  const size_t mask = (size_t{1} << partition_bits_) - 1;
+  std::vector<SpillWriter> writers;
+  for (size_t p = 0; p <= mask; p++) {
+    writers.emplace_back(bpm_, layout.GetSize());
+  }
+  source([&](const char* entry) {
+    writers[HashKey(layout.GetKey(entry)) >> shift & mask].Append(entry);
+  });
+
+  std::vector<Side> sides;
+  for (auto& writer : writers) {
+    size_t count = writer.GetEntryCount();
+    sides.push_back({writer.Finish(), count});
+  }
+  return sides;
+}
+
+void HashJoin::Repartition_(Partition partition) {
+  auto read = [this](Side& side, size_t entry_size) {
+    return [this, &side, entry_size](const auto& emit) {
+      SpillReader reader(bpm_, entry_size, std::move(side.pages));
+      for (const char* entry; (entry = reader.Peek()) != nullptr;
+           reader.Advance()) {
+        emit(entry);
+      }
+    };
+  };
+  auto build =
+      Partition_(build_layout_, partition.level,
+                 read(partition.build, build_layout_.GetSize()));
+  auto probe =
+      Partition_(probe_layout_, partition.level,
+                 read(partition.probe, probe_layout_.GetSize()));
+
+  for (size_t p = 0; p < build.size(); p++) {
+    size_t level = build[p].count == partition.build.count
+                       ? MAX_LEVELS
+                       : partition.level + 1;
+    pending_.push_back({std::move(build[p]), std::move(probe[p]), level});
+  }
+}
+
+bool HashJoin::NextPartition_() {
+  probe_reader_.reset();
+  while (!pending_.empty()) {
+    Partition partition = std::move(pending_.back());
+    pending_.pop_back();
+    if (partition.build.count == 0 || partition.probe.count == 0) {
+      DeletePages(bpm_, partition.build.pages);
+      DeletePages(bpm_, partition.probe.pages);
+      continue;
+    }
+    if (partition.build.count > capacity_ && partition.level < MAX_LEVELS) {
+      Repartition_(std::move(partition));
+      continue;
+    }
+
+    const size_t entry_size = build_layout_.GetSize();
+    buffer_.resize(partition.build.count * entry_size);
+    buffered_ = 0;
+    SpillReader reader(bpm_, entry_size, std::move(partition.build.pages));
+    for (const char* entry; (entry = reader.Peek()) != nullptr;
+         reader.Advance()) {
+      memcpy(buffer_.data() + buffered_++ * entry_size, entry, entry_size);
+    }
+    BuildTable_();
+    probe_reader_ = std::make_unique<SpillReader>(
+        bpm_, probe_layout_.GetSize(), std::move(partition.probe.pages));
+    partition_count_++;
+    max_level_ = std::max(max_level_, partition.level);
+    return true;
+  }
+  return false;
+}
+
+bool HashJoin::StageProbe_() {
+  const size_t entry_size = probe_layout_.GetSize();
+  while (true) {
+    probe_count_ = 0;
+    probe_pos_ = 0;
+    if (!partitioned_) {
+      if (buffered_ == 0 || !probe_->Next(probe_input_)) {
+        return false;
+      }
+      probe_count_ = probe_input_.GetSelectedCount();
+      probe_layout_.Gather(probe_input_, 0, probe_count_,
+                           probe_buffer_.data());
+    } else if (probe_reader_ != nullptr) {
+      for (const char* entry;
+           probe_count_ < VECTOR_SIZE &&
+           (entry = probe_reader_->Peek()) != nullptr;
+           probe_reader_->Advance()) {
+        memcpy(probe_buffer_.data() + probe_count_++ * entry_size, entry,
+               entry_size);
+      }
+    }
+
+    if (probe_count_ > 0) {
+      match_ = Head_(probe_buffer_.data());
+      return true;
+    }
+    if (!partitioned_ || !NextPartition_()) {
+      return false;
+    }
+  }
+}
+
+bool HashJoin::Probe_(Batch& batch, size_t& rows) {
+  const size_t probe_size = probe_layout_.GetSize();
+  const size_t build_size = build_layout_.GetSize();
+  const size_t first_build_column = probe_layout_.GetColumns().size();
+  while (probe_pos_ < probe_count_) {
+    const char* probe = probe_buffer_.data() + probe_pos_ * probe_size;
+    uint64_t key = probe_layout_.GetKey(probe);
+    for (; match_ != UINT32_MAX; match_ = next_[match_]) {
+      const char* build = buffer_.data() + match_ * build_size;
+      if (build_layout_.GetKey(build) != key) {
+        continue;
+      }
+      if (rows == VECTOR_SIZE) {
+        return true;
+      }
+      probe_layout_.Scatter(probe, batch, rows);
+      build_layout_.Scatter(build, batch, rows, first_build_column);
+      rows++;
+    }
+    if (++probe_pos_ < probe_count_) {
+      match_ = Head_(probe + probe_size);
+    }
+  }
+  return rows == VECTOR_SIZE;
+}
+
+uint32_t HashJoin::Head_(const char* probe_entry) const {
+  uint64_t key = probe_layout_.GetKey(probe_entry);
+  return heads_[HashKey(key) & (heads_.size() - 1)];
+}
@@ -0,0 +1,363 @@
+#include <execution/kernels.hpp>
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+namespace {
+
+template <CompareOp OP, typename T>
+inline bool Compare(T a, T b) {
+  if constexpr (OP == CompareOp::Eq) {
+    return a == b;
+  } else if constexpr (OP == CompareOp::Ne) {
+    return a != b;
+  } else if constexpr (OP == CompareOp::Lt) {
+    return a < b;
+  } else if constexpr (OP == CompareOp::Le) {
+    return a <= b;
+  } else if constexpr (OP == CompareOp::Gt) {
+    return a > b;
+  } else {
+    return a >= b;
+  }
+}
+
+template <ArithOp OP, typename T>
+inline T Apply(T a, T b) {
+  if constexpr (OP == ArithOp::Add) {
+    return a + b;
+  } else if constexpr (OP == ArithOp::Sub) {
+    return a - b;
+  } else if constexpr (OP == ArithOp::Mul) {
+    return a * b;
+  } else {
+    return a / b;
+  }
+}
+
+template <typename T>
+inline T Load(const T* values, size_t i) {
+  return values[i];
+}
+
+template <typename T>
+inline T Load(T constant, size_t) {
+  return constant;
+}
+
+// Branch free, the index is always written and only kept on a match
+template <typename T, CompareOp OP>
+size_t SelectScalar(const T* values, size_t begin, size_t size, T constant,
+                    uint32_t* out, size_t count) {
+  for (size_t i = begin; i < size; i++) {
+    out[count] = i;
+    count += Compare<OP>(values[i], constant);
+  }
+  return count;
+}
+
+// The loops below are written once and inlined into a copy per instruction
+// set, the compiler vectorizes each copy for its target
+template <ArithOp OP, typename T, typename L, typename R>
+__attribute__((always_inline)) inline void ArithmeticLoop(L left, R right,
+                                                          T* out,
+                                                          size_t size) {
+  for (size_t i = 0; i < size; i++) {
+    out[i] = Apply<OP, T>(Load(left, i), Load(right, i));
+  }
+}
+
+// Independent partial sums, so floating point sums vectorize without
+// reordering additions within a lane
+template <typename T>
+__attribute__((always_inline)) inline SumType<T> SumLoop(const T* values,
+                                                         size_t size) {
+  constexpr size_t LANES = 8;
+  SumType<T> lanes[LANES] = {};
+  size_t i = 0;
+  for (; i + LANES <= size; i += LANES) {
+    for (size_t j = 0; j < LANES; j++) {
+      lanes[j] += values[i + j];
+    }
+  }
+  SumType<T> sum = 0;
+  for (size_t j = 0; j < LANES; j++) {
+    sum += lanes[j];
+  }
+  for (; i < size; i++) {
+    sum += values[i];
+  }
+  return sum;
+}
+
+#if defined(__x86_64__)
+
+template <CompareOp OP>
+constexpr int INT_PREDICATE = OP == CompareOp::Eq   ? _MM_CMPINT_EQ
+                              : OP == CompareOp::Ne ? _MM_CMPINT_NE
+                              : OP == CompareOp::Lt ? _MM_CMPINT_LT
+                              : OP == CompareOp::Le ? _MM_CMPINT_LE
+                              : OP == CompareOp::Gt ? _MM_CMPINT_NLE
+                                                    : _MM_CMPINT_NLT;
+
+// Ordered compares are false for NaN, != is true for it like in C++
+template <CompareOp OP>
+constexpr int FLOAT_PREDICATE = OP == CompareOp::Eq   ? _CMP_EQ_OQ
+                                : OP == CompareOp::Ne ? _CMP_NEQ_UQ
+                                : OP == CompareOp::Lt ? _CMP_LT_OQ
+                                : OP == CompareOp::Le ? _CMP_LE_OQ
+                                : OP == CompareOp::Gt ? _CMP_GT_OQ
+                                                      : _CMP_GE_OQ;
+
+// AVX2 has only == and > for integers, the other operators swap the
+// operands or negate the result
+template <typename T, CompareOp OP>
+__attribute__((target("avx2"))) size_t SelectAvx2(const T* values,
+                                                  size_t size, T constant,
+                                                  uint32_t* out) {
+  constexpr size_t LANES = 32 / sizeof(T);
+  constexpr uint32_t ALL = (1u << LANES) - 1;
+  constexpr bool NEGATE = OP == CompareOp::Ne || OP == CompareOp::Le ||
+                          OP == CompareOp::Ge;
+  size_t count = 0;
+  size_t i = 0;
+  for (; i + LANES <= size; i += LANES) {
+    uint32_t mask;
+    if constexpr (std::is_same_v<T, double>) {
+      __m256d cmp = _mm256_cmp_pd(_mm256_loadu_pd(values + i),
+                                  _mm256_set1_pd(constant),
+                                  FLOAT_PREDICATE<OP>);
+      mask = _mm256_movemask_pd(cmp);
+    } else {
+      __m256i v =
+          _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + i));
+      __m256i k = sizeof(T) == 8 ? _mm256_set1_epi64x(constant)
+                                 : _mm256_set1_epi32(constant);
+      __m256i cmp;
+      if constexpr (OP == CompareOp::Eq || OP == CompareOp::Ne) {
+        cmp = sizeof(T) == 8 ? _mm256_cmpeq_epi64(v, k)
+                             : _mm256_cmpeq_epi32(v, k);
+      } else if constexpr (OP == CompareOp::Gt || OP == CompareOp::Le) {
+        cmp = sizeof(T) == 8 ? _mm256_cmpgt_epi64(v, k)
+                             : _mm256_cmpgt_epi32(v, k);
+      } else {
+        cmp = sizeof(T) == 8 ? _mm256_cmpgt_epi64(k, v)
+                             : _mm256_cmpgt_epi32(k, v);
+      }
+      mask = sizeof(T) == 8
+                 ? _mm256_movemask_pd(_mm256_castsi256_pd(cmp))
+                 : _mm256_movemask_ps(_mm256_castsi256_ps(cmp));
+      if constexpr (NEGATE) {
+        mask ^= ALL;
+      }
+    }
+    while (mask != 0) {
+      out[count++] = i + __builtin_ctz(mask);
+      mask &= mask - 1;
+    }
+  }
+  return SelectScalar<T, OP>(values, i, size, constant, out, count);
+}
+
+// Matching row indices are written with a compress store
+template <typename T, CompareOp OP>
+__attribute__((target("avx512f,popcnt"))) size_t SelectAvx512(
+    const T* values, size_t size, T constant, uint32_t* out) {
+  constexpr size_t LANES = 64 / sizeof(T);
+  __m512i indices = _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11,
+                                      12, 13, 14, 15);
+  const __m512i step = _mm512_set1_epi32(LANES);
+  size_t count = 0;
+  size_t i = 0;
+  for (; i + LANES <= size; i += LANES) {
+    __mmask16 mask;
+    if constexpr (std::is_same_v<T, double>) {
+      mask = _mm512_cmp_pd_mask(_mm512_loadu_pd(values + i),
+                                _mm512_set1_pd(constant), FLOAT_PREDICATE<OP>);
+    } else if constexpr (sizeof(T) == 8) {
+      mask = _mm512_cmp_epi64_mask(_mm512_loadu_si512(values + i),
+                                   _mm512_set1_epi64(constant),
+                                   INT_PREDICATE<OP>);
+    } else {
+      mask = _mm512_cmp_epi32_mask(_mm512_loadu_si512(values + i),
+                                   _mm512_set1_epi32(constant),
+                                   INT_PREDICATE<OP>);
+    }
+    _mm512_mask_compressstoreu_epi32(out + count, mask, indices);
+    count += __builtin_popcount(mask);
+    indices = _mm512_add_epi32(indices, step);
+  }
+  return SelectScalar<T, OP>(values, i, size, constant, out, count);
+}
+
+template <ArithOp OP, typename T, typename L, typename R>
+__attribute__((target("avx2"))) void ArithmeticAvx2(L left, R right, T* out,
+                                                    size_t size) {
+  ArithmeticLoop<OP, T>(left, right, out, size);
+}
+
+template <ArithOp OP, typename T, typename L, typename R>
+__attribute__((target("avx512f"))) void ArithmeticAvx512(L left, R right,
+                                                         T* out, size_t size) {
+  ArithmeticLoop<OP, T>(left, right, out, size);
+}
+
+template <typename T>
+__attribute__((target("avx2"))) SumType<T> SumAvx2(const T* values,
+                                                   size_t size) {
+  return SumLoop(values, size);
+}
+
+template <typename T>
+__attribute__((target("avx512f"))) SumType<T> SumAvx512(const T* values,
+                                                        size_t size) {
+  return SumLoop(values, size);
+}
+
+#endif
+
+template <ArithOp OP, typename T, typename L, typename R>
+void ArithmeticDispatch(L left, R right, T* out, size_t size,
+                        VectorKernel kernel) {
+  switch (kernel) {
+#if defined(__x86_64__)
+    case VectorKernel::AVX512:
+      return ArithmeticAvx512<OP, T>(left, right, out, size);
+    case VectorKernel::AVX2:
+      return ArithmeticAvx2<OP, T>(left, right, out, size);
+#endif
+    default:
+      return ArithmeticLoop<OP, T>(left, right, out, size);
+  }
+}
+
+VectorKernel DetectKernel() {
+#if defined(__x86_64__)
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f")) {
+    return VectorKernel::AVX512;
+  }
+  if (__builtin_cpu_supports("avx2")) {
+    return VectorKernel::AVX2;
+  }
+#endif
+  return VectorKernel::Scalar;
+}
+
+}  // namespace
+
+VectorKernel DetectVectorKernel() {
+  static const VectorKernel kernel = DetectKernel();
+  return kernel;
+}
+
+const char* VectorKernelName(VectorKernel kernel) {
+  switch (kernel) {
+    case VectorKernel::AVX512:
+      return "avx512";
+    case VectorKernel::AVX2:
+      return "avx2";
+    default:
+      return "scalar";
+  }
+}
+
+template <typename T, CompareOp OP>
+size_t SelectCompare(const T* values, size_t size, T constant, uint32_t* out,
+                     VectorKernel kernel) {
+  switch (kernel) {
+#if defined(__x86_64__)
+    case VectorKernel::AVX512:
+      return SelectAvx512<T, OP>(values, size, constant, out);
+    case VectorKernel::AVX2:
+      return SelectAvx2<T, OP>(values, size, constant, out);
+#endif
+    default:
+      return SelectScalar<T, OP>(values, 0, size, constant, out, 0);
+  }
+}
+
+// Selected rows are scattered, gathering them into vectors does not pay off
+template <typename T, CompareOp OP>
+size_t SelectCompare(const T* values, const uint32_t* selection, size_t count,
+                     T constant, uint32_t* out) {
+  size_t selected = 0;
+  for (size_t i = 0; i < count; i++) {
+    uint32_t row = selection[i];
+    out[selected] = row;
+    selected += Compare<OP>(values[row], constant);
+  }
+  return selected;
+}
+
+template <typename T, ArithOp OP>
+void Arithmetic(const T* left, const T* right, T* out, size_t size,
+                VectorKernel kernel) {
+  ArithmeticDispatch<OP, T>(left, right, out, size, kernel);
+}
+
+template <typename T, ArithOp OP>
+void Arithmetic(const T* left, T right, T* out, size_t size,
+                VectorKernel kernel) {
+  ArithmeticDispatch<OP, T>(left, right, out, size, kernel);
+}
+
+template <typename T, ArithOp OP>
+void Arithmetic(T left, const T* right, T* out, size_t size,
+                VectorKernel kernel) {
+  ArithmeticDispatch<OP, T>(left, right, out, size, kernel);
+}
+
+template <typename T>
+SumType<T> Sum(const T* values, size_t size, VectorKernel kernel) {
+  switch (kernel) {
+#if defined(__x86_64__)
+    case VectorKernel::AVX512:
+      return SumAvx512(values, size);
+    case VectorKernel::AVX2:
+      return SumAvx2(values, size);
+#endif
+    default:
+      return SumLoop(values, size);
+  }
+}
+
+template <typename T>
+SumType<T> Sum(const T* values, const uint32_t* selection, size_t count) {
+  SumType<T> sum = 0;
+  for (size_t i = 0; i < count; i++) {
+    sum += values[selection[i]];
+  }
+  return sum;
+}
+
+#define INSTANTIATE_SELECT(T, OP)                                           \
+  template size_t SelectCompare<T, OP>(const T*, size_t, T, uint32_t*,      \
+                                       VectorKernel);                       \
+  template size_t SelectCompare<T, OP>(const T*, const uint32_t*, size_t, T, \
+                                       uint32_t*);
+
+#define INSTANTIATE_ARITHMETIC(T, OP)                                      \
+  template void Arithmetic<T, OP>(const T*, const T*, T*, size_t,          \
+                                  VectorKernel);                           \
+  template void Arithmetic<T, OP>(const T*, T, T*, size_t, VectorKernel);  \
+  template void Arithmetic<T, OP>(T, const T*, T*, size_t, VectorKernel);
+
+#define INSTANTIATE_TYPE(T)                                     \
+  INSTANTIATE_SELECT(T, CompareOp::Eq)                          \
+  INSTANTIATE_SELECT(T, CompareOp::Ne)                          \
+  INSTANTIATE_SELECT(T, CompareOp::Lt)                          \
+  INSTANTIATE_SELECT(T, CompareOp::Le)                          \
+  INSTANTIATE_SELECT(T, CompareOp::Gt)                          \
+  INSTANTIATE_SELECT(T, CompareOp::Ge)                          \
+  INSTANTIATE_ARITHMETIC(T, ArithOp::Add)                       \
+  INSTANTIATE_ARITHMETIC(T, ArithOp::Sub)                       \
+  INSTANTIATE_ARITHMETIC(T, ArithOp::Mul)                       \
+  INSTANTIATE_ARITHMETIC(T, ArithOp::Div)                       \
+  template SumType<T> Sum(const T*, size_t, VectorKernel);      \
+  template SumType<T> Sum(const T*, const uint32_t*, size_t);
+
+INSTANTIATE_TYPE(int32_t)
+INSTANTIATE_TYPE(int64_t)
+INSTANTIATE_TYPE(double)
@@ -0,0 +1,62 @@
+#include <execution/morsel_scan.hpp>
+
+#include <algorithm>
+#include <utility>
+
+MorselScan::MorselScan(PaxTable* table, std::vector<size_t> columns,
+                       const std::vector<PageId_t>* page_ids,
+                       MorselScheduler* scheduler, size_t worker,
+                       size_t morsel_pages)
+    : table_(table),
+      column_ids_(std::move(columns)),
+      page_ids_(page_ids),
+      scheduler_(scheduler),
+      worker_(worker),
+      morsel_pages_(morsel_pages) {
+  for (size_t column : column_ids_) {
+    columns_.push_back(table_->GetSchema().GetColumn(column));
+  }
+}
+
+size_t MorselScan::MorselCount(size_t num_pages, size_t morsel_pages) {
+  return (num_pages + morsel_pages - 1) / morsel_pages;
+}
+
+const std::vector<Column>& MorselScan::GetColumns() const {
+  return columns_;
+}
+
+bool MorselScan::Next(Batch& batch) {
+  while (!scan_.has_value() || !scan_->Next(batch)) {
+    auto morsel = scheduler_->NextMorsel(worker_);
+    if (!morsel.has_value()) {
+      scan_.reset();
+      return false;
+    }
+    size_t begin = *morsel * morsel_pages_;
+    size_t end = std::min(begin + morsel_pages_, page_ids_->size());
+    scan_.emplace(table_, column_ids_,
+                  std::vector<PageId_t>(page_ids_->begin() + begin,
+                                        page_ids_->begin() + end));
+  }
+  return true;
+}
+
+std::unique_ptr<Aggregate> ParallelAggregate(
+    MorselScheduler* scheduler, PaxTable* table, std::vector<size_t> columns,
+    const AggregatePipeline& pipeline, size_t morsel_pages) {
+  const std::vector<PageId_t> page_ids = table->GetPageIds();
+  std::vector<std::unique_ptr<Aggregate>> partials(
+      scheduler->GetWorkerCount());
+  for (size_t worker = 0; worker < partials.size(); worker++) {
+    partials[worker] = pipeline(std::make_unique<MorselScan>(
+        table, columns, &page_ids, scheduler, worker, morsel_pages));
+  }
+
+  scheduler->Run(MorselScan::MorselCount(page_ids.size(), morsel_pages),
+                 [&](size_t worker) { partials[worker]->ConsumeInput(); });
+  for (size_t worker = 1; worker < partials.size(); worker++) {
+    partials[0]->Merge(*partials[worker]);
+  }
+  return std::move(partials[0]);
+}
@@ -0,0 +1,107 @@
+#include <execution/morsel_scheduler.hpp>
+
+#include <algorithm>
+
+MorselScheduler::MorselScheduler(size_t num_workers) {
+  num_workers = std::max<size_t>(num_workers, 1);
+  for (size_t i = 0; i < num_workers; i++) {
+    queues_.push_back(std::make_unique<Queue>());
+  }
+  for (size_t i = 0; i < num_workers; i++) {
+    threads_.emplace_back([this, i]() { Work_(i); });
+  }
+}
+
+MorselScheduler::~MorselScheduler() {
+  {
+    std::scoped_lock lock(mutex_);
+    stop_ = true;
+  }
+  start_cv_.notify_all();
+  for (auto& thread : threads_) {
+    thread.join();
+  }
+}
+
+size_t MorselScheduler::GetWorkerCount() const {
+  return queues_.size();
+}
+
+void MorselScheduler::Run(size_t num_morsels,
+                          const std::function<void(size_t)>& task) {
+  const size_t num_workers = queues_.size();
+  for (size_t i = 0; i < num_workers; i++) {
+    std::scoped_lock lock(queues_[i]->mutex);
+    queues_[i]->morsels.clear();
+    for (size_t m = num_morsels * i / num_workers;
+         m < num_morsels * (i + 1) / num_workers; m++) {
+      queues_[i]->morsels.push_back(m);
+    }
+  }
+
+  std::unique_lock lock(mutex_);
+  task_ = &task;
+  running_ = num_workers;
+  error_ = nullptr;
+  job_++;
+  start_cv_.notify_all();
+  done_cv_.wait(lock, [&]() { return running_ == 0; });
+  task_ = nullptr;
+  if (error_) {
+    std::rethrow_exception(error_);
+  }
+}
+
+std::optional<size_t> MorselScheduler::NextMorsel(size_t worker) {
+  {
+    Queue& own = *queues_[worker];
+    std::scoped_lock lock(own.mutex);
+    if (!own.morsels.empty()) {
+      size_t morsel = own.morsels.front();
+      own.morsels.pop_front();
+      return morsel;
+    }
+  }
+
+  for (size_t i = 1; i < queues_.size(); i++) {
+    Queue& victim = *queues_[(worker + i) % queues_.size()];
+    std::scoped_lock lock(victim.mutex);
+    if (!victim.morsels.empty()) {
+      size_t morsel = victim.morsels.back();
+      victim.morsels.pop_back();
+      return morsel;
+    }
+  }
+  return std::nullopt;
+}
+
+void MorselScheduler::Work_(size_t worker) {
+  uint64_t done = 0;
+  while (true) {
+    const std::function<void(size_t)>* task;
+    {
+      std::unique_lock lock(mutex_);
+      start_cv_.wait(lock, [&]() { return stop_ || job_ != done; });
+      if (stop_) {
+        return;
+      }
+      done = job_;
+      task = task_;
+    }
+
+    std::exception_ptr error;
+    try {
+      (*task)(worker);
+    } catch (...) {
+      error = std::current_exception();
+    }
+
+    std::scoped_lock lock(mutex_);
+    if (error && !error_) {
+      error_ = error;
+    }
+    if (--running_ == 0) {
+      done_cv_.notify_one();
+    }
+  }
+}
@@ -0,0 +1,45 @@
+#include <execution/pax_scan.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+PaxScan::PaxScan(PaxTable* table, std::vector<size_t> columns)
+    : it_(table->Scan(columns)) {
+  for (size_t column : columns) {
+    columns_.push_back(table->GetSchema().GetColumn(column));
+  }
+}
+
+PaxScan::PaxScan(PaxTable* table, std::vector<size_t> columns,
+                 std::vector<PageId_t> page_ids)
+    : it_(table->Scan(columns, std::move(page_ids))) {
+  for (size_t column : columns) {
+    columns_.push_back(table->GetSchema().GetColumn(column));
+  }
+}
+
+const std::vector<Column>& PaxScan::GetColumns() const {
+  return columns_;
+}
+
+bool PaxScan::Next(Batch& batch) {
+  size_t size = 0;
+  while (size < VECTOR_SIZE && !it_.IsEnd()) {
+    size_t rows = std::min<size_t>(VECTOR_SIZE - size,
+                                   it_.GetPageRows() - row_);
+    for (size_t i = 0; i < columns_.size(); i++) {
+      size_t width = columns_[i].size;
+      memcpy(batch.GetColumn(i).GetData() + size * width,
+             it_.GetMinipage(i) + row_ * width, rows * width);
+    }
+    size += rows;
+    row_ += rows;
+    if (row_ == it_.GetPageRows()) {
+      it_.NextPage();
+      row_ = 0;
+    }
+  }
+  batch.SetSize(size);
+  return size > 0;
+}
@@ -0,0 +1,145 @@
+#include <execution/spill.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+EntryLayout::EntryLayout(const std::vector<Column>& columns,
+                         size_t key_column)
+    : columns_(columns), key_column_(key_column), size_(sizeof(uint64_t)) {
+  if (columns_.at(key_column_).size > sizeof(uint64_t)) {
+    throw std::runtime_error("Key column wider than 8 bytes");
+  }
+  for (const auto& column : columns_) {
+    offsets_.push_back(size_);
+    size_ += column.size;
+  }
+}
+
+size_t EntryLayout::GetSize() const {
+  return size_;
+}
+
+const std::vector<Column>& EntryLayout::GetColumns() const {
+  return columns_;
+}
+
+uint64_t EntryLayout::GetKey(const char* entry) const {
+  uint64_t key;
+  memcpy(&key, entry, sizeof(key));
+  return key;
+}
+
+// A column at a time, then the keys
+void EntryLayout::Gather(const Batch& batch, size_t begin, size_t count,
+                         char* out) const {
+  const uint32_t* selection =
+      batch.IsFiltered() ? batch.GetSelection() : nullptr;
+  for (size_t c = 0; c < columns_.size(); c++) {
+    const char* data = batch.GetColumn(c).GetData();
+    size_t width = columns_[c].size;
+    for (size_t i = 0; i < count; i++) {
+      size_t row = selection != nullptr ? selection[begin + i] : begin + i;
+      memcpy(out + i * size_ + offsets_[c], data + row * width, width);
+    }
+  }
+
+  const Column& key_column = columns_[key_column_];
+  for (size_t i = 0; i < count; i++) {
+    char* entry = out + i * size_;
+    uint64_t key = NormalizeKey(key_column.type,
+                                entry + offsets_[key_column_],
+                                key_column.size);
+    memcpy(entry, &key, sizeof(key));
+  }
+}
+
+void EntryLayout::Scatter(const char* entry, Batch& batch, size_t row,
+                          size_t first_column) const {
+  for (size_t c = 0; c < columns_.size(); c++) {
+    size_t width = columns_[c].size;
+    memcpy(batch.GetColumn(first_column + c).GetData() + row * width,
+           entry + offsets_[c], width);
+  }
+}
+
+SpillWriter::SpillWriter(BufferPoolManager* bpm, size_t entry_size)
+    : bpm_(bpm),
+      entry_size_(entry_size),
+      entries_per_page_(EntriesPerPage(entry_size)) {
+  RequireDefaultPageSize(bpm_->GetPageSize(), "Spill file");
+  if (entries_per_page_ == 0) {
+    throw std::runtime_error("Spilled rows do not fit in a page");
+  }
+}
+
+size_t SpillWriter::EntriesPerPage(size_t entry_size) {
+  return (DB_PAGE_SIZE - SpillReader::PAGE_HEADER_SIZE) / entry_size;
+}
+
+void SpillWriter::Append(const char* entry) {
+  if (!guard_.has_value() || rows_ == entries_per_page_) {
+    FinishPage_();
+    pages_.push_back(bpm_->NewTempPage());
+    guard_ = bpm_->WritePage(pages_.back(), AccessType::Scan);
+    rows_ = 0;
+  }
+  memcpy(guard_->GetDataMut() + SpillReader::PAGE_HEADER_SIZE +
+             rows_ * entry_size_,
+         entry, entry_size_);
+  rows_++;
+  count_++;
+}
+
+size_t SpillWriter::GetEntryCount() const {
+  return count_;
+}
+
+std::vector<PageId_t> SpillWriter::Finish() {
+  FinishPage_();
+  return std::move(pages_);
+}
+
+void SpillWriter::FinishPage_() {
+  if (guard_.has_value()) {
+    memcpy(guard_->GetDataMut(), &rows_, sizeof(rows_));
+    guard_.reset();
+  }
+}
+
+SpillReader::SpillReader(BufferPoolManager* bpm, size_t entry_size,
+                         std::vector<PageId_t> pages)
+    : bpm_(bpm), entry_size_(entry_size), pages_(std::move(pages)) {
+  LoadPage_();
+}
+
+SpillReader::~SpillReader() {
+  guard_.reset();
+  for (size_t i = page_; i < pages_.size(); i++) {
+    bpm_->DeletePage(pages_[i]);
+  }
+}
+
+void SpillReader::Advance() {
+  if (++row_ < rows_) {
+    return;
+  }
+  guard_.reset();
+  bpm_->DeletePage(pages_[page_++]);
+  LoadPage_();
+}
+
+void SpillReader::LoadPage_() {
+  row_ = 0;
+  if (page_ >= pages_.size()) {
+    return;
+  }
+  if (page_ % SPILL_READ_AHEAD_PAGES == 0) {
+    auto end = pages_.begin() +
+               std::min(pages_.size(), page_ + SPILL_READ_AHEAD_PAGES);
+    bpm_->PrefetchPages({pages_.begin() + page_, end});
+  }
+  guard_ = bpm_->ReadPage(pages_[page_], AccessType::Scan);
+  memcpy(&rows_, guard_->GetData(), sizeof(rows_));
+}
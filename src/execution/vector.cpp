@@ -0,0 +1,76 @@
+#include <execution/vector.hpp>
+
+#include <utility>
+
+ColumnVector::ColumnVector(const Column& column)
+    : type_(column.type),
+      width_(column.size),
+      data_((VECTOR_SIZE * column.size + sizeof(uint64_t) - 1) /
+            sizeof(uint64_t)) {}
+
+TypeId ColumnVector::GetType() const {
+  return type_;
+}
+
+size_t ColumnVector::GetWidth() const {
+  return width_;
+}
+
+char* ColumnVector::GetData() {
+  return reinterpret_cast<char*>(data_.data());
+}
+
+const char* ColumnVector::GetData() const {
+  return reinterpret_cast<const char*>(data_.data());
+}
+
+Batch::Batch(const std::vector<Column>& columns)
+    : selection_(VECTOR_SIZE), selection_buffer_(VECTOR_SIZE) {
+  for (const auto& column : columns) {
+    columns_.emplace_back(column);
+  }
+}
+
+size_t Batch::GetColumnCount() const {
+  return columns_.size();
+}
+
+ColumnVector& Batch::GetColumn(size_t index) {
+  return columns_[index];
+}
+
+const ColumnVector& Batch::GetColumn(size_t index) const {
+  return columns_[index];
+}
+
+size_t Batch::GetSize() const {
+  return size_;
+}
+
+void Batch::SetSize(size_t size) {
+  size_ = size;
+  filtered_ = false;
+  selected_ = size;
+}
+
+bool Batch::IsFiltered() const {
+  return filtered_;
+}
+
+size_t Batch::GetSelectedCount() const {
+  return selected_;
+}
+
+const uint32_t* Batch::GetSelection() const {
+  return selection_.data();
+}
+
+uint32_t* Batch::GetSelectionBuffer() {
+  return selection_buffer_.data();
+}
+
+void Batch::SetSelection(size_t count) {
+  std::swap(selection_, selection_buffer_);
+  filtered_ = true;
+  selected_ = count;
+}
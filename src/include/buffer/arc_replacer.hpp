@@ -3,6 +3,7 @@
 
 #include <config.hpp>
 
+#include <functional>
 #include <list>
 #include <mutex>
 #include <optional>
@@ -29,7 +30,10 @@ class ArcReplacer {
   ArcReplacer(ArcReplacer&) = delete;
   ArcReplacer(ArcReplacer&&) = delete;
 
-  std::optional<FrameId_t> Evict();
+  // take_reference reports and clears an access made without RecordAccess,
+  // such a frame has the access recorded and is passed over once
+  std::optional<FrameId_t> Evict(
+      const std::function<bool(FrameId_t)>& take_reference = nullptr);
   void RecordAccess(FrameId_t, PageId_t,
                     AccessType access_type = AccessType::Unknown);
   void SetEvictable(FrameId_t, bool);
@@ -37,7 +41,8 @@ class ArcReplacer {
   size_t Size() const noexcept;
 
  private:
-  std::optional<FrameId_t> EvictOneList_(bool);
+  std::optional<FrameId_t> EvictOneList_(
+      bool, const std::function<bool(FrameId_t)>&, bool&);
   bool RecordAccessExists_(FrameId_t, AccessType);
   bool RecordAccessGhostHit_(FrameId_t, PageId_t, AccessType);
   void RecordAccessNoHit_(FrameId_t, PageId_t, AccessType);
@@ -2,11 +2,16 @@
 #define _BUFFER_POOL_MANAGER_HPP_
 
 #include <buffer/arc_replacer.hpp>
+#include <buffer/victim_cache.hpp>
 #include <config.hpp>
 #include <storage/disk_manager.hpp>
 #include <storage/disk_scheduler.hpp>
 #include <storage/page_guard.hpp>
 
+#include <future>
+#include <map>
+#include <unordered_set>
+
 class BufferPoolManager;
 class ReadPageGuard;
 class WritePageGuard;
@@ -15,9 +20,10 @@ class FrameHeader {
   friend class BufferPoolManager;
   friend class ReadPageGuard;
   friend class WritePageGuard;
+  friend class OptimisticPageGuard;
 
  public:
-  FrameHeader(FrameId_t);
+  FrameHeader(FrameId_t, size_t page_size);
 
  private:
   const char* GetData() const;
@@ -29,15 +35,36 @@ class FrameHeader {
   std::atomic<size_t> pin_count_;
   bool is_dirty_{false};
   std::vector<char> data_;
+  // Odd while the page is write latched or the frame changes pages
+  std::atomic<uint64_t> version_{0};
+  std::atomic<PageId_t> page_id_{INVALID_PAGE_ID};
+  // Set by optimistic reads, which do not take the buffer pool latch to tell
+  // the replacer, and taken by the replacer when it considers the frame
+  std::atomic<bool> referenced_{false};
 };
 
 class BufferPoolManager {
  public:
-  BufferPoolManager(size_t, DiskManager*);
+  // A victim cache budget above 0 keeps evicted pages compressed in memory
+  // up to that many bytes, misses check it before they read from disk
+  BufferPoolManager(size_t, DiskManager*, size_t victim_cache_bytes = 0);
   ~BufferPoolManager();
 
   size_t Size() const;
+  // Size of the frames, the page size of the disk manager's file
+  size_t GetPageSize() const;
   PageId_t NewPage();
+  // First of count consecutive page ids whose pages are placed next to each
+  // other on disk. The owner is the first page id of the object the pages
+  // belong to, so a disk manager can keep an object's extents together.
+  PageId_t NewPages(size_t count, PageId_t owner = INVALID_PAGE_ID);
+  // Page for intermediate results, its id is not shared with data pages. It
+  // is never flushed or written on delete, an evicted dirty temporary page is
+  // written to the disk manager's scratch file.
+  PageId_t NewTempPage();
+  // Drops the page without writing it back, false for an id that was never
+  // allocated or is already deleted. A pinned page is dropped once it is
+  // unpinned, it can still be read until then.
   bool DeletePage(PageId_t);
   std::optional<WritePageGuard> CheckedWritePage(
       PageId_t, AccessType access_type = AccessType::Unknown);
@@ -47,22 +74,65 @@ class BufferPoolManager {
                            AccessType access_type = AccessType::Unknown);
   ReadPageGuard ReadPage(PageId_t,
                          AccessType access_type = AccessType::Unknown);
+  // Lock free lookup of a resident page that is not write latched, it does
+  // not pin the page. The access is recorded once the replacer considers
+  // the frame for eviction.
+  std::optional<OptimisticPageGuard> OptimisticReadPage(PageId_t);
+  // Read ahead, loads the pages that are not resident with one batch of disk
+  // reads and leaves them unpinned. Stops early when no frame can be evicted.
+  void PrefetchPages(const std::vector<PageId_t>&);
   bool FlushPageUnsafe(PageId_t);
   bool FlushPage(PageId_t);
   void FlushAllPagesUnsafe();
   void FlushAllPages();
+  // Flushes every page that is dirty at the time of the call. The returned
+  // future must be waited on before the buffer pool is destroyed.
+  std::future<void> FlushAllPagesAsync();
   std::optional<size_t> GetPinCount(PageId_t);
+  // nullptr without a victim cache
+  const VictimCache* GetVictimCache() const;
 
  private:
+  using DirtyFrames =
+      std::vector<std::pair<PageId_t, std::shared_ptr<FrameHeader>>>;
+
+  DirtyFrames PinDirtyFrames_();
+  void FlushFrames_(DirtyFrames&, bool);
+  void UnpinFrames_(DirtyFrames&);
+  std::optional<FrameId_t> AllocateFrame_(std::vector<DiskRequest>&,
+                                          std::vector<std::future<bool>>&);
+  bool QueueRead_(PageId_t, FrameHeader&, std::vector<DiskRequest>&,
+                  std::vector<std::future<bool>>&);
+  size_t HintSlot_(PageId_t) const;
+  bool IsDeleted_(PageId_t) const;
+  void AddDeleted_(PageId_t);
+  void FinishDeletes_();
+  void DropFrame_(PageId_t, FrameId_t);
+  void ReleasePage_(PageId_t);
+  bool IsTemp_(PageId_t) const;
+
   const size_t num_frames_;
+  const size_t page_size_;
   std::atomic<PageId_t> next_page_id_;
   std::shared_ptr<std::mutex> mutex_;
   std::vector<std::shared_ptr<FrameHeader>> frames_;
   std::unordered_map<PageId_t, FrameId_t> page_table_;
   std::unordered_map<FrameId_t, PageId_t> rev_page_table_;
   std::list<FrameId_t> free_frames_;
+  // Deleted ids as ranges from first id to end. Ranges are merged, so there
+  // are no more of them than runs of live ids between them.
+  std::map<PageId_t, PageId_t> deleted_ranges_;
+  // Pages deleted while pinned, dropped by the next delete or eviction after
+  // their last unpin
+  std::unordered_set<PageId_t> pending_deletes_;
+  // Live temporary pages, true once they have a copy in the scratch file
+  std::unordered_map<PageId_t, bool> temp_pages_;
+  // Page id modulo size to the frame that last held a page in that slot,
+  // only a hint for OptimisticReadPage, the frame's page id is checked
+  std::vector<std::atomic<FrameId_t>> frame_hints_;
   std::shared_ptr<ArcReplacer> replacer_;
   std::shared_ptr<DiskScheduler> disk_scheduler_;
+  std::shared_ptr<VictimCache> victim_cache_;
 };
 
 #endif
@@ -0,0 +1,17 @@
+#ifndef _PAGE_CODEC_HPP_
+#define _PAGE_CODEC_HPP_
+
+#include <cstddef>
+#include <vector>
+
+// Compresses a page into out. A page that repeats its first 8 bytes, zero
+// pages among them, takes 9 bytes. Other pages are LZ compressed: sequences
+// of literals followed by a match of at least 4 bytes within the page,
+// found through a hash table of 4 byte prefixes, with lengths packed into a
+// token byte like LZ4 does. A page that does not shrink is stored as is.
+// Returns the compressed size.
+size_t CompressPage(const char* page, size_t page_size, std::vector<char>& out);
+void DecompressPage(const char* data, size_t size, char* page,
+                    size_t page_size);
+
+#endif
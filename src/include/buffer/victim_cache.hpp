@@ -0,0 +1,59 @@
+#ifndef _VICTIM_CACHE_HPP_
+#define _VICTIM_CACHE_HPP_
+
+#include <config.hpp>
+
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+// Second level cache of pages evicted from the buffer pool, kept compressed
+// in memory. It only holds copies of pages that match the disk, the buffer
+// pool puts a page in when it evicts it, once its write back is queued, and
+// takes it out when it loads the page again, so a page is never both in the
+// pool and in the cache. Least recently put pages are dropped to stay within
+// the byte budget, which counts compressed bytes.
+class VictimCache {
+ public:
+  VictimCache(size_t budget_bytes, size_t page_size);
+
+  void Put(PageId_t, const char* page);
+  // Fills the page and drops it from the cache, false on a miss
+  bool Get(PageId_t, char* page);
+  void Erase(PageId_t);
+
+  size_t GetBudget() const;
+  // Compressed bytes held
+  size_t GetSize() const;
+  size_t GetPageCount() const;
+  size_t GetHits() const;
+  size_t GetMisses() const;
+  // Hits per lookup, 0 before the first one
+  double GetHitRatio() const;
+  // Page bytes per compressed byte of the pages put so far
+  double GetCompressionRatio() const;
+
+ private:
+  struct Entry {
+    std::vector<char> data;
+    std::list<PageId_t>::iterator lru;
+  };
+
+  void Erase_(std::unordered_map<PageId_t, Entry>::iterator);
+
+  const size_t budget_;
+  const size_t page_size_;
+  mutable std::mutex mutex_;
+  std::unordered_map<PageId_t, Entry> entries_;
+  // Most recently put first
+  std::list<PageId_t> lru_;
+  size_t size_{0};
+  size_t hits_{0};
+  size_t misses_{0};
+  size_t bytes_in_{0};
+  size_t bytes_stored_{0};
+  std::vector<char> buffer_;
+};
+
+#endif
@@ -4,10 +4,24 @@
 #include <cstddef>
 #include <cstdint>
 
+// Default and smallest page size of a db file. Pages of any size hold a page
+// format laid out for DB_PAGE_SIZE in their first DB_PAGE_SIZE bytes, only
+// PAX pages fill pages of every size.
 const size_t DB_PAGE_SIZE = 4096;
+const size_t DB_MAX_PAGE_SIZE = 64 * 1024;
 const size_t DEFAULT_DB_IO_SIZE = 16;
+const size_t DB_MAX_COALESCED_PAGES = 64;
+const size_t DB_STAGING_BUFFERS = 64;
+// Pages a table allocates at once, so that its pages sit next to each other
+// on disk
+const size_t TABLE_EXTENT_PAGES = 16;
 
+// Page ids and file offsets are 64 bit, frame ids stay 32 bit to keep the
+// page table and replacer entries small
 using FrameId_t = int32_t;
-using PageId_t = int32_t;
+using PageId_t = int64_t;
+
+const PageId_t INVALID_PAGE_ID = -1;
+const FrameId_t INVALID_FRAME_ID = -1;
 
 #endif
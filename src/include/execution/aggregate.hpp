@@ -0,0 +1,78 @@
+#ifndef _AGGREGATE_HPP_
+#define _AGGREGATE_HPP_
+
+#include <execution/vector_operator.hpp>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+enum class AggregateType { Count, Sum, Min, Max, Avg };
+
+struct AggregateExpr {
+  AggregateType type;
+  // Input column, unused by Count
+  size_t column;
+  std::string name;
+};
+
+// Hash aggregation over the selected rows of its input. It consumes the
+// whole input on the first call to Next and then returns one row per group,
+// the group by columns followed by the aggregates, in order of first
+// appearance. Sums of integers are int64, averages are float64. The group
+// by columns may not be wider than 8 bytes together. Without group by
+// columns there is exactly one group, even for an empty input.
+class Aggregate : public VectorOperator {
+ public:
+  Aggregate(std::unique_ptr<VectorOperator> child, std::vector<size_t> group_by,
+            std::vector<AggregateExpr> aggregates);
+
+  const std::vector<Column>& GetColumns() const override;
+  bool Next(Batch&) override;
+
+  // Aggregates the whole input, Next and Merge do it when it was not done yet
+  void ConsumeInput();
+  // Folds the groups of another aggregate with the same group by columns and
+  // aggregates into this one, for plans that aggregate parts of the input in
+  // parallel. Both consume their input first, other must not be used after.
+  void Merge(Aggregate& other);
+
+ private:
+  // Running values of one aggregate for every group, integer inputs are
+  // aggregated in ints and float64 inputs in floats. Each group has a few
+  // partial values that consecutive rows update in turn, so rows of the same
+  // group do not wait for each other's update.
+  struct State {
+    bool is_float;
+    std::vector<int64_t> ints;
+    std::vector<double> floats;
+  };
+
+  uint32_t FindGroup_(uint64_t key);
+  uint32_t AddGroup_(uint64_t key);
+  void Consume_(const Batch&);
+  void Emit_(Batch&, size_t group, size_t row) const;
+  template <typename S>
+  S Combine_(AggregateType, const std::vector<S>&, size_t group) const;
+
+  std::unique_ptr<VectorOperator> child_;
+  std::vector<size_t> group_by_;
+  std::vector<AggregateExpr> aggregates_;
+  std::vector<Column> columns_;
+  Batch input_;
+  bool consumed_{false};
+  size_t emitted_{0};
+
+  // Open addressing table from key to group, a power of two of slots with
+  // empty slots holding UINT32_MAX
+  std::vector<uint64_t> slot_keys_;
+  std::vector<uint32_t> slot_groups_;
+  std::vector<uint64_t> keys_;
+  std::vector<int64_t> counts_;
+  std::vector<State> states_;
+  // Key and state slot of each selected row of the current input batch
+  std::vector<uint64_t> row_keys_;
+  std::vector<uint32_t> groups_;
+};
+
+#endif
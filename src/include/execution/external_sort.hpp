@@ -0,0 +1,73 @@
+#ifndef _EXTERNAL_SORT_HPP_
+#define _EXTERNAL_SORT_HPP_
+
+#include <buffer/buffer_pool_manager.hpp>
+#include <execution/spill.hpp>
+#include <execution/vector_operator.hpp>
+
+#include <memory>
+#include <vector>
+
+// Frames a sort uses by default, for its run buffer and while merging
+const size_t SORT_FRAME_BUDGET = 256;
+
+// Stable sort of its input on one key column of at most 8 bytes, for inputs
+// larger than memory. Rows are collected in a buffer of frame_budget pages
+// and radix sorted on a normalized key. If the input does not fit, every
+// full buffer is written to buffer pool pages as a sorted run and the runs
+// are merged with a loser tree, frame_budget / (1 + SPILL_READ_AHEAD_PAGES)
+// runs at a time and in several passes if needed. Run pages are deleted once
+// merged, they only reach the scratch file when the buffer pool evicts them.
+class ExternalSort : public VectorOperator {
+ public:
+  ExternalSort(std::unique_ptr<VectorOperator> child, BufferPoolManager*,
+               size_t key_column, bool descending = false,
+               size_t frame_budget = SORT_FRAME_BUDGET);
+  ~ExternalSort() override;
+
+  const std::vector<Column>& GetColumns() const override;
+  bool Next(Batch&) override;
+
+  // Runs written to pages, 0 if the input fit in the buffer
+  size_t GetRunCount() const;
+  // Merges before the final one
+  size_t GetMergePasses() const;
+
+ private:
+  void Sort_();
+  void Append_(const Batch&);
+  void SortBuffer_();
+  std::vector<PageId_t> Spill_();
+
+  void StartMerge_(std::vector<std::vector<PageId_t>> runs);
+  bool Less_(size_t a, size_t b) const;
+  void Replay_(size_t run);
+  // Emits the head of the winning run, false once all runs are exhausted
+  template <typename Emit>
+  bool Pop_(const Emit&);
+
+  std::unique_ptr<VectorOperator> child_;
+  BufferPoolManager* bpm_;
+  EntryLayout layout_;
+  bool descending_;
+  size_t frame_budget_;
+  size_t fan_in_;
+  Batch input_;
+  bool sorted_{false};
+
+  // Run being built, emitted directly when it holds the whole input
+  std::vector<char> buffer_;
+  size_t buffered_{0};
+  std::vector<uint32_t> order_;
+  size_t emitted_{0};
+  bool in_memory_{false};
+
+  std::vector<std::vector<PageId_t>> runs_;
+  size_t run_count_{0};
+  size_t merge_passes_{0};
+  std::vector<std::unique_ptr<SpillReader>> merging_;
+  // Loser tree over merging_, tree_[0] is the winner
+  std::vector<size_t> tree_;
+};
+
+#endif
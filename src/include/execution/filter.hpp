@@ -0,0 +1,53 @@
+#ifndef _FILTER_HPP_
+#define _FILTER_HPP_
+
+#include <execution/kernels.hpp>
+#include <execution/vector_operator.hpp>
+
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+// Keeps the rows where column OP constant holds by narrowing the selection
+// of the batch, a chain of filters is a conjunction. Batches without matches
+// are skipped.
+template <typename T, CompareOp OP>
+class Filter : public VectorOperator {
+ public:
+  Filter(std::unique_ptr<VectorOperator> child, size_t column, T constant)
+      : child_(std::move(child)), column_(column), constant_(constant) {
+    if (!IsStorageType<T>(child_->GetColumns().at(column_).type)) {
+      throw std::runtime_error("Filter constant does not match column type");
+    }
+  }
+
+  const std::vector<Column>& GetColumns() const override {
+    return child_->GetColumns();
+  }
+
+  bool Next(Batch& batch) override {
+    while (child_->Next(batch)) {
+      const T* values = batch.GetColumn(column_).template Data<T>();
+      size_t count =
+          batch.IsFiltered()
+              ? SelectCompare<T, OP>(values, batch.GetSelection(),
+                                     batch.GetSelectedCount(), constant_,
+                                     batch.GetSelectionBuffer())
+              : SelectCompare<T, OP>(values, batch.GetSize(), constant_,
+                                     batch.GetSelectionBuffer());
+      batch.SetSelection(count);
+      if (count > 0) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+ private:
+  std::unique_ptr<VectorOperator> child_;
+  size_t column_;
+  T constant_;
+};
+
+#endif
@@ -0,0 +1,103 @@
+#ifndef _HASH_JOIN_HPP_
+#define _HASH_JOIN_HPP_
+
+#include <buffer/buffer_pool_manager.hpp>
+#include <execution/spill.hpp>
+#include <execution/vector_operator.hpp>
+
+#include <memory>
+#include <vector>
+
+// Frames a join uses by default, for its hash table or while partitioning
+const size_t JOIN_FRAME_BUDGET = 256;
+
+// Inner equi-join on a key column of at most 8 bytes of each input, the key
+// columns must have the same type. Output rows are the probe columns followed
+// by the build columns. The build input is read into a chained hash table of
+// at most frame_budget pages and the probe input streams through it. If the
+// build input does not fit, both inputs are radix partitioned on bits of the
+// key hash into buffer pool pages, a few dozen partitions at a time so the
+// pages being written stay cached, and the partitions are joined one by one,
+// partitioned again on the next bits while their build side does not fit.
+// After MAX_LEVELS partitioning levels, or when a level puts the whole build
+// side of a partition into one partition, which takes a single hot key, the
+// build side is joined in memory even if it exceeds the budget.
+class HashJoin : public VectorOperator {
+ public:
+  static constexpr size_t MAX_LEVELS = 4;
+
+  HashJoin(std::unique_ptr<VectorOperator> build,
+           std::unique_ptr<VectorOperator> probe, size_t build_key,
+           size_t probe_key, BufferPoolManager*,
+           size_t frame_budget = JOIN_FRAME_BUDGET);
+  ~HashJoin() override;
+
+  const std::vector<Column>& GetColumns() const override;
+  bool Next(Batch&) override;
+
+  // Partitions joined from pages, 0 if the build input fit in memory
+  size_t GetPartitionCount() const;
+  // Deepest partitioning level of a joined partition
+  size_t GetMaxLevel() const;
+
+ private:
+  struct Side {
+    std::vector<PageId_t> pages;
+    size_t count;
+  };
+  struct Partition {
+    Side build;
+    Side probe;
+    size_t level;
+  };
+
+  void Build_();
+  void BuildTable_();
+  void Spill_();
+  // Writes the entries source emits into partitions by the key hash bits of
+  // level, as build or probe entries
+  template <typename Source>
+  std::vector<Side> Partition_(const EntryLayout&, size_t level,
+                               const Source&);
+  void Repartition_(Partition);
+  bool NextPartition_();
+
+  // Refills the probe entries, false once all inputs are exhausted
+  bool StageProbe_();
+  // Emits matches of the probe entries, true once the batch is full
+  bool Probe_(Batch&, size_t& rows);
+  uint32_t Head_(const char* probe_entry) const;
+
+  std::unique_ptr<VectorOperator> build_;
+  std::unique_ptr<VectorOperator> probe_;
+  BufferPoolManager* bpm_;
+  EntryLayout build_layout_;
+  EntryLayout probe_layout_;
+  std::vector<Column> columns_;
+  size_t capacity_;
+  size_t partition_bits_;
+  Batch build_input_;
+  Batch probe_input_;
+  bool built_{false};
+
+  // Build entries and their hash table, chains end at UINT32_MAX
+  std::vector<char> buffer_;
+  size_t buffered_{0};
+  std::vector<uint32_t> heads_;
+  std::vector<uint32_t> next_;
+
+  // Probe entries being joined, the current one continues at match_
+  std::vector<char> probe_buffer_;
+  size_t probe_count_{0};
+  size_t probe_pos_{0};
+  uint32_t match_{UINT32_MAX};
+  bool exhausted_{false};
+
+  bool partitioned_{false};
+  std::vector<Partition> pending_;
+  std::unique_ptr<SpillReader> probe_reader_;
+  size_t partition_count_{0};
+  size_t max_level_{0};
+};
+
+#endif
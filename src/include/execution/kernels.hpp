@@ -0,0 +1,52 @@
+#ifndef _KERNELS_HPP_
+#define _KERNELS_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+// Primitives of the vectorized executor over arrays of int32, int64 (and
+// dates, which are int32) or double values. Every type and operator gets its
+// own instantiation, so the inner loops have no branches on either, and the
+// instruction set is picked once from the CPU features like the key search
+// kernels. Selections are arrays of row indices in increasing order.
+enum class CompareOp { Eq, Ne, Lt, Le, Gt, Ge };
+enum class ArithOp { Add, Sub, Mul, Div };
+enum class VectorKernel { Scalar = 0, AVX2, AVX512 };
+
+VectorKernel DetectVectorKernel();
+const char* VectorKernelName(VectorKernel);
+
+// Sums of integers are kept in 64 bits
+template <typename T>
+using SumType = std::conditional_t<std::is_floating_point_v<T>, double,
+                                   int64_t>;
+
+// Writes the index of every row with values[i] OP constant to out and
+// returns their number, either over rows [0, size) or over a selection
+template <typename T, CompareOp OP>
+size_t SelectCompare(const T* values, size_t size, T constant, uint32_t* out,
+                     VectorKernel kernel = DetectVectorKernel());
+template <typename T, CompareOp OP>
+size_t SelectCompare(const T* values, const uint32_t* selection, size_t count,
+                     T constant, uint32_t* out);
+
+// out[i] = left[i] OP right[i] for rows [0, size), with either side
+// optionally a constant
+template <typename T, ArithOp OP>
+void Arithmetic(const T* left, const T* right, T* out, size_t size,
+                VectorKernel kernel = DetectVectorKernel());
+template <typename T, ArithOp OP>
+void Arithmetic(const T* left, T right, T* out, size_t size,
+                VectorKernel kernel = DetectVectorKernel());
+template <typename T, ArithOp OP>
+void Arithmetic(T left, const T* right, T* out, size_t size,
+                VectorKernel kernel = DetectVectorKernel());
+
+template <typename T>
+SumType<T> Sum(const T* values, size_t size,
+               VectorKernel kernel = DetectVectorKernel());
+template <typename T>
+SumType<T> Sum(const T* values, const uint32_t* selection, size_t count);
+
+#endif
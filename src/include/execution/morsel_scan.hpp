@@ -0,0 +1,49 @@
+#ifndef _MORSEL_SCAN_HPP_
+#define _MORSEL_SCAN_HPP_
+
+#include <execution/aggregate.hpp>
+#include <execution/morsel_scheduler.hpp>
+#include <execution/pax_scan.hpp>
+#include <storage/table/pax_table.hpp>
+
+#include <functional>
+#include <memory>
+#include <optional>
+#include <vector>
+
+// Source of one worker of a parallel scan of a PAX table. Morsel m is pages
+// [m * morsel_pages, (m + 1) * morsel_pages) of page_ids, the scan reads the
+// morsels the scheduler gives to the worker until none are left.
+class MorselScan : public VectorOperator {
+ public:
+  MorselScan(PaxTable*, std::vector<size_t> columns,
+             const std::vector<PageId_t>* page_ids, MorselScheduler*,
+             size_t worker, size_t morsel_pages = MORSEL_PAGES);
+
+  static size_t MorselCount(size_t num_pages,
+                            size_t morsel_pages = MORSEL_PAGES);
+
+  const std::vector<Column>& GetColumns() const override;
+  bool Next(Batch&) override;
+
+ private:
+  PaxTable* table_;
+  std::vector<size_t> column_ids_;
+  std::vector<Column> columns_;
+  const std::vector<PageId_t>* page_ids_;
+  MorselScheduler* scheduler_;
+  size_t worker_;
+  size_t morsel_pages_;
+  std::optional<PaxScan> scan_;
+};
+
+// Runs a pipeline ending in an aggregate on every worker of the scheduler,
+// each on its own MorselScan of the table, and merges the partial
+// aggregates. The returned aggregate yields the result.
+using AggregatePipeline = std::function<std::unique_ptr<Aggregate>(
+    std::unique_ptr<VectorOperator>)>;
+std::unique_ptr<Aggregate> ParallelAggregate(
+    MorselScheduler*, PaxTable*, std::vector<size_t> columns,
+    const AggregatePipeline&, size_t morsel_pages = MORSEL_PAGES);
+
+#endif
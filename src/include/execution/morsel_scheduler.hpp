@@ -0,0 +1,59 @@
+#ifndef _MORSEL_SCHEDULER_HPP_
+#define _MORSEL_SCHEDULER_HPP_
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+// Pages per morsel, large enough that taking a morsel is rare and small
+// enough that stealing evens out skew between workers
+const size_t MORSEL_PAGES = 1024;
+
+// Fixed pool of workers for morsel driven parallelism. Run hands the morsels
+// of a job out through per worker queues: each worker starts on its own
+// contiguous range and takes morsels from the front of its queue, an idle
+// worker steals from the back of another queue, the end farthest from where
+// its owner is working. Workers index their local state by worker number.
+class MorselScheduler {
+ public:
+  explicit MorselScheduler(
+      size_t num_workers = std::thread::hardware_concurrency());
+  ~MorselScheduler();
+
+  size_t GetWorkerCount() const;
+
+  // Runs task(worker) on every worker and waits for all of them, tasks take
+  // morsels [0, num_morsels) with NextMorsel until it returns nullopt. The
+  // first exception thrown by a task is rethrown here.
+  void Run(size_t num_morsels, const std::function<void(size_t)>& task);
+  std::optional<size_t> NextMorsel(size_t worker);
+
+ private:
+  struct Queue {
+    std::mutex mutex;
+    std::deque<size_t> morsels;
+  };
+
+  void Work_(size_t worker);
+
+  std::vector<std::unique_ptr<Queue>> queues_;
+  std::vector<std::thread> threads_;
+
+  std::mutex mutex_;
+  std::condition_variable start_cv_;
+  std::condition_variable done_cv_;
+  // Bumped for each job, workers wait for a job they have not run yet
+  uint64_t job_{0};
+  const std::function<void(size_t)>* task_{nullptr};
+  size_t running_{0};
+  std::exception_ptr error_;
+  bool stop_{false};
+};
+
+#endif
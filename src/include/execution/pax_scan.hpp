@@ -0,0 +1,28 @@
+#ifndef _PAX_SCAN_HPP_
+#define _PAX_SCAN_HPP_
+
+#include <execution/vector_operator.hpp>
+#include <storage/table/pax_table.hpp>
+
+#include <vector>
+
+// Source reading some columns of a PAX table, or of some of its pages. The
+// projected minipages are copied into the batch a page run at a time, a batch
+// spans several pages.
+class PaxScan : public VectorOperator {
+ public:
+  PaxScan(PaxTable*, std::vector<size_t> columns);
+  PaxScan(PaxTable*, std::vector<size_t> columns,
+          std::vector<PageId_t> page_ids);
+
+  const std::vector<Column>& GetColumns() const override;
+  bool Next(Batch&) override;
+
+ private:
+  std::vector<Column> columns_;
+  PaxTableIterator it_;
+  // Next row of the current page
+  uint32_t row_{0};
+};
+
+#endif
@@ -0,0 +1,88 @@
+#ifndef _PROJECTION_HPP_
+#define _PROJECTION_HPP_
+
+#include <execution/kernels.hpp>
+#include <execution/vector_operator.hpp>
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Input of a projection, a column of the batch or a constant
+template <typename T>
+struct Operand {
+  static Operand OfColumn(size_t index) { return {true, index, T{}}; }
+  static Operand OfConstant(T value) { return {false, 0, value}; }
+
+  bool is_column;
+  size_t index;
+  T value;
+};
+
+// Appends the column left OP right. It is computed for every row of the
+// batch, selected or not, a dense loop is cheaper than gathering the rows
+// and keeps the kernel vectorized.
+template <typename T, ArithOp OP>
+class Projection : public VectorOperator {
+ public:
+  Projection(std::unique_ptr<VectorOperator> child, Operand<T> left,
+             Operand<T> right, std::string name)
+      : child_(std::move(child)),
+        left_(left),
+        right_(right),
+        columns_(child_->GetColumns()) {
+    if (!left_.is_column && !right_.is_column) {
+      throw std::runtime_error("Projection needs a column operand");
+    }
+    for (const auto& operand : {left_, right_}) {
+      if (operand.is_column &&
+          !IsStorageType<T>(columns_.at(operand.index).type)) {
+        throw std::runtime_error("Projection operand type mismatch");
+      }
+    }
+    columns_.emplace_back(std::move(name), OutputType_());
+  }
+
+  const std::vector<Column>& GetColumns() const override { return columns_; }
+
+  bool Next(Batch& batch) override {
+    if (!child_->Next(batch)) {
+      return false;
+    }
+    T* out = batch.GetColumn(columns_.size() - 1).template Data<T>();
+    size_t size = batch.GetSize();
+    if (!left_.is_column) {
+      Arithmetic<T, OP>(left_.value, Values_(batch, right_), out, size);
+    } else if (!right_.is_column) {
+      Arithmetic<T, OP>(Values_(batch, left_), right_.value, out, size);
+    } else {
+      Arithmetic<T, OP>(Values_(batch, left_), Values_(batch, right_), out,
+                        size);
+    }
+    return true;
+  }
+
+ private:
+  static const T* Values_(const Batch& batch, const Operand<T>& operand) {
+    return batch.GetColumn(operand.index).template Data<T>();
+  }
+
+  static TypeId OutputType_() {
+    if constexpr (std::is_same_v<T, int32_t>) {
+      return TypeId::Int32;
+    } else if constexpr (std::is_same_v<T, int64_t>) {
+      return TypeId::Int64;
+    } else {
+      return TypeId::Float64;
+    }
+  }
+
+  std::unique_ptr<VectorOperator> child_;
+  Operand<T> left_;
+  Operand<T> right_;
+  std::vector<Column> columns_;
+};
+
+#endif
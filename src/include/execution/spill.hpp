@@ -0,0 +1,96 @@
+#ifndef _SPILL_HPP_
+#define _SPILL_HPP_
+
+#include <buffer/buffer_pool_manager.hpp>
+#include <execution/vector.hpp>
+
+#include <optional>
+#include <vector>
+
+// Pages of spilled entries that a reader reads ahead at once
+const size_t SPILL_READ_AHEAD_PAGES = 4;
+
+// Operators that spill keep rows as entries: the normalized key of one
+// column followed by all columns of the row
+class EntryLayout {
+ public:
+  EntryLayout(const std::vector<Column>&, size_t key_column);
+
+  size_t GetSize() const;
+  const std::vector<Column>& GetColumns() const;
+  uint64_t GetKey(const char* entry) const;
+
+  // Writes the selected rows [begin, begin + count) of the batch to
+  // consecutive entries at out
+  void Gather(const Batch&, size_t begin, size_t count, char* out) const;
+  // Writes the columns of the entry to row of the batch, starting at column
+  // first_column of the batch
+  void Scatter(const char* entry, Batch&, size_t row,
+               size_t first_column = 0) const;
+
+ private:
+  std::vector<Column> columns_;
+  size_t key_column_;
+  std::vector<size_t> offsets_;
+  size_t size_;
+};
+
+// Appends entries of a fixed size to new temporary pages, one write latched
+// page at a time. Pages only reach the scratch file if they are evicted.
+class SpillWriter {
+ public:
+  SpillWriter(BufferPoolManager*, size_t entry_size);
+
+  // Entries of one page, 0 if they are too large for a page
+  static size_t EntriesPerPage(size_t entry_size);
+
+  void Append(const char* entry);
+  size_t GetEntryCount() const;
+  std::vector<PageId_t> Finish();
+
+ private:
+  void FinishPage_();
+
+  BufferPoolManager* bpm_;
+  size_t entry_size_;
+  size_t entries_per_page_;
+  std::optional<WritePageGuard> guard_;
+  uint32_t rows_{0};
+  size_t count_{0};
+  std::vector<PageId_t> pages_;
+};
+
+// Reads the entries of spilled pages in order. Pages are read ahead and
+// deleted once read, pages left unread are deleted with the reader.
+class SpillReader {
+ public:
+  SpillReader(BufferPoolManager*, size_t entry_size,
+              std::vector<PageId_t> pages);
+  ~SpillReader();
+  SpillReader(const SpillReader&) = delete;
+  SpillReader& operator=(const SpillReader&) = delete;
+
+  // nullptr once all entries were read
+  const char* Peek() const {
+    return guard_.has_value()
+               ? guard_->GetData() + PAGE_HEADER_SIZE + row_ * entry_size_
+               : nullptr;
+  }
+  void Advance();
+
+  // Spilled pages start with their number of entries
+  static constexpr size_t PAGE_HEADER_SIZE = 8;
+
+ private:
+  void LoadPage_();
+
+  BufferPoolManager* bpm_;
+  size_t entry_size_;
+  std::vector<PageId_t> pages_;
+  size_t page_{0};
+  std::optional<ReadPageGuard> guard_;
+  uint32_t row_{0};
+  uint32_t rows_{0};
+};
+
+#endif
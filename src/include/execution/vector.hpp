@@ -0,0 +1,84 @@
+#ifndef _VECTOR_HPP_
+#define _VECTOR_HPP_
+
+#include <storage/table/schema.hpp>
+
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+// Rows per batch, a batch of a few columns stays in the L1 and L2 caches
+const size_t VECTOR_SIZE = 1024;
+
+// Whether T is how columns of the type are stored in memory
+template <typename T>
+constexpr bool IsStorageType(TypeId type) {
+  if constexpr (std::is_same_v<T, int32_t>) {
+    return type == TypeId::Int32 || type == TypeId::Date;
+  } else if constexpr (std::is_same_v<T, int64_t>) {
+    return type == TypeId::Int64;
+  } else if constexpr (std::is_same_v<T, double>) {
+    return type == TypeId::Float64;
+  } else {
+    return false;
+  }
+}
+
+// Up to VECTOR_SIZE values of one fixed width column, stored as an array
+class ColumnVector {
+ public:
+  explicit ColumnVector(const Column&);
+
+  TypeId GetType() const;
+  size_t GetWidth() const;
+  char* GetData();
+  const char* GetData() const;
+
+  template <typename T>
+  T* Data() {
+    return reinterpret_cast<T*>(GetData());
+  }
+  template <typename T>
+  const T* Data() const {
+    return reinterpret_cast<const T*>(GetData());
+  }
+
+ private:
+  TypeId type_;
+  size_t width_;
+  // 8 byte words keep every value naturally aligned
+  std::vector<uint64_t> data_;
+};
+
+// Rows exchanged between vectorized operators, one vector per column. Rows
+// removed by a filter stay in the vectors, the selection vector lists the
+// rows still alive in increasing order. An unfiltered batch selects all rows.
+class Batch {
+ public:
+  explicit Batch(const std::vector<Column>&);
+
+  size_t GetColumnCount() const;
+  ColumnVector& GetColumn(size_t);
+  const ColumnVector& GetColumn(size_t) const;
+
+  size_t GetSize() const;
+  // Sets the number of rows and selects all of them
+  void SetSize(size_t);
+
+  bool IsFiltered() const;
+  size_t GetSelectedCount() const;
+  const uint32_t* GetSelection() const;
+  // Scratch space for a new selection, committed by SetSelection
+  uint32_t* GetSelectionBuffer();
+  void SetSelection(size_t count);
+
+ private:
+  std::vector<ColumnVector> columns_;
+  size_t size_{0};
+  bool filtered_{false};
+  size_t selected_{0};
+  std::vector<uint32_t> selection_;
+  std::vector<uint32_t> selection_buffer_;
+};
+
+#endif
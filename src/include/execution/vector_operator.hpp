@@ -0,0 +1,21 @@
+#ifndef _VECTOR_OPERATOR_HPP_
+#define _VECTOR_OPERATOR_HPP_
+
+#include <execution/vector.hpp>
+#include <storage/table/schema.hpp>
+
+#include <vector>
+
+// Pull based operator of the vectorized executor. A pipeline shares one
+// batch built from the columns of its last operator: Next fills the first
+// columns with those of the child and appends its own after them.
+class VectorOperator {
+ public:
+  virtual ~VectorOperator() = default;
+
+  virtual const std::vector<Column>& GetColumns() const = 0;
+  // Returns false once exhausted, a returned batch has selected rows
+  virtual bool Next(Batch&) = 0;
+};
+
+#endif
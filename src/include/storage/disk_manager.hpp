@@ -2,47 +2,130 @@
 #define _DISK_MANAGER_HPP_
 
 #include <config.hpp>
+#include <storage/page_size.hpp>
+
 #include <filesystem>
 #include <fstream>
 #include <future>
 #include <mutex>
+#include <optional>
 #include <unordered_map>
-#include <list>
+#include <utility>
+#include <vector>
+
+// Pages DiskManager::Compact moves per hold of the file lock
+const size_t COMPACTION_BATCH_PAGES = 64;
+
+// Outcome of a compaction of the db file, bytes reclaimed are the drop in
+// file size plus the bytes punched
+struct CompactionResult {
+  size_t pages_moved{0};
+  // Bytes read and written to move pages
+  size_t bytes_copied{0};
+  size_t file_size_before{0};
+  size_t file_size_after{0};
+  // Free slots left inside the file whose disk space was released
+  size_t bytes_punched{0};
+};
 
+// Db files start with a header slot that records their page size. The page
+// size given applies to a new file, an existing one keeps its own. A file
+// without a log only holds pages, it has no log and no scratch file either.
 class DiskManager {
  public:
-  DiskManager(const std::filesystem::path&);
+  DiskManager(const std::filesystem::path&, size_t page_size = DB_PAGE_SIZE,
+              bool has_log = true);
   DiskManager() = default;
+  virtual ~DiskManager() = default;
 
-  void ShutDown();
+  virtual void ShutDown();
 
   virtual void WritePage(PageId_t, const char*);
   virtual void ReadPage(PageId_t, char*);
   virtual void DeletePage(PageId_t);
+  // Places the pages [first_page_id, first_page_id + count) in adjacent
+  // slots before they are first written and preallocates the slots, so the
+  // pages are read back with large sequential reads. The owner is the first
+  // page id of the object the extent belongs to, INVALID_PAGE_ID for its
+  // first extent.
+  virtual void AllocateExtent(PageId_t first_page_id, size_t count,
+                              PageId_t owner = INVALID_PAGE_ID);
+  // Writes a batch of pages sorted by file offset, merging pages that sit in
+  // adjacent slots into a single write. The stream is flushed once at the end.
+  virtual void WritePages(const std::vector<std::pair<PageId_t, const char*>>&);
+  // Durability barrier, flushes the stream and fsyncs the db file.
+  virtual void Sync();
+  // Online compaction: moves the pages in the highest slots into the lowest
+  // free slots, at most max_pages of them and at most pages_per_second (0 for
+  // no limit), then truncates the file after the last used slot and punches
+  // holes into the free slots left below it. Pages are moved a batch at a
+  // time under the file lock, so concurrent reads and writes, including the
+  // write-back of pages resident in the buffer pool, always see the page
+  // where the map says it is.
+  virtual CompactionResult Compact(size_t max_pages = SIZE_MAX,
+                                   size_t pages_per_second = 0);
+
+  // Temporary pages live in a scratch file next to the log, created on the
+  // first write. Slots are handed out sequentially and the file is emptied
+  // once it holds no pages, it is removed at shutdown.
+  virtual void WriteTempPage(PageId_t, const char*);
+  virtual void ReadTempPage(PageId_t, char*);
+  virtual void DeleteTempPage(PageId_t);
 
-  void WriteLog(char*, int);
-  void ReadLog(char*, int, int);
+  void WriteLog(char*, size_t);
+  // Reads size bytes at offset of the log, past its end reads zeros
+  void ReadLog(char*, size_t size, size_t offset);
   int GetNumFlushes() const;
   bool GetFlushState() const;
   int GetNumWrites() const;
+  int GetNumReads() const;
   int GetNumDeletes() const;
+  int GetNumTempWrites() const;
 
   void SetFlushLogFuture(std::future<void>*);
   bool HasFlushLogFuture();
   std::filesystem::path GetLogFileName() const;
 
+  size_t GetPageSize() const;
   size_t GetDbFileSize();
+  // Byte offset of the page's slot, nullopt if it has none
+  virtual std::optional<size_t> GetPageOffset(PageId_t);
+  // Files whose I/O is independent, the disk scheduler gives each its own
+  // queue
+  virtual size_t GetFileCount() const;
+  // File in [0, GetFileCount()) that holds the page
+  virtual size_t GetFile(PageId_t) const;
 
  protected:
   int num_flushes_{0};
   int num_writes_{0};
+  int num_reads_{0};
   int num_deletes_{0};
+  int num_temp_writes_{0};
 
   size_t page_capacity_{DEFAULT_DB_IO_SIZE};
+  size_t page_size_{DB_PAGE_SIZE};
 
  private:
-  int GetFileSize(const std::string&);
+  // Size of the file, nullopt if it can't be stat'ed
+  std::optional<size_t> GetFileSize(const std::filesystem::path&);
+  // False if the file has no valid header yet
+  bool ReadHeader_();
+  void WriteHeader_();
   size_t AllocatePage();
+  // Offset of the first of count adjacent free slots, taken first fit and
+  // at the end of the file if no run is long enough
+  size_t AllocateSlots_(size_t count);
+  void SetSlots_(size_t first_slot, size_t count, bool free);
+  bool IsFree_(size_t slot) const;
+  bool IsPunched_(size_t slot) const;
+  // First free slot at or after slot, num_slots_ if there is none
+  size_t NextFreeSlot_(size_t slot) const;
+  // False if the file system does not support the operation
+  bool Fallocate_(int mode, size_t offset, size_t length);
+  // Moves up to limit pages from the tail into lower free slots
+  size_t RelocateTail_(size_t limit, char* buffer);
+  void Shrink_(CompactionResult&);
 
   std::fstream log_io_;
   std::filesystem::path log_file_name_;
@@ -51,7 +134,18 @@ class DiskManager {
   std::filesystem::path db_file_name_;
 
   std::unordered_map<PageId_t, size_t> pages_;
-  std::list<size_t> free_slots_;
+  // One bit per slot of the file, set while the slot is free. Slots past
+  // num_slots_ have never been handed out.
+  std::vector<uint64_t> free_slots_;
+  // Same layout, set for free slots whose space was already punched
+  std::vector<uint64_t> punched_slots_;
+  size_t num_slots_{0};
+
+  std::fstream temp_io_;
+  std::filesystem::path temp_file_name_;
+  std::unordered_map<PageId_t, size_t> temp_pages_;
+  size_t next_temp_slot_{0};
+  std::mutex temp_io_mutex_;
 
   bool flush_log_{false};
   std::future<void>* flush_log_f_{nullptr};
@@ -3,8 +3,10 @@
 
 #include <config.hpp>
 #include <storage/disk_manager.hpp>
+#include <storage/staging_buffer_pool.hpp>
 #include <utility/channel.hpp>
 
+#include <exception>
 #include <future>
 #include <memory>
 #include <optional>
@@ -18,22 +20,45 @@ struct DiskRequest {
   char* data;
   PageId_t page_id;
   DiskSchedulerPromise cb;
+  // Set when data points into the staging pool and is released after the write
+  bool is_staged{false};
+  // Temporary pages are read from and written to the scratch file
+  bool is_temp{false};
 };
 
+// Requests are queued per file of the disk manager and each queue has its own
+// worker thread, so files on different devices are served in parallel. The
+// requests for a page always go to the same queue and stay in order.
 class DiskScheduler {
  public:
   DiskScheduler(DiskManager*);
   ~DiskScheduler();
 
   void Schedule(std::vector<DiskRequest>&);
-  void StartWorkerThread();
+  // Copies the page image into a staging buffer and schedules its write, the
+  // caller may modify the source as soon as this returns.
+  std::future<bool> ScheduleWriteCopy(PageId_t, const char*,
+                                      bool is_temp = false);
+  // Number of queues, requests in different queues run concurrently
+  size_t GetQueueCount() const;
+  void StartWorkerThread(size_t queue);
   DiskSchedulerPromise CreatePromise();
+  void AllocateExtent(PageId_t, size_t, PageId_t owner = INVALID_PAGE_ID);
   void DeallocatePage(PageId_t);
+  void DeallocateTempPage(PageId_t);
+  void Sync();
 
  private:
+  void ProcessWrites_(std::vector<DiskRequest*>&);
+  void Finish_(DiskRequest&, std::exception_ptr);
+  // Queue of the file the request goes to, temporary pages go to the first
+  void Put_(DiskRequest);
+
   DiskManager* disk_manager_;
-  Channel<std::optional<DiskRequest>> request_q_;
-  std::optional<std::thread> worker_thread_;
+  StagingBufferPool staging_buffers_;
+  std::vector<std::unique_ptr<Channel<std::optional<DiskRequest>>>>
+      request_qs_;
+  std::vector<std::thread> worker_threads_;
   bool end_thread_{true};
 };
 
@@ -0,0 +1,37 @@
+#ifndef _FILE_IO_HPP_
+#define _FILE_IO_HPP_
+
+#include <unistd.h>
+#include <cstring>
+#include <stdexcept>
+
+inline void WriteFully(int fd, const char* data, size_t size, size_t offset) {
+  while (size > 0) {
+    ssize_t written = pwrite(fd, data, size, offset);
+    if (written <= 0) {
+      throw std::runtime_error("Error writing data to file");
+    }
+    data += written;
+    size -= written;
+    offset += written;
+  }
+}
+
+// Bytes past the end of the file read as zeros
+inline void ReadFully(int fd, char* buffer, size_t size, size_t offset) {
+  while (size > 0) {
+    ssize_t read_count = pread(fd, buffer, size, offset);
+    if (read_count < 0) {
+      throw std::runtime_error("Error reading data from file");
+    }
+    if (read_count == 0) {
+      memset(buffer, 0, size);
+      return;
+    }
+    buffer += read_count;
+    size -= read_count;
+    offset += read_count;
+  }
+}
+
+#endif
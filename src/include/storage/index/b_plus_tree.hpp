@@ -0,0 +1,682 @@
+#ifndef _B_PLUS_TREE_HPP_
+#define _B_PLUS_TREE_HPP_
+
+#include <buffer/buffer_pool_manager.hpp>
+#include <storage/index/b_plus_tree_iterator.hpp>
+#include <storage/page/b_plus_tree_internal_page.hpp>
+#include <storage/page/b_plus_tree_leaf_page.hpp>
+#include <storage/page/b_plus_tree_page.hpp>
+#include <utility/parallel_sort.hpp>
+
+#include <algorithm>
+#include <deque>
+#include <functional>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// Disk resident B+ tree with unique keys. Nodes live in buffer pool pages and
+// the root page id is kept in a separate header page. Concurrency is handled
+// with latch crabbing: writers first descend with read latches and only latch
+// the leaf for writing, restarting with write latches from the header page
+// when the leaf would split or underflow. By default the descent to the leaf
+// uses optimistic lock coupling instead of read latches on inner nodes.
+template <typename Key, typename Value, typename Comparator = std::less<Key>>
+class BPlusTree {
+  using LeafPage = BPlusTreeLeafPage<Key, Value>;
+  using InternalPage = BPlusTreeInternalPage<Key>;
+
+ public:
+  using Iterator = BPlusTreeIterator<Key, Value>;
+
+  BPlusTree(PageId_t header_page_id, BufferPoolManager* bpm,
+            const Comparator& comparator = Comparator(),
+            int leaf_max_size = LeafPage::CAPACITY - 1,
+            int internal_max_size = InternalPage::CAPACITY - 1)
+      : header_page_id_(header_page_id),
+        bpm_(bpm),
+        comparator_(comparator),
+        leaf_max_size_(leaf_max_size),
+        internal_max_size_(internal_max_size) {
+    RequireDefaultPageSize(bpm_->GetPageSize(), "B+ tree");
+    if (leaf_max_size_ < 2 || leaf_max_size_ > LeafPage::CAPACITY - 1) {
+      throw std::runtime_error("Invalid B+ tree leaf max size");
+    }
+    if (internal_max_size_ < 3 ||
+        internal_max_size_ > InternalPage::CAPACITY - 1) {
+      throw std::runtime_error("Invalid B+ tree internal max size");
+    }
+
+    auto guard = bpm_->WritePage(header_page_id_, AccessType::Index);
+    guard.template AsMut<BPlusTreeHeaderPage>()->root_page_id_ =
+        INVALID_PAGE_ID;
+  }
+
+  bool IsEmpty() { return GetRootPageId() == INVALID_PAGE_ID; }
+
+  // Switches between optimistic lock coupling and read latch crabbing for
+  // the inner nodes of a descent, not safe while the tree is in use
+  void SetOptimisticReads(bool enabled) { optimistic_reads_ = enabled; }
+
+  PageId_t GetRootPageId() {
+    auto guard = bpm_->ReadPage(header_page_id_, AccessType::Index);
+    return guard.template As<BPlusTreeHeaderPage>()->root_page_id_;
+  }
+
+  std::optional<Value> GetValue(const Key& key) {
+    auto guard = FindLeaf_(key);
+    if (!guard.has_value()) {
+      return std::nullopt;
+    }
+
+    const auto* leaf = guard->template As<LeafPage>();
+    int index = leaf->LowerBound(key, comparator_);
+    if (index < leaf->GetSize() && Equal_(leaf->KeyAt(index), key)) {
+      return leaf->ValueAt(index);
+    }
+    return std::nullopt;
+  }
+
+  // Returns false if the key is already present
+  bool Insert(const Key& key, const Value& value) {
+    auto done = InsertOptimistic_(key, value);
+    if (done.has_value()) {
+      return done.value();
+    }
+    return InsertPessimistic_(key, value);
+  }
+
+  void Remove(const Key& key) {
+    if (RemoveOptimistic_(key)) {
+      return;
+    }
+    RemovePessimistic_(key);
+  }
+
+  Iterator Begin() {
+    auto guard = bpm_->ReadPage(header_page_id_, AccessType::Index);
+    PageId_t page_id = guard.template As<BPlusTreeHeaderPage>()->root_page_id_;
+    if (page_id == INVALID_PAGE_ID) {
+      return Iterator();
+    }
+
+    guard = bpm_->ReadPage(page_id, AccessType::Index);
+    while (!guard.template As<BPlusTreePage>()->IsLeaf()) {
+      page_id = guard.template As<InternalPage>()->ValueAt(0);
+      guard = bpm_->ReadPage(page_id, AccessType::Index);
+    }
+    return Iterator(bpm_, std::move(guard), 0);
+  }
+
+  // Iterator positioned at the first key that is not less than key
+  Iterator Begin(const Key& key) {
+    auto guard = FindLeaf_(key);
+    if (!guard.has_value()) {
+      return Iterator();
+    }
+    int index = guard->template As<LeafPage>()->LowerBound(key, comparator_);
+    return Iterator(bpm_, std::move(guard).value(), index);
+  }
+
+  Iterator End() { return Iterator(); }
+
+  // Builds an empty tree bottom up from unsorted entries. The entries are
+  // sorted on num_threads threads, then leaves and inner levels are filled to
+  // fill_factor of their max size and written once each to freshly allocated
+  // pages. For duplicate keys the first entry wins. Returns false if the tree
+  // is not empty.
+  bool BulkLoad(std::vector<std::pair<Key, Value>> entries,
+                double fill_factor = 1.0,
+                size_t num_threads = std::thread::hardware_concurrency()) {
+    if (fill_factor <= 0 || fill_factor > 1) {
+      throw std::runtime_error("Invalid B+ tree fill factor");
+    }
+    if (!IsEmpty()) {
+      return false;
+    }
+
+    auto less = [this](const auto& a, const auto& b) {
+      return comparator_(a.first, b.first);
+    };
+    auto equal = [this](const auto& a, const auto& b) {
+      return Equal_(a.first, b.first);
+    };
+    ParallelSort(entries.begin(), entries.end(), less, num_threads);
+    entries.erase(std::unique(entries.begin(), entries.end(), equal),
+                  entries.end());
+
+    // The header stays latched so no insert can race with the build
+    auto header = bpm_->WritePage(header_page_id_, AccessType::Index);
+    if (header.template As<BPlusTreeHeaderPage>()->root_page_id_ !=
+        INVALID_PAGE_ID) {
+      return false;
+    }
+    if (entries.empty()) {
+      return true;
+    }
+
+    // Lowest key and page id of every node on the level built last. Pages are
+    // only touched once, so they stay in the replacer's recency list.
+    std::vector<std::pair<Key, PageId_t>> level;
+    auto sizes = NodeSizes_(entries.size(), leaf_max_size_,
+                            leaf_max_size_ / 2, fill_factor);
+    // Leaves are one extent, so range scans read them sequentially
+    std::vector<PageId_t> leaf_ids(sizes.size());
+    PageId_t first_leaf_id = bpm_->NewPages(sizes.size());
+    for (size_t i = 0; i < leaf_ids.size(); i++) {
+      leaf_ids[i] = first_leaf_id + i;
+    }
+
+    size_t pos = 0;
+    for (size_t i = 0; i < sizes.size(); i++) {
+      auto guard = bpm_->WritePage(leaf_ids[i], AccessType::Scan);
+      auto* leaf = guard.template AsMut<LeafPage>();
+      leaf->Init(leaf_max_size_);
+      if (i + 1 < leaf_ids.size()) {
+        leaf->SetNextPageId(leaf_ids[i + 1]);
+      }
+      level.emplace_back(entries[pos].first, leaf_ids[i]);
+      for (int j = 0; j < sizes[i]; j++, pos++) {
+        leaf->Append(entries[pos].first, entries[pos].second);
+      }
+    }
+
+    while (level.size() > 1) {
+      sizes = NodeSizes_(level.size(), internal_max_size_,
+                         (internal_max_size_ + 1) / 2, fill_factor);
+      std::vector<std::pair<Key, PageId_t>> parents;
+      pos = 0;
+      for (int size : sizes) {
+        PageId_t page_id = bpm_->NewPage();
+        auto guard = bpm_->WritePage(page_id, AccessType::Scan);
+        auto* node = guard.template AsMut<InternalPage>();
+        node->Init(internal_max_size_);
+        parents.emplace_back(level[pos].first, page_id);
+        for (int j = 0; j < size; j++, pos++) {
+          node->Append(level[pos].first, level[pos].second);
+        }
+      }
+      level = std::move(parents);
+    }
+
+    header.template AsMut<BPlusTreeHeaderPage>()->root_page_id_ =
+        level.front().second;
+    return true;
+  }
+
+ private:
+  struct Context {
+    std::optional<WritePageGuard> header_;
+    std::deque<WritePageGuard> write_set_;
+  };
+
+  // Splits count entries into nodes of fill_factor * max_size entries. A short
+  // last node is merged into or balanced with its left neighbour so that
+  // every node but a lone root holds at least min_size entries.
+  static std::vector<int> NodeSizes_(size_t count, int max_size, int min_size,
+                                     double fill_factor) {
+    int per_node = std::clamp(static_cast<int>(max_size * fill_factor),
+                              std::max(min_size, 2), max_size);
+    std::vector<int> sizes(count / per_node, per_node);
+    int rest = count % per_node;
+    if (rest == 0) {
+      return sizes;
+    }
+
+    if (sizes.empty() || rest >= min_size) {
+      sizes.push_back(rest);
+    } else if (per_node + rest <= max_size) {
+      sizes.back() += rest;
+    } else {
+      int both = per_node + rest;
+      sizes.back() = both / 2;
+      sizes.push_back(both - both / 2);
+    }
+    return sizes;
+  }
+
+  bool Equal_(const Key& a, const Key& b) const {
+    return !comparator_(a, b) && !comparator_(b, a);
+  }
+
+  // Optimistic descents tried before falling back to latch crabbing
+  static constexpr int OPTIMISTIC_ATTEMPTS = 4;
+
+  // Optimistic lock coupling: inner nodes are read without latches or pins
+  // and checked against their frame version, only the leaf is latched. A
+  // leaf is only split or merged together with its parent, so validating the
+  // parent after latching the leaf proves it is still the right one. Returns
+  // false when a version changed and the descent has to restart, leaf stays
+  // empty if the tree is empty.
+  template <typename Guard, typename Latch>
+  bool FindLeafOptimistic_(const Key& key, Latch latch,
+                           std::optional<Guard>& leaf, bool& is_root) {
+    auto header = OptimisticRead_(header_page_id_);
+    if (!header.has_value()) {
+      return false;
+    }
+    OptimisticPageGuard parent = header.value();
+    PageId_t page_id =
+        parent.template As<BPlusTreeHeaderPage>()->root_page_id_;
+    if (!parent.Validate()) {
+      return false;
+    }
+    if (page_id == INVALID_PAGE_ID) {
+      leaf.reset();
+      return true;
+    }
+
+    is_root = true;
+    while (true) {
+      // The parent is validated after the child's version is taken, so the
+      // child cannot have split between reading its id and reading it
+      auto read = OptimisticRead_(page_id);
+      if (!read.has_value() || !parent.Validate()) {
+        return false;
+      }
+      OptimisticPageGuard node = read.value();
+      const auto* page = node.template As<InternalPage>();
+      bool is_leaf = page->IsLeaf();
+      int size = page->GetSize();
+      if (!node.Validate()) {
+        return false;
+      }
+
+      if (is_leaf) {
+        leaf = latch(page_id);
+        if (!leaf.has_value() || !parent.Validate()) {
+          leaf.reset();
+          return false;
+        }
+        return true;
+      }
+
+      page_id = page->ValueAt(page->ChildIndex(key, comparator_, size));
+      if (!node.Validate()) {
+        return false;
+      }
+      parent = node;
+      is_root = false;
+    }
+  }
+
+  // Empty if the page was deleted since its id was read
+  std::optional<OptimisticPageGuard> OptimisticRead_(PageId_t page_id) {
+    auto guard = bpm_->OptimisticReadPage(page_id);
+    if (guard.has_value()) {
+      return guard;
+    }
+    // Not resident or write latched, a latched read loads it or waits
+    auto latched = bpm_->CheckedReadPage(page_id, AccessType::Index);
+    if (!latched.has_value()) {
+      return std::nullopt;
+    }
+    return latched->Optimistic();
+  }
+
+  std::optional<ReadPageGuard> FindLeaf_(const Key& key) {
+    if (optimistic_reads_) {
+      std::optional<ReadPageGuard> leaf;
+      bool is_root;
+      auto latch = [this](PageId_t page_id) {
+        return bpm_->CheckedReadPage(page_id, AccessType::Index);
+      };
+      for (int i = 0; i < OPTIMISTIC_ATTEMPTS; i++) {
+        if (FindLeafOptimistic_(key, latch, leaf, is_root)) {
+          return leaf;
+        }
+      }
+    }
+
+    auto guard = bpm_->ReadPage(header_page_id_, AccessType::Index);
+    PageId_t page_id = guard.template As<BPlusTreeHeaderPage>()->root_page_id_;
+    if (page_id == INVALID_PAGE_ID) {
+      return std::nullopt;
+    }
+
+    guard = bpm_->ReadPage(page_id, AccessType::Index);
+    while (!guard.template As<BPlusTreePage>()->IsLeaf()) {
+      const auto* node = guard.template As<InternalPage>();
+      page_id = node->ValueAt(node->ChildIndex(key, comparator_));
+      guard = bpm_->ReadPage(page_id, AccessType::Index);
+    }
+    return std::optional<ReadPageGuard>(std::move(guard));
+  }
+
+  // Descends with read latches and write latches only the leaf, the parent's
+  // read latch is kept until then so the leaf cannot be split under us.
+  // Returns the leaf guard and whether the leaf is the root.
+  std::optional<std::pair<WritePageGuard, bool>> FindLeafForWrite_(
+      const Key& key) {
+    if (optimistic_reads_) {
+      std::optional<WritePageGuard> leaf;
+      bool is_root = false;
+      auto latch = [this](PageId_t page_id) {
+        return bpm_->CheckedWritePage(page_id, AccessType::Index);
+      };
+      for (int i = 0; i < OPTIMISTIC_ATTEMPTS; i++) {
+        if (FindLeafOptimistic_(key, latch, leaf, is_root)) {
+          if (!leaf.has_value()) {
+            return std::nullopt;
+          }
+          return std::make_pair(std::move(leaf).value(), is_root);
+        }
+      }
+    }
+
+    auto parent = bpm_->ReadPage(header_page_id_, AccessType::Index);
+    PageId_t page_id =
+        parent.template As<BPlusTreeHeaderPage>()->root_page_id_;
+    if (page_id == INVALID_PAGE_ID) {
+      return std::nullopt;
+    }
+
+    bool is_root = true;
+    while (true) {
+      auto guard = bpm_->ReadPage(page_id, AccessType::Index);
+      if (guard.template As<BPlusTreePage>()->IsLeaf()) {
+        guard.Drop();
+        auto leaf_guard = bpm_->WritePage(page_id, AccessType::Index);
+        parent.Drop();
+        return std::make_pair(std::move(leaf_guard), is_root);
+      }
+
+      const auto* node = guard.template As<InternalPage>();
+      page_id = node->ValueAt(node->ChildIndex(key, comparator_));
+      parent = std::move(guard);
+      is_root = false;
+    }
+  }
+
+  std::optional<bool> InsertOptimistic_(const Key& key, const Value& value) {
+    auto found = FindLeafForWrite_(key);
+    if (!found.has_value()) {
+      return std::nullopt;
+    }
+
+    auto& guard = found->first;
+    const auto* leaf = guard.template As<LeafPage>();
+    int index = leaf->LowerBound(key, comparator_);
+    if (index < leaf->GetSize() && Equal_(leaf->KeyAt(index), key)) {
+      return false;
+    }
+    if (leaf->GetSize() >= leaf->GetMaxSize()) {
+      return std::nullopt;
+    }
+
+    guard.template AsMut<LeafPage>()->InsertAt(index, key, value);
+    return true;
+  }
+
+  bool InsertPessimistic_(const Key& key, const Value& value) {
+    Context ctx;
+    ctx.header_ = bpm_->WritePage(header_page_id_, AccessType::Index);
+    PageId_t root_id =
+        ctx.header_->template As<BPlusTreeHeaderPage>()->root_page_id_;
+
+    if (root_id == INVALID_PAGE_ID) {
+      root_id = bpm_->NewPage();
+      auto root_guard = bpm_->WritePage(root_id, AccessType::Index);
+      auto* root = root_guard.template AsMut<LeafPage>();
+      root->Init(leaf_max_size_);
+      root->InsertAt(0, key, value);
+      ctx.header_->template AsMut<BPlusTreeHeaderPage>()->root_page_id_ =
+          root_id;
+      return true;
+    }
+
+    ctx.write_set_.push_back(bpm_->WritePage(root_id, AccessType::Index));
+    if (IsInsertSafe_(ctx.write_set_.back())) {
+      ctx.header_.reset();
+    }
+
+    while (!ctx.write_set_.back().template As<BPlusTreePage>()->IsLeaf()) {
+      const auto* node = ctx.write_set_.back().template As<InternalPage>();
+      PageId_t child_id = node->ValueAt(node->ChildIndex(key, comparator_));
+      auto child = bpm_->WritePage(child_id, AccessType::Index);
+      if (IsInsertSafe_(child)) {
+        ctx.header_.reset();
+        ctx.write_set_.clear();
+      }
+      ctx.write_set_.push_back(std::move(child));
+    }
+
+    const auto* leaf = ctx.write_set_.back().template As<LeafPage>();
+    int index = leaf->LowerBound(key, comparator_);
+    if (index < leaf->GetSize() && Equal_(leaf->KeyAt(index), key)) {
+      return false;
+    }
+
+    auto* mut_leaf = ctx.write_set_.back().template AsMut<LeafPage>();
+    mut_leaf->InsertAt(index, key, value);
+    if (mut_leaf->GetSize() <= mut_leaf->GetMaxSize()) {
+      return true;
+    }
+
+    PageId_t right_id = bpm_->NewPage();
+    auto right_guard = bpm_->WritePage(right_id, AccessType::Index);
+    auto* right = right_guard.template AsMut<LeafPage>();
+    right->Init(leaf_max_size_);
+    mut_leaf->MoveHalfTo(right);
+    right->SetNextPageId(mut_leaf->GetNextPageId());
+    mut_leaf->SetNextPageId(right_id);
+
+    InsertIntoParent_(ctx, right->KeyAt(0), right_id);
+    return true;
+  }
+
+  // The page at the back of the write set was split, key separates it from
+  // its new right sibling.
+  void InsertIntoParent_(Context& ctx, const Key& key, PageId_t right_id) {
+    PageId_t left_id = ctx.write_set_.back().GetPageId();
+    ctx.write_set_.pop_back();
+
+    if (ctx.write_set_.empty()) {
+      PageId_t root_id = bpm_->NewPage();
+      auto root_guard = bpm_->WritePage(root_id, AccessType::Index);
+      auto* root = root_guard.template AsMut<InternalPage>();
+      root->Init(internal_max_size_);
+      root->PopulateNewRoot(left_id, key, right_id);
+      ctx.header_->template AsMut<BPlusTreeHeaderPage>()->root_page_id_ =
+          root_id;
+      return;
+    }
+
+    auto* parent = ctx.write_set_.back().template AsMut<InternalPage>();
+    parent->InsertAt(parent->ValueIndex(left_id) + 1, key, right_id);
+    if (parent->GetSize() <= parent->GetMaxSize()) {
+      return;
+    }
+
+    PageId_t sibling_id = bpm_->NewPage();
+    auto sibling_guard = bpm_->WritePage(sibling_id, AccessType::Index);
+    auto* sibling = sibling_guard.template AsMut<InternalPage>();
+    sibling->Init(internal_max_size_);
+    Key middle = parent->MoveHalfTo(sibling);
+    InsertIntoParent_(ctx, middle, sibling_id);
+  }
+
+  bool IsInsertSafe_(const WritePageGuard& guard) const {
+    const auto* page = guard.template As<BPlusTreePage>();
+    return page->GetSize() < page->GetMaxSize();
+  }
+
+  bool IsRemoveSafe_(const WritePageGuard& guard, bool is_root) const {
+    const auto* page = guard.template As<BPlusTreePage>();
+    if (is_root) {
+      return page->GetSize() > (page->IsLeaf() ? 1 : 2);
+    }
+    return page->GetSize() > page->GetMinSize();
+  }
+
+  // Returns true if the remove was completed without restructuring the tree
+  bool RemoveOptimistic_(const Key& key) {
+    auto found = FindLeafForWrite_(key);
+    if (!found.has_value()) {
+      return true;
+    }
+
+    auto& [guard, is_root] = found.value();
+    const auto* leaf = guard.template As<LeafPage>();
+    int index = leaf->LowerBound(key, comparator_);
+    if (index >= leaf->GetSize() || !Equal_(leaf->KeyAt(index), key)) {
+      return true;
+    }
+    if (!IsRemoveSafe_(guard, is_root)) {
+      return false;
+    }
+
+    guard.template AsMut<LeafPage>()->RemoveAt(index);
+    return true;
+  }
+
+  void RemovePessimistic_(const Key& key) {
+    Context ctx;
+    ctx.header_ = bpm_->WritePage(header_page_id_, AccessType::Index);
+    PageId_t root_id =
+        ctx.header_->template As<BPlusTreeHeaderPage>()->root_page_id_;
+    if (root_id == INVALID_PAGE_ID) {
+      return;
+    }
+
+    ctx.write_set_.push_back(bpm_->WritePage(root_id, AccessType::Index));
+    if (IsRemoveSafe_(ctx.write_set_.back(), true)) {
+      ctx.header_.reset();
+    }
+
+    while (!ctx.write_set_.back().template As<BPlusTreePage>()->IsLeaf()) {
+      const auto* node = ctx.write_set_.back().template As<InternalPage>();
+      PageId_t child_id = node->ValueAt(node->ChildIndex(key, comparator_));
+      auto child = bpm_->WritePage(child_id, AccessType::Index);
+      if (IsRemoveSafe_(child, false)) {
+        ctx.header_.reset();
+        ctx.write_set_.clear();
+      }
+      ctx.write_set_.push_back(std::move(child));
+    }
+
+    const auto* leaf = ctx.write_set_.back().template As<LeafPage>();
+    int index = leaf->LowerBound(key, comparator_);
+    if (index >= leaf->GetSize() || !Equal_(leaf->KeyAt(index), key)) {
+      return;
+    }
+
+    ctx.write_set_.back().template AsMut<LeafPage>()->RemoveAt(index);
+    HandleUnderflow_(ctx);
+  }
+
+  // Fixes the page at the back of the write set after it lost an entry
+  void HandleUnderflow_(Context& ctx) {
+    auto& guard = ctx.write_set_.back();
+    const auto* page = guard.template As<BPlusTreePage>();
+
+    if (ctx.write_set_.size() == 1) {
+      if (!ctx.header_.has_value()) {
+        return;
+      }
+
+      // The page is the root, drop it once it becomes empty or has a single
+      // child left.
+      PageId_t root_id = guard.GetPageId();
+      PageId_t new_root_id;
+      if (page->IsLeaf() && page->GetSize() == 0) {
+        new_root_id = INVALID_PAGE_ID;
+      } else if (!page->IsLeaf() && page->GetSize() == 1) {
+        new_root_id = guard.template As<InternalPage>()->ValueAt(0);
+      } else {
+        return;
+      }
+
+      ctx.header_->template AsMut<BPlusTreeHeaderPage>()->root_page_id_ =
+          new_root_id;
+      ctx.write_set_.pop_back();
+      bpm_->DeletePage(root_id);
+      return;
+    }
+
+    if (page->GetSize() >= page->GetMinSize()) {
+      return;
+    }
+
+    PageId_t page_id = guard.GetPageId();
+    const auto* parent =
+        ctx.write_set_[ctx.write_set_.size() - 2].template As<InternalPage>();
+    int index = parent->ValueIndex(page_id);
+
+    // Siblings are always latched left to right, which is the order iterators
+    // use. The page itself is unlatched for a moment when its left sibling is
+    // needed, the parent's write latch keeps other writers away meanwhile.
+    if (index > 0) {
+      PageId_t left_id = parent->ValueAt(index - 1);
+      ctx.write_set_.pop_back();
+      auto left_guard = bpm_->WritePage(left_id, AccessType::Index);
+      auto right_guard = bpm_->WritePage(page_id, AccessType::Index);
+      MergeOrRedistribute_(ctx, left_guard, right_guard, index);
+    } else {
+      PageId_t right_id = parent->ValueAt(1);
+      auto left_guard = std::move(ctx.write_set_.back());
+      ctx.write_set_.pop_back();
+      auto right_guard = bpm_->WritePage(right_id, AccessType::Index);
+      MergeOrRedistribute_(ctx, left_guard, right_guard, 1);
+    }
+  }
+
+  // right_index is the position of the right page in the parent, which is at
+  // the back of the write set.
+  void MergeOrRedistribute_(Context& ctx, WritePageGuard& left_guard,
+                            WritePageGuard& right_guard, int right_index) {
+    auto* parent = ctx.write_set_.back().template AsMut<InternalPage>();
+    PageId_t right_id = right_guard.GetPageId();
+
+    if (left_guard.template As<BPlusTreePage>()->IsLeaf()) {
+      auto* left = left_guard.template AsMut<LeafPage>();
+      auto* right = right_guard.template AsMut<LeafPage>();
+
+      if (left->GetSize() + right->GetSize() <= left->GetMaxSize()) {
+        right->MoveAllTo(left);
+        left->SetNextPageId(right->GetNextPageId());
+        parent->RemoveAt(right_index);
+      } else {
+        if (left->GetSize() < right->GetSize()) {
+          right->MoveFirstToEndOf(left);
+        } else {
+          left->MoveLastToFrontOf(right);
+        }
+        parent->SetKeyAt(right_index, right->KeyAt(0));
+        return;
+      }
+    } else {
+      auto* left = left_guard.template AsMut<InternalPage>();
+      auto* right = right_guard.template AsMut<InternalPage>();
+      Key middle = parent->KeyAt(right_index);
+
+      if (left->GetSize() + right->GetSize() <= left->GetMaxSize()) {
+        right->MoveAllTo(left, middle);
+        parent->RemoveAt(right_index);
+      } else {
+        if (left->GetSize() < right->GetSize()) {
+          parent->SetKeyAt(right_index, right->MoveFirstToEndOf(left, middle));
+        } else {
+          parent->SetKeyAt(right_index, left->MoveLastToFrontOf(right, middle));
+        }
+        return;
+      }
+    }
+
+    right_guard.Drop();
+    left_guard.Drop();
+    bpm_->DeletePage(right_id);
+    HandleUnderflow_(ctx);
+  }
+
+  const PageId_t header_page_id_;
+  BufferPoolManager* bpm_;
+  Comparator comparator_;
+  const int leaf_max_size_;
+  const int internal_max_size_;
+  bool optimistic_reads_{true};
+};
+
+#endif
@@ -0,0 +1,82 @@
+#ifndef _B_PLUS_TREE_ITERATOR_HPP_
+#define _B_PLUS_TREE_ITERATOR_HPP_
+
+#include <buffer/buffer_pool_manager.hpp>
+#include <storage/page/b_plus_tree_leaf_page.hpp>
+
+#include <optional>
+#include <utility>
+
+// Forward iterator over the leaf level. It keeps a read latch on the current
+// leaf and latches the next leaf before releasing the current one, so the
+// owning thread must not modify the tree while the iterator is alive.
+template <typename Key, typename Value>
+class BPlusTreeIterator {
+  using LeafPage = BPlusTreeLeafPage<Key, Value>;
+
+ public:
+  BPlusTreeIterator() = default;
+  BPlusTreeIterator(BufferPoolManager* bpm, ReadPageGuard guard, int index)
+      : bpm_(bpm),
+        guard_(std::move(guard)),
+        page_id_(guard_->GetPageId()),
+        index_(index) {
+    SkipExhausted_();
+  }
+
+  bool IsEnd() const { return !guard_.has_value(); }
+
+  std::pair<Key, Value> operator*() const {
+    const auto* leaf = guard_->As<LeafPage>();
+    return {leaf->KeyAt(index_), leaf->ValueAt(index_)};
+  }
+
+  const Key& GetKey() const {
+    return guard_->As<LeafPage>()->KeyAt(index_);
+  }
+
+  const Value& GetValue() const {
+    return guard_->As<LeafPage>()->ValueAt(index_);
+  }
+
+  BPlusTreeIterator& operator++() {
+    index_++;
+    SkipExhausted_();
+    return *this;
+  }
+
+  bool operator==(const BPlusTreeIterator& other) const {
+    if (IsEnd() || other.IsEnd()) {
+      return IsEnd() == other.IsEnd();
+    }
+    return page_id_ == other.page_id_ && index_ == other.index_;
+  }
+
+  bool operator!=(const BPlusTreeIterator& other) const {
+    return !(*this == other);
+  }
+
+ private:
+  void SkipExhausted_() {
+    while (guard_.has_value() &&
+           index_ >= guard_->As<LeafPage>()->GetSize()) {
+      PageId_t next = guard_->As<LeafPage>()->GetNextPageId();
+      if (next == INVALID_PAGE_ID) {
+        guard_.reset();
+        page_id_ = INVALID_PAGE_ID;
+        index_ = 0;
+        return;
+      }
+      guard_ = bpm_->ReadPage(next, AccessType::Index);
+      page_id_ = next;
+      index_ = 0;
+    }
+  }
+
+  BufferPoolManager* bpm_{nullptr};
+  std::optional<ReadPageGuard> guard_;
+  PageId_t page_id_{INVALID_PAGE_ID};
+  int index_{0};
+};
+
+#endif
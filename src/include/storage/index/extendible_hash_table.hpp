@@ -0,0 +1,375 @@
+#ifndef _EXTENDIBLE_HASH_TABLE_HPP_
+#define _EXTENDIBLE_HASH_TABLE_HPP_
+
+#include <buffer/buffer_pool_manager.hpp>
+#include <storage/page/extendible_htable_bucket_page.hpp>
+#include <storage/page/extendible_htable_directory_page.hpp>
+#include <storage/page/extendible_htable_header_page.hpp>
+
+#include <atomic>
+#include <functional>
+#include <optional>
+#include <stdexcept>
+#include <vector>
+
+// Disk resident extendible hash table with unique keys. A header page points
+// to directory pages, which point to bucket pages. Lookups first try the
+// bucket remembered for the hash in an in-memory cache and only walk header
+// and directory when that bucket no longer covers the hash, so a lookup costs
+// a single page access in steady state. Merged buckets are deleted, a cached
+// id of a deleted bucket fails to load or no longer covers any hash.
+template <typename Key, typename Value, typename KeyEqual = std::equal_to<Key>,
+          typename Hasher = std::hash<Key>>
+class DiskExtendibleHashTable {
+  using BucketPage = ExtendibleHTableBucketPage<Key, Value>;
+
+ public:
+  DiskExtendibleHashTable(
+      PageId_t header_page_id, BufferPoolManager* bpm,
+      uint32_t header_max_depth = 2,
+      uint32_t directory_max_depth = HTABLE_DIRECTORY_MAX_DEPTH,
+      uint32_t bucket_max_size = BucketPage::CAPACITY,
+      const KeyEqual& key_equal = KeyEqual(), const Hasher& hasher = Hasher())
+      : header_page_id_(header_page_id),
+        bpm_(bpm),
+        header_max_depth_(header_max_depth),
+        directory_max_depth_(directory_max_depth),
+        bucket_max_size_(bucket_max_size),
+        key_equal_(key_equal),
+        hasher_(hasher),
+        bucket_cache_(size_t{1} << (header_max_depth + directory_max_depth)) {
+    RequireDefaultPageSize(bpm_->GetPageSize(), "Hash table");
+    if (bucket_max_size_ == 0 || bucket_max_size_ > BucketPage::CAPACITY) {
+      throw std::runtime_error("Invalid hash table bucket size");
+    }
+    if (directory_max_depth_ > HTABLE_DIRECTORY_MAX_DEPTH) {
+      throw std::runtime_error("Hash table directory depth too large");
+    }
+
+    for (auto& page_id : bucket_cache_) {
+      page_id.store(INVALID_PAGE_ID);
+    }
+
+    auto guard = bpm_->WritePage(header_page_id_, AccessType::Index);
+    guard.AsMut<ExtendibleHTableHeaderPage>()->Init(header_max_depth_);
+  }
+
+  std::optional<Value> GetValue(const Key& key) {
+    uint32_t hash = Hash_(key);
+    uint32_t directory_index = DirectoryIndex_(hash);
+    auto& cached = bucket_cache_[CacheSlot_(directory_index, hash)];
+
+    PageId_t bucket_id = cached.load(std::memory_order_acquire);
+    auto guard = bucket_id != INVALID_PAGE_ID
+                     ? bpm_->CheckedReadPage(bucket_id, AccessType::Index)
+                     : std::nullopt;
+    if (guard.has_value()) {
+      const auto* bucket = guard->template As<BucketPage>();
+      if (bucket->Covers(directory_index, hash)) {
+        return bucket->Lookup(key, key_equal_);
+      }
+      guard->Drop();
+    }
+
+    auto header_guard = bpm_->ReadPage(header_page_id_, AccessType::Index);
+    PageId_t directory_id = header_guard.As<ExtendibleHTableHeaderPage>()
+                                ->GetDirectoryPageId(directory_index);
+    if (directory_id == INVALID_PAGE_ID) {
+      return std::nullopt;
+    }
+
+    auto directory_guard = bpm_->ReadPage(directory_id, AccessType::Index);
+    header_guard.Drop();
+    const auto* directory =
+        directory_guard.As<ExtendibleHTableDirectoryPage>();
+    bucket_id =
+        directory->GetBucketPageId(directory->HashToBucketIndex(hash));
+
+    auto bucket_guard = bpm_->ReadPage(bucket_id, AccessType::Index);
+    directory_guard.Drop();
+    cached.store(bucket_id, std::memory_order_release);
+    return bucket_guard.template As<BucketPage>()->Lookup(key, key_equal_);
+  }
+
+  // Returns false if the key is already present or its bucket cannot be
+  // split any further.
+  bool Insert(const Key& key, const Value& value) {
+    auto done = InsertOptimistic_(key, value);
+    if (done.has_value()) {
+      return done.value();
+    }
+    return InsertPessimistic_(key, value);
+  }
+
+  // Returns false if the key was not present
+  bool Remove(const Key& key) {
+    auto done = RemoveOptimistic_(key);
+    if (done.has_value()) {
+      return done.value();
+    }
+    return RemovePessimistic_(key);
+  }
+
+  uint32_t GetGlobalDepth(uint32_t directory_index) {
+    auto header_guard = bpm_->ReadPage(header_page_id_, AccessType::Index);
+    PageId_t directory_id = header_guard.As<ExtendibleHTableHeaderPage>()
+                                ->GetDirectoryPageId(directory_index);
+    if (directory_id == INVALID_PAGE_ID) {
+      return 0;
+    }
+    auto directory_guard = bpm_->ReadPage(directory_id, AccessType::Index);
+    return directory_guard.As<ExtendibleHTableDirectoryPage>()
+        ->GetGlobalDepth();
+  }
+
+ private:
+  uint32_t Hash_(const Key& key) const {
+    // std::hash is the identity for integers, mix the bits so that both the
+    // top bits (header) and the low bits (directory) are spread.
+    uint64_t h = hasher_(key);
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return static_cast<uint32_t>(h);
+  }
+
+  uint32_t DirectoryIndex_(uint32_t hash) const {
+    if (header_max_depth_ == 0) {
+      return 0;
+    }
+    return hash >> (32 - header_max_depth_);
+  }
+
+  size_t CacheSlot_(uint32_t directory_index, uint32_t hash) const {
+    return (static_cast<size_t>(directory_index) << directory_max_depth_) |
+           (hash & ((1 << directory_max_depth_) - 1));
+  }
+
+  // Latches the bucket for the hash for writing while holding a read latch on
+  // its directory, nullopt if the directory does not exist yet.
+  std::optional<WritePageGuard> FindBucketForWrite_(uint32_t hash) {
+    auto header_guard = bpm_->ReadPage(header_page_id_, AccessType::Index);
+    PageId_t directory_id = header_guard.As<ExtendibleHTableHeaderPage>()
+                                ->GetDirectoryPageId(DirectoryIndex_(hash));
+    if (directory_id == INVALID_PAGE_ID) {
+      return std::nullopt;
+    }
+
+    auto directory_guard = bpm_->ReadPage(directory_id, AccessType::Index);
+    header_guard.Drop();
+    const auto* directory =
+        directory_guard.As<ExtendibleHTableDirectoryPage>();
+    PageId_t bucket_id =
+        directory->GetBucketPageId(directory->HashToBucketIndex(hash));
+    auto bucket_guard = bpm_->WritePage(bucket_id, AccessType::Index);
+    directory_guard.Drop();
+    return std::optional<WritePageGuard>(std::move(bucket_guard));
+  }
+
+  std::optional<bool> InsertOptimistic_(const Key& key, const Value& value) {
+    auto bucket_guard = FindBucketForWrite_(Hash_(key));
+    if (!bucket_guard.has_value()) {
+      return std::nullopt;
+    }
+
+    const auto* bucket = bucket_guard->template As<BucketPage>();
+    if (bucket->Contains(key, key_equal_)) {
+      return false;
+    }
+    if (bucket->IsFull()) {
+      return std::nullopt;
+    }
+    bucket_guard->template AsMut<BucketPage>()->Append(key, value);
+    return true;
+  }
+
+  bool InsertPessimistic_(const Key& key, const Value& value) {
+    uint32_t hash = Hash_(key);
+    uint32_t directory_index = DirectoryIndex_(hash);
+    PageId_t directory_id;
+    {
+      auto header_guard = bpm_->WritePage(header_page_id_, AccessType::Index);
+      directory_id = header_guard.As<ExtendibleHTableHeaderPage>()
+                         ->GetDirectoryPageId(directory_index);
+      if (directory_id == INVALID_PAGE_ID) {
+        directory_id = bpm_->NewPage();
+        PageId_t bucket_id = bpm_->NewPage();
+
+        auto directory_guard =
+            bpm_->WritePage(directory_id, AccessType::Index);
+        auto* directory =
+            directory_guard.AsMut<ExtendibleHTableDirectoryPage>();
+        directory->Init(directory_max_depth_);
+        directory->SetBucketPageId(0, bucket_id);
+
+        auto bucket_guard = bpm_->WritePage(bucket_id, AccessType::Index);
+        auto* bucket = bucket_guard.template AsMut<BucketPage>();
+        bucket->Init(bucket_max_size_);
+        bucket->SetCoverage(directory_index, 0, 0);
+
+        header_guard.AsMut<ExtendibleHTableHeaderPage>()->SetDirectoryPageId(
+            directory_index, directory_id);
+      }
+    }
+
+    auto directory_guard = bpm_->WritePage(directory_id, AccessType::Index);
+    auto* directory = directory_guard.AsMut<ExtendibleHTableDirectoryPage>();
+    uint32_t bucket_index = directory->HashToBucketIndex(hash);
+    auto bucket_guard = bpm_->WritePage(
+        directory->GetBucketPageId(bucket_index), AccessType::Index);
+    if (bucket_guard.template As<BucketPage>()->Contains(key, key_equal_)) {
+      return false;
+    }
+
+    while (bucket_guard.template As<BucketPage>()->IsFull()) {
+      uint32_t local_depth = directory->GetLocalDepth(bucket_index);
+      if (local_depth == directory->GetGlobalDepth()) {
+        if (local_depth == directory->GetMaxDepth()) {
+          return false;
+        }
+        directory->IncrGlobalDepth();
+        bucket_index = directory->HashToBucketIndex(hash);
+      }
+
+      PageId_t image_id = bpm_->NewPage();
+      auto image_guard = bpm_->WritePage(image_id, AccessType::Index);
+      auto* image = image_guard.template AsMut<BucketPage>();
+      auto* bucket = bucket_guard.template AsMut<BucketPage>();
+      image->Init(bucket_max_size_);
+
+      uint32_t high_bit = 1 << local_depth;
+      uint32_t low_bits = bucket_index & (high_bit - 1);
+      for (uint32_t i = 0; i < directory->Size(); i++) {
+        if ((i & (high_bit - 1)) != low_bits) {
+          continue;
+        }
+        directory->SetLocalDepth(i, local_depth + 1);
+        if (i & high_bit) {
+          directory->SetBucketPageId(i, image_id);
+        }
+      }
+      bucket->SetCoverage(directory_index, local_depth + 1, low_bits);
+      image->SetCoverage(directory_index, local_depth + 1, low_bits | high_bit);
+
+      for (uint32_t i = 0; i < bucket->Size();) {
+        if (Hash_(bucket->KeyAt(i)) & high_bit) {
+          image->Append(bucket->KeyAt(i), bucket->ValueAt(i));
+          bucket->RemoveAt(i);
+        } else {
+          i++;
+        }
+      }
+
+      if (hash & high_bit) {
+        bucket_guard = std::move(image_guard);
+      }
+      bucket_index = directory->HashToBucketIndex(hash);
+    }
+
+    bucket_guard.template AsMut<BucketPage>()->Append(key, value);
+    return true;
+  }
+
+  // nullopt when removing the key would empty a bucket that can be merged
+  std::optional<bool> RemoveOptimistic_(const Key& key) {
+    auto bucket_guard = FindBucketForWrite_(Hash_(key));
+    if (!bucket_guard.has_value()) {
+      return false;
+    }
+
+    const auto* bucket = bucket_guard->template As<BucketPage>();
+    if (!bucket->Contains(key, key_equal_)) {
+      return false;
+    }
+    if (bucket->Size() == 1) {
+      return std::nullopt;
+    }
+    bucket_guard->template AsMut<BucketPage>()->Remove(key, key_equal_);
+    return true;
+  }
+
+  bool RemovePessimistic_(const Key& key) {
+    uint32_t hash = Hash_(key);
+    uint32_t directory_index = DirectoryIndex_(hash);
+
+    auto header_guard = bpm_->ReadPage(header_page_id_, AccessType::Index);
+    PageId_t directory_id = header_guard.As<ExtendibleHTableHeaderPage>()
+                                ->GetDirectoryPageId(directory_index);
+    if (directory_id == INVALID_PAGE_ID) {
+      return false;
+    }
+    auto directory_guard = bpm_->WritePage(directory_id, AccessType::Index);
+    header_guard.Drop();
+
+    auto* directory = directory_guard.AsMut<ExtendibleHTableDirectoryPage>();
+    uint32_t bucket_index = directory->HashToBucketIndex(hash);
+    auto bucket_guard = bpm_->WritePage(
+        directory->GetBucketPageId(bucket_index), AccessType::Index);
+    if (!bucket_guard.template AsMut<BucketPage>()->Remove(key, key_equal_)) {
+      return false;
+    }
+
+    // Merge with the split image while one of the two is empty
+    while (true) {
+      uint32_t local_depth = directory->GetLocalDepth(bucket_index);
+      if (local_depth == 0) {
+        break;
+      }
+      uint32_t image_index = directory->GetSplitImageIndex(bucket_index);
+      if (directory->GetLocalDepth(image_index) != local_depth) {
+        break;
+      }
+
+      PageId_t bucket_id = bucket_guard.GetPageId();
+      PageId_t image_id = directory->GetBucketPageId(image_index);
+      auto image_guard = bpm_->WritePage(image_id, AccessType::Index);
+      bool bucket_empty = bucket_guard.template As<BucketPage>()->IsEmpty();
+      bool image_empty = image_guard.template As<BucketPage>()->IsEmpty();
+      if (!bucket_empty && !image_empty) {
+        break;
+      }
+
+      PageId_t dead_id = bucket_empty ? bucket_id : image_id;
+      PageId_t survivor_id = bucket_empty ? image_id : bucket_id;
+      auto& dead_guard = bucket_empty ? bucket_guard : image_guard;
+      auto& survivor_guard = bucket_empty ? image_guard : bucket_guard;
+
+      uint32_t merged_mask = (1 << (local_depth - 1)) - 1;
+      survivor_guard.template AsMut<BucketPage>()->SetCoverage(
+          directory_index, local_depth - 1, bucket_index);
+      dead_guard.template AsMut<BucketPage>()->MarkDead();
+      for (uint32_t i = 0; i < directory->Size(); i++) {
+        if ((i & merged_mask) == (bucket_index & merged_mask)) {
+          directory->SetLocalDepth(i, local_depth - 1);
+          directory->SetBucketPageId(i, survivor_id);
+        }
+      }
+
+      if (bucket_empty) {
+        bucket_guard = std::move(image_guard);
+      } else {
+        image_guard.Drop();
+      }
+      bpm_->DeletePage(dead_id);
+    }
+
+    while (directory->CanShrink()) {
+      directory->DecrGlobalDepth();
+    }
+    return true;
+  }
+
+  const PageId_t header_page_id_;
+  BufferPoolManager* bpm_;
+  const uint32_t header_max_depth_;
+  const uint32_t directory_max_depth_;
+  const uint32_t bucket_max_size_;
+  KeyEqual key_equal_;
+  Hasher hasher_;
+
+  std::vector<std::atomic<PageId_t>> bucket_cache_;
+};
+
+#endif
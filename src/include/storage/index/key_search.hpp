@@ -0,0 +1,58 @@
+#ifndef _KEY_SEARCH_HPP_
+#define _KEY_SEARCH_HPP_
+
+#include <cstdint>
+#include <functional>
+#include <string_view>
+#include <type_traits>
+
+// Searches in sorted arrays of fixed width integer keys, the same results as
+// std::lower_bound and std::upper_bound. Binary search narrows the range to a
+// few cache lines and a SIMD kernel counts the keys left of the target in the
+// rest, which avoids the mispredicted branches of the last search steps. The
+// kernel is picked once from the CPU features.
+enum class SearchKernel { Scalar = 0, SSE, AVX2, AVX512 };
+
+SearchKernel DetectSearchKernel();
+const char* SearchKernelName(SearchKernel);
+
+template <typename T>
+int KeyLowerBound(const T* keys, int size, T key,
+                  SearchKernel kernel = DetectSearchKernel());
+template <typename T>
+int KeyUpperBound(const T* keys, int size, T key,
+                  SearchKernel kernel = DetectSearchKernel());
+
+// Whether a node keyed by Key and ordered by Comparator can use the kernels
+template <typename Key, typename Comparator>
+constexpr bool SIMD_SEARCHABLE =
+    (std::is_same_v<Key, int32_t> || std::is_same_v<Key, int64_t>) &&
+    (std::is_same_v<Comparator, std::less<Key>> ||
+     std::is_same_v<Comparator, std::less<>>);
+
+// First 8 bytes of a variable length key as an integer that orders like the
+// key itself, shorter keys are padded with zeros. Equal prefixes say nothing,
+// the full keys have to be compared.
+int64_t KeyPrefix(std::string_view key);
+
+// Lower bound over variable length keys with a parallel array of their
+// prefixes. Full keys, returned by key_at(index), are only compared among the
+// entries whose prefix equals the prefix of key.
+template <typename KeyAt>
+int PrefixLowerBound(const int64_t* prefixes, int size, std::string_view key,
+                     KeyAt key_at) {
+  int64_t prefix = KeyPrefix(key);
+  int lo = KeyLowerBound(prefixes, size, prefix);
+  int hi = KeyUpperBound(prefixes + lo, size - lo, prefix) + lo;
+  while (lo < hi) {
+    int mid = lo + (hi - lo) / 2;
+    if (std::string_view(key_at(mid)) < key) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+  return lo;
+}
+
+#endif
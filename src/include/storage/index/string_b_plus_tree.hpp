@@ -0,0 +1,312 @@
+#ifndef _STRING_B_PLUS_TREE_HPP_
+#define _STRING_B_PLUS_TREE_HPP_
+
+#include <buffer/buffer_pool_manager.hpp>
+#include <storage/index/string_b_plus_tree_iterator.hpp>
+#include <storage/page/b_plus_tree_page.hpp>
+#include <storage/page/string_b_plus_tree_page.hpp>
+
+#include <deque>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+// B+ tree with unique variable length string keys, latched like BPlusTree.
+// With compression on, nodes store the prefix shared by their keys once and
+// a leaf split only pushes up the shortest key that separates the two halves
+// (suffix truncation), so internal nodes hold short separators and the tree
+// gets a higher fanout. Nodes split by bytes rather than by entry count.
+// Removes never merge nodes, the space is reused by later inserts.
+template <typename Value>
+class StringBPlusTree {
+  using LeafPage = StringBPlusTreePage<Value>;
+  using InternalPage = StringBPlusTreePage<PageId_t>;
+
+  static_assert(LeafPage::HEADER_SIZE >= B_PLUS_TREE_PAGE_HEADER_SIZE + 8);
+
+ public:
+  using Iterator = StringBPlusTreeIterator<Value>;
+
+  static constexpr size_t MAX_KEY_SIZE = LeafPage::MAX_KEY_SIZE;
+
+  StringBPlusTree(PageId_t header_page_id, BufferPoolManager* bpm,
+                  bool compress = true)
+      : header_page_id_(header_page_id), bpm_(bpm), compress_(compress) {
+    RequireDefaultPageSize(bpm_->GetPageSize(), "String B+ tree");
+    auto guard = bpm_->WritePage(header_page_id_, AccessType::Index);
+    guard.template AsMut<BPlusTreeHeaderPage>()->root_page_id_ =
+        INVALID_PAGE_ID;
+  }
+
+  bool IsEmpty() { return GetRootPageId() == INVALID_PAGE_ID; }
+
+  PageId_t GetRootPageId() {
+    auto guard = bpm_->ReadPage(header_page_id_, AccessType::Index);
+    return guard.template As<BPlusTreeHeaderPage>()->root_page_id_;
+  }
+
+  // Number of levels, 0 for an empty tree
+  int GetHeight() {
+    PageId_t page_id = GetRootPageId();
+    int height = 0;
+    while (page_id != INVALID_PAGE_ID) {
+      auto guard = bpm_->ReadPage(page_id, AccessType::Index);
+      height++;
+      if (guard.template As<BPlusTreePage>()->IsLeaf()) {
+        break;
+      }
+      page_id = guard.template As<InternalPage>()->ValueAt(0);
+    }
+    return height;
+  }
+
+  std::optional<Value> GetValue(std::string_view key) {
+    auto guard = FindLeaf_(key);
+    if (!guard.has_value()) {
+      return std::nullopt;
+    }
+
+    const auto* leaf = guard->template As<LeafPage>();
+    int index = leaf->LowerBound(key);
+    if (index < leaf->GetSize() && leaf->KeyEquals(index, key)) {
+      return leaf->ValueAt(index);
+    }
+    return std::nullopt;
+  }
+
+  // Returns false if the key is already present
+  bool Insert(std::string_view key, const Value& value) {
+    if (key.size() > MAX_KEY_SIZE) {
+      throw std::runtime_error("B+ tree key too large");
+    }
+    auto done = InsertOptimistic_(key, value);
+    if (done.has_value()) {
+      return done.value();
+    }
+    return InsertPessimistic_(key, value);
+  }
+
+  void Remove(std::string_view key) {
+    auto guard = FindLeafForWrite_(key);
+    if (!guard.has_value()) {
+      return;
+    }
+
+    const auto* leaf = guard->template As<LeafPage>();
+    int index = leaf->LowerBound(key);
+    if (index < leaf->GetSize() && leaf->KeyEquals(index, key)) {
+      guard->template AsMut<LeafPage>()->RemoveAt(index);
+    }
+  }
+
+  Iterator Begin() { return Begin(std::string_view()); }
+
+  // Iterator positioned at the first key that is not less than key
+  Iterator Begin(std::string_view key) {
+    auto guard = FindLeaf_(key);
+    if (!guard.has_value()) {
+      return Iterator();
+    }
+    int index = guard->template As<LeafPage>()->LowerBound(key);
+    return Iterator(bpm_, std::move(guard).value(), index);
+  }
+
+  Iterator End() { return Iterator(); }
+
+ private:
+  struct Context {
+    std::optional<WritePageGuard> header_;
+    std::deque<WritePageGuard> write_set_;
+  };
+
+  static PageId_t Child_(const InternalPage* node, std::string_view key) {
+    return node->ValueAt(node->UpperBound(key) - 1);
+  }
+
+  std::optional<ReadPageGuard> FindLeaf_(std::string_view key) {
+    auto guard = bpm_->ReadPage(header_page_id_, AccessType::Index);
+    PageId_t page_id =
+        guard.template As<BPlusTreeHeaderPage>()->root_page_id_;
+    if (page_id == INVALID_PAGE_ID) {
+      return std::nullopt;
+    }
+
+    guard = bpm_->ReadPage(page_id, AccessType::Index);
+    while (!guard.template As<BPlusTreePage>()->IsLeaf()) {
+      page_id = Child_(guard.template As<InternalPage>(), key);
+      guard = bpm_->ReadPage(page_id, AccessType::Index);
+    }
+    return std::optional<ReadPageGuard>(std::move(guard));
+  }
+
+  // Descends with read latches and write latches only the leaf, the parent's
+  // read latch is kept until then so the leaf cannot be split under us.
+  std::optional<WritePageGuard> FindLeafForWrite_(std::string_view key) {
+    auto parent = bpm_->ReadPage(header_page_id_, AccessType::Index);
+    PageId_t page_id =
+        parent.template As<BPlusTreeHeaderPage>()->root_page_id_;
+    if (page_id == INVALID_PAGE_ID) {
+      return std::nullopt;
+    }
+
+    while (true) {
+      auto guard = bpm_->ReadPage(page_id, AccessType::Index);
+      if (guard.template As<BPlusTreePage>()->IsLeaf()) {
+        guard.Drop();
+        auto leaf_guard = bpm_->WritePage(page_id, AccessType::Index);
+        parent.Drop();
+        return std::optional<WritePageGuard>(std::move(leaf_guard));
+      }
+
+      page_id = Child_(guard.template As<InternalPage>(), key);
+      parent = std::move(guard);
+    }
+  }
+
+  std::optional<bool> InsertOptimistic_(std::string_view key,
+                                        const Value& value) {
+    auto guard = FindLeafForWrite_(key);
+    if (!guard.has_value()) {
+      return std::nullopt;
+    }
+
+    const auto* leaf = guard->template As<LeafPage>();
+    int index = leaf->LowerBound(key);
+    if (index < leaf->GetSize() && leaf->KeyEquals(index, key)) {
+      return false;
+    }
+    if (!leaf->HasRoom(key)) {
+      return std::nullopt;
+    }
+
+    guard->template AsMut<LeafPage>()->InsertAt(index, key, value);
+    return true;
+  }
+
+  bool InsertPessimistic_(std::string_view key, const Value& value) {
+    Context ctx;
+    ctx.header_ = bpm_->WritePage(header_page_id_, AccessType::Index);
+    PageId_t root_id =
+        ctx.header_->template As<BPlusTreeHeaderPage>()->root_page_id_;
+
+    if (root_id == INVALID_PAGE_ID) {
+      root_id = bpm_->NewPage();
+      auto root_guard = bpm_->WritePage(root_id, AccessType::Index);
+      auto* root = root_guard.template AsMut<LeafPage>();
+      root->Init(IndexPageType::Leaf);
+      root->Build({{std::string(key), value}}, compress_);
+      ctx.header_->template AsMut<BPlusTreeHeaderPage>()->root_page_id_ =
+          root_id;
+      return true;
+    }
+
+    ctx.write_set_.push_back(bpm_->WritePage(root_id, AccessType::Index));
+    if (IsInsertSafe_(ctx.write_set_.back(), key)) {
+      ctx.header_.reset();
+    }
+
+    while (!ctx.write_set_.back().template As<BPlusTreePage>()->IsLeaf()) {
+      PageId_t child_id =
+          Child_(ctx.write_set_.back().template As<InternalPage>(), key);
+      auto child = bpm_->WritePage(child_id, AccessType::Index);
+      if (IsInsertSafe_(child, key)) {
+        ctx.header_.reset();
+        ctx.write_set_.clear();
+      }
+      ctx.write_set_.push_back(std::move(child));
+    }
+
+    auto* leaf = ctx.write_set_.back().template AsMut<LeafPage>();
+    int index = leaf->LowerBound(key);
+    if (index < leaf->GetSize() && leaf->KeyEquals(index, key)) {
+      return false;
+    }
+    if (leaf->InsertAt(index, key, value)) {
+      return true;
+    }
+
+    auto entries = leaf->Entries();
+    entries.emplace(entries.begin() + index, std::string(key), value);
+    size_t split = leaf->SplitPoint(entries);
+    std::vector<typename LeafPage::Entry> right_entries(
+        std::make_move_iterator(entries.begin() + split),
+        std::make_move_iterator(entries.end()));
+    entries.resize(split);
+
+    PageId_t right_id = bpm_->NewPage();
+    auto right_guard = bpm_->WritePage(right_id, AccessType::Index);
+    auto* right = right_guard.template AsMut<LeafPage>();
+    right->Init(IndexPageType::Leaf);
+    right->Build(right_entries, compress_);
+    right->SetNextPageId(leaf->GetNextPageId());
+    leaf->Build(entries, compress_);
+    leaf->SetNextPageId(right_id);
+
+    std::string separator =
+        compress_ ? LeafPage::Separator(entries.back().first,
+                                        right_entries.front().first)
+                  : right_entries.front().first;
+    InsertIntoParent_(ctx, separator, right_id);
+    return true;
+  }
+
+  // The page at the back of the write set was split, key separates it from
+  // its new right sibling.
+  void InsertIntoParent_(Context& ctx, const std::string& key,
+                         PageId_t right_id) {
+    PageId_t left_id = ctx.write_set_.back().GetPageId();
+    ctx.write_set_.pop_back();
+
+    if (ctx.write_set_.empty()) {
+      PageId_t root_id = bpm_->NewPage();
+      auto root_guard = bpm_->WritePage(root_id, AccessType::Index);
+      auto* root = root_guard.template AsMut<InternalPage>();
+      root->Init(IndexPageType::Internal);
+      root->Build({{std::string(), left_id}, {key, right_id}}, compress_);
+      ctx.header_->template AsMut<BPlusTreeHeaderPage>()->root_page_id_ =
+          root_id;
+      return;
+    }
+
+    auto* parent = ctx.write_set_.back().template AsMut<InternalPage>();
+    int index = parent->UpperBound(key);
+    if (parent->InsertAt(index, key, right_id)) {
+      return;
+    }
+
+    // The first key of the new sibling moves up, its slot keeps an empty key
+    auto entries = parent->Entries();
+    entries.emplace(entries.begin() + index, key, right_id);
+    size_t split = parent->SplitPoint(entries);
+    std::vector<typename InternalPage::Entry> sibling_entries(
+        std::make_move_iterator(entries.begin() + split),
+        std::make_move_iterator(entries.end()));
+    entries.resize(split);
+    std::string middle = std::move(sibling_entries.front().first);
+    sibling_entries.front().first.clear();
+
+    PageId_t sibling_id = bpm_->NewPage();
+    auto sibling_guard = bpm_->WritePage(sibling_id, AccessType::Index);
+    auto* sibling = sibling_guard.template AsMut<InternalPage>();
+    sibling->Init(IndexPageType::Internal);
+    sibling->Build(sibling_entries, compress_);
+    parent->Build(entries, compress_);
+    InsertIntoParent_(ctx, middle, sibling_id);
+  }
+
+  bool IsInsertSafe_(const WritePageGuard& guard, std::string_view key) const {
+    if (guard.template As<BPlusTreePage>()->IsLeaf()) {
+      return guard.template As<LeafPage>()->HasRoom(key);
+    }
+    return guard.template As<InternalPage>()->HasRoomForAnyKey();
+  }
+
+  PageId_t header_page_id_;
+  BufferPoolManager* bpm_;
+  bool compress_;
+};
+
+#endif
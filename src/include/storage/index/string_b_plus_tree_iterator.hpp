@@ -0,0 +1,77 @@
+#ifndef _STRING_B_PLUS_TREE_ITERATOR_HPP_
+#define _STRING_B_PLUS_TREE_ITERATOR_HPP_
+
+#include <buffer/buffer_pool_manager.hpp>
+#include <storage/page/string_b_plus_tree_page.hpp>
+
+#include <optional>
+#include <string>
+
+// Forward iterator over the leaf level of a string keyed tree, latched the
+// same way as BPlusTreeIterator. Leaves emptied by removes are skipped.
+template <typename Value>
+class StringBPlusTreeIterator {
+  using LeafPage = StringBPlusTreePage<Value>;
+
+ public:
+  StringBPlusTreeIterator() = default;
+  StringBPlusTreeIterator(BufferPoolManager* bpm, ReadPageGuard guard,
+                          int index)
+      : bpm_(bpm),
+        guard_(std::move(guard)),
+        page_id_(guard_->GetPageId()),
+        index_(index) {
+    SkipExhausted_();
+  }
+
+  bool IsEnd() const { return !guard_.has_value(); }
+
+  std::string GetKey() const {
+    return guard_->As<LeafPage>()->KeyAt(index_);
+  }
+
+  const Value& GetValue() const {
+    return guard_->As<LeafPage>()->ValueAt(index_);
+  }
+
+  StringBPlusTreeIterator& operator++() {
+    index_++;
+    SkipExhausted_();
+    return *this;
+  }
+
+  bool operator==(const StringBPlusTreeIterator& other) const {
+    if (IsEnd() || other.IsEnd()) {
+      return IsEnd() == other.IsEnd();
+    }
+    return page_id_ == other.page_id_ && index_ == other.index_;
+  }
+
+  bool operator!=(const StringBPlusTreeIterator& other) const {
+    return !(*this == other);
+  }
+
+ private:
+  void SkipExhausted_() {
+    while (guard_.has_value() &&
+           index_ >= guard_->As<LeafPage>()->GetSize()) {
+      PageId_t next = guard_->As<LeafPage>()->GetNextPageId();
+      if (next == INVALID_PAGE_ID) {
+        guard_.reset();
+        page_id_ = INVALID_PAGE_ID;
+        index_ = 0;
+        return;
+      }
+      guard_ = bpm_->ReadPage(next, AccessType::Index);
+      page_id_ = next;
+      index_ = 0;
+    }
+  }
+
+  BufferPoolManager* bpm_{nullptr};
+  std::optional<ReadPageGuard> guard_;
+  PageId_t page_id_{INVALID_PAGE_ID};
+  int index_{0};
+};
+
+#endif
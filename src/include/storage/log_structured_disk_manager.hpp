@@ -0,0 +1,134 @@
+#ifndef _LOG_STRUCTURED_DISK_MANAGER_HPP_
+#define _LOG_STRUCTURED_DISK_MANAGER_HPP_
+
+#include <storage/disk_manager.hpp>
+
+#include <condition_variable>
+#include <optional>
+#include <shared_mutex>
+#include <thread>
+
+// Pages of a segment, the unit the file is appended and cleaned in
+const size_t LOG_SEGMENT_PAGES = 256;
+
+// Disk manager that never writes a page in place. The db file is divided into
+// segments after its header slot, every write appends the page to the
+// current head segment and moves the page's entry in the page map, so the
+// random write-back of evicted pages becomes sequential writes. A background
+// cleaner keeps the share of dead slots bounded: it picks the segment with
+// the fewest live pages, copies them to the head and frees the segment.
+// Writers clean themselves when the cleaner falls far behind.
+//
+// Sync writes a checkpoint of the page map next to the db file, the db file
+// is reopened from it. Segments freed after a checkpoint still hold pages the
+// checkpoint refers to, so they are reused only after the next one; the
+// cleaner checkpoints on its own when too many segments are waiting. Writes
+// after the last checkpoint are lost on a crash.
+//
+// The latch only covers the page map and segment bookkeeping. A write
+// reserves its slots under it, writes them without it and then installs
+// them, unless a later write or a delete of the page came in between.
+class LogStructuredDiskManager : public DiskManager {
+ public:
+  LogStructuredDiskManager(const std::filesystem::path&,
+                           size_t page_size = DB_PAGE_SIZE);
+  ~LogStructuredDiskManager() override;
+
+  void ShutDown() override;
+
+  void WritePage(PageId_t, const char*) override;
+  void ReadPage(PageId_t, char*) override;
+  void DeletePage(PageId_t) override;
+  // Pages written together are appended together already
+  void AllocateExtent(PageId_t, size_t, PageId_t) override;
+  // Appends the batch as one write per segment it spans
+  void WritePages(
+      const std::vector<std::pair<PageId_t, const char*>>&) override;
+  // Fsyncs the db file and checkpoints the page map
+  void Sync() override;
+  // The cleaner already packs live pages, this only truncates the free
+  // segments at the end of the file
+  CompactionResult Compact(size_t max_pages = SIZE_MAX,
+                           size_t pages_per_second = 0) override;
+
+  // Live pages the cleaner moved
+  int GetNumCleanerWrites() const;
+  // Segments of the db file, in use or free
+  size_t GetSegmentCount() const;
+  std::filesystem::path GetCheckpointFileName() const;
+
+ private:
+  struct Segment {
+    // Page in each written slot, INVALID_PAGE_ID once dead
+    std::vector<PageId_t> slots;
+    size_t live{0};
+    // Reserved slots whose write has not landed, the cleaner skips the
+    // segment until they have
+    size_t writing{0};
+  };
+
+  // Writes of a page that are reserved but not installed
+  struct PendingWrite {
+    size_t count{0};
+    // Only the write with this sequence number is installed, a delete
+    // bumps it past all of them
+    uint64_t latest{0};
+  };
+
+  // Sources are the offsets the cleaner copied the pages from, a copy is
+  // dropped if its page moved since. Returns the pages installed.
+  size_t Append_(const std::vector<std::pair<PageId_t, const char*>>&,
+                 const std::vector<size_t>* sources = nullptr);
+  // Starts a new head segment, reusing a free one before growing the file
+  void NextSegment_();
+  void KillSlot_(size_t offset);
+  void FreeSegment_(size_t segment);
+  // Sealed segment with the fewest live pages that has a dead one
+  std::optional<size_t> Victim_() const;
+  bool NeedsCleaning_() const;
+  void WakeCleaner_();
+  // Cleans and checkpoints on the writer's thread while the cleaner lags too
+  // far behind
+  void CatchUp_();
+  void Clean_();
+  void CleanerWork_();
+  void Checkpoint_();
+  void LoadCheckpoint_();
+  void SyncFile_(int fd);
+  size_t SegmentOffset_(size_t segment) const;
+  // Segment and slot in it of a page's byte offset
+  size_t SegmentOf_(size_t offset) const;
+  size_t SlotOf_(size_t offset) const;
+
+  std::filesystem::path file_name_;
+  std::filesystem::path checkpoint_file_name_;
+  int fd_{-1};
+
+  mutable std::mutex mutex_;
+  // Held shared across page reads and the cleaner's segment reads,
+  // exclusively to hand freed segments out for reuse
+  std::shared_mutex io_latch_;
+  std::mutex clean_mutex_;
+  std::mutex checkpoint_mutex_;
+  std::condition_variable cleaner_cv_;
+  // Signalled when a checkpoint hands its freed segments out
+  std::condition_variable checkpoint_cv_;
+  // Page id to byte offset in the file
+  std::unordered_map<PageId_t, size_t> locations_;
+  std::unordered_map<PageId_t, PendingWrite> pending_writes_;
+  uint64_t write_seq_{0};
+  std::vector<Segment> segments_;
+  std::vector<size_t> free_segments_;
+  // Freed since the last checkpoint
+  std::vector<size_t> pending_segments_;
+  // Freed segments the running checkpoint will hand out
+  size_t checkpoint_segments_{0};
+  size_t head_{0};
+  size_t written_pages_{0};
+  size_t dead_pages_{0};
+  int num_cleaner_writes_{0};
+  bool stop_{false};
+  std::thread cleaner_;
+};
+
+#endif
@@ -0,0 +1,26 @@
+#ifndef _BLOOM_FILTER_HPP_
+#define _BLOOM_FILTER_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+// Bloom filter over the keys of a sorted run, kept in memory. With
+// bits_per_key bits for each key it probes ln 2 * bits_per_key bits derived
+// from one hash by double hashing, 10 bits per key give about 1% false
+// positives.
+class BloomFilter {
+ public:
+  BloomFilter(size_t num_keys, size_t bits_per_key);
+
+  void Add(std::string_view key);
+  // False only if the key was never added
+  bool MayContain(std::string_view key) const;
+
+ private:
+  size_t num_probes_;
+  std::vector<uint64_t> bits_;
+};
+
+#endif
@@ -0,0 +1,106 @@
+#ifndef _LSM_TREE_HPP_
+#define _LSM_TREE_HPP_
+
+#include <buffer/buffer_pool_manager.hpp>
+#include <storage/disk_manager.hpp>
+#include <storage/lsm/skip_list.hpp>
+#include <storage/lsm/sorted_run.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+struct LsmOptions {
+  // Memtable size at which it is written to a level 0 run
+  size_t memtable_size{4 << 20};
+  // Level 0 runs that trigger a compaction into level 1
+  size_t level0_runs{4};
+  // Pages of the runs compactions write
+  size_t run_pages{512};
+  // Pages of level 1, each further level holds level_ratio times more
+  size_t base_level_pages{2560};
+  size_t level_ratio{10};
+  size_t bloom_bits_per_key{10};
+};
+
+// Key value store for write heavy workloads. Writes go to a skip list
+// memtable; a full memtable becomes immutable and a background thread writes
+// it to a new level 0 run. Level 0 runs may overlap, the runs of every deeper
+// level cover disjoint key ranges. When level 0 holds level0_runs runs, or a
+// deeper level grows beyond its size, the background thread merges runs into
+// the next level, one run at a time below level 0, round robin over the key
+// range. Tombstones are dropped once they reach the deepest level. Reads check
+// the memtables and then the runs from newest to oldest, each run skipped
+// unless its key range and bloom filter admit the key; run pages are read
+// through the buffer pool, which acts as the block cache.
+//
+// Readers see an immutable snapshot of the runs and never wait for
+// compactions. Writers stall while a full memtable waits for the previous one
+// to be written. The runs are only known in memory, a tree is not reopened
+// from its pages and unflushed writes are lost on destruction.
+class LsmTree {
+ public:
+  static constexpr size_t MAX_LEVELS = 7;
+
+  LsmTree(BufferPoolManager*, DiskManager*, LsmOptions options = {});
+  ~LsmTree();
+  LsmTree(const LsmTree&) = delete;
+  LsmTree& operator=(const LsmTree&) = delete;
+
+  void Put(std::string_view key, std::string_view value);
+  void Delete(std::string_view key);
+  std::optional<std::string> Get(std::string_view key) const;
+
+  // Writes the memtable to a run and waits until no compaction is due
+  void Flush();
+
+  size_t GetRunCount(size_t level) const;
+  size_t GetPageCount(size_t level) const;
+  // Run pages read by lookups
+  size_t GetBlockReads() const;
+  size_t GetCompactionCount() const;
+
+ private:
+  // Runs of each level, level 0 newest first and deeper levels by key
+  struct Version {
+    std::vector<std::shared_ptr<SortedRun>> levels[MAX_LEVELS];
+  };
+
+  void Write_(std::string_view key, std::string_view value, bool deleted);
+  // Makes the full memtable immutable, waiting for the previous one
+  void SwitchMemtable_(std::unique_lock<std::mutex>&);
+  void BackgroundWork_();
+  std::shared_ptr<SortedRun> WriteMemtable_(const SkipList&);
+  // Level whose runs should be merged into the next, MAX_LEVELS if none
+  size_t PickLevel_() const;
+  std::shared_ptr<Version> Compact_(const Version&, size_t level);
+  size_t MaxLevelPages_(size_t level) const;
+
+  BufferPoolManager* bpm_;
+  DiskManager* disk_manager_;
+  const LsmOptions options_;
+
+  mutable std::mutex mutex_;
+  // Wakes the background thread
+  std::condition_variable work_cv_;
+  // Signals finished background work
+  std::condition_variable done_cv_;
+  std::shared_ptr<SkipList> mem_;
+  std::shared_ptr<SkipList> imm_;
+  std::shared_ptr<const Version> version_;
+  // Last key compacted out of each level
+  std::string compact_pointer_[MAX_LEVELS];
+  bool stop_{false};
+
+  mutable std::atomic<size_t> block_reads_{0};
+  size_t compactions_{0};
+  std::thread thread_;
+};
+
+#endif
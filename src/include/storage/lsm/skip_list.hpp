@@ -0,0 +1,86 @@
+#ifndef _SKIP_LIST_HPP_
+#define _SKIP_LIST_HPP_
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <random>
+#include <string_view>
+#include <vector>
+
+// Value of a key in a memtable or run, deleted keys keep a tombstone that
+// hides older values until compaction drops it
+struct LsmValue {
+  bool deleted;
+  std::string_view value;
+};
+
+// Sorted in-memory map of the LSM tree. Writers are serialized by a mutex,
+// readers never block: nodes are published with release stores and only
+// freed with the list, so a reader sees either the old or the new list. A
+// key written twice keeps both nodes, the newer one first. Keys and values
+// are copied into an arena that grows in blocks.
+class SkipList {
+  struct Node;
+
+ public:
+  static constexpr int MAX_HEIGHT = 12;
+
+  SkipList();
+  ~SkipList();
+  SkipList(const SkipList&) = delete;
+  SkipList& operator=(const SkipList&) = delete;
+
+  void Put(std::string_view key, std::string_view value);
+  void Delete(std::string_view key);
+  // Newest value of the key, nullopt if the list does not hold it
+  std::optional<LsmValue> Get(std::string_view key) const;
+
+  // Bytes of keys, values and nodes
+  size_t GetMemoryUsage() const;
+  bool IsEmpty() const;
+
+  // Walks the newest value of every key in order, not safe against writers
+  class Iterator {
+   public:
+    bool IsEnd() const;
+    std::string_view Key() const;
+    LsmValue Value() const;
+    Iterator& operator++();
+
+   private:
+    friend class SkipList;
+    explicit Iterator(const Node*);
+
+    const Node* node_;
+  };
+  Iterator Begin() const;
+
+ private:
+  void Insert_(std::string_view key, std::string_view value, bool deleted);
+  Node* NewNode_(std::string_view key, std::string_view value, bool deleted,
+                 int height);
+  char* Allocate_(size_t size);
+  int RandomHeight_();
+  // Whether the node comes before (key, seq), newer sequence numbers first
+  static bool Before_(const Node*, std::string_view key, uint64_t seq);
+  // First node that does not come before (key, seq), with its predecessor on
+  // every level when prev is given
+  Node* FindGreaterOrEqual_(std::string_view key, uint64_t seq,
+                            Node** prev) const;
+
+  std::mutex write_mutex_;
+  Node* head_;
+  std::atomic<int> height_{1};
+  uint64_t next_seq_{1};
+  std::mt19937 rng_{0xdecafbad};
+
+  std::vector<std::unique_ptr<char[]>> blocks_;
+  char* alloc_ptr_{nullptr};
+  size_t alloc_remaining_{0};
+  std::atomic<size_t> memory_usage_{0};
+};
+
+#endif
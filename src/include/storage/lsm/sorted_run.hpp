@@ -0,0 +1,107 @@
+#ifndef _SORTED_RUN_HPP_
+#define _SORTED_RUN_HPP_
+
+#include <buffer/buffer_pool_manager.hpp>
+#include <storage/disk_manager.hpp>
+#include <storage/lsm/bloom_filter.hpp>
+#include <storage/lsm/skip_list.hpp>
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Pages of a run that an iterator reads ahead at once
+const size_t LSM_READ_AHEAD_PAGES = 8;
+
+// Immutable sorted sequence of keys of the LSM tree, stored in pages that are
+// written once, as a few large sequential writes straight to the disk
+// manager, and read back through the buffer pool. A page holds its number of
+// entries and their offsets followed by the entries: key and value lengths
+// and bytes, a value length of TOMBSTONE marks a deleted key. The first key
+// of every page and a bloom filter over all keys stay in memory. The pages
+// are deleted with the run.
+class SortedRun {
+ public:
+  static constexpr uint16_t TOMBSTONE = 0xFFFF;
+
+  ~SortedRun();
+  SortedRun(const SortedRun&) = delete;
+  SortedRun& operator=(const SortedRun&) = delete;
+
+  // Collects keys in ascending order into pages kept in memory until Finish
+  class Builder {
+   public:
+    Builder(BufferPoolManager*, DiskManager*, size_t bits_per_key);
+
+    // Largest key and value a page holds
+    static size_t MaxEntrySize();
+
+    void Add(std::string_view key, const LsmValue&);
+    // Pages of the run so far, including the one being filled
+    size_t GetPageCount() const;
+    bool IsEmpty() const;
+    // Writes the pages, nullptr if no key was added
+    std::shared_ptr<SortedRun> Finish();
+
+   private:
+    void FinishPage_();
+
+    BufferPoolManager* bpm_;
+    DiskManager* disk_manager_;
+    size_t bits_per_key_;
+    std::vector<std::vector<char>> pages_;
+    std::vector<std::string> first_keys_;
+    std::string last_key_;
+    size_t num_keys_{0};
+    // Entries of the page being filled
+    std::vector<uint16_t> offsets_;
+    std::vector<char> entries_;
+  };
+
+  // Range and bloom filter check, false if the run cannot hold the key
+  bool MayContain(std::string_view key) const;
+  // Reads the page that may hold the key, the value points into buffer
+  std::optional<LsmValue> Get(std::string_view key, std::string& buffer) const;
+
+  std::string_view GetFirstKey() const;
+  std::string_view GetLastKey() const;
+  size_t GetPageCount() const;
+
+  // Walks the entries in order, the page being read stays pinned
+  class Iterator {
+   public:
+    explicit Iterator(const SortedRun*);
+
+    bool IsEnd() const;
+    std::string_view Key() const;
+    LsmValue Value() const;
+    Iterator& operator++();
+
+   private:
+    void LoadPage_();
+    void LoadEntry_();
+
+    const SortedRun* run_;
+    size_t page_{0};
+    std::optional<ReadPageGuard> guard_;
+    uint16_t entry_{0};
+    uint16_t count_{0};
+    std::string_view key_;
+    LsmValue value_;
+  };
+
+ private:
+  SortedRun(BufferPoolManager*, std::vector<PageId_t>,
+            std::vector<std::string> first_keys, std::string last_key,
+            BloomFilter);
+
+  BufferPoolManager* bpm_;
+  std::vector<PageId_t> page_ids_;
+  std::vector<std::string> first_keys_;
+  std::string last_key_;
+  BloomFilter bloom_;
+};
+
+#endif
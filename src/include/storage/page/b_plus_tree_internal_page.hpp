@@ -0,0 +1,151 @@
+#ifndef _B_PLUS_TREE_INTERNAL_PAGE_HPP_
+#define _B_PLUS_TREE_INTERNAL_PAGE_HPP_
+
+#include <storage/index/key_search.hpp>
+#include <storage/page/b_plus_tree_page.hpp>
+
+#include <cstring>
+#include <type_traits>
+
+// Internal layout: header | keys | child page ids. The size counts children,
+// the key at index 0 is unused and child i holds keys in [key i, key i + 1).
+template <typename Key>
+class BPlusTreeInternalPage : public BPlusTreePage {
+  static_assert(std::is_trivially_copyable_v<Key>);
+
+ public:
+  static constexpr int CAPACITY =
+      static_cast<int>((DB_PAGE_SIZE - B_PLUS_TREE_PAGE_HEADER_SIZE) /
+                       (sizeof(Key) + sizeof(PageId_t))) -
+      1;
+
+  void Init(int max_size = CAPACITY - 1) {
+    SetPageType(IndexPageType::Internal);
+    SetSize(0);
+    SetMaxSize(max_size);
+  }
+
+  const Key& KeyAt(int index) const { return keys_[index]; }
+  void SetKeyAt(int index, const Key& key) { keys_[index] = key; }
+  PageId_t ValueAt(int index) const { return children_[index]; }
+  void SetValueAt(int index, PageId_t page_id) { children_[index] = page_id; }
+  const Key* Keys() const { return keys_; }
+
+  int ValueIndex(PageId_t page_id) const {
+    for (int i = 0; i < GetSize(); i++) {
+      if (children_[i] == page_id) {
+        return i;
+      }
+    }
+    return -1;
+  }
+
+  // Index of the child whose subtree may contain key
+  template <typename Comparator>
+  int ChildIndex(const Key& key, const Comparator& comparator) const {
+    return ChildIndex(key, comparator, GetSize());
+  }
+
+  // Same with the size passed in, for optimistic readers that validated it
+  template <typename Comparator>
+  int ChildIndex(const Key& key, const Comparator& comparator,
+                 int size) const {
+    if constexpr (SIMD_SEARCHABLE<Key, Comparator>) {
+      return KeyUpperBound(keys_ + 1, size - 1, key);
+    }
+    int lo = 1;
+    int hi = size;
+    while (lo < hi) {
+      int mid = lo + (hi - lo) / 2;
+      if (comparator(key, keys_[mid])) {
+        hi = mid;
+      } else {
+        lo = mid + 1;
+      }
+    }
+    return lo - 1;
+  }
+
+  void PopulateNewRoot(PageId_t left, const Key& key, PageId_t right) {
+    children_[0] = left;
+    keys_[1] = key;
+    children_[1] = right;
+    SetSize(2);
+  }
+
+  void InsertAt(int index, const Key& key, PageId_t page_id) {
+    int size = GetSize();
+    memmove(keys_ + index + 1, keys_ + index, (size - index) * sizeof(Key));
+    memmove(children_ + index + 1, children_ + index,
+            (size - index) * sizeof(PageId_t));
+    keys_[index] = key;
+    children_[index] = page_id;
+    IncreaseSize(1);
+  }
+
+  void RemoveAt(int index) {
+    int size = GetSize();
+    memmove(keys_ + index, keys_ + index + 1, (size - index - 1) * sizeof(Key));
+    memmove(children_ + index, children_ + index + 1,
+            (size - index - 1) * sizeof(PageId_t));
+    IncreaseSize(-1);
+  }
+
+  // Appends a child, the key is ignored for the first child
+  void Append(const Key& key, PageId_t page_id) {
+    keys_[GetSize()] = key;
+    children_[GetSize()] = page_id;
+    IncreaseSize(1);
+  }
+
+  // Moves the upper half of the children into an empty recipient and returns
+  // the key separating the two pages, which moves up into the parent.
+  Key MoveHalfTo(BPlusTreeInternalPage* recipient) {
+    int size = GetSize();
+    int keep = (size + 1) / 2;
+    Key middle = keys_[keep];
+    recipient->CopyFrom(keys_ + keep, children_ + keep, size - keep);
+    SetSize(keep);
+    return middle;
+  }
+
+  // Appends every child to the recipient, middle_key is the parent key that
+  // separated the two pages and comes down between them.
+  void MoveAllTo(BPlusTreeInternalPage* recipient, const Key& middle_key) {
+    keys_[0] = middle_key;
+    recipient->CopyFrom(keys_, children_, GetSize());
+    SetSize(0);
+  }
+
+  // Returns the new separator between the recipient and this page
+  Key MoveFirstToEndOf(BPlusTreeInternalPage* recipient,
+                       const Key& middle_key) {
+    recipient->Append(middle_key, children_[0]);
+    Key separator = keys_[1];
+    RemoveAt(0);
+    return separator;
+  }
+
+  // Returns the new separator between this page and the recipient
+  Key MoveLastToFrontOf(BPlusTreeInternalPage* recipient,
+                        const Key& middle_key) {
+    int last = GetSize() - 1;
+    recipient->keys_[0] = middle_key;
+    recipient->InsertAt(0, keys_[last], children_[last]);
+    IncreaseSize(-1);
+    return recipient->keys_[0];
+  }
+
+ private:
+  void CopyFrom(const Key* keys, const PageId_t* children, int count) {
+    int size = GetSize();
+    memcpy(keys_ + size, keys, count * sizeof(Key));
+    memcpy(children_ + size, children, count * sizeof(PageId_t));
+    IncreaseSize(count);
+  }
+
+  Key keys_[CAPACITY];
+  PageId_t children_[CAPACITY];
+};
+
+#endif
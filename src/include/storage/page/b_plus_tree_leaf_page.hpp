@@ -0,0 +1,122 @@
+#ifndef _B_PLUS_TREE_LEAF_PAGE_HPP_
+#define _B_PLUS_TREE_LEAF_PAGE_HPP_
+
+#include <storage/index/key_search.hpp>
+#include <storage/page/b_plus_tree_page.hpp>
+
+#include <cstring>
+#include <type_traits>
+
+// Leaf layout: header | next page id | keys | values. Keys and values are kept
+// in separate arrays so a key search only touches the key cache lines. One
+// slot more than the max size is reserved, a leaf overflows by one entry
+// before it is split.
+template <typename Key, typename Value>
+class BPlusTreeLeafPage : public BPlusTreePage {
+  static_assert(std::is_trivially_copyable_v<Key>);
+  static_assert(std::is_trivially_copyable_v<Value>);
+
+ public:
+  static constexpr int CAPACITY =
+      static_cast<int>((DB_PAGE_SIZE - B_PLUS_TREE_PAGE_HEADER_SIZE) /
+                       (sizeof(Key) + sizeof(Value))) -
+      1;
+
+  void Init(int max_size = CAPACITY - 1) {
+    SetPageType(IndexPageType::Leaf);
+    SetSize(0);
+    SetMaxSize(max_size);
+    next_page_id_ = INVALID_PAGE_ID;
+  }
+
+  PageId_t GetNextPageId() const { return next_page_id_; }
+  void SetNextPageId(PageId_t next_page_id) { next_page_id_ = next_page_id; }
+
+  const Key& KeyAt(int index) const { return keys_[index]; }
+  const Value& ValueAt(int index) const { return values_[index]; }
+  const Key* Keys() const { return keys_; }
+  void SetValueAt(int index, const Value& value) { values_[index] = value; }
+
+  // Index of the first key that is not less than key
+  template <typename Comparator>
+  int LowerBound(const Key& key, const Comparator& comparator) const {
+    if constexpr (SIMD_SEARCHABLE<Key, Comparator>) {
+      return KeyLowerBound(keys_, GetSize(), key);
+    }
+    int lo = 0;
+    int hi = GetSize();
+    while (lo < hi) {
+      int mid = lo + (hi - lo) / 2;
+      if (comparator(keys_[mid], key)) {
+        lo = mid + 1;
+      } else {
+        hi = mid;
+      }
+    }
+    return lo;
+  }
+
+  void InsertAt(int index, const Key& key, const Value& value) {
+    int size = GetSize();
+    memmove(keys_ + index + 1, keys_ + index, (size - index) * sizeof(Key));
+    memmove(values_ + index + 1, values_ + index,
+            (size - index) * sizeof(Value));
+    keys_[index] = key;
+    values_[index] = value;
+    IncreaseSize(1);
+  }
+
+  void RemoveAt(int index) {
+    int size = GetSize();
+    memmove(keys_ + index, keys_ + index + 1, (size - index - 1) * sizeof(Key));
+    memmove(values_ + index, values_ + index + 1,
+            (size - index - 1) * sizeof(Value));
+    IncreaseSize(-1);
+  }
+
+  // Appends entries in order, used when building leaves bottom up
+  void Append(const Key& key, const Value& value) {
+    keys_[GetSize()] = key;
+    values_[GetSize()] = value;
+    IncreaseSize(1);
+  }
+
+  // Moves the upper half of the entries into an empty recipient
+  void MoveHalfTo(BPlusTreeLeafPage* recipient) {
+    int size = GetSize();
+    int keep = size / 2;
+    recipient->CopyFrom(keys_ + keep, values_ + keep, size - keep);
+    SetSize(keep);
+  }
+
+  // Appends every entry to the recipient, this page must be its right sibling
+  void MoveAllTo(BPlusTreeLeafPage* recipient) {
+    recipient->CopyFrom(keys_, values_, GetSize());
+    SetSize(0);
+  }
+
+  void MoveFirstToEndOf(BPlusTreeLeafPage* recipient) {
+    recipient->Append(keys_[0], values_[0]);
+    RemoveAt(0);
+  }
+
+  void MoveLastToFrontOf(BPlusTreeLeafPage* recipient) {
+    int last = GetSize() - 1;
+    recipient->InsertAt(0, keys_[last], values_[last]);
+    IncreaseSize(-1);
+  }
+
+ private:
+  void CopyFrom(const Key* keys, const Value* values, int count) {
+    int size = GetSize();
+    memcpy(keys_ + size, keys, count * sizeof(Key));
+    memcpy(values_ + size, values, count * sizeof(Value));
+    IncreaseSize(count);
+  }
+
+  PageId_t next_page_id_;
+  Key keys_[CAPACITY];
+  Value values_[CAPACITY];
+};
+
+#endif
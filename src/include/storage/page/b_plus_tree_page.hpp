@@ -0,0 +1,44 @@
+#ifndef _B_PLUS_TREE_PAGE_HPP_
+#define _B_PLUS_TREE_PAGE_HPP_
+
+#include <config.hpp>
+
+enum class IndexPageType : int32_t { Invalid = 0, Leaf, Internal };
+
+// Common header shared by leaf and internal pages, the page specific header
+// fields must keep the total under B_PLUS_TREE_PAGE_HEADER_SIZE bytes.
+const size_t B_PLUS_TREE_PAGE_HEADER_SIZE = 24;
+
+class BPlusTreePage {
+ public:
+  BPlusTreePage() = delete;
+  BPlusTreePage(const BPlusTreePage&) = delete;
+  BPlusTreePage& operator=(const BPlusTreePage&) = delete;
+
+  bool IsLeaf() const;
+  IndexPageType GetPageType() const;
+  void SetPageType(IndexPageType);
+
+  int GetSize() const;
+  void SetSize(int);
+  void IncreaseSize(int);
+
+  int GetMaxSize() const;
+  void SetMaxSize(int);
+  int GetMinSize() const;
+
+ private:
+  IndexPageType page_type_;
+  int32_t size_;
+  int32_t max_size_;
+};
+
+class BPlusTreeHeaderPage {
+ public:
+  BPlusTreeHeaderPage() = delete;
+  BPlusTreeHeaderPage(const BPlusTreeHeaderPage&) = delete;
+
+  PageId_t root_page_id_;
+};
+
+#endif
@@ -0,0 +1,108 @@
+#ifndef _EXTENDIBLE_HTABLE_BUCKET_PAGE_HPP_
+#define _EXTENDIBLE_HTABLE_BUCKET_PAGE_HPP_
+
+#include <config.hpp>
+
+#include <cstring>
+#include <optional>
+#include <type_traits>
+
+const size_t HTABLE_BUCKET_PAGE_HEADER_SIZE = 24;
+
+// Leaf level of the extendible hash table. Besides the entries a bucket
+// records which hashes it covers (directory index, local depth and the low
+// local depth bits), which lets a lookup that skipped the header and
+// directory pages check that it landed on the right bucket.
+template <typename Key, typename Value>
+class ExtendibleHTableBucketPage {
+  static_assert(std::is_trivially_copyable_v<Key>);
+  static_assert(std::is_trivially_copyable_v<Value>);
+
+ public:
+  static constexpr uint32_t CAPACITY =
+      static_cast<uint32_t>((DB_PAGE_SIZE - HTABLE_BUCKET_PAGE_HEADER_SIZE) /
+                            (sizeof(Key) + sizeof(Value))) -
+      1;
+
+  ExtendibleHTableBucketPage() = delete;
+  ExtendibleHTableBucketPage(const ExtendibleHTableBucketPage&) = delete;
+
+  void Init(uint32_t max_size = CAPACITY) {
+    size_ = 0;
+    max_size_ = max_size;
+    is_live_ = 0;
+  }
+
+  void SetCoverage(uint32_t directory_index, uint32_t local_depth,
+                   uint32_t hash_bits) {
+    is_live_ = 1;
+    directory_index_ = directory_index;
+    local_depth_ = local_depth;
+    hash_bits_ = hash_bits & ((1 << local_depth) - 1);
+  }
+
+  void MarkDead() { is_live_ = 0; }
+
+  bool Covers(uint32_t directory_index, uint32_t hash) const {
+    return is_live_ == 1 && directory_index_ == directory_index &&
+           (hash & ((1 << local_depth_) - 1)) == hash_bits_;
+  }
+
+  template <typename KeyEqual>
+  std::optional<Value> Lookup(const Key& key, const KeyEqual& eq) const {
+    for (uint32_t i = 0; i < size_; i++) {
+      if (eq(keys_[i], key)) {
+        return values_[i];
+      }
+    }
+    return std::nullopt;
+  }
+
+  template <typename KeyEqual>
+  bool Contains(const Key& key, const KeyEqual& eq) const {
+    return Lookup(key, eq).has_value();
+  }
+
+  // The caller checks for duplicates and room
+  void Append(const Key& key, const Value& value) {
+    keys_[size_] = key;
+    values_[size_] = value;
+    size_++;
+  }
+
+  template <typename KeyEqual>
+  bool Remove(const Key& key, const KeyEqual& eq) {
+    for (uint32_t i = 0; i < size_; i++) {
+      if (eq(keys_[i], key)) {
+        RemoveAt(i);
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // Order is not kept, the last entry fills the hole
+  void RemoveAt(uint32_t index) {
+    size_--;
+    keys_[index] = keys_[size_];
+    values_[index] = values_[size_];
+  }
+
+  const Key& KeyAt(uint32_t index) const { return keys_[index]; }
+  const Value& ValueAt(uint32_t index) const { return values_[index]; }
+  uint32_t Size() const { return size_; }
+  bool IsFull() const { return size_ >= max_size_; }
+  bool IsEmpty() const { return size_ == 0; }
+
+ private:
+  uint32_t size_;
+  uint32_t max_size_;
+  uint32_t is_live_;
+  uint32_t directory_index_;
+  uint32_t local_depth_;
+  uint32_t hash_bits_;
+  Key keys_[CAPACITY];
+  Value values_[CAPACITY];
+};
+
+#endif
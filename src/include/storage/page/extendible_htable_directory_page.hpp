@@ -0,0 +1,43 @@
+#ifndef _EXTENDIBLE_HTABLE_DIRECTORY_PAGE_HPP_
+#define _EXTENDIBLE_HTABLE_DIRECTORY_PAGE_HPP_
+
+#include <config.hpp>
+
+const uint32_t HTABLE_DIRECTORY_MAX_DEPTH = 8;
+const uint32_t HTABLE_DIRECTORY_ARRAY_SIZE = 1 << HTABLE_DIRECTORY_MAX_DEPTH;
+
+// Second level of the extendible hash table, the low global_depth bits of a
+// hash select the bucket page.
+class ExtendibleHTableDirectoryPage {
+ public:
+  ExtendibleHTableDirectoryPage() = delete;
+  ExtendibleHTableDirectoryPage(const ExtendibleHTableDirectoryPage&) = delete;
+
+  void Init(uint32_t max_depth = HTABLE_DIRECTORY_MAX_DEPTH);
+  uint32_t HashToBucketIndex(uint32_t) const;
+  PageId_t GetBucketPageId(uint32_t) const;
+  void SetBucketPageId(uint32_t, PageId_t);
+  uint32_t GetSplitImageIndex(uint32_t) const;
+
+  uint32_t GetGlobalDepth() const;
+  uint32_t GetMaxDepth() const;
+  uint32_t GetGlobalDepthMask() const;
+  void IncrGlobalDepth();
+  void DecrGlobalDepth();
+  bool CanShrink() const;
+  uint32_t Size() const;
+
+  uint32_t GetLocalDepth(uint32_t) const;
+  void SetLocalDepth(uint32_t, uint8_t);
+  uint32_t GetLocalDepthMask(uint32_t) const;
+
+ private:
+  uint32_t max_depth_;
+  uint32_t global_depth_;
+  uint8_t local_depths_[HTABLE_DIRECTORY_ARRAY_SIZE];
+  PageId_t bucket_page_ids_[HTABLE_DIRECTORY_ARRAY_SIZE];
+};
+
+static_assert(sizeof(ExtendibleHTableDirectoryPage) <= DB_PAGE_SIZE);
+
+#endif
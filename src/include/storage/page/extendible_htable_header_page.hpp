@@ -0,0 +1,29 @@
+#ifndef _EXTENDIBLE_HTABLE_HEADER_PAGE_HPP_
+#define _EXTENDIBLE_HTABLE_HEADER_PAGE_HPP_
+
+#include <config.hpp>
+
+const uint32_t HTABLE_HEADER_MAX_DEPTH = 8;
+const uint32_t HTABLE_HEADER_ARRAY_SIZE = 1 << HTABLE_HEADER_MAX_DEPTH;
+
+// First level of the extendible hash table, the top max_depth bits of a hash
+// select the directory page.
+class ExtendibleHTableHeaderPage {
+ public:
+  ExtendibleHTableHeaderPage() = delete;
+  ExtendibleHTableHeaderPage(const ExtendibleHTableHeaderPage&) = delete;
+
+  void Init(uint32_t max_depth = HTABLE_HEADER_MAX_DEPTH);
+  uint32_t HashToDirectoryIndex(uint32_t) const;
+  PageId_t GetDirectoryPageId(uint32_t) const;
+  void SetDirectoryPageId(uint32_t, PageId_t);
+  uint32_t MaxSize() const;
+
+ private:
+  PageId_t directory_page_ids_[HTABLE_HEADER_ARRAY_SIZE];
+  uint32_t max_depth_;
+};
+
+static_assert(sizeof(ExtendibleHTableHeaderPage) <= DB_PAGE_SIZE);
+
+#endif
@@ -0,0 +1,58 @@
+#ifndef _PAX_PAGE_HPP_
+#define _PAX_PAGE_HPP_
+
+#include <config.hpp>
+#include <storage/table/schema.hpp>
+
+#include <optional>
+
+// Page in PAX layout: the rows of the page are split into one minipage per
+// column holding that column's values back to back, so reading some columns
+// of every row only touches the cache lines of their minipages. Minipages are
+// packed and only aligned for the values they hold, padding them to cache
+// lines would cost wide schemas a third of the rows per page. The header is
+// followed by the minipage offsets. Rows are only appended. A PAX page fills
+// the page size of its table's pool, up to the 64 KB the offsets reach.
+class PaxPage {
+ public:
+  static constexpr size_t HEADER_SIZE = 24;
+  static constexpr size_t MINIPAGE_ALIGNMENT = 8;
+
+  PaxPage() = delete;
+  PaxPage(const PaxPage&) = delete;
+
+  // Rows of the schema a page holds, 0 if a single row does not fit
+  static uint16_t Capacity(const Schema&, size_t page_size = DB_PAGE_SIZE);
+
+  void Init(const Schema&, uint32_t ordinal, size_t page_size = DB_PAGE_SIZE);
+
+  PageId_t GetNextPageId() const;
+  void SetNextPageId(PageId_t);
+  uint32_t GetOrdinal() const;
+  uint32_t GetNumRows() const;
+  uint32_t GetCapacity() const;
+
+  // Scatters a tuple in row format into the minipages
+  std::optional<uint32_t> InsertTuple(const Schema&, const char*);
+  // Gathers a row back into row format
+  void GetTuple(const Schema&, uint32_t, char*) const;
+  const char* GetMinipage(size_t column) const;
+
+ private:
+  static size_t MinipagesBegin_(size_t num_columns);
+  const uint16_t* Offsets_() const;
+  uint16_t* Offsets_();
+  char* Data_();
+  const char* Data_() const;
+
+  PageId_t next_page_id_;
+  uint32_t ordinal_;
+  uint16_t num_rows_;
+  uint16_t capacity_;
+  uint16_t num_columns_;
+  uint16_t reserved_;
+};
+
+static_assert(sizeof(PaxPage) == PaxPage::HEADER_SIZE);
+
+#endif
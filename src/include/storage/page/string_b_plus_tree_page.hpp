@@ -0,0 +1,318 @@
+#ifndef _STRING_B_PLUS_TREE_PAGE_HPP_
+#define _STRING_B_PLUS_TREE_PAGE_HPP_
+
+#include <storage/page/b_plus_tree_page.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Slotted node for variable length keys, used for leaves and, with page ids
+// as values, for internal nodes. Slots are sorted by key and hold the value
+// and the first 4 bytes of the key suffix as a big endian integer, the rest
+// of the suffix lives in a heap growing down from the end of the page. The
+// prefix shared by all keys of the node is stored once, after the heap.
+// Internal nodes keep an empty key in slot 0 for the leftmost child, it is
+// never compared and does not count for the prefix.
+//
+// Searches compare the probe key against the prefix once and then compare
+// suffix heads as integers, the heap is only read when heads are equal.
+template <typename Value>
+class StringBPlusTreePage : public BPlusTreePage {
+  static_assert(std::is_trivially_copyable_v<Value>);
+
+  struct Slot {
+    uint16_t offset;
+    uint16_t size;
+    uint32_t head;
+    Value value;
+  };
+
+ public:
+  using Entry = std::pair<std::string, Value>;
+
+  static constexpr size_t HEADER_SIZE = 32;
+  static constexpr size_t SLOT_SIZE = sizeof(Slot);
+  static constexpr size_t HEAD_SIZE = sizeof(uint32_t);
+  // Small enough for any node to hold several of them
+  static constexpr size_t MAX_KEY_SIZE = 512;
+
+  void Init(IndexPageType page_type) {
+    SetPageType(page_type);
+    SetSize(0);
+    SetMaxSize(0);
+    next_page_id_ = INVALID_PAGE_ID;
+    prefix_size_ = 0;
+    heap_begin_ = DB_PAGE_SIZE;
+    garbage_ = 0;
+    compress_ = 0;
+  }
+
+  PageId_t GetNextPageId() const { return next_page_id_; }
+  void SetNextPageId(PageId_t next_page_id) { next_page_id_ = next_page_id; }
+
+  std::string_view GetPrefix() const {
+    return {Data() + DB_PAGE_SIZE - prefix_size_, prefix_size_};
+  }
+
+  std::string KeyAt(int index) const {
+    if (index < FirstKey_()) {
+      return {};
+    }
+    const Slot& slot = Slots()[index];
+    std::string key(GetPrefix());
+    char head[HEAD_SIZE];
+    StoreHead_(slot.head, head);
+    key.append(head, std::min<size_t>(slot.size, HEAD_SIZE));
+    key.append(Tail_(slot));
+    return key;
+  }
+
+  const Value& ValueAt(int index) const { return Slots()[index].value; }
+  void SetValueAt(int index, const Value& value) {
+    Slots()[index].value = value;
+  }
+
+  // Index of the first key that is not less than key
+  int LowerBound(std::string_view key) const { return Search_(key, false); }
+  // Index of the first key that is greater than key
+  int UpperBound(std::string_view key) const { return Search_(key, true); }
+
+  bool KeyEquals(int index, std::string_view key) const {
+    std::string_view prefix = GetPrefix();
+    if (key.substr(0, prefix.size()) != prefix) {
+      return false;
+    }
+    return CompareSuffix_(Slots()[index], key.substr(prefix.size())) == 0;
+  }
+
+  // Bytes an insert of key needs, without splitting but possibly after
+  // rebuilding the node with a shorter prefix
+  bool HasRoom(std::string_view key) const {
+    std::string_view prefix = GetPrefix();
+    if (key.substr(0, prefix.size()) == prefix) {
+      return SLOT_SIZE + TailSize_(key.size() - prefix.size()) <=
+             FreeSpace_() + garbage_;
+    }
+    auto entries = Entries();
+    entries.emplace_back(std::string(key), Value{});
+    std::sort(entries.begin(), entries.end(),
+              [](const auto& a, const auto& b) { return a.first < b.first; });
+    return RequiredSpace(entries) <= DB_PAGE_SIZE - HEADER_SIZE;
+  }
+
+  // Room for any key, so a split of a child cannot split this node
+  bool HasRoomForAnyKey() const {
+    return SLOT_SIZE + MAX_KEY_SIZE + GetSize() * prefix_size_ <=
+           FreeSpace_() + garbage_;
+  }
+
+  // Returns false without changing the node if it has no room for the key
+  bool InsertAt(int index, std::string_view key, const Value& value) {
+    std::string_view prefix = GetPrefix();
+    if (key.substr(0, prefix.size()) != prefix ||
+        SLOT_SIZE + TailSize_(key.size() - prefix.size()) > FreeSpace_()) {
+      if (!HasRoom(key)) {
+        return false;
+      }
+      auto entries = Entries();
+      entries.emplace(entries.begin() + index, std::string(key), value);
+      Build(entries, compress_);
+      return true;
+    }
+
+    Slot* slots = Slots();
+    memmove(slots + index + 1, slots + index,
+            (GetSize() - index) * SLOT_SIZE);
+    slots[index] = MakeSlot_(key.substr(prefix.size()), value);
+    IncreaseSize(1);
+    return true;
+  }
+
+  void RemoveAt(int index) {
+    Slot* slots = Slots();
+    garbage_ += TailSize_(slots[index].size);
+    memmove(slots + index, slots + index + 1,
+            (GetSize() - index - 1) * SLOT_SIZE);
+    IncreaseSize(-1);
+  }
+
+  std::vector<Entry> Entries() const {
+    std::vector<Entry> entries;
+    for (int i = 0; i < GetSize(); i++) {
+      entries.emplace_back(KeyAt(i), ValueAt(i));
+    }
+    return entries;
+  }
+
+  // Replaces the content with sorted entries. With compress set the common
+  // prefix of the first and last key, which all keys share, is stored once.
+  void Build(const std::vector<Entry>& entries, bool compress) {
+    compress_ = compress;
+    std::string prefix = CommonPrefix_(entries);
+    prefix_size_ = prefix.size();
+    heap_begin_ = DB_PAGE_SIZE - prefix_size_;
+    garbage_ = 0;
+    memcpy(Data() + heap_begin_, prefix.data(), prefix_size_);
+
+    SetSize(entries.size());
+    Slot* slots = Slots();
+    for (size_t i = 0; i < entries.size(); i++) {
+      std::string_view key = entries[i].first;
+      slots[i] = MakeSlot_(
+          i < static_cast<size_t>(FirstKey_()) ? "" : key.substr(prefix_size_),
+          entries[i].second);
+    }
+  }
+
+  // Bytes below the header that Build needs for entries
+  size_t RequiredSpace(const std::vector<Entry>& entries) const {
+    size_t prefix_size = CommonPrefix_(entries).size();
+    size_t space = prefix_size + entries.size() * SLOT_SIZE;
+    for (size_t i = FirstKey_(); i < entries.size(); i++) {
+      space += TailSize_(entries[i].first.size() - prefix_size);
+    }
+    return space;
+  }
+
+  // Index where sorted entries are cut in two halves of about the same
+  // encoded size, both sides get at least one entry
+  size_t SplitPoint(const std::vector<Entry>& entries) const {
+    size_t prefix_size = CommonPrefix_(entries).size();
+    size_t total = RequiredSpace(entries);
+    size_t space = prefix_size;
+    size_t index = 0;
+    while (index + 1 < entries.size() && space < total / 2) {
+      space += SLOT_SIZE;
+      if (index >= static_cast<size_t>(FirstKey_())) {
+        space += TailSize_(entries[index].first.size() - prefix_size);
+      }
+      index++;
+    }
+    return std::max<size_t>(index, 1);
+  }
+
+  // Shortest key that sorts after left and not after right, left < right
+  static std::string Separator(std::string_view left, std::string_view right) {
+    size_t common = 0;
+    while (common < left.size() && common < right.size() &&
+           left[common] == right[common]) {
+      common++;
+    }
+    return std::string(right.substr(0, common + 1));
+  }
+
+ private:
+  static size_t TailSize_(size_t suffix_size) {
+    return suffix_size > HEAD_SIZE ? suffix_size - HEAD_SIZE : 0;
+  }
+
+  static uint32_t LoadHead_(std::string_view suffix) {
+    uint32_t head = 0;
+    for (size_t i = 0; i < HEAD_SIZE; i++) {
+      head = head << 8 |
+             (i < suffix.size() ? static_cast<unsigned char>(suffix[i]) : 0);
+    }
+    return head;
+  }
+
+  static void StoreHead_(uint32_t head, char* out) {
+    for (size_t i = 0; i < HEAD_SIZE; i++) {
+      out[i] = static_cast<char>(head >> (8 * (HEAD_SIZE - 1 - i)));
+    }
+  }
+
+  // Slot 0 of an internal node holds no key
+  int FirstKey_() const { return IsLeaf() ? 0 : 1; }
+
+  std::string CommonPrefix_(const std::vector<Entry>& entries) const {
+    if (!compress_ || entries.size() <= static_cast<size_t>(FirstKey_())) {
+      return {};
+    }
+    const std::string& first = entries[FirstKey_()].first;
+    const std::string& last = entries.back().first;
+    size_t common = 0;
+    while (common < first.size() && common < last.size() &&
+           first[common] == last[common]) {
+      common++;
+    }
+    return first.substr(0, common);
+  }
+
+  Slot MakeSlot_(std::string_view suffix, const Value& value) {
+    size_t tail_size = TailSize_(suffix.size());
+    heap_begin_ -= tail_size;
+    memcpy(Data() + heap_begin_, suffix.data() + suffix.size() - tail_size,
+           tail_size);
+    return Slot{heap_begin_, static_cast<uint16_t>(suffix.size()),
+                LoadHead_(suffix), value};
+  }
+
+  std::string_view Tail_(const Slot& slot) const {
+    return {Data() + slot.offset, TailSize_(slot.size)};
+  }
+
+  int CompareSuffix_(const Slot& slot, std::string_view suffix) const {
+    uint32_t head = LoadHead_(suffix);
+    if (slot.head != head) {
+      return slot.head < head ? -1 : 1;
+    }
+    std::string_view tail =
+        suffix.size() > HEAD_SIZE ? suffix.substr(HEAD_SIZE) : "";
+    int cmp = Tail_(slot).compare(tail);
+    if (cmp != 0) {
+      return cmp;
+    }
+    // Equal heads and tails only differ in the zero padding of the heads
+    if (slot.size == suffix.size()) {
+      return 0;
+    }
+    return slot.size < suffix.size() ? -1 : 1;
+  }
+
+  int Search_(std::string_view key, bool upper) const {
+    std::string_view prefix = GetPrefix();
+    std::string_view key_prefix = key.substr(0, prefix.size());
+    if (key_prefix != prefix) {
+      return key_prefix < prefix ? FirstKey_() : GetSize();
+    }
+
+    std::string_view suffix = key.substr(prefix.size());
+    const Slot* slots = Slots();
+    int lo = FirstKey_();
+    int hi = GetSize();
+    while (lo < hi) {
+      int mid = lo + (hi - lo) / 2;
+      int cmp = CompareSuffix_(slots[mid], suffix);
+      if (cmp < 0 || (upper && cmp == 0)) {
+        lo = mid + 1;
+      } else {
+        hi = mid;
+      }
+    }
+    return lo;
+  }
+
+  size_t FreeSpace_() const {
+    return heap_begin_ - HEADER_SIZE - GetSize() * SLOT_SIZE;
+  }
+
+  Slot* Slots() { return reinterpret_cast<Slot*>(Data() + HEADER_SIZE); }
+  const Slot* Slots() const {
+    return reinterpret_cast<const Slot*>(Data() + HEADER_SIZE);
+  }
+  char* Data() { return reinterpret_cast<char*>(this); }
+  const char* Data() const { return reinterpret_cast<const char*>(this); }
+
+  PageId_t next_page_id_;
+  uint16_t prefix_size_;
+  uint16_t heap_begin_;
+  uint16_t garbage_;
+  uint16_t compress_;
+};
+
+#endif
@@ -0,0 +1,66 @@
+#ifndef _TABLE_PAGE_HPP_
+#define _TABLE_PAGE_HPP_
+
+#include <config.hpp>
+
+#include <optional>
+#include <utility>
+
+// Slotted page. The slot array grows from the header towards the end of the
+// page and tuple data grows from the end of the page towards the slots.
+// Live tuples keep their slot so record ids stay stable. A deleted tuple's
+// slot is reused by a later insert and trailing deleted slots are dropped,
+// its bytes are reclaimed by compacting the page when an insert or update
+// needs them.
+class TablePage {
+ public:
+  static constexpr size_t HEADER_SIZE = 24;
+  static constexpr size_t SLOT_SIZE = 4;
+  static constexpr size_t MAX_TUPLE_SIZE =
+      DB_PAGE_SIZE - HEADER_SIZE - SLOT_SIZE;
+
+  TablePage() = delete;
+  TablePage(const TablePage&) = delete;
+
+  void Init(uint32_t ordinal);
+
+  PageId_t GetNextPageId() const;
+  void SetNextPageId(PageId_t);
+  uint32_t GetOrdinal() const;
+  uint32_t GetNumSlots() const;
+
+  // Bytes available for a new tuple and its slot, after compaction
+  size_t GetFreeSpace() const;
+
+  std::optional<uint32_t> InsertTuple(const char*, size_t);
+  std::optional<std::pair<const char*, size_t>> GetTuple(uint32_t) const;
+  bool IsDeleted(uint32_t) const;
+  bool UpdateTuple(uint32_t, const char*, size_t);
+  bool DeleteTuple(uint32_t);
+
+ private:
+  struct Slot {
+    uint16_t offset;
+    uint16_t size;
+  };
+
+  static constexpr uint16_t DELETED_FLAG = 0x8000;
+
+  Slot* Slots();
+  const Slot* Slots() const;
+  char* Data();
+  const char* Data() const;
+  size_t ContiguousFreeSpace() const;
+  void Compact();
+
+  PageId_t next_page_id_;
+  uint32_t ordinal_;
+  uint16_t num_slots_;
+  uint16_t free_space_offset_;
+  uint16_t garbage_bytes_;
+  uint16_t reserved_;
+};
+
+static_assert(sizeof(TablePage) == TablePage::HEADER_SIZE);
+
+#endif
@@ -11,6 +11,34 @@
 class FrameHeader;
 class BufferPoolManager;
 
+// Unlatched and unpinned view of a resident page, for optimistic lock
+// coupling. Writers bump the frame version when they latch and unlatch a
+// page and the buffer pool bumps it when the frame changes pages, so data
+// read through this guard can only be trusted once Validate() confirms the
+// version it was created with. Reads may see torn or unrelated data in the
+// meantime and must stay within the page.
+class OptimisticPageGuard {
+  friend class BufferPoolManager;
+  friend class ReadPageGuard;
+
+ public:
+  PageId_t GetPageId() const;
+  const char* GetData() const;
+  template <class T>
+  const T* As() const {
+    return reinterpret_cast<const T*>(GetData());
+  }
+
+  bool Validate() const;
+
+ private:
+  OptimisticPageGuard(PageId_t, FrameHeader*, uint64_t);
+
+  PageId_t page_id_;
+  FrameHeader* frame_;
+  uint64_t version_;
+};
+
 class ReadPageGuard {
   friend class BufferPoolManager;
 
@@ -33,6 +61,8 @@ class ReadPageGuard {
   bool IsDirty() const;
   void Flush();
   void Drop();
+  // Optimistic view of the page at the version seen under this latch
+  OptimisticPageGuard Optimistic() const;
 
  private:
   ReadPageGuard(PageId_t, std::shared_ptr<FrameHeader>,
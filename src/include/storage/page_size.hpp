@@ -0,0 +1,56 @@
+#ifndef _PAGE_SIZE_HPP_
+#define _PAGE_SIZE_HPP_
+
+#include <config.hpp>
+
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+// Page sizes a db file can use, powers of two from DB_PAGE_SIZE to
+// DB_MAX_PAGE_SIZE
+inline bool IsValidPageSize(size_t page_size) {
+  return page_size >= DB_PAGE_SIZE && page_size <= DB_MAX_PAGE_SIZE &&
+         (page_size & (page_size - 1)) == 0;
+}
+
+// Calls f with the page size as a compile time constant for the common
+// sizes, so that code over a whole page is specialized for each of them,
+// and as a plain size_t otherwise
+template <typename F>
+inline auto WithPageSize(size_t page_size, F&& f) {
+  switch (page_size) {
+    case 4096:
+      return f(std::integral_constant<size_t, 4096>());
+    case 8192:
+      return f(std::integral_constant<size_t, 8192>());
+    case 16384:
+      return f(std::integral_constant<size_t, 16384>());
+    case 32768:
+      return f(std::integral_constant<size_t, 32768>());
+    case 65536:
+      return f(std::integral_constant<size_t, 65536>());
+    default:
+      return f(page_size);
+  }
+}
+
+// Formats laid out for DB_PAGE_SIZE pages would only use the start of a
+// larger frame, they refuse files with another page size
+inline void RequireDefaultPageSize(size_t page_size, const char* format) {
+  if (page_size != DB_PAGE_SIZE) {
+    throw std::runtime_error(std::string(format) +
+                             " needs pages of DB_PAGE_SIZE bytes");
+  }
+}
+
+inline void CopyPage(char* dest, const char* src, size_t page_size) {
+  WithPageSize(page_size, [&](auto size) { memcpy(dest, src, size); });
+}
+
+inline void ZeroPage(char* page, size_t page_size) {
+  WithPageSize(page_size, [&](auto size) { memset(page, 0, size); });
+}
+
+#endif
@@ -0,0 +1,31 @@
+#ifndef _STAGING_BUFFER_POOL_HPP_
+#define _STAGING_BUFFER_POOL_HPP_
+
+#include <config.hpp>
+
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+
+// Fixed set of page sized buffers that page images are copied into before
+// being handed to the disk thread, so a frame never has to stay latched for
+// the duration of its write.
+class StagingBufferPool {
+ public:
+  StagingBufferPool(size_t num_buffers, size_t page_size);
+  StagingBufferPool(const StagingBufferPool&) = delete;
+  StagingBufferPool& operator=(const StagingBufferPool&) = delete;
+
+  char* Acquire();
+  void Release(char*);
+  size_t Size() const;
+
+ private:
+  const size_t num_buffers_;
+  std::vector<char> data_;
+  std::vector<char*> free_buffers_;
+  mutable std::mutex mutex_;
+  std::condition_variable cv_;
+};
+
+#endif
@@ -0,0 +1,36 @@
+#ifndef _FREE_SPACE_MAP_HPP_
+#define _FREE_SPACE_MAP_HPP_
+
+#include <config.hpp>
+
+#include <array>
+#include <optional>
+#include <vector>
+
+// In-memory map from the pages of a table heap to how much room they have.
+// Pages are identified by their ordinal in the heap and rounded down to one
+// of NUM_CATEGORIES free space classes, each class keeps a bucket of pages
+// and a bitmap of non-empty classes gives a page with enough room in O(1).
+// Costs about 9 bytes per page. Not thread safe, the heap serializes access.
+class FreeSpaceMap {
+ public:
+  static constexpr size_t NUM_CATEGORIES = 64;
+  static constexpr size_t CATEGORY_SIZE = DB_PAGE_SIZE / NUM_CATEGORIES;
+
+  uint32_t AddPage(size_t free_space);
+  void Update(uint32_t ordinal, size_t free_space);
+  std::optional<uint32_t> FindPage(size_t needed) const;
+  size_t NumPages() const;
+
+ private:
+  static uint8_t Category_(size_t free_space);
+  void Insert_(uint32_t ordinal, uint8_t category);
+  void Erase_(uint32_t ordinal);
+
+  std::vector<uint8_t> categories_;
+  std::vector<uint32_t> positions_;
+  std::array<std::vector<uint32_t>, NUM_CATEGORIES> buckets_;
+  uint64_t non_empty_{0};
+};
+
+#endif
@@ -0,0 +1,67 @@
+#ifndef _PAX_TABLE_HPP_
+#define _PAX_TABLE_HPP_
+
+#include <buffer/buffer_pool_manager.hpp>
+#include <storage/table/pax_table_iterator.hpp>
+#include <storage/table/schema.hpp>
+#include <storage/table/tuple.hpp>
+#include <storage/table/zone_map.hpp>
+
+#include <mutex>
+#include <optional>
+#include <vector>
+
+// Append only table of fixed width tuples stored in a linked list of PAX
+// pages, for scans that read a few columns of wide tuples. Tuples are passed
+// in and returned in the row format of the schema.
+class PaxTable {
+ public:
+  // Creates an empty table
+  PaxTable(BufferPoolManager*, Schema);
+  // Opens the table starting at first_page_id
+  PaxTable(BufferPoolManager*, Schema, PageId_t first_page_id);
+
+  const Schema& GetSchema() const;
+  PageId_t GetFirstPageId() const;
+  // Ids of the pages in scan order, for splitting a scan into page ranges
+  std::vector<PageId_t> GetPageIds();
+  // Ids of the pages that may hold rows with the column in [low, high], in
+  // scan order. The bounds are values in the column's format. Pages are only
+  // skipped if the column has a zone map.
+  std::vector<PageId_t> GetPageIds(size_t column, const char* low,
+                                   const char* high);
+
+  // Keeps the minimum and maximum of the column on every page from now on,
+  // the pages already in the table are read once
+  void AddZoneMap(size_t column);
+
+  // Fails if the tuple size does not match the schema
+  std::optional<RID> InsertTuple(const Tuple&);
+  std::optional<Tuple> GetTuple(RID);
+
+  // Iterator over the given columns of all rows
+  PaxTableIterator Scan(std::vector<size_t> columns);
+  // Iterator over the given columns of the rows on some pages of the table,
+  // the pages are read ahead
+  PaxTableIterator Scan(std::vector<size_t> columns,
+                        std::vector<PageId_t> page_ids);
+
+ private:
+  // Next page of the table's current extent
+  PageId_t NewPage_();
+  void CheckColumns_(const std::vector<size_t>&) const;
+  void UpdateZones_(uint32_t ordinal, const Tuple&);
+
+  BufferPoolManager* bpm_;
+  Schema schema_;
+  PageId_t first_page_id_{INVALID_PAGE_ID};
+  PageId_t last_page_id_;
+  std::vector<PageId_t> page_ids_;
+  PageId_t next_page_id_{INVALID_PAGE_ID};
+  size_t extent_pages_left_{0};
+  ZoneMap zone_map_;
+  // Serializes writers
+  std::mutex mutex_;
+};
+
+#endif
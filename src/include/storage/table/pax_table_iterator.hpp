@@ -0,0 +1,69 @@
+#ifndef _PAX_TABLE_ITERATOR_HPP_
+#define _PAX_TABLE_ITERATOR_HPP_
+
+#include <buffer/buffer_pool_manager.hpp>
+#include <storage/table/schema.hpp>
+#include <storage/table/tuple.hpp>
+
+#include <cstring>
+#include <optional>
+#include <vector>
+
+// Pages of a page list that a scan reads ahead at once
+const size_t READ_AHEAD_PAGES = 32;
+
+// Forward iterator over the rows of a PAX table that only reads a projection
+// of the columns, the other minipages of a page are never touched. Values are
+// addressed by their position in the projection. Latches pages like
+// TableIterator. Scans that work a page at a time can use the minipages of
+// the current page directly and skip to the next page. An iterator over a
+// list of pages reads them in list order instead of following the page links
+// and prefetches the next READ_AHEAD_PAGES of them whenever it gets there.
+class PaxTableIterator {
+ public:
+  PaxTableIterator() = default;
+  PaxTableIterator(BufferPoolManager*, const Schema*, std::vector<size_t>,
+                   ReadPageGuard);
+  PaxTableIterator(BufferPoolManager*, const Schema*, std::vector<size_t>,
+                   std::vector<PageId_t>);
+
+  bool IsEnd() const;
+  RID GetRid() const;
+
+  const char* GetValue(size_t index) const {
+    return minipages_[index] + row_ * sizes_[index];
+  }
+
+  template <typename T>
+  T Get(size_t index) const {
+    T value;
+    memcpy(&value, GetValue(index), sizeof(T));
+    return value;
+  }
+
+  // Rows of the current page, the iterator can be anywhere on the page
+  uint32_t GetPageRows() const;
+  const char* GetMinipage(size_t index) const;
+
+  PaxTableIterator& operator++();
+  PaxTableIterator& NextPage();
+
+ private:
+  PageId_t NextPageId_() const;
+  void ReadPage_(PageId_t);
+  void LoadPage_();
+
+  BufferPoolManager* bpm_{nullptr};
+  const Schema* schema_{nullptr};
+  std::vector<size_t> columns_;
+  std::vector<size_t> sizes_;
+  std::vector<const char*> minipages_;
+  std::optional<ReadPageGuard> guard_;
+  // Empty when following the page links
+  std::vector<PageId_t> page_ids_;
+  size_t next_page_{0};
+  uint32_t num_rows_{0};
+  uint32_t row_{0};
+};
+
+#endif
@@ -0,0 +1,46 @@
+#ifndef _SCHEMA_HPP_
+#define _SCHEMA_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Fixed width column types. Dates are days since 1970-01-01 stored as int32,
+// Char columns are blank padded to their declared length.
+enum class TypeId : uint8_t { Int32, Int64, Float64, Date, Char };
+
+struct Column {
+  Column(std::string name, TypeId type, uint16_t length = 0);
+
+  std::string name;
+  TypeId type;
+  uint16_t size;
+};
+
+// Maps a value to an unsigned integer with the same order, equal values map
+// to equal integers. Char values longer than 8 bytes map by their first 8.
+uint64_t NormalizeKey(TypeId, const char* value, size_t width);
+
+// Ordered list of columns. Tuples in row format store the columns back to
+// back in schema order without padding.
+class Schema {
+ public:
+  explicit Schema(std::vector<Column>);
+
+  size_t GetColumnCount() const;
+  const Column& GetColumn(size_t) const;
+  std::optional<size_t> GetColumnIndex(std::string_view) const;
+  // Offset of a column within a tuple in row format
+  size_t GetOffset(size_t) const;
+  size_t GetTupleSize() const;
+
+ private:
+  std::vector<Column> columns_;
+  std::vector<size_t> offsets_;
+  size_t tuple_size_{0};
+};
+
+#endif
@@ -0,0 +1,47 @@
+#ifndef _TABLE_HEAP_HPP_
+#define _TABLE_HEAP_HPP_
+
+#include <buffer/buffer_pool_manager.hpp>
+#include <storage/table/free_space_map.hpp>
+#include <storage/table/table_iterator.hpp>
+#include <storage/table/tuple.hpp>
+
+#include <mutex>
+#include <optional>
+
+// Unordered collection of variable length tuples stored in a linked list of
+// slotted pages. Inserts go to a page found through the free space map and
+// only append a new page when no existing page has room.
+class TableHeap {
+ public:
+  // Creates an empty heap
+  explicit TableHeap(BufferPoolManager*);
+  // Opens the heap starting at first_page_id and rebuilds its free space map
+  TableHeap(BufferPoolManager*, PageId_t first_page_id);
+
+  PageId_t GetFirstPageId() const;
+
+  std::optional<RID> InsertTuple(const Tuple&);
+  std::optional<Tuple> GetTuple(RID);
+  // Fails when the new image does not fit in the tuple's page
+  bool UpdateTuple(RID, const Tuple&);
+  bool DeleteTuple(RID);
+
+  TableIterator Begin();
+  TableIterator End();
+
+ private:
+  // Next page of the table's current extent
+  PageId_t NewPage_();
+  BufferPoolManager* bpm_;
+  PageId_t first_page_id_{INVALID_PAGE_ID};
+  PageId_t last_page_id_;
+  // Serializes writers, always taken before a page latch
+  std::mutex mutex_;
+  FreeSpaceMap free_space_map_;
+  std::vector<PageId_t> page_ids_;
+  PageId_t next_page_id_{INVALID_PAGE_ID};
+  size_t extent_pages_left_{0};
+};
+
+#endif
@@ -0,0 +1,32 @@
+#ifndef _TABLE_ITERATOR_HPP_
+#define _TABLE_ITERATOR_HPP_
+
+#include <buffer/buffer_pool_manager.hpp>
+#include <storage/table/tuple.hpp>
+
+#include <optional>
+
+// Forward iterator over the live tuples of a table heap. It keeps a read
+// latch on the current page and latches the next page before releasing it,
+// so the owning thread must not modify the heap while the iterator is alive.
+class TableIterator {
+ public:
+  TableIterator() = default;
+  TableIterator(BufferPoolManager*, ReadPageGuard);
+
+  bool IsEnd() const;
+  Tuple operator*() const;
+  RID GetRid() const;
+  TableIterator& operator++();
+  bool operator==(const TableIterator&) const;
+  bool operator!=(const TableIterator&) const;
+
+ private:
+  void SkipDeleted_();
+
+  BufferPoolManager* bpm_{nullptr};
+  std::optional<ReadPageGuard> guard_;
+  RID rid_;
+};
+
+#endif
@@ -0,0 +1,36 @@
+#ifndef _TUPLE_HPP_
+#define _TUPLE_HPP_
+
+#include <config.hpp>
+
+#include <cstring>
+#include <vector>
+
+// Record id, the page holding a tuple and its slot in that page
+struct RID {
+  PageId_t page_id{INVALID_PAGE_ID};
+  uint32_t slot{0};
+
+  bool operator==(const RID& other) const {
+    return page_id == other.page_id && slot == other.slot;
+  }
+  bool operator!=(const RID& other) const { return !(*this == other); }
+};
+
+class Tuple {
+ public:
+  Tuple() = default;
+  Tuple(const char* data, size_t size) : data_(data, data + size) {}
+  Tuple(const char* data, size_t size, RID rid)
+      : data_(data, data + size), rid_(rid) {}
+
+  const char* GetData() const { return data_.data(); }
+  size_t GetSize() const { return data_.size(); }
+  RID GetRid() const { return rid_; }
+
+ private:
+  std::vector<char> data_;
+  RID rid_;
+};
+
+#endif
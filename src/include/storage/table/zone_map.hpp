@@ -0,0 +1,44 @@
+#ifndef _ZONE_MAP_HPP_
+#define _ZONE_MAP_HPP_
+
+#include <storage/table/schema.hpp>
+
+#include <cstdint>
+#include <vector>
+
+// In-memory summary of some columns of a table: the smallest and largest
+// value of each column on each page, so scans can skip pages whose range
+// excludes the predicate without reading them. Values are kept as normalized
+// keys, Char columns longer than 8 bytes are summarized by their first 8
+// bytes. Pages are identified by their ordinal. Costs 16 bytes per page and
+// column. Not thread safe, the table serializes access.
+class ZoneMap {
+ public:
+  explicit ZoneMap(const Schema&);
+
+  void AddColumn(size_t column);
+  bool HasColumn(size_t column) const;
+  const std::vector<size_t>& GetColumns() const;
+
+  // Widens the zone of the column on the page by a value in column format
+  void Update(uint32_t ordinal, size_t column, const char* value);
+  // Whether the page may hold a value of the column in [low, high], always
+  // true for columns without zones
+  bool MayContain(uint32_t ordinal, size_t column, const char* low,
+                  const char* high) const;
+
+ private:
+  struct Zone {
+    uint64_t min{UINT64_MAX};
+    uint64_t max{0};
+  };
+
+  uint64_t Key_(size_t column, const char* value) const;
+
+  Schema schema_;
+  std::vector<size_t> columns_;
+  // Zones of columns_[i] by page ordinal, pages without rows hold none
+  std::vector<std::vector<Zone>> zones_;
+};
+
+#endif
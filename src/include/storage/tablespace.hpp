@@ -0,0 +1,96 @@
+#ifndef _TABLESPACE_HPP_
+#define _TABLESPACE_HPP_
+
+#include <storage/disk_manager.hpp>
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+// Pages allocated one at a time are striped over the files of a tablespace
+// in runs of this many
+const size_t TABLESPACE_STRIPE_PAGES = 16;
+
+// Where a tablespace puts the extents it is asked to allocate
+enum class TablespacePlacement {
+  // Every extent goes to the next file in turn
+  RoundRobinExtents,
+  // The extents of an object go to the file of its first extent, objects are
+  // spread over the files in turn
+  PerObject,
+};
+
+// Disk manager that spreads the pages of a database over files in several
+// directories, which may sit on different devices. Each file is managed like
+// a db file of its own, with its own lock, and the disk scheduler gives each
+// its own queue, so the files serve I/O in parallel. An extent is placed
+// whole on one file, so it is still read back sequentially. The log and the
+// scratch file for temporary pages belong to the first file. Like the page
+// map of a db file, placements are not persisted.
+class Tablespace : public DiskManager {
+ public:
+  // One file of the given name in each of the directories, which must differ
+  Tablespace(const std::filesystem::path& file_name,
+             const std::vector<std::filesystem::path>& directories,
+             TablespacePlacement placement =
+                 TablespacePlacement::RoundRobinExtents,
+             size_t page_size = DB_PAGE_SIZE);
+  ~Tablespace() override;
+
+  void ShutDown() override;
+
+  void WritePage(PageId_t, const char*) override;
+  void ReadPage(PageId_t, char*) override;
+  void DeletePage(PageId_t) override;
+  void AllocateExtent(PageId_t first_page_id, size_t count,
+                      PageId_t owner = INVALID_PAGE_ID) override;
+  // Splits the batch by file, each part is written like a db file's batch
+  void WritePages(
+      const std::vector<std::pair<PageId_t, const char*>>&) override;
+  void Sync() override;
+  // Compacts every file, max_pages and pages_per_second apply to each
+  CompactionResult Compact(size_t max_pages = SIZE_MAX,
+                           size_t pages_per_second = 0) override;
+
+  size_t GetFileCount() const override;
+  size_t GetFile(PageId_t) const override;
+  // Byte offset of the page's slot in its file
+  std::optional<size_t> GetPageOffset(PageId_t) override;
+  std::filesystem::path GetFileName(size_t file) const;
+
+ private:
+  struct Extent {
+    size_t count;
+    size_t file;
+    // Pages not deleted yet, the extent is dropped once none are left
+    size_t live;
+    // Key of the object in objects_, INVALID_PAGE_ID if it has none
+    PageId_t object;
+  };
+
+  struct Object {
+    size_t file;
+    size_t extents;
+  };
+
+  // Counts a deleted page against its extent
+  void ReleaseExtentPage_(PageId_t);
+
+  TablespacePlacement placement_;
+  std::vector<std::filesystem::path> file_names_;
+  // Managers of the files after the first, index 0 stays empty. The first
+  // file is this object's own db file.
+  std::vector<std::unique_ptr<DiskManager>> files_;
+
+  mutable std::mutex mutex_;
+  // Placed extents by their first page id, dropped with their last page
+  std::map<PageId_t, Extent> extents_;
+  // File and live extents of each object under PerObject placement, by the
+  // object's first page id
+  std::unordered_map<PageId_t, Object> objects_;
+  size_t next_file_{0};
+};
+
+#endif
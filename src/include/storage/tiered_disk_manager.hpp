@@ -0,0 +1,140 @@
+#ifndef _TIERED_DISK_MANAGER_HPP_
+#define _TIERED_DISK_MANAGER_HPP_
+
+#include <storage/disk_manager.hpp>
+
+#include <chrono>
+#include <condition_variable>
+#include <optional>
+#include <set>
+#include <shared_mutex>
+#include <thread>
+
+// Pages moved between the tiers per second by the background migration
+const size_t TIER_MIGRATION_PAGES_PER_SECOND = 2560;
+// Milliseconds between migration rounds
+const size_t TIER_MIGRATION_INTERVAL_MS = 100;
+// Rounds after which the heat of a page halves
+const size_t TIER_HEAT_HALF_LIFE = 16;
+// Heat a slow page needs before it is promoted
+const uint32_t TIER_PROMOTE_HEAT = 4;
+
+enum class Tier { Fast, Slow };
+
+// Disk manager over a small fast file and a large slow file, in directories
+// on different devices. Every page lives on one tier. New pages go to the
+// fast tier while it has room. Reads and writes of a page heat it and the
+// heat decays over migration rounds. A background thread moves pages between
+// the tiers at most pages_per_second at a time: it demotes the coldest fast
+// pages to keep free room on the fast tier and promotes hot slow pages,
+// swapping them with fast pages that are much colder.
+//
+// A page is copied without blocking I/O and its new location is installed
+// only if the page was not written meanwhile. Sync writes a checkpoint of
+// the page map, with tiers, slots and heat, the files are reopened from it.
+// Writes after the last checkpoint are lost on a crash. A pages_per_second
+// of 0 leaves migration to explicit calls of Migrate. slow_latency is added
+// to every I/O of the slow tier to emulate a slow device.
+class TieredDiskManager : public DiskManager {
+ public:
+  TieredDiskManager(const std::filesystem::path& file_name,
+                    const std::filesystem::path& fast_directory,
+                    const std::filesystem::path& slow_directory,
+                    size_t fast_pages,
+                    size_t pages_per_second = TIER_MIGRATION_PAGES_PER_SECOND,
+                    std::chrono::microseconds slow_latency = {},
+                    size_t page_size = DB_PAGE_SIZE);
+  ~TieredDiskManager() override;
+
+  void ShutDown() override;
+
+  void WritePage(PageId_t, const char*) override;
+  void ReadPage(PageId_t, char*) override;
+  void DeletePage(PageId_t) override;
+  // Places the extent in adjacent slots at the end of one tier
+  void AllocateExtent(PageId_t first_page_id, size_t count,
+                      PageId_t owner = INVALID_PAGE_ID) override;
+  void WritePages(
+      const std::vector<std::pair<PageId_t, const char*>>&) override;
+  // Fsyncs both files and checkpoints the page map
+  void Sync() override;
+  // Truncates the free slots at the end of both files
+  CompactionResult Compact(size_t max_pages = SIZE_MAX,
+                           size_t pages_per_second = 0) override;
+  // Byte offset of the page's slot in the file of its tier
+  std::optional<size_t> GetPageOffset(PageId_t) override;
+
+  // One migration round that moves at most max_pages pages, returns the
+  // pages moved. The background thread runs one every
+  // TIER_MIGRATION_INTERVAL_MS.
+  size_t Migrate(size_t max_pages);
+  std::optional<Tier> GetTier(PageId_t) const;
+  size_t GetTierPages(Tier) const;
+  int GetNumPromotions() const;
+  int GetNumDemotions() const;
+  std::filesystem::path GetCheckpointFileName() const;
+  std::filesystem::path GetSlowFileName() const;
+
+ private:
+  struct Location {
+    Tier tier;
+    size_t slot;
+    uint32_t heat{0};
+    // Half-life the heat was last decayed in
+    uint64_t epoch{0};
+    // Bumped by every write once its data is in the slot, a copy made by
+    // migration is dropped if the page was written while it was copied
+    uint64_t version{0};
+  };
+
+  struct TierFile {
+    int fd{-1};
+    // Slots handed out, slot 0 holds the fast file's header and is left
+    // empty in the slow file
+    size_t num_slots{1};
+    std::set<size_t> free_slots;
+    size_t used{0};
+  };
+
+  TierFile& File_(Tier tier);
+  size_t AllocateSlot_(Tier tier);
+  void FreeSlot_(Tier tier, size_t slot);
+  // Fast while the fast tier has room
+  Tier NewPageTier_() const;
+  // Heat decayed to the current round
+  uint32_t Heat_(Location&) const;
+  void Touch_(Location&) const;
+  void Delay_(Tier tier) const;
+  // Copies the page to the other tier, false if it was written or deleted
+  // meanwhile
+  bool Move_(PageId_t page_id, Tier to, char* buffer);
+  void MigratorWork_();
+  void Checkpoint_();
+  void LoadCheckpoint_();
+
+  std::filesystem::path fast_file_name_;
+  std::filesystem::path slow_file_name_;
+  std::filesystem::path checkpoint_file_name_;
+  size_t fast_pages_;
+  size_t pages_per_second_;
+  std::chrono::microseconds slow_latency_;
+
+  // Guards the page map and the slot allocation
+  mutable std::mutex mutex_;
+  // Held shared across every page read and write, exclusively to install a
+  // moved page, so no I/O still uses the slot it frees
+  std::shared_mutex io_latch_;
+  std::unordered_map<PageId_t, Location> locations_;
+  TierFile fast_;
+  TierFile slow_;
+  uint64_t round_{0};
+  int num_promotions_{0};
+  int num_demotions_{0};
+
+  std::mutex migrator_mutex_;
+  std::condition_variable migrator_cv_;
+  bool stop_{false};
+  std::thread migrator_;
+};
+
+#endif
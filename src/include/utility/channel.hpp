@@ -4,6 +4,7 @@
 #include <condition_variable>
 #include <mutex>
 #include <queue>
+#include <vector>
 
 template <typename T>
 class Channel {
@@ -25,6 +26,18 @@ class Channel {
     return e;
   }
 
+  std::vector<T> GetAll() {
+    std::unique_lock<std::mutex> l(mutex_);
+    cv_.wait(l, [&]() { return !q_.empty(); });
+    std::vector<T> elements;
+    elements.reserve(q_.size());
+    while (!q_.empty()) {
+      elements.push_back(std::move(q_.front()));
+      q_.pop();
+    }
+    return elements;
+  }
+
  private:
   std::mutex mutex_;
   std::condition_variable cv_;
@@ -0,0 +1,63 @@
+#ifndef _PARALLEL_SORT_HPP_
+#define _PARALLEL_SORT_HPP_
+
+#include <algorithm>
+#include <iterator>
+#include <thread>
+#include <vector>
+
+// Runs shorter than this are not worth a thread of their own
+const size_t PARALLEL_SORT_MIN_RUN = 1 << 14;
+
+// Stable sort of [first, last). The range is cut into one run per thread,
+// runs are sorted concurrently and then merged pairwise, also concurrently,
+// until a single run is left.
+template <typename RandomIt, typename Compare>
+void ParallelSort(RandomIt first, RandomIt last, Compare comp,
+                  size_t num_threads = std::thread::hardware_concurrency()) {
+  const size_t size = std::distance(first, last);
+  num_threads = std::min(num_threads, size / PARALLEL_SORT_MIN_RUN);
+  if (num_threads <= 1) {
+    std::stable_sort(first, last, comp);
+    return;
+  }
+
+  std::vector<size_t> bounds;
+  for (size_t i = 0; i <= num_threads; i++) {
+    bounds.push_back(size * i / num_threads);
+  }
+
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i + 1 < bounds.size(); i++) {
+    threads.emplace_back([&, i]() {
+      std::stable_sort(first + bounds[i], first + bounds[i + 1], comp);
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  while (bounds.size() > 2) {
+    std::vector<size_t> merged;
+    threads.clear();
+    size_t i = 0;
+    for (; i + 2 < bounds.size(); i += 2) {
+      threads.emplace_back([&, i]() {
+        std::inplace_merge(first + bounds[i], first + bounds[i + 1],
+                           first + bounds[i + 2], comp);
+      });
+      merged.push_back(bounds[i]);
+    }
+    if (i + 1 < bounds.size()) {
+      merged.push_back(bounds[i]);
+    }
+    merged.push_back(bounds.back());
+
+    for (auto& thread : threads) {
+      thread.join();
+    }
+    bounds = std::move(merged);
+  }
+}
+
+#endif
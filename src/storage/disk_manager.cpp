@@ -1,25 +1,50 @@
 #include <storage/disk_manager.hpp>
 
+#include <fcntl.h>
 #include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
 #include <cassert>
+#include <chrono>
 #include <cstring>
+#include <functional>
 #include <stdexcept>
 #include <thread>
 
 #include <iostream>
 
-DiskManager::DiskManager(const std::filesystem::path& p) : db_file_name_(p) {
-  log_file_name_ = p.filename().stem().string() + ".log";
-  log_io_.open(log_file_name_,
-               std::ios::binary | std::ios::in | std::ios::app | std::ios::out);
+namespace {
 
-  if (!log_io_.is_open()) {
-    log_io_.clear();
+// Slot 0 of a db file holds the header, the rest of the slot is zero
+struct FileHeader {
+  uint64_t magic;
+  uint64_t page_size;
+};
+
+const uint64_t FILE_MAGIC = 0x4442504147455331;
+
+}  // namespace
+
+DiskManager::DiskManager(const std::filesystem::path& p, size_t page_size,
+                         bool has_log)
+    : page_size_(page_size), db_file_name_(p) {
+  if (!IsValidPageSize(page_size)) {
+    throw std::runtime_error("Invalid page size");
+  }
+  if (has_log) {
+    log_file_name_ = p.filename().stem().string() + ".log";
+    temp_file_name_ = p.filename().stem().string() + ".tmp";
     log_io_.open(log_file_name_, std::ios::binary | std::ios::in |
-                                     std::ios::trunc | std::ios::out);
+                                     std::ios::app | std::ios::out);
 
     if (!log_io_.is_open()) {
-      throw std::runtime_error("Can't open db log file");
+      log_io_.clear();
+      log_io_.open(log_file_name_, std::ios::binary | std::ios::in |
+                                       std::ios::trunc | std::ios::out);
+
+      if (!log_io_.is_open()) {
+        throw std::runtime_error("Can't open db log file");
+      }
     }
   }
 
@@ -35,15 +60,24 @@ DiskManager::DiskManager(const std::filesystem::path& p) : db_file_name_(p) {
     }
   }
 
-  std::filesystem::resize_file(p, page_capacity_ * DB_PAGE_SIZE);
-  if (static_cast<size_t>(GetFileSize(db_file_name_)) <
-      page_capacity_ * DB_PAGE_SIZE) {
+  // An existing file keeps its page size and is only ever grown
+  bool has_header = ReadHeader_();
+  if (std::filesystem::file_size(p) < page_capacity_ * page_size_) {
+    std::filesystem::resize_file(p, page_capacity_ * page_size_);
+  }
+  if (GetFileSize(db_file_name_).value_or(0) < page_capacity_ * page_size_) {
     throw std::runtime_error("File size lower than expected");
   }
-
-  for (size_t i = 0; i < page_capacity_; i++) {
-    free_slots_.push_back(i*DB_PAGE_SIZE);
+  if (!has_header) {
+    WriteHeader_();
   }
+
+  SetSlots_(0, page_capacity_, true);
+  SetSlots_(0, 1, false);
+}
+
+size_t DiskManager::GetPageSize() const {
+  return page_size_;
 }
 
 void DiskManager::ShutDown() {
@@ -52,6 +86,13 @@ void DiskManager::ShutDown() {
     db_io_.close();
   }
   log_io_.close();
+  {
+    std::unique_lock<std::mutex> l(temp_io_mutex_);
+    if (temp_io_.is_open()) {
+      temp_io_.close();
+      std::filesystem::remove(temp_file_name_);
+    }
+  }
 }
 
 void DiskManager::WritePage(PageId_t page_id, const char* data) {
@@ -65,7 +106,7 @@ void DiskManager::WritePage(PageId_t page_id, const char* data) {
   }
 
   db_io_.seekp(offset);
-  db_io_.write(data, DB_PAGE_SIZE);
+  db_io_.write(data, page_size_);
 
   if (db_io_.bad()) {
     throw std::runtime_error("Error writing data to file");
@@ -85,28 +126,114 @@ void DiskManager::ReadPage(PageId_t page_id, char* buffer) {
     offset = AllocatePage();
   }
 
-  int file_size = GetFileSize(db_file_name_);
-  if (file_size < 0) {
+  auto file_size = GetFileSize(db_file_name_);
+  if (!file_size.has_value()) {
     throw std::runtime_error("Error while getting file size");
   }
 
-  if (offset + DB_PAGE_SIZE > static_cast<size_t>(file_size)) {
+  if (offset + page_size_ > *file_size) {
     throw std::runtime_error("Offset outside file size");
   }
 
   pages_[page_id] = offset;
   db_io_.seekp(offset);
-  db_io_.read(buffer, DB_PAGE_SIZE);
+  db_io_.read(buffer, page_size_);
 
   if (db_io_.bad()) {
     throw std::runtime_error("Error reading data from file");
   }
 
-  int read_count = db_io_.gcount();
-  if (read_count < DB_PAGE_SIZE) {
+  if (static_cast<size_t>(db_io_.gcount()) < page_size_) {
     db_io_.clear();
     throw std::runtime_error("Error reading data from file");
   }
+  num_reads_ += 1;
+}
+
+void DiskManager::WritePages(
+    const std::vector<std::pair<PageId_t, const char*>>& pages) {
+  if (pages.empty()) {
+    return;
+  }
+
+  // Only the last write of a page within the batch is kept, new pages are
+  // given slots in page id order so that they end up next to each other.
+  std::vector<std::pair<PageId_t, const char*>> by_page(pages.begin(),
+                                                        pages.end());
+  std::stable_sort(
+      by_page.begin(), by_page.end(),
+      [](const auto& a, const auto& b) { return a.first < b.first; });
+
+  std::unique_lock<std::mutex> l(db_io_mutex_);
+  std::vector<std::pair<size_t, const char*>> writes;
+  writes.reserve(by_page.size());
+  for (size_t i = 0; i < by_page.size(); i++) {
+    if (i + 1 < by_page.size() && by_page[i + 1].first == by_page[i].first) {
+      continue;
+    }
+
+    PageId_t page_id = by_page[i].first;
+    size_t offset;
+    auto it = pages_.find(page_id);
+    if (it != pages_.end()) {
+      offset = it->second;
+    } else {
+      offset = AllocatePage();
+      pages_[page_id] = offset;
+    }
+    writes.push_back({offset, by_page[i].second});
+  }
+
+  std::sort(writes.begin(), writes.end(),
+            [](const auto& a, const auto& b) { return a.first < b.first; });
+
+  std::vector<char> run;
+  size_t begin = 0;
+  while (begin < writes.size()) {
+    size_t end = begin + 1;
+    while (end < writes.size() && end - begin < DB_MAX_COALESCED_PAGES &&
+           writes[end].first == writes[end - 1].first + page_size_) {
+      end++;
+    }
+
+    db_io_.seekp(writes[begin].first);
+    if (end - begin == 1) {
+      db_io_.write(writes[begin].second, page_size_);
+    } else {
+      run.resize((end - begin) * page_size_);
+      for (size_t i = begin; i < end; i++) {
+        CopyPage(run.data() + (i - begin) * page_size_, writes[i].second,
+                 page_size_);
+      }
+      db_io_.write(run.data(), run.size());
+    }
+
+    if (db_io_.bad()) {
+      throw std::runtime_error("Error writing data to file");
+    }
+    begin = end;
+  }
+
+  num_writes_ += writes.size();
+  db_io_.flush();
+}
+
+void DiskManager::Sync() {
+  std::unique_lock<std::mutex> l(db_io_mutex_);
+  if (!db_io_.is_open()) {
+    return;
+  }
+
+  db_io_.flush();
+  int fd = open(db_file_name_.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw std::runtime_error("Can't open db file for sync");
+  }
+  int rc = fsync(fd);
+  close(fd);
+  if (rc != 0) {
+    throw std::runtime_error("Error syncing db file");
+  }
 }
 
 void DiskManager::DeletePage(PageId_t page_id) {
@@ -116,15 +243,114 @@ void DiskManager::DeletePage(PageId_t page_id) {
   }
 
   size_t offset = pages_[page_id];
-  free_slots_.push_back(offset);
+  SetSlots_(offset / page_size_, 1, true);
   pages_.erase(page_id);
   num_deletes_ += 1;
 }
 
-void DiskManager::WriteLog(char* data, int size) {
+void DiskManager::AllocateExtent(PageId_t first_page_id, size_t count,
+                                 PageId_t) {
+  std::unique_lock<std::mutex> l(db_io_mutex_);
+  size_t offset = AllocateSlots_(count);
+  for (size_t i = 0; i < count; i++) {
+    pages_[first_page_id + i] = offset + i * page_size_;
+  }
+  Fallocate_(0, offset, count * page_size_);
+}
+
+CompactionResult DiskManager::Compact(size_t max_pages,
+                                      size_t pages_per_second) {
+  CompactionResult result;
+  result.file_size_before = GetDbFileSize();
+  std::vector<char> buffer(page_size_);
+  while (result.pages_moved < max_pages) {
+    auto start = std::chrono::steady_clock::now();
+    size_t limit =
+        std::min(COMPACTION_BATCH_PAGES, max_pages - result.pages_moved);
+    size_t moved;
+    {
+      std::unique_lock<std::mutex> l(db_io_mutex_);
+      moved = RelocateTail_(limit, buffer.data());
+    }
+    result.pages_moved += moved;
+    if (moved < limit) {
+      break;
+    }
+    if (pages_per_second > 0) {
+      std::this_thread::sleep_until(
+          start + std::chrono::microseconds(moved * 1000000 /
+                                            pages_per_second));
+    }
+  }
+  result.bytes_copied = 2 * result.pages_moved * page_size_;
+
+  {
+    std::unique_lock<std::mutex> l(db_io_mutex_);
+    Shrink_(result);
+  }
+  result.file_size_after = GetDbFileSize();
+  return result;
+}
+
+void DiskManager::WriteTempPage(PageId_t page_id, const char* data) {
+  if (temp_file_name_.empty()) {
+    throw std::runtime_error("Db file has no scratch file");
+  }
+  std::unique_lock<std::mutex> l(temp_io_mutex_);
+  if (!temp_io_.is_open()) {
+    temp_io_.open(temp_file_name_, std::ios::binary | std::ios::in |
+                                       std::ios::trunc | std::ios::out);
+    if (!temp_io_.is_open()) {
+      throw std::runtime_error("Can't open scratch file");
+    }
+  }
+
+  auto it = temp_pages_.find(page_id);
+  if (it == temp_pages_.end()) {
+    it = temp_pages_.emplace(page_id, next_temp_slot_++ * page_size_).first;
+  }
+  temp_io_.seekp(it->second);
+  temp_io_.write(data, page_size_);
+  if (temp_io_.bad()) {
+    throw std::runtime_error("Error writing data to scratch file");
+  }
+  num_temp_writes_ += 1;
+}
+
+void DiskManager::ReadTempPage(PageId_t page_id, char* buffer) {
+  std::unique_lock<std::mutex> l(temp_io_mutex_);
+  auto it = temp_pages_.find(page_id);
+  if (it == temp_pages_.end()) {
+    throw std::runtime_error("Temporary page was never written");
+  }
+
+  temp_io_.flush();
+  temp_io_.seekg(it->second);
+  temp_io_.read(buffer, page_size_);
+  if (temp_io_.bad() ||
+      static_cast<size_t>(temp_io_.gcount()) < page_size_) {
+    temp_io_.clear();
+    throw std::runtime_error("Error reading data from scratch file");
+  }
+}
+
+void DiskManager::DeleteTempPage(PageId_t page_id) {
+  std::unique_lock<std::mutex> l(temp_io_mutex_);
+  if (temp_pages_.erase(page_id) == 0 || !temp_pages_.empty()) {
+    return;
+  }
+  next_temp_slot_ = 0;
+  temp_io_.flush();
+  std::filesystem::resize_file(temp_file_name_, 0);
+}
+
+void DiskManager::WriteLog(char* data, size_t size) {
   if (size == 0) {
     return;
   }
+  if (!log_io_.is_open()) {
+    throw std::runtime_error("Db file has no log");
+  }
 
   flush_log_ = true;
 
@@ -143,8 +369,11 @@ void DiskManager::WriteLog(char* data, int size) {
   flush_log_ = false;
 }
 
-void DiskManager::ReadLog(char* buffer, int size, int offset) {
-  if (offset + size > GetFileSize(log_file_name_)) {
+void DiskManager::ReadLog(char* buffer, size_t size, size_t offset) {
+  if (!log_io_.is_open()) {
+    throw std::runtime_error("Db file has no log");
+  }
+  if (offset + size > GetFileSize(log_file_name_).value_or(0)) {
     throw std::runtime_error("Error, tried to read log outside of file");
   }
   log_io_.seekp(offset);
@@ -154,7 +383,7 @@ void DiskManager::ReadLog(char* buffer, int size, int offset) {
     throw std::runtime_error("Error reading log");
   }
 
-  int read_count = log_io_.gcount();
+  size_t read_count = log_io_.gcount();
   if (read_count < size) {
     log_io_.clear();
     memset(buffer + read_count, 0, size - read_count);
@@ -173,10 +402,18 @@ int DiskManager::GetNumWrites() const {
   return num_writes_;
 }
 
+int DiskManager::GetNumReads() const {
+  return num_reads_;
+}
+
 int DiskManager::GetNumDeletes() const {
   return num_deletes_;
 }
 
+int DiskManager::GetNumTempWrites() const {
+  return num_temp_writes_;
+}
+
 void DiskManager::SetFlushLogFuture(std::future<void>* f) {
   flush_log_f_ = f;
 }
@@ -190,32 +427,233 @@ std::filesystem::path DiskManager::GetLogFileName() const {
 }
 
 size_t DiskManager::GetDbFileSize() {
-  int file_size = GetFileSize(db_file_name_);
-  if (file_size < 0) {
-    return -1;
+  return GetFileSize(db_file_name_).value_or(-1);
+}
+
+std::optional<size_t> DiskManager::GetPageOffset(PageId_t page_id) {
+  std::unique_lock<std::mutex> l(db_io_mutex_);
+  auto it = pages_.find(page_id);
+  if (it == pages_.end()) {
+    return std::nullopt;
   }
+  return it->second;
+}
+
+size_t DiskManager::GetFileCount() const {
+  return 1;
+}
 
-  return static_cast<size_t>(file_size);
+size_t DiskManager::GetFile(PageId_t) const {
+  return 0;
 }
 
-int DiskManager::GetFileSize(const std::string& name) {
+std::optional<size_t> DiskManager::GetFileSize(
+    const std::filesystem::path& name) {
   struct stat stat_buf;
-  int rc = stat(db_file_name_.c_str(), &stat_buf);
-  return rc == 0 ? static_cast<int>(stat_buf.st_size) : -1;
+  if (stat(name.c_str(), &stat_buf) != 0) {
+    return std::nullopt;
+  }
+  return static_cast<size_t>(stat_buf.st_size);
+}
+
+// The highest used slot moves to the lowest free slot until no free slot is
+// below a used one
+size_t DiskManager::RelocateTail_(size_t limit, char* buffer) {
+  std::vector<std::pair<size_t, PageId_t>> tail;
+  tail.reserve(pages_.size());
+  for (const auto& [page_id, offset] : pages_) {
+    tail.push_back({offset, page_id});
+  }
+  limit = std::min(limit, tail.size());
+  std::partial_sort(tail.begin(), tail.begin() + limit, tail.end(),
+                    std::greater<>());
+
+  size_t moved = 0;
+  size_t target = 0;
+  for (; moved < limit; moved++) {
+    auto [offset, page_id] = tail[moved];
+    target = NextFreeSlot_(target);
+    if (target > offset / page_size_) {
+      break;
+    }
+
+    db_io_.seekg(offset);
+    db_io_.read(buffer, page_size_);
+    if (db_io_.bad() ||
+        static_cast<size_t>(db_io_.gcount()) < page_size_) {
+      db_io_.clear();
+      throw std::runtime_error("Error reading data from file");
+    }
+    db_io_.seekp(target * page_size_);
+    db_io_.write(buffer, page_size_);
+    if (db_io_.bad()) {
+      throw std::runtime_error("Error writing data to file");
+    }
+    pages_[page_id] = target * page_size_;
+    SetSlots_(target, 1, false);
+    SetSlots_(offset / page_size_, 1, true);
+  }
+  db_io_.flush();
+  return moved;
+}
+
+// Slots past the last used one are forgotten, so the next allocations
+// continue right after it
+void DiskManager::Shrink_(CompactionResult& result) {
+  size_t end = 1;
+  for (const auto& [page_id, offset] : pages_) {
+    end = std::max(end, offset / page_size_ + 1);
+  }
+  num_slots_ = end;
+  free_slots_.resize((end + 63) / 64);
+  punched_slots_.resize(free_slots_.size());
+  if (end % 64 != 0) {
+    free_slots_.back() &= (uint64_t{1} << (end % 64)) - 1;
+    punched_slots_.back() &= (uint64_t{1} << (end % 64)) - 1;
+  }
+
+  db_io_.flush();
+  page_capacity_ = std::max(end, DEFAULT_DB_IO_SIZE);
+  if (GetDbFileSize() > page_capacity_ * page_size_) {
+    std::filesystem::resize_file(db_file_name_, page_capacity_ * page_size_);
+  }
+
+  // Runs punched by an earlier compaction are skipped, so their space is not
+  // counted twice
+  size_t slot = NextFreeSlot_(0);
+  while (slot < num_slots_) {
+    size_t run_end = slot + 1;
+    while (run_end < num_slots_ && IsFree_(run_end)) {
+      run_end++;
+    }
+    while (slot < run_end) {
+      if (IsPunched_(slot)) {
+        slot++;
+        continue;
+      }
+      size_t hole_end = slot + 1;
+      while (hole_end < run_end && !IsPunched_(hole_end)) {
+        hole_end++;
+      }
+      // File systems without hole punching keep the space
+      if (!Fallocate_(FALLOC_FL_PUNCH_HOLE | FALLOC_FL_KEEP_SIZE,
+                      slot * page_size_, (hole_end - slot) * page_size_)) {
+        return;
+      }
+      result.bytes_punched += (hole_end - slot) * page_size_;
+      for (; slot < hole_end; slot++) {
+        punched_slots_[slot / 64] |= uint64_t{1} << (slot % 64);
+      }
+    }
+    slot = NextFreeSlot_(run_end);
+  }
+}
+
+bool DiskManager::ReadHeader_() {
+  FileHeader header;
+  db_io_.seekg(0);
+  db_io_.read(reinterpret_cast<char*>(&header), sizeof(header));
+  if (static_cast<size_t>(db_io_.gcount()) < sizeof(header)) {
+    db_io_.clear();
+    return false;
+  }
+  if (header.magic != FILE_MAGIC || !IsValidPageSize(header.page_size)) {
+    return false;
+  }
+  page_size_ = header.page_size;
+  return true;
+}
+
+void DiskManager::WriteHeader_() {
+  std::vector<char> slot(page_size_, 0);
+  FileHeader header{FILE_MAGIC, page_size_};
+  memcpy(slot.data(), &header, sizeof(header));
+  db_io_.seekp(0);
+  db_io_.write(slot.data(), slot.size());
+  if (db_io_.bad()) {
+    throw std::runtime_error("Error writing data to file");
+  }
+  db_io_.flush();
 }
 
 size_t DiskManager::AllocatePage() {
-  if (!free_slots_.empty()) {
-    auto offset = free_slots_.front();
-    free_slots_.pop_front();
-    return offset;
+  return AllocateSlots_(1);
+}
+
+size_t DiskManager::AllocateSlots_(size_t count) {
+  size_t first = num_slots_;
+  size_t slot = NextFreeSlot_(0);
+  while (slot < num_slots_) {
+    size_t run_end = slot + 1;
+    while (run_end < num_slots_ && run_end - slot < count &&
+           IsFree_(run_end)) {
+      run_end++;
+    }
+    // A free run at the end of the file is extended past it
+    if (run_end - slot == count || run_end == num_slots_) {
+      first = slot;
+      break;
+    }
+    slot = NextFreeSlot_(run_end);
   }
+  SetSlots_(first, count, false);
 
-  if (pages_.size() + 1 >= page_capacity_) {
-    page_capacity_ *= 2;
+  if (num_slots_ >= page_capacity_) {
+    while (num_slots_ >= page_capacity_) {
+      page_capacity_ *= 2;
+    }
     std::filesystem::resize_file(db_file_name_,
-                                 (page_capacity_ + 1) * DB_PAGE_SIZE);
+                                 (page_capacity_ + 1) * page_size_);
+  }
+  return first * page_size_;
+}
+
+void DiskManager::SetSlots_(size_t first_slot, size_t count, bool free) {
+  if (first_slot + count > num_slots_) {
+    num_slots_ = first_slot + count;
+    free_slots_.resize((num_slots_ + 63) / 64);
+    punched_slots_.resize(free_slots_.size());
+  }
+  for (size_t slot = first_slot; slot < first_slot + count; slot++) {
+    uint64_t bit = uint64_t{1} << (slot % 64);
+    if (free) {
+      free_slots_[slot / 64] |= bit;
+    } else {
+      free_slots_[slot / 64] &= ~bit;
+      punched_slots_[slot / 64] &= ~bit;
+    }
+  }
+}
+
+bool DiskManager::IsFree_(size_t slot) const {
+  return (free_slots_[slot / 64] >> (slot % 64)) & 1;
+}
+
+bool DiskManager::IsPunched_(size_t slot) const {
+  return (punched_slots_[slot / 64] >> (slot % 64)) & 1;
+}
+
+size_t DiskManager::NextFreeSlot_(size_t slot) const {
+  size_t word = slot / 64;
+  if (word >= free_slots_.size()) {
+    return num_slots_;
   }
+  uint64_t bits = free_slots_[word] & (~uint64_t{0} << (slot % 64));
+  while (bits == 0) {
+    if (++word == free_slots_.size()) {
+      return num_slots_;
+    }
+    bits = free_slots_[word];
+  }
+  return std::min(word * 64 + __builtin_ctzll(bits), num_slots_);
+}
 
-  return pages_.size() * DB_PAGE_SIZE;
+bool DiskManager::Fallocate_(int mode, size_t offset, size_t length) {
+  int fd = open(db_file_name_.c_str(), O_WRONLY);
+  if (fd < 0) {
+    throw std::runtime_error("Can't open db file");
+  }
+  int rc = fallocate(fd, mode, offset, length);
+  close(fd);
+  return rc == 0;
 }
@@ -1,50 +1,166 @@
 #include <storage/disk_scheduler.hpp>
 
+#include <cstring>
+#include <exception>
 #include <iostream>
 
-DiskScheduler::DiskScheduler(DiskManager* m) : disk_manager_(m) {
-  worker_thread_.emplace([&] { StartWorkerThread(); });
+DiskScheduler::DiskScheduler(DiskManager* m)
+    : disk_manager_(m),
+      staging_buffers_(DB_STAGING_BUFFERS, m->GetPageSize()) {
+  for (size_t i = 0; i < m->GetFileCount(); i++) {
+    request_qs_.push_back(
+        std::make_unique<Channel<std::optional<DiskRequest>>>());
+  }
+  for (size_t i = 0; i < request_qs_.size(); i++) {
+    worker_threads_.emplace_back([this, i] { StartWorkerThread(i); });
+  }
 }
 
 DiskScheduler::~DiskScheduler() {
   end_thread_ = true;
-  request_q_.Put(std::nullopt);
-  if (worker_thread_.has_value()) {
-    worker_thread_->join();
+  for (auto& q : request_qs_) {
+    q->Put(std::nullopt);
+  }
+  for (auto& t : worker_threads_) {
+    t.join();
   }
 }
 
 void DiskScheduler::Schedule(std::vector<DiskRequest>& requests) {
   for (auto& r : requests) {
-    request_q_.Put(std::move(r));
+    Put_(std::move(r));
   }
 }
 
-  bool is_write;
-  char* data;
-  PageId_t page_id;
-  DiskSchedulerPromise cb;
+void DiskScheduler::Put_(DiskRequest r) {
+  size_t queue = r.is_temp ? 0 : disk_manager_->GetFile(r.page_id);
+  request_qs_[queue]->Put(std::move(r));
+}
 
-void DiskScheduler::StartWorkerThread() {
+std::future<bool> DiskScheduler::ScheduleWriteCopy(PageId_t page_id,
+                                                   const char* data,
+                                                   bool is_temp) {
+  char* buffer = staging_buffers_.Acquire();
+  CopyPage(buffer, data, disk_manager_->GetPageSize());
+  DiskRequest req{.is_write = true,
+                  .data = buffer,
+                  .page_id = page_id,
+                  .cb = CreatePromise(),
+                  .is_staged = true,
+                  .is_temp = is_temp};
+  auto fut = req.cb.get_future();
+  Put_(std::move(req));
+  return fut;
+}
+
+void DiskScheduler::StartWorkerThread(size_t queue) {
   while (true) {
-    auto r(request_q_.Get());
-    if (!r.has_value() && end_thread_) {
-      break;
+    // Everything queued so far is drained at once so that runs of writes can
+    // be handed to the disk manager as a single batch. A read ends the run to
+    // keep requests for the same page in order.
+    auto requests = request_qs_[queue]->GetAll();
+    std::vector<DiskRequest*> writes;
+    for (auto& r : requests) {
+      if (!r.has_value() && end_thread_) {
+        ProcessWrites_(writes);
+        return;
+      }
+
+      // Temporary pages never share ids with queued data file writes
+      if (r->is_temp) {
+        std::exception_ptr error;
+        try {
+          if (r->is_write) {
+            disk_manager_->WriteTempPage(r->page_id, r->data);
+          } else {
+            disk_manager_->ReadTempPage(r->page_id, r->data);
+          }
+        } catch (...) {
+          error = std::current_exception();
+        }
+        Finish_(*r, error);
+        continue;
+      }
+
+      if (r->is_write) {
+        writes.push_back(&r.value());
+        continue;
+      }
+
+      ProcessWrites_(writes);
+      std::exception_ptr error;
+      try {
+        disk_manager_->ReadPage(r->page_id, r->data);
+      } catch (...) {
+        error = std::current_exception();
+      }
+      Finish_(*r, error);
     }
+    ProcessWrites_(writes);
+  }
+}
 
-    if (r->is_write) {
-      disk_manager_->WritePage(r->page_id, r->data);
+void DiskScheduler::ProcessWrites_(std::vector<DiskRequest*>& writes) {
+  if (writes.empty()) {
+    return;
+  }
+
+  std::exception_ptr error;
+  try {
+    if (writes.size() == 1) {
+      disk_manager_->WritePage(writes[0]->page_id, writes[0]->data);
     } else {
-      disk_manager_->ReadPage(r->page_id, r->data);
+      std::vector<std::pair<PageId_t, const char*>> pages;
+      pages.reserve(writes.size());
+      for (auto* r : writes) {
+        pages.push_back({r->page_id, r->data});
+      }
+      disk_manager_->WritePages(pages);
     }
-    r->cb.set_value(true);
+  } catch (...) {
+    error = std::current_exception();
   }
+
+  for (auto* r : writes) {
+    Finish_(*r, error);
+  }
+  writes.clear();
+}
+
+// Staged buffers go back to the pool whether the I/O worked or not, a failed
+// request hands its error to the waiter
+void DiskScheduler::Finish_(DiskRequest& r, std::exception_ptr error) {
+  if (r.is_staged) {
+    staging_buffers_.Release(r.data);
+  }
+  if (error) {
+    r.cb.set_exception(error);
+  } else {
+    r.cb.set_value(true);
+  }
+}
+
+size_t DiskScheduler::GetQueueCount() const {
+  return request_qs_.size();
 }
 
 DiskSchedulerPromise DiskScheduler::CreatePromise() {
   return {};
 }
 
+void DiskScheduler::AllocateExtent(PageId_t first_page_id, size_t count,
+                                   PageId_t owner) {
+  disk_manager_->AllocateExtent(first_page_id, count, owner);
+}
+
 void DiskScheduler::DeallocatePage(PageId_t page_id) {
   disk_manager_->DeletePage(page_id);
 }
+
+void DiskScheduler::DeallocateTempPage(PageId_t page_id) {
+  disk_manager_->DeleteTempPage(page_id);
+}
+
+void DiskScheduler::Sync() {
+  disk_manager_->Sync();
+}
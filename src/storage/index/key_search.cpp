@@ -0,0 +1,194 @@
+#include <storage/index/key_search.hpp>
+
+#include <algorithm>
+#include <cstring>
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+namespace {
+
+// Range left to the counting kernels, four cache lines
+const int WINDOW_BYTES = 256;
+
+// Number of keys before the bound, keys < key for a lower bound and
+// keys <= key for an upper bound
+template <typename T, bool UPPER>
+int CountScalar(const T* keys, int n, T key) {
+  int count = 0;
+  for (int i = 0; i < n; i++) {
+    count += UPPER ? keys[i] <= key : keys[i] < key;
+  }
+  return count;
+}
+
+#if defined(__x86_64__)
+
+// The vector kernels count keys[i] > key for an upper bound and subtract it
+// from n, integer compares only come in the greater-than flavour.
+template <typename T, bool UPPER>
+__attribute__((target("sse4.2,popcnt"))) int CountSse(const T* keys, int n,
+                                                       T key) {
+  constexpr int LANES = 16 / sizeof(T);
+  __m128i k = sizeof(T) == 8 ? _mm_set1_epi64x(key) : _mm_set1_epi32(key);
+  int count = 0;
+  int i = 0;
+  for (; i + LANES <= n; i += LANES) {
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(keys + i));
+    __m128i a = UPPER ? v : k;
+    __m128i b = UPPER ? k : v;
+    if constexpr (sizeof(T) == 8) {
+      count += __builtin_popcount(
+          _mm_movemask_pd(_mm_castsi128_pd(_mm_cmpgt_epi64(a, b))));
+    } else {
+      count += __builtin_popcount(
+          _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(a, b))));
+    }
+  }
+  if (UPPER) {
+    count = i - count;
+  }
+  return count + CountScalar<T, UPPER>(keys + i, n - i, key);
+}
+
+template <typename T, bool UPPER>
+__attribute__((target("avx2,popcnt"))) int CountAvx2(const T* keys, int n,
+                                                     T key) {
+  constexpr int LANES = 32 / sizeof(T);
+  __m256i k =
+      sizeof(T) == 8 ? _mm256_set1_epi64x(key) : _mm256_set1_epi32(key);
+  int count = 0;
+  int i = 0;
+  for (; i + LANES <= n; i += LANES) {
+    __m256i v =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(keys + i));
+    __m256i a = UPPER ? v : k;
+    __m256i b = UPPER ? k : v;
+    if constexpr (sizeof(T) == 8) {
+      count += __builtin_popcount(
+          _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpgt_epi64(a, b))));
+    } else {
+      count += __builtin_popcount(
+          _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(a, b))));
+    }
+  }
+  if (UPPER) {
+    count = i - count;
+  }
+  return count + CountScalar<T, UPPER>(keys + i, n - i, key);
+}
+
+template <typename T, bool UPPER>
+__attribute__((target("avx512f,popcnt"))) int CountAvx512(const T* keys, int n,
+                                                          T key) {
+  constexpr int LANES = 64 / sizeof(T);
+  __m512i k =
+      sizeof(T) == 8 ? _mm512_set1_epi64(key) : _mm512_set1_epi32(key);
+  int count = 0;
+  int i = 0;
+  for (; i + LANES <= n; i += LANES) {
+    __m512i v = _mm512_loadu_si512(keys + i);
+    __m512i a = UPPER ? v : k;
+    __m512i b = UPPER ? k : v;
+    if constexpr (sizeof(T) == 8) {
+      count += __builtin_popcount(_mm512_cmpgt_epi64_mask(a, b));
+    } else {
+      count += __builtin_popcount(_mm512_cmpgt_epi32_mask(a, b));
+    }
+  }
+  if (UPPER) {
+    count = i - count;
+  }
+  return count + CountScalar<T, UPPER>(keys + i, n - i, key);
+}
+
+#endif
+
+template <typename T, bool UPPER>
+int Search(const T* keys, int size, T key, SearchKernel kernel) {
+  // Branch free binary search until the range fits the window
+  int lo = 0;
+  int n = size;
+  while (n > WINDOW_BYTES / static_cast<int>(sizeof(T))) {
+    int half = n / 2;
+    bool right = UPPER ? keys[lo + half] <= key : keys[lo + half] < key;
+    lo = right ? lo + half + 1 : lo;
+    n = right ? n - half - 1 : half;
+  }
+
+  switch (kernel) {
+#if defined(__x86_64__)
+    case SearchKernel::AVX512:
+      return lo + CountAvx512<T, UPPER>(keys + lo, n, key);
+    case SearchKernel::AVX2:
+      return lo + CountAvx2<T, UPPER>(keys + lo, n, key);
+    case SearchKernel::SSE:
+      return lo + CountSse<T, UPPER>(keys + lo, n, key);
+#endif
+    default:
+      return lo + CountScalar<T, UPPER>(keys + lo, n, key);
+  }
+}
+
+SearchKernel DetectKernel() {
+#if defined(__x86_64__)
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f")) {
+    return SearchKernel::AVX512;
+  }
+  if (__builtin_cpu_supports("avx2")) {
+    return SearchKernel::AVX2;
+  }
+  if (__builtin_cpu_supports("sse4.2")) {
+    return SearchKernel::SSE;
+  }
+#endif
+  return SearchKernel::Scalar;
+}
+
+}  // namespace
+
+SearchKernel DetectSearchKernel() {
+  static const SearchKernel kernel = DetectKernel();
+  return kernel;
+}
+
+const char* SearchKernelName(SearchKernel kernel) {
+  switch (kernel) {
+    case SearchKernel::AVX512:
+      return "avx512";
+    case SearchKernel::AVX2:
+      return "avx2";
+    case SearchKernel::SSE:
+      return "sse";
+    default:
+      return "scalar";
+  }
+}
+
+template <typename T>
+int KeyLowerBound(const T* keys, int size, T key, SearchKernel kernel) {
+  return Search<T, false>(keys, size, key, kernel);
+}
+
+template <typename T>
+int KeyUpperBound(const T* keys, int size, T key, SearchKernel kernel) {
+  return Search<T, true>(keys, size, key, kernel);
+}
+
+template int KeyLowerBound(const int32_t*, int, int32_t, SearchKernel);
+template int KeyLowerBound(const int64_t*, int, int64_t, SearchKernel);
+template int KeyUpperBound(const int32_t*, int, int32_t, SearchKernel);
+template int KeyUpperBound(const int64_t*, int, int64_t, SearchKernel);
+
+int64_t KeyPrefix(std::string_view key) {
+  unsigned char bytes[8] = {};
+  memcpy(bytes, key.data(), std::min<size_t>(key.size(), 8));
+  uint64_t prefix = 0;
+  for (unsigned char byte : bytes) {
+    prefix = (prefix << 8) | byte;
+  }
+  // Flipping the sign bit makes signed order match unsigned byte order
+  return static_cast<int64_t>(prefix ^ (uint64_t{1} << 63));
+}
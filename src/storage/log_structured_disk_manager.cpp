@@ -0,0 +1,514 @@
+#include <storage/log_structured_disk_manager.hpp>
+
+#include <storage/file_io.hpp>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+namespace {
+
+// Cleaning starts once more than 1 in CLEAN_DEAD_FRACTION written slots is
+// dead
+const size_t CLEAN_DEAD_FRACTION = 4;
+// Freed segments that make the cleaner checkpoint so they can be reused
+const size_t CHECKPOINT_SEGMENTS = 16;
+// Writers clean once more than 1 in CATCH_UP_DEAD_FRACTION slots is dead or
+// CATCH_UP_SEGMENTS freed segments wait for a checkpoint
+const size_t CATCH_UP_DEAD_FRACTION = 2;
+const size_t CATCH_UP_SEGMENTS = 2 * CHECKPOINT_SEGMENTS;
+const uint64_t CHECKPOINT_MAGIC = 0x4c53444d50473634;
+
+}  // namespace
+
+LogStructuredDiskManager::LogStructuredDiskManager(
+    const std::filesystem::path& p, size_t page_size)
+    : DiskManager(p, page_size),
+      file_name_(p),
+      checkpoint_file_name_(p.filename().stem().string() + ".map") {
+  fd_ = open(file_name_.c_str(), O_RDWR);
+  if (fd_ < 0) {
+    throw std::runtime_error("Can't open db file");
+  }
+  LoadCheckpoint_();
+  NextSegment_();
+  cleaner_ = std::thread(&LogStructuredDiskManager::CleanerWork_, this);
+}
+
+LogStructuredDiskManager::~LogStructuredDiskManager() {
+  ShutDown();
+}
+
+void LogStructuredDiskManager::ShutDown() {
+  {
+    std::scoped_lock lock(mutex_);
+    if (fd_ < 0) {
+      return;
+    }
+    stop_ = true;
+  }
+  cleaner_cv_.notify_one();
+  cleaner_.join();
+
+  Checkpoint_();
+  {
+    std::scoped_lock lock(mutex_);
+    close(fd_);
+    fd_ = -1;
+  }
+  DiskManager::ShutDown();
+}
+
+void LogStructuredDiskManager::WritePage(PageId_t page_id, const char* data) {
+  CatchUp_();
+  Append_({{page_id, data}});
+  std::scoped_lock lock(mutex_);
+  num_writes_ += 1;
+  WakeCleaner_();
+}
+
+void LogStructuredDiskManager::ReadPage(PageId_t page_id, char* buffer) {
+  std::shared_lock latch(io_latch_);
+  size_t offset;
+  {
+    std::scoped_lock lock(mutex_);
+    num_reads_ += 1;
+    auto it = locations_.find(page_id);
+    if (it == locations_.end()) {
+      ZeroPage(buffer, page_size_);
+      return;
+    }
+    offset = it->second;
+  }
+  ReadFully(fd_, buffer, page_size_, offset);
+}
+
+void LogStructuredDiskManager::DeletePage(PageId_t page_id) {
+  std::scoped_lock lock(mutex_);
+  auto pending = pending_writes_.find(page_id);
+  if (pending != pending_writes_.end()) {
+    pending->second.latest = ++write_seq_;
+  }
+  auto it = locations_.find(page_id);
+  if (it == locations_.end()) {
+    return;
+  }
+  KillSlot_(it->second);
+  locations_.erase(it);
+  num_deletes_ += 1;
+  WakeCleaner_();
+}
+
+void LogStructuredDiskManager::AllocateExtent(PageId_t, size_t, PageId_t) {}
+
+// Only the last write of a page within the batch is kept, pages are appended
+// in page id order so that neighbours stay next to each other
+void LogStructuredDiskManager::WritePages(
+    const std::vector<std::pair<PageId_t, const char*>>& pages) {
+  if (pages.empty()) {
+    return;
+  }
+  std::vector<std::pair<PageId_t, const char*>> by_page(pages.begin(),
+                                                        pages.end());
+  std::stable_sort(
+      by_page.begin(), by_page.end(),
+      [](const auto& a, const auto& b) { return a.first < b.first; });
+  std::vector<std::pair<PageId_t, const char*>> writes;
+  writes.reserve(by_page.size());
+  for (size_t i = 0; i < by_page.size(); i++) {
+    if (i + 1 < by_page.size() && by_page[i + 1].first == by_page[i].first) {
+      continue;
+    }
+    writes.push_back(by_page[i]);
+  }
+
+  CatchUp_();
+  Append_(writes);
+  std::scoped_lock lock(mutex_);
+  num_writes_ += writes.size();
+  WakeCleaner_();
+}
+
+void LogStructuredDiskManager::Sync() {
+  Checkpoint_();
+}
+
+CompactionResult LogStructuredDiskManager::Compact(size_t, size_t) {
+  CompactionResult result;
+  result.file_size_before = GetDbFileSize();
+  {
+    std::scoped_lock lock(mutex_);
+    while (segments_.size() > 1 && segments_.size() - 1 != head_) {
+      auto it = std::find(free_segments_.begin(), free_segments_.end(),
+                          segments_.size() - 1);
+      if (it == free_segments_.end()) {
+        break;
+      }
+      free_segments_.erase(it);
+      segments_.pop_back();
+    }
+    size_t end = SegmentOffset_(segments_.size());
+    if (result.file_size_before > end && ftruncate(fd_, end) != 0) {
+      throw std::runtime_error("Error truncating db file");
+    }
+  }
+  result.file_size_after = GetDbFileSize();
+  return result;
+}
+
+int LogStructuredDiskManager::GetNumCleanerWrites() const {
+  std::scoped_lock lock(mutex_);
+  return num_cleaner_writes_;
+}
+
+size_t LogStructuredDiskManager::GetSegmentCount() const {
+  std::scoped_lock lock(mutex_);
+  return segments_.size();
+}
+
+std::filesystem::path LogStructuredDiskManager::GetCheckpointFileName() const {
+  return checkpoint_file_name_;
+}
+
+size_t LogStructuredDiskManager::Append_(
+    const std::vector<std::pair<PageId_t, const char*>>& pages,
+    const std::vector<size_t>* sources) {
+  std::vector<char> buffer;
+  std::vector<uint64_t> seqs;
+  size_t installed = 0;
+  size_t begin = 0;
+  while (begin < pages.size()) {
+    size_t segment;
+    size_t count;
+    size_t offset;
+    seqs.clear();
+    {
+      std::unique_lock lock(mutex_);
+      if (segments_[head_].slots.size() == LOG_SEGMENT_PAGES) {
+        // Segments a running checkpoint frees are worth waiting for rather
+        // than growing the file
+        checkpoint_cv_.wait(lock, [this]() {
+          return !free_segments_.empty() || checkpoint_segments_ == 0;
+        });
+        NextSegment_();
+      }
+      segment = head_;
+      Segment& head = segments_[segment];
+      size_t first_slot = head.slots.size();
+      count = std::min(pages.size() - begin, LOG_SEGMENT_PAGES - first_slot);
+      offset = SegmentOffset_(segment) + first_slot * page_size_;
+      for (size_t i = 0; i < count; i++) {
+        PageId_t page_id = pages[begin + i].first;
+        head.slots.push_back(page_id);
+        head.live++;
+        written_pages_++;
+        if (sources == nullptr) {
+          PendingWrite& pending = pending_writes_[page_id];
+          pending.count++;
+          pending.latest = ++write_seq_;
+          seqs.push_back(pending.latest);
+        }
+      }
+      head.writing += count;
+    }
+
+    if (count == 1) {
+      WriteFully(fd_, pages[begin].second, page_size_, offset);
+    } else {
+      buffer.resize(count * page_size_);
+      for (size_t i = 0; i < count; i++) {
+        CopyPage(buffer.data() + i * page_size_, pages[begin + i].second,
+                 page_size_);
+      }
+      WriteFully(fd_, buffer.data(), buffer.size(), offset);
+    }
+
+    std::scoped_lock lock(mutex_);
+    segments_[segment].writing -= count;
+    for (size_t i = 0; i < count; i++) {
+      PageId_t page_id = pages[begin + i].first;
+      size_t slot_offset = offset + i * page_size_;
+      auto it = locations_.find(page_id);
+      bool current;
+      if (sources == nullptr) {
+        auto pending = pending_writes_.find(page_id);
+        current = pending->second.latest == seqs[i];
+        if (--pending->second.count == 0) {
+          pending_writes_.erase(pending);
+        }
+      } else {
+        current = it != locations_.end() && it->second == (*sources)[begin + i];
+      }
+      if (!current) {
+        KillSlot_(slot_offset);
+        continue;
+      }
+      if (it != locations_.end()) {
+        KillSlot_(it->second);
+      }
+      locations_[page_id] = slot_offset;
+      installed++;
+    }
+    begin += count;
+  }
+  return installed;
+}
+
+void LogStructuredDiskManager::NextSegment_() {
+  if (head_ < segments_.size() && segments_[head_].live == 0) {
+    FreeSegment_(head_);
+  }
+  if (!free_segments_.empty()) {
+    head_ = free_segments_.back();
+    free_segments_.pop_back();
+  } else {
+    head_ = segments_.size();
+    segments_.emplace_back();
+  }
+  segments_[head_].slots.reserve(LOG_SEGMENT_PAGES);
+}
+
+void LogStructuredDiskManager::KillSlot_(size_t offset) {
+  size_t segment = SegmentOf_(offset);
+  Segment& dead = segments_[segment];
+  dead.slots[SlotOf_(offset)] = INVALID_PAGE_ID;
+  dead.live--;
+  dead_pages_++;
+  if (dead.live == 0 && segment != head_) {
+    FreeSegment_(segment);
+  }
+}
+
+void LogStructuredDiskManager::FreeSegment_(size_t segment) {
+  Segment& freed = segments_[segment];
+  dead_pages_ -= freed.slots.size() - freed.live;
+  written_pages_ -= freed.slots.size();
+  freed.slots.clear();
+  freed.slots.shrink_to_fit();
+  freed.live = 0;
+  pending_segments_.push_back(segment);
+}
+
+std::optional<size_t> LogStructuredDiskManager::Victim_() const {
+  std::optional<size_t> victim;
+  for (size_t segment = 0; segment < segments_.size(); segment++) {
+    const Segment& candidate = segments_[segment];
+    if (segment == head_ || candidate.live == candidate.slots.size() ||
+        candidate.writing > 0) {
+      continue;
+    }
+    if (!victim.has_value() || candidate.live < segments_[*victim].live) {
+      victim = segment;
+    }
+  }
+  return victim;
+}
+
+bool LogStructuredDiskManager::NeedsCleaning_() const {
+  return pending_segments_.size() >= CHECKPOINT_SEGMENTS ||
+         (dead_pages_ * CLEAN_DEAD_FRACTION > written_pages_ &&
+          Victim_().has_value());
+}
+
+void LogStructuredDiskManager::WakeCleaner_() {
+  if (pending_segments_.size() >= CHECKPOINT_SEGMENTS ||
+      dead_pages_ * CLEAN_DEAD_FRACTION > written_pages_) {
+    cleaner_cv_.notify_one();
+  }
+}
+
+void LogStructuredDiskManager::CatchUp_() {
+  while (true) {
+    {
+      std::scoped_lock lock(mutex_);
+      if (dead_pages_ * CATCH_UP_DEAD_FRACTION <= written_pages_ ||
+          !Victim_().has_value()) {
+        break;
+      }
+    }
+    Clean_();
+  }
+  bool checkpoint;
+  {
+    std::scoped_lock lock(mutex_);
+    checkpoint = pending_segments_.size() >= CATCH_UP_SEGMENTS;
+  }
+  if (checkpoint) {
+    Checkpoint_();
+  }
+}
+
+// The live pages are read with one sequential read and appended to the head,
+// which frees the segment once the last one moved. The shared latch keeps the
+// segment from being reused while it is read.
+void LogStructuredDiskManager::Clean_() {
+  std::scoped_lock cleaning(clean_mutex_);
+  std::shared_lock latch(io_latch_);
+  size_t segment;
+  size_t size;
+  std::vector<PageId_t> page_ids;
+  std::vector<size_t> sources;
+  {
+    std::scoped_lock lock(mutex_);
+    auto victim = Victim_();
+    if (!victim.has_value()) {
+      return;
+    }
+    segment = *victim;
+    const auto& slots = segments_[segment].slots;
+    size = slots.size();
+    for (size_t slot = 0; slot < slots.size(); slot++) {
+      if (slots[slot] != INVALID_PAGE_ID) {
+        page_ids.push_back(slots[slot]);
+        sources.push_back(SegmentOffset_(segment) + slot * page_size_);
+      }
+    }
+  }
+
+  std::vector<char> data(size * page_size_);
+  ReadFully(fd_, data.data(), data.size(), SegmentOffset_(segment));
+  latch.unlock();
+  std::vector<std::pair<PageId_t, const char*>> live;
+  for (size_t i = 0; i < page_ids.size(); i++) {
+    live.push_back(
+        {page_ids[i], data.data() + sources[i] - SegmentOffset_(segment)});
+  }
+  size_t moved = Append_(live, &sources);
+  std::scoped_lock lock(mutex_);
+  num_cleaner_writes_ += moved;
+}
+
+// Cleans a segment at a time and lets writers in between
+void LogStructuredDiskManager::CleanerWork_() {
+  std::unique_lock lock(mutex_);
+  while (true) {
+    cleaner_cv_.wait(lock, [this]() { return stop_ || NeedsCleaning_(); });
+    if (stop_) {
+      return;
+    }
+    bool checkpoint = pending_segments_.size() >= CHECKPOINT_SEGMENTS;
+    lock.unlock();
+    if (checkpoint) {
+      Checkpoint_();
+    } else {
+      Clean_();
+    }
+    std::this_thread::yield();
+    lock.lock();
+  }
+}
+
+// The page map is written to a new file that replaces the checkpoint once
+// it is durable, after the pages it refers to. Only segments freed before
+// the map was taken can be reused then.
+void LogStructuredDiskManager::Checkpoint_() {
+  std::scoped_lock checkpointing(checkpoint_mutex_);
+  std::vector<std::pair<PageId_t, uint64_t>> entries;
+  std::vector<size_t> freed;
+  {
+    std::scoped_lock lock(mutex_);
+    if (fd_ < 0) {
+      return;
+    }
+    entries.assign(locations_.begin(), locations_.end());
+    freed.swap(pending_segments_);
+    checkpoint_segments_ = freed.size();
+  }
+  SyncFile_(fd_);
+
+  uint64_t header[2] = {CHECKPOINT_MAGIC, entries.size()};
+  std::filesystem::path temp_name = checkpoint_file_name_.string() + ".new";
+  int fd = open(temp_name.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0) {
+    throw std::runtime_error("Can't open checkpoint file");
+  }
+  WriteFully(fd, reinterpret_cast<const char*>(header), sizeof(header), 0);
+  WriteFully(fd, reinterpret_cast<const char*>(entries.data()),
+             entries.size() * sizeof(entries[0]), sizeof(header));
+  SyncFile_(fd);
+  close(fd);
+  std::filesystem::rename(temp_name, checkpoint_file_name_);
+
+  {
+    std::unique_lock latch(io_latch_);
+    std::scoped_lock lock(mutex_);
+    free_segments_.insert(free_segments_.end(), freed.begin(), freed.end());
+    checkpoint_segments_ = 0;
+  }
+  checkpoint_cv_.notify_all();
+}
+
+// Segments of the checkpoint are treated as full, slots not in the map are
+// dead. A checkpoint that refers past the end of the file belongs to another
+// db file and is ignored.
+void LogStructuredDiskManager::LoadCheckpoint_() {
+  std::ifstream in(checkpoint_file_name_, std::ios::binary);
+  if (!in.is_open()) {
+    return;
+  }
+  uint64_t header[2];
+  in.read(reinterpret_cast<char*>(header), sizeof(header));
+  if (!in || header[0] != CHECKPOINT_MAGIC) {
+    return;
+  }
+  std::vector<std::pair<PageId_t, uint64_t>> entries(header[1]);
+  in.read(reinterpret_cast<char*>(entries.data()),
+          entries.size() * sizeof(entries[0]));
+  if (!in) {
+    return;
+  }
+  const size_t file_size = std::filesystem::file_size(file_name_);
+  for (const auto& [page_id, offset] : entries) {
+    if (offset < page_size_ || offset + page_size_ > file_size ||
+        offset % page_size_ != 0) {
+      return;
+    }
+  }
+
+  for (const auto& [page_id, offset] : entries) {
+    size_t segment = SegmentOf_(offset);
+    if (segment >= segments_.size()) {
+      segments_.resize(segment + 1);
+    }
+    Segment& loaded = segments_[segment];
+    if (loaded.slots.empty()) {
+      loaded.slots.assign(LOG_SEGMENT_PAGES, INVALID_PAGE_ID);
+    }
+    loaded.slots[SlotOf_(offset)] = page_id;
+    loaded.live++;
+    locations_[page_id] = offset;
+  }
+  for (size_t segment = 0; segment < segments_.size(); segment++) {
+    Segment& loaded = segments_[segment];
+    if (loaded.live == 0) {
+      loaded.slots.clear();
+      free_segments_.push_back(segment);
+      continue;
+    }
+    written_pages_ += loaded.slots.size();
+    dead_pages_ += loaded.slots.size() - loaded.live;
+  }
+  head_ = segments_.size();
+}
+
+void LogStructuredDiskManager::SyncFile_(int fd) {
+  if (fsync(fd) != 0) {
+    throw std::runtime_error("Error syncing file");
+  }
+}
+
+// Segments follow the header slot
+size_t LogStructuredDiskManager::SegmentOffset_(size_t segment) const {
+  return page_size_ + segment * LOG_SEGMENT_PAGES * page_size_;
+}
+
+size_t LogStructuredDiskManager::SegmentOf_(size_t offset) const {
+  return (offset - page_size_) / (LOG_SEGMENT_PAGES * page_size_);
+}
+
+size_t LogStructuredDiskManager::SlotOf_(size_t offset) const {
+  return (offset - page_size_) / page_size_ % LOG_SEGMENT_PAGES;
+}
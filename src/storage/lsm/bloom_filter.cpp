@@ -0,0 +1,33 @@
+#include <storage/lsm/bloom_filter.hpp>
+
+#include <algorithm>
+#include <functional>
+
+BloomFilter::BloomFilter(size_t num_keys, size_t bits_per_key)
+    : num_probes_(std::clamp<size_t>(bits_per_key * 69 / 100, 1, 30)),
+      bits_((std::max<size_t>(num_keys * bits_per_key, 64) + 63) / 64) {}
+
+void BloomFilter::Add(std::string_view key) {
+  const uint64_t num_bits = bits_.size() * 64;
+  uint64_t hash = std::hash<std::string_view>{}(key);
+  const uint64_t delta = (hash >> 33) | (hash << 31);
+  for (size_t i = 0; i < num_probes_; i++) {
+    uint64_t bit = hash % num_bits;
+    bits_[bit / 64] |= uint64_t{1} << (bit % 64);
+    hash += delta;
+  }
+}
+
+bool BloomFilter::MayContain(std::string_view key) const {
+  const uint64_t num_bits = bits_.size() * 64;
+  uint64_t hash = std::hash<std::string_view>{}(key);
+  const uint64_t delta = (hash >> 33) | (hash << 31);
+  for (size_t i = 0; i < num_probes_; i++) {
+    uint64_t bit = hash % num_bits;
+    if ((bits_[bit / 64] & (uint64_t{1} << (bit % 64))) == 0) {
+      return false;
+    }
+    hash += delta;
+  }
+  return true;
+}
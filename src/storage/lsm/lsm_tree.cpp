@@ -0,0 +1,330 @@
+#include <storage/lsm/lsm_tree.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace {
+
+// Level 0 runs, in multiples of the compaction trigger, at which writers wait
+// for compactions to catch up
+const size_t LEVEL0_STOP_FACTOR = 3;
+
+bool Overlaps(const SortedRun& run, std::string_view low,
+              std::string_view high) {
+  return run.GetFirstKey() <= high && run.GetLastKey() >= low;
+}
+
+}  // namespace
+
+LsmTree::LsmTree(BufferPoolManager* bpm, DiskManager* disk_manager,
+                 LsmOptions options)
+    : bpm_(bpm),
+      disk_manager_(disk_manager),
+      options_(options),
+      mem_(std::make_shared<SkipList>()),
+      version_(std::make_shared<Version>()) {
+  RequireDefaultPageSize(bpm_->GetPageSize(), "LSM tree");
+  thread_ = std::thread(&LsmTree::BackgroundWork_, this);
+}
+
+LsmTree::~LsmTree() {
+  {
+    std::scoped_lock lock(mutex_);
+    stop_ = true;
+  }
+  work_cv_.notify_one();
+  thread_.join();
+}
+
+void LsmTree::Put(std::string_view key, std::string_view value) {
+  Write_(key, value, false);
+}
+
+void LsmTree::Delete(std::string_view key) {
+  Write_(key, {}, true);
+}
+
+std::optional<std::string> LsmTree::Get(std::string_view key) const {
+  std::shared_ptr<SkipList> mem;
+  std::shared_ptr<SkipList> imm;
+  std::shared_ptr<const Version> version;
+  {
+    std::scoped_lock lock(mutex_);
+    mem = mem_;
+    imm = imm_;
+    version = version_;
+  }
+
+  for (const SkipList* memtable : {mem.get(), imm.get()}) {
+    if (memtable == nullptr) {
+      continue;
+    }
+    if (auto value = memtable->Get(key)) {
+      if (value->deleted) {
+        return std::nullopt;
+      }
+      return std::string(value->value);
+    }
+  }
+
+  std::string buffer;
+  auto lookup = [&](const SortedRun& run) -> std::optional<LsmValue> {
+    if (!run.MayContain(key)) {
+      return std::nullopt;
+    }
+    block_reads_.fetch_add(1, std::memory_order_relaxed);
+    return run.Get(key, buffer);
+  };
+  for (size_t level = 0; level < MAX_LEVELS; level++) {
+    const auto& runs = version->levels[level];
+    std::optional<LsmValue> value;
+    if (level == 0) {
+      for (const auto& run : runs) {
+        if ((value = lookup(*run))) {
+          break;
+        }
+      }
+    } else {
+      // The only run of the level whose range may hold the key
+      auto it = std::lower_bound(
+          runs.begin(), runs.end(), key,
+          [](const std::shared_ptr<SortedRun>& run, std::string_view key) {
+            return run->GetLastKey() < key;
+          });
+      if (it != runs.end()) {
+        value = lookup(**it);
+      }
+    }
+    if (value.has_value()) {
+      if (value->deleted) {
+        return std::nullopt;
+      }
+      return buffer;
+    }
+  }
+  return std::nullopt;
+}
+
+void LsmTree::Flush() {
+  std::unique_lock lock(mutex_);
+  if (!mem_->IsEmpty()) {
+    SwitchMemtable_(lock);
+  }
+  done_cv_.wait(lock, [this]() {
+    return imm_ == nullptr && PickLevel_() == MAX_LEVELS;
+  });
+}
+
+size_t LsmTree::GetRunCount(size_t level) const {
+  std::scoped_lock lock(mutex_);
+  return version_->levels[level].size();
+}
+
+size_t LsmTree::GetPageCount(size_t level) const {
+  std::scoped_lock lock(mutex_);
+  size_t pages = 0;
+  for (const auto& run : version_->levels[level]) {
+    pages += run->GetPageCount();
+  }
+  return pages;
+}
+
+size_t LsmTree::GetBlockReads() const {
+  return block_reads_.load(std::memory_order_relaxed);
+}
+
+size_t LsmTree::GetCompactionCount() const {
+  std::scoped_lock lock(mutex_);
+  return compactions_;
+}
+
+void LsmTree::Write_(std::string_view key, std::string_view value,
+                     bool deleted) {
+  if (key.size() + value.size() > SortedRun::Builder::MaxEntrySize()) {
+    throw std::runtime_error("Key and value do not fit in a page");
+  }
+  std::unique_lock lock(mutex_);
+  if (mem_->GetMemoryUsage() >= options_.memtable_size) {
+    SwitchMemtable_(lock);
+  }
+  if (deleted) {
+    mem_->Delete(key);
+  } else {
+    mem_->Put(key, value);
+  }
+}
+
+void LsmTree::SwitchMemtable_(std::unique_lock<std::mutex>& lock) {
+  done_cv_.wait(lock, [this]() {
+    return imm_ == nullptr && version_->levels[0].size() <
+                                  LEVEL0_STOP_FACTOR * options_.level0_runs;
+  });
+  imm_ = std::move(mem_);
+  mem_ = std::make_shared<SkipList>();
+  work_cv_.notify_one();
+}
+
+// Only this thread replaces version_, so runs are built from a snapshot
+// outside the lock and installed under it
+void LsmTree::BackgroundWork_() {
+  std::unique_lock lock(mutex_);
+  while (true) {
+    work_cv_.wait(lock, [this]() {
+      return stop_ || imm_ != nullptr || PickLevel_() < MAX_LEVELS;
+    });
+    if (stop_) {
+      return;
+    }
+
+    std::shared_ptr<const Version> version = version_;
+    if (imm_ != nullptr) {
+      std::shared_ptr<SkipList> imm = imm_;
+      lock.unlock();
+      auto next = std::make_shared<Version>(*version);
+      if (auto run = WriteMemtable_(*imm)) {
+        next->levels[0].insert(next->levels[0].begin(), std::move(run));
+      }
+      lock.lock();
+      version_ = std::move(next);
+      imm_ = nullptr;
+    } else {
+      size_t level = PickLevel_();
+      lock.unlock();
+      auto next = Compact_(*version, level);
+      lock.lock();
+      version_ = std::move(next);
+      compactions_++;
+    }
+    done_cv_.notify_all();
+  }
+}
+
+std::shared_ptr<SortedRun> LsmTree::WriteMemtable_(const SkipList& memtable) {
+  SortedRun::Builder builder(bpm_, disk_manager_, options_.bloom_bits_per_key);
+  for (auto it = memtable.Begin(); !it.IsEnd(); ++it) {
+    builder.Add(it.Key(), it.Value());
+  }
+  return builder.Finish();
+}
+
+size_t LsmTree::PickLevel_() const {
+  if (version_->levels[0].size() >= options_.level0_runs) {
+    return 0;
+  }
+  for (size_t level = 1; level + 1 < MAX_LEVELS; level++) {
+    size_t pages = 0;
+    for (const auto& run : version_->levels[level]) {
+      pages += run->GetPageCount();
+    }
+    if (pages > MaxLevelPages_(level)) {
+      return level;
+    }
+  }
+  return MAX_LEVELS;
+}
+
+std::shared_ptr<LsmTree::Version> LsmTree::Compact_(const Version& version,
+                                                    size_t level) {
+  auto next = std::make_shared<Version>(version);
+  const size_t output_level = level + 1;
+
+  // Inputs by precedence, newer runs first
+  std::vector<std::shared_ptr<SortedRun>> inputs;
+  std::string low;
+  std::string high;
+  if (level == 0) {
+    inputs = version.levels[0];
+    low = inputs.front()->GetFirstKey();
+    high = inputs.front()->GetLastKey();
+    for (const auto& run : inputs) {
+      low = std::min<std::string_view>(low, run->GetFirstKey());
+      high = std::max<std::string_view>(high, run->GetLastKey());
+    }
+    next->levels[0].clear();
+  } else {
+    auto& runs = next->levels[level];
+    auto it = std::find_if(runs.begin(), runs.end(), [&](const auto& run) {
+      return run->GetFirstKey() > compact_pointer_[level];
+    });
+    if (it == runs.end()) {
+      it = runs.begin();
+    }
+    inputs.push_back(*it);
+    low = (*it)->GetFirstKey();
+    high = (*it)->GetLastKey();
+    compact_pointer_[level] = high;
+    runs.erase(it);
+  }
+
+  std::vector<std::shared_ptr<SortedRun>> outputs;
+  for (const auto& run : version.levels[output_level]) {
+    if (Overlaps(*run, low, high)) {
+      inputs.push_back(run);
+    } else {
+      outputs.push_back(run);
+    }
+  }
+
+  // A run that overlaps nothing below level 0 moves down as is
+  if (level > 0 && inputs.size() == 1) {
+    outputs.push_back(inputs.front());
+  } else {
+    bool bottom = true;
+    for (size_t deeper = output_level + 1; deeper < MAX_LEVELS; deeper++) {
+      bottom = bottom && version.levels[deeper].empty();
+    }
+
+    std::vector<SortedRun::Iterator> iterators;
+    iterators.reserve(inputs.size());
+    for (const auto& run : inputs) {
+      iterators.emplace_back(run.get());
+    }
+    SortedRun::Builder builder(bpm_, disk_manager_,
+                               options_.bloom_bits_per_key);
+    while (true) {
+      // Smallest key, ties go to the newest input
+      SortedRun::Iterator* smallest = nullptr;
+      for (auto& it : iterators) {
+        if (!it.IsEnd() &&
+            (smallest == nullptr || it.Key() < smallest->Key())) {
+          smallest = &it;
+        }
+      }
+      if (smallest == nullptr) {
+        break;
+      }
+
+      for (auto& it : iterators) {
+        if (&it != smallest && !it.IsEnd() && it.Key() == smallest->Key()) {
+          ++it;
+        }
+      }
+      LsmValue value = smallest->Value();
+      if (!(bottom && value.deleted)) {
+        builder.Add(smallest->Key(), value);
+        if (builder.GetPageCount() >= options_.run_pages) {
+          outputs.push_back(builder.Finish());
+        }
+      }
+      ++*smallest;
+    }
+    if (!builder.IsEmpty()) {
+      outputs.push_back(builder.Finish());
+    }
+  }
+
+  std::sort(outputs.begin(), outputs.end(),
+            [](const auto& a, const auto& b) {
+              return a->GetFirstKey() < b->GetFirstKey();
+            });
+  next->levels[output_level] = std::move(outputs);
+  return next;
+}
+
+size_t LsmTree::MaxLevelPages_(size_t level) const {
+  size_t pages = options_.base_level_pages;
+  for (size_t i = 1; i < level; i++) {
+    pages *= options_.level_ratio;
+  }
+  return pages;
+}
@@ -0,0 +1,187 @@
+#include <storage/lsm/skip_list.hpp>
+
+#include <cstring>
+#include <new>
+
+namespace {
+
+const size_t ARENA_BLOCK_SIZE = 64 * 1024;
+
+}  // namespace
+
+struct SkipList::Node {
+  std::string_view key;
+  std::string_view value;
+  uint64_t seq;
+  bool deleted;
+  // Allocated with one pointer per level of the node
+  std::atomic<Node*> next[1];
+
+  Node* Next(int level) const {
+    return next[level].load(std::memory_order_acquire);
+  }
+  void SetNext(int level, Node* node) {
+    next[level].store(node, std::memory_order_release);
+  }
+};
+
+SkipList::SkipList() {
+  head_ = NewNode_({}, {}, false, MAX_HEIGHT);
+}
+
+SkipList::~SkipList() = default;
+
+void SkipList::Put(std::string_view key, std::string_view value) {
+  Insert_(key, value, false);
+}
+
+void SkipList::Delete(std::string_view key) {
+  Insert_(key, {}, true);
+}
+
+std::optional<LsmValue> SkipList::Get(std::string_view key) const {
+  Node* node = FindGreaterOrEqual_(key, UINT64_MAX, nullptr);
+  if (node == nullptr || node->key != key) {
+    return std::nullopt;
+  }
+  return LsmValue{node->deleted, node->value};
+}
+
+size_t SkipList::GetMemoryUsage() const {
+  return memory_usage_.load(std::memory_order_relaxed);
+}
+
+bool SkipList::IsEmpty() const {
+  return head_->Next(0) == nullptr;
+}
+
+SkipList::Iterator::Iterator(const Node* node) : node_(node) {}
+
+bool SkipList::Iterator::IsEnd() const {
+  return node_ == nullptr;
+}
+
+std::string_view SkipList::Iterator::Key() const {
+  return node_->key;
+}
+
+LsmValue SkipList::Iterator::Value() const {
+  return {node_->deleted, node_->value};
+}
+
+// Older values of the same key follow the newest one and are skipped
+SkipList::Iterator& SkipList::Iterator::operator++() {
+  std::string_view key = node_->key;
+  do {
+    node_ = node_->Next(0);
+  } while (node_ != nullptr && node_->key == key);
+  return *this;
+}
+
+SkipList::Iterator SkipList::Begin() const {
+  return Iterator(head_->Next(0));
+}
+
+void SkipList::Insert_(std::string_view key, std::string_view value,
+                       bool deleted) {
+  std::scoped_lock lock(write_mutex_);
+  uint64_t seq = next_seq_++;
+  Node* prev[MAX_HEIGHT];
+  FindGreaterOrEqual_(key, seq, prev);
+
+  int height = RandomHeight_();
+  int list_height = height_.load(std::memory_order_relaxed);
+  if (height > list_height) {
+    for (int level = list_height; level < height; level++) {
+      prev[level] = head_;
+    }
+    // A reader that sees the new height before the node finds no successor
+    // of head_ on the new levels and drops down
+    height_.store(height, std::memory_order_relaxed);
+  }
+
+  Node* node = NewNode_(key, value, deleted, height);
+  node->seq = seq;
+  for (int level = 0; level < height; level++) {
+    node->next[level].store(prev[level]->Next(level),
+                            std::memory_order_relaxed);
+    prev[level]->SetNext(level, node);
+  }
+}
+
+SkipList::Node* SkipList::NewNode_(std::string_view key,
+                                   std::string_view value, bool deleted,
+                                   int height) {
+  size_t node_size =
+      sizeof(Node) + (height - 1) * sizeof(std::atomic<Node*>);
+  char* memory = Allocate_(node_size + key.size() + value.size());
+  char* data = memory + node_size;
+  memcpy(data, key.data(), key.size());
+  memcpy(data + key.size(), value.data(), value.size());
+
+  Node* node = new (memory) Node{{data, key.size()},
+                                 {data + key.size(), value.size()},
+                                 0,
+                                 deleted,
+                                 {}};
+  for (int level = 1; level < height; level++) {
+    new (&node->next[level]) std::atomic<Node*>(nullptr);
+  }
+  return node;
+}
+
+// Large allocations get a block of their own so the current one is not
+// wasted
+char* SkipList::Allocate_(size_t size) {
+  size = (size + 7) & ~size_t{7};
+  if (size > ARENA_BLOCK_SIZE / 4) {
+    blocks_.push_back(std::make_unique<char[]>(size));
+    memory_usage_.fetch_add(size, std::memory_order_relaxed);
+    return blocks_.back().get();
+  }
+  if (size > alloc_remaining_) {
+    blocks_.push_back(std::make_unique<char[]>(ARENA_BLOCK_SIZE));
+    alloc_ptr_ = blocks_.back().get();
+    alloc_remaining_ = ARENA_BLOCK_SIZE;
+  }
+  char* memory = alloc_ptr_;
+  alloc_ptr_ += size;
+  alloc_remaining_ -= size;
+  memory_usage_.fetch_add(size, std::memory_order_relaxed);
+  return memory;
+}
+
+// Each level holds a quarter of the nodes of the one below
+int SkipList::RandomHeight_() {
+  int height = 1;
+  while (height < MAX_HEIGHT && rng_() % 4 == 0) {
+    height++;
+  }
+  return height;
+}
+
+bool SkipList::Before_(const Node* node, std::string_view key, uint64_t seq) {
+  int cmp = node->key.compare(key);
+  return cmp < 0 || (cmp == 0 && node->seq > seq);
+}
+
+SkipList::Node* SkipList::FindGreaterOrEqual_(std::string_view key,
+                                              uint64_t seq,
+                                              Node** prev) const {
+  Node* node = head_;
+  int level = height_.load(std::memory_order_relaxed) - 1;
+  while (true) {
+    Node* next = node->Next(level);
+    if (next != nullptr && Before_(next, key, seq)) {
+      node = next;
+      continue;
+    }
+    if (prev != nullptr) {
+      prev[level] = node;
+    }
+    if (level == 0) {
+      return next;
+    }
+    level--;
+  }
+}
@@ -0,0 +1,260 @@
+#include <storage/lsm/sorted_run.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+namespace {
+
+// Entry count and offset of an entry
+const size_t COUNT_SIZE = sizeof(uint16_t);
+// Key and value lengths
+const size_t ENTRY_HEADER_SIZE = 2 * sizeof(uint16_t);
+
+uint16_t GetCount(const char* page) {
+  uint16_t count;
+  memcpy(&count, page, sizeof(count));
+  return count;
+}
+
+void GetEntry(const char* page, uint16_t entry, std::string_view& key,
+              LsmValue& value) {
+  uint16_t offset;
+  memcpy(&offset, page + COUNT_SIZE + entry * sizeof(uint16_t),
+         sizeof(offset));
+  uint16_t key_size;
+  uint16_t value_size;
+  memcpy(&key_size, page + offset, sizeof(key_size));
+  memcpy(&value_size, page + offset + sizeof(key_size), sizeof(value_size));
+  const char* data = page + offset + ENTRY_HEADER_SIZE;
+  key = {data, key_size};
+  if (value_size == SortedRun::TOMBSTONE) {
+    value = {true, {}};
+  } else {
+    value = {false, {data + key_size, value_size}};
+  }
+}
+
+}  // namespace
+
+SortedRun::Builder::Builder(BufferPoolManager* bpm,
+                            DiskManager* disk_manager, size_t bits_per_key)
+    : bpm_(bpm), disk_manager_(disk_manager), bits_per_key_(bits_per_key) {}
+
+size_t SortedRun::Builder::MaxEntrySize() {
+  return DB_PAGE_SIZE - 2 * COUNT_SIZE - ENTRY_HEADER_SIZE;
+}
+
+void SortedRun::Builder::Add(std::string_view key, const LsmValue& value) {
+  size_t value_size = value.deleted ? 0 : value.value.size();
+  if (key.size() + value_size > MaxEntrySize()) {
+    throw std::runtime_error("Key and value do not fit in a page");
+  }
+  if (num_keys_ > 0 && key <= last_key_) {
+    throw std::runtime_error("Keys added to a run out of order");
+  }
+
+  size_t entry_size = ENTRY_HEADER_SIZE + key.size() + value_size;
+  if (COUNT_SIZE * (offsets_.size() + 2) + entries_.size() + entry_size >
+      DB_PAGE_SIZE) {
+    FinishPage_();
+  }
+  if (offsets_.empty()) {
+    first_keys_.emplace_back(key);
+  }
+
+  offsets_.push_back(entries_.size());
+  uint16_t key_size = key.size();
+  uint16_t stored_size = value.deleted ? TOMBSTONE : value_size;
+  size_t offset = entries_.size();
+  entries_.resize(offset + entry_size);
+  memcpy(entries_.data() + offset, &key_size, sizeof(key_size));
+  memcpy(entries_.data() + offset + sizeof(key_size), &stored_size,
+         sizeof(stored_size));
+  memcpy(entries_.data() + offset + ENTRY_HEADER_SIZE, key.data(),
+         key.size());
+  if (value_size > 0) {
+    memcpy(entries_.data() + offset + ENTRY_HEADER_SIZE + key.size(),
+           value.value.data(), value_size);
+  }
+  last_key_.assign(key);
+  num_keys_++;
+}
+
+size_t SortedRun::Builder::GetPageCount() const {
+  return pages_.size() + (offsets_.empty() ? 0 : 1);
+}
+
+bool SortedRun::Builder::IsEmpty() const {
+  return num_keys_ == 0;
+}
+
+std::shared_ptr<SortedRun> SortedRun::Builder::Finish() {
+  FinishPage_();
+  if (pages_.empty()) {
+    return nullptr;
+  }
+
+  BloomFilter bloom(num_keys_, bits_per_key_);
+  std::string_view key;
+  LsmValue value;
+  for (const auto& page : pages_) {
+    uint16_t count = GetCount(page.data());
+    for (uint16_t i = 0; i < count; i++) {
+      GetEntry(page.data(), i, key, value);
+      bloom.Add(key);
+    }
+  }
+
+  // The run is one extent, written with as few writes as the disk manager
+  // coalesces
+  std::vector<PageId_t> page_ids;
+  std::vector<std::pair<PageId_t, const char*>> writes;
+  PageId_t first_page_id = bpm_->NewPages(pages_.size());
+  for (const auto& page : pages_) {
+    page_ids.push_back(first_page_id + page_ids.size());
+    writes.push_back({page_ids.back(), page.data()});
+  }
+  disk_manager_->WritePages(writes);
+
+  std::shared_ptr<SortedRun> run(
+      new SortedRun(bpm_, std::move(page_ids), std::move(first_keys_),
+                    std::move(last_key_), std::move(bloom)));
+  pages_.clear();
+  first_keys_.clear();
+  last_key_.clear();
+  num_keys_ = 0;
+  return run;
+}
+
+void SortedRun::Builder::FinishPage_() {
+  if (offsets_.empty()) {
+    return;
+  }
+  // Laid out in the first DB_PAGE_SIZE bytes, written as a whole page
+  std::vector<char> page(bpm_->GetPageSize());
+  uint16_t count = offsets_.size();
+  size_t header_size = COUNT_SIZE * (count + 1);
+  memcpy(page.data(), &count, sizeof(count));
+  for (uint16_t i = 0; i < count; i++) {
+    uint16_t offset = header_size + offsets_[i];
+    memcpy(page.data() + COUNT_SIZE * (i + 1), &offset, sizeof(offset));
+  }
+  memcpy(page.data() + header_size, entries_.data(), entries_.size());
+  pages_.push_back(std::move(page));
+  offsets_.clear();
+  entries_.clear();
+}
+
+SortedRun::SortedRun(BufferPoolManager* bpm, std::vector<PageId_t> page_ids,
+                     std::vector<std::string> first_keys,
+                     std::string last_key, BloomFilter bloom)
+    : bpm_(bpm),
+      page_ids_(std::move(page_ids)),
+      first_keys_(std::move(first_keys)),
+      last_key_(std::move(last_key)),
+      bloom_(std::move(bloom)) {}
+
+SortedRun::~SortedRun() {
+  for (PageId_t page_id : page_ids_) {
+    bpm_->DeletePage(page_id);
+  }
+}
+
+bool SortedRun::MayContain(std::string_view key) const {
+  return key >= first_keys_.front() && key <= last_key_ &&
+         bloom_.MayContain(key);
+}
+
+std::optional<LsmValue> SortedRun::Get(std::string_view key,
+                                       std::string& buffer) const {
+  auto it = std::upper_bound(
+      first_keys_.begin(), first_keys_.end(), key,
+      [](std::string_view key, const std::string& first) {
+        return key < first;
+      });
+  if (it == first_keys_.begin()) {
+    return std::nullopt;
+  }
+  auto guard = bpm_->ReadPage(page_ids_[it - first_keys_.begin() - 1],
+                              AccessType::Lookup);
+  const char* page = guard.GetData();
+
+  std::string_view entry_key;
+  LsmValue value;
+  uint16_t low = 0;
+  uint16_t high = GetCount(page);
+  while (low < high) {
+    uint16_t mid = (low + high) / 2;
+    GetEntry(page, mid, entry_key, value);
+    if (entry_key < key) {
+      low = mid + 1;
+    } else if (key < entry_key) {
+      high = mid;
+    } else {
+      buffer.assign(value.value);
+      return LsmValue{value.deleted, buffer};
+    }
+  }
+  return std::nullopt;
+}
+
+std::string_view SortedRun::GetFirstKey() const {
+  return first_keys_.front();
+}
+
+std::string_view SortedRun::GetLastKey() const {
+  return last_key_;
+}
+
+size_t SortedRun::GetPageCount() const {
+  return page_ids_.size();
+}
+
+SortedRun::Iterator::Iterator(const SortedRun* run) : run_(run) {
+  LoadPage_();
+}
+
+bool SortedRun::Iterator::IsEnd() const {
+  return !guard_.has_value();
+}
+
+std::string_view SortedRun::Iterator::Key() const {
+  return key_;
+}
+
+LsmValue SortedRun::Iterator::Value() const {
+  return value_;
+}
+
+SortedRun::Iterator& SortedRun::Iterator::operator++() {
+  if (++entry_ < count_) {
+    LoadEntry_();
+    return *this;
+  }
+  guard_.reset();
+  page_++;
+  LoadPage_();
+  return *this;
+}
+
+void SortedRun::Iterator::LoadPage_() {
+  entry_ = 0;
+  const auto& page_ids = run_->page_ids_;
+  if (page_ >= page_ids.size()) {
+    return;
+  }
+  if (page_ % LSM_READ_AHEAD_PAGES == 0) {
+    auto end = page_ids.begin() +
+               std::min(page_ids.size(), page_ + LSM_READ_AHEAD_PAGES);
+    run_->bpm_->PrefetchPages({page_ids.begin() + page_, end});
+  }
+  guard_ = run_->bpm_->ReadPage(page_ids[page_], AccessType::Scan);
+  count_ = GetCount(guard_->GetData());
+  LoadEntry_();
+}
+
+void SortedRun::Iterator::LoadEntry_() {
+  GetEntry(guard_->GetData(), entry_, key_, value_);
+}
@@ -0,0 +1,41 @@
+#include <storage/page/b_plus_tree_page.hpp>
+
+bool BPlusTreePage::IsLeaf() const {
+  return page_type_ == IndexPageType::Leaf;
+}
+
+IndexPageType BPlusTreePage::GetPageType() const {
+  return page_type_;
+}
+
+void BPlusTreePage::SetPageType(IndexPageType page_type) {
+  page_type_ = page_type;
+}
+
+int BPlusTreePage::GetSize() const {
+  return size_;
+}
+
+void BPlusTreePage::SetSize(int size) {
+  size_ = size;
+}
+
+void BPlusTreePage::IncreaseSize(int amount) {
+  size_ += amount;
+}
+
+int BPlusTreePage::GetMaxSize() const {
+  return max_size_;
+}
+
+void BPlusTreePage::SetMaxSize(int max_size) {
+  max_size_ = max_size;
+}
+
+int BPlusTreePage::GetMinSize() const {
+  // Leaves count key/value pairs, internal pages count children
+  if (IsLeaf()) {
+    return max_size_ / 2;
+  }
+  return (max_size_ + 1) / 2;
+}
@@ -0,0 +1,102 @@
+#include <storage/page/extendible_htable_directory_page.hpp>
+
+#include <stdexcept>
+
+void ExtendibleHTableDirectoryPage::Init(uint32_t max_depth) {
+  if (max_depth > HTABLE_DIRECTORY_MAX_DEPTH) {
+    throw std::runtime_error("Hash table directory depth too large");
+  }
+  max_depth_ = max_depth;
+  global_depth_ = 0;
+  for (uint32_t i = 0; i < HTABLE_DIRECTORY_ARRAY_SIZE; i++) {
+    local_depths_[i] = 0;
+    bucket_page_ids_[i] = INVALID_PAGE_ID;
+  }
+}
+
+uint32_t ExtendibleHTableDirectoryPage::HashToBucketIndex(uint32_t hash) const {
+  return hash & GetGlobalDepthMask();
+}
+
+PageId_t ExtendibleHTableDirectoryPage::GetBucketPageId(
+    uint32_t bucket_index) const {
+  return bucket_page_ids_[bucket_index];
+}
+
+void ExtendibleHTableDirectoryPage::SetBucketPageId(uint32_t bucket_index,
+                                                    PageId_t page_id) {
+  bucket_page_ids_[bucket_index] = page_id;
+}
+
+uint32_t ExtendibleHTableDirectoryPage::GetSplitImageIndex(
+    uint32_t bucket_index) const {
+  uint32_t local_depth = local_depths_[bucket_index];
+  if (local_depth == 0) {
+    return bucket_index;
+  }
+  return bucket_index ^ (1 << (local_depth - 1));
+}
+
+uint32_t ExtendibleHTableDirectoryPage::GetGlobalDepth() const {
+  return global_depth_;
+}
+
+uint32_t ExtendibleHTableDirectoryPage::GetMaxDepth() const {
+  return max_depth_;
+}
+
+uint32_t ExtendibleHTableDirectoryPage::GetGlobalDepthMask() const {
+  return (1 << global_depth_) - 1;
+}
+
+void ExtendibleHTableDirectoryPage::IncrGlobalDepth() {
+  if (global_depth_ >= max_depth_) {
+    throw std::runtime_error("Hash table directory is at its max depth");
+  }
+
+  // The new upper half mirrors the lower half
+  uint32_t size = Size();
+  for (uint32_t i = 0; i < size; i++) {
+    local_depths_[i + size] = local_depths_[i];
+    bucket_page_ids_[i + size] = bucket_page_ids_[i];
+  }
+  global_depth_++;
+}
+
+void ExtendibleHTableDirectoryPage::DecrGlobalDepth() {
+  if (global_depth_ == 0) {
+    return;
+  }
+  global_depth_--;
+}
+
+bool ExtendibleHTableDirectoryPage::CanShrink() const {
+  if (global_depth_ == 0) {
+    return false;
+  }
+  for (uint32_t i = 0; i < Size(); i++) {
+    if (local_depths_[i] >= global_depth_) {
+      return false;
+    }
+  }
+  return true;
+}
+
+uint32_t ExtendibleHTableDirectoryPage::Size() const {
+  return 1 << global_depth_;
+}
+
+uint32_t ExtendibleHTableDirectoryPage::GetLocalDepth(
+    uint32_t bucket_index) const {
+  return local_depths_[bucket_index];
+}
+
+void ExtendibleHTableDirectoryPage::SetLocalDepth(uint32_t bucket_index,
+                                                  uint8_t local_depth) {
+  local_depths_[bucket_index] = local_depth;
+}
+
+uint32_t ExtendibleHTableDirectoryPage::GetLocalDepthMask(
+    uint32_t bucket_index) const {
+  return (1 << local_depths_[bucket_index]) - 1;
+}
@@ -0,0 +1,35 @@
+#include <storage/page/extendible_htable_header_page.hpp>
+
+#include <stdexcept>
+
+void ExtendibleHTableHeaderPage::Init(uint32_t max_depth) {
+  if (max_depth > HTABLE_HEADER_MAX_DEPTH) {
+    throw std::runtime_error("Hash table header depth too large");
+  }
+  max_depth_ = max_depth;
+  for (uint32_t i = 0; i < HTABLE_HEADER_ARRAY_SIZE; i++) {
+    directory_page_ids_[i] = INVALID_PAGE_ID;
+  }
+}
+
+uint32_t ExtendibleHTableHeaderPage::HashToDirectoryIndex(
+    uint32_t hash) const {
+  if (max_depth_ == 0) {
+    return 0;
+  }
+  return hash >> (32 - max_depth_);
+}
+
+PageId_t ExtendibleHTableHeaderPage::GetDirectoryPageId(
+    uint32_t directory_index) const {
+  return directory_page_ids_[directory_index];
+}
+
+void ExtendibleHTableHeaderPage::SetDirectoryPageId(uint32_t directory_index,
+                                                    PageId_t page_id) {
+  directory_page_ids_[directory_index] = page_id;
+}
+
+uint32_t ExtendibleHTableHeaderPage::MaxSize() const {
+  return 1 << max_depth_;
+}
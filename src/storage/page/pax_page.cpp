@@ -0,0 +1,110 @@
+#include <storage/page/pax_page.hpp>
+
+#include <cstring>
+
+static size_t AlignUp(size_t size) {
+  return (size + PaxPage::MINIPAGE_ALIGNMENT - 1) &
+         ~(PaxPage::MINIPAGE_ALIGNMENT - 1);
+}
+
+uint16_t PaxPage::Capacity(const Schema& schema, size_t page_size) {
+  size_t begin = MinipagesBegin_(schema.GetColumnCount());
+  if (schema.GetTupleSize() == 0 || begin >= page_size) {
+    return 0;
+  }
+
+  // Start from the unpadded estimate and drop rows until the padded
+  // minipages fit
+  size_t rows = (page_size - begin) / schema.GetTupleSize();
+  while (rows > 0) {
+    size_t end = begin;
+    for (size_t i = 0; i < schema.GetColumnCount(); i++) {
+      end = AlignUp(end) + rows * schema.GetColumn(i).size;
+    }
+    if (end <= page_size) {
+      break;
+    }
+    rows--;
+  }
+  return rows;
+}
+
+void PaxPage::Init(const Schema& schema, uint32_t ordinal, size_t page_size) {
+  next_page_id_ = INVALID_PAGE_ID;
+  ordinal_ = ordinal;
+  num_rows_ = 0;
+  capacity_ = Capacity(schema, page_size);
+  num_columns_ = schema.GetColumnCount();
+  reserved_ = 0;
+
+  size_t offset = MinipagesBegin_(num_columns_);
+  for (size_t i = 0; i < num_columns_; i++) {
+    offset = AlignUp(offset);
+    Offsets_()[i] = offset;
+    offset += capacity_ * schema.GetColumn(i).size;
+  }
+}
+
+PageId_t PaxPage::GetNextPageId() const {
+  return next_page_id_;
+}
+
+void PaxPage::SetNextPageId(PageId_t next_page_id) {
+  next_page_id_ = next_page_id;
+}
+
+uint32_t PaxPage::GetOrdinal() const {
+  return ordinal_;
+}
+
+uint32_t PaxPage::GetNumRows() const {
+  return num_rows_;
+}
+
+uint32_t PaxPage::GetCapacity() const {
+  return capacity_;
+}
+
+std::optional<uint32_t> PaxPage::InsertTuple(const Schema& schema,
+                                             const char* data) {
+  if (num_rows_ >= capacity_) {
+    return std::nullopt;
+  }
+  for (size_t i = 0; i < num_columns_; i++) {
+    size_t size = schema.GetColumn(i).size;
+    memcpy(Data_() + Offsets_()[i] + num_rows_ * size,
+           data + schema.GetOffset(i), size);
+  }
+  return num_rows_++;
+}
+
+void PaxPage::GetTuple(const Schema& schema, uint32_t row, char* out) const {
+  for (size_t i = 0; i < num_columns_; i++) {
+    size_t size = schema.GetColumn(i).size;
+    memcpy(out + schema.GetOffset(i), GetMinipage(i) + row * size, size);
+  }
+}
+
+const char* PaxPage::GetMinipage(size_t column) const {
+  return Data_() + Offsets_()[column];
+}
+
+size_t PaxPage::MinipagesBegin_(size_t num_columns) {
+  return HEADER_SIZE + num_columns * sizeof(uint16_t);
+}
+
+const uint16_t* PaxPage::Offsets_() const {
+  return reinterpret_cast<const uint16_t*>(Data_() + HEADER_SIZE);
+}
+
+uint16_t* PaxPage::Offsets_() {
+  return reinterpret_cast<uint16_t*>(Data_() + HEADER_SIZE);
+}
+
+char* PaxPage::Data_() {
+  return reinterpret_cast<char*>(this);
+}
+
+const char* PaxPage::Data_() const {
+  return reinterpret_cast<const char*>(this);
+}
@@ -0,0 +1,161 @@
+#include <storage/page/table_page.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+void TablePage::Init(uint32_t ordinal) {
+  next_page_id_ = INVALID_PAGE_ID;
+  ordinal_ = ordinal;
+  num_slots_ = 0;
+  free_space_offset_ = DB_PAGE_SIZE;
+  garbage_bytes_ = 0;
+  reserved_ = 0;
+}
+
+PageId_t TablePage::GetNextPageId() const {
+  return next_page_id_;
+}
+
+void TablePage::SetNextPageId(PageId_t next_page_id) {
+  next_page_id_ = next_page_id;
+}
+
+uint32_t TablePage::GetOrdinal() const {
+  return ordinal_;
+}
+
+uint32_t TablePage::GetNumSlots() const {
+  return num_slots_;
+}
+
+size_t TablePage::GetFreeSpace() const {
+  size_t free_space = ContiguousFreeSpace() + garbage_bytes_;
+  return free_space < SLOT_SIZE ? 0 : free_space - SLOT_SIZE;
+}
+
+std::optional<uint32_t> TablePage::InsertTuple(const char* data, size_t size) {
+  if (size == 0 || size > GetFreeSpace()) {
+    return std::nullopt;
+  }
+  if (size + SLOT_SIZE > ContiguousFreeSpace()) {
+    Compact();
+  }
+
+  uint32_t slot = 0;
+  while (slot < num_slots_ && !IsDeleted(slot)) {
+    slot++;
+  }
+  if (slot == num_slots_) {
+    num_slots_++;
+  }
+
+  free_space_offset_ -= size;
+  memcpy(Data() + free_space_offset_, data, size);
+  Slots()[slot] = {free_space_offset_, static_cast<uint16_t>(size)};
+  return slot;
+}
+
+std::optional<std::pair<const char*, size_t>> TablePage::GetTuple(
+    uint32_t slot) const {
+  if (IsDeleted(slot)) {
+    return std::nullopt;
+  }
+  const Slot& s = Slots()[slot];
+  return std::make_pair(Data() + s.offset, static_cast<size_t>(s.size));
+}
+
+bool TablePage::IsDeleted(uint32_t slot) const {
+  return slot >= num_slots_ || (Slots()[slot].size & DELETED_FLAG);
+}
+
+bool TablePage::UpdateTuple(uint32_t slot, const char* data, size_t size) {
+  if (size == 0 || IsDeleted(slot)) {
+    return false;
+  }
+
+  Slot& s = Slots()[slot];
+  if (size <= s.size) {
+    memcpy(Data() + s.offset, data, size);
+    garbage_bytes_ += s.size - size;
+    s.size = size;
+    return true;
+  }
+
+  // The old image becomes garbage, which makes it usable by Compact()
+  if (size > ContiguousFreeSpace() + garbage_bytes_ + s.size) {
+    return false;
+  }
+  garbage_bytes_ += s.size;
+  s.size |= DELETED_FLAG;
+  if (size > ContiguousFreeSpace()) {
+    Compact();
+  }
+
+  free_space_offset_ -= size;
+  memcpy(Data() + free_space_offset_, data, size);
+  Slots()[slot] = {free_space_offset_, static_cast<uint16_t>(size)};
+  return true;
+}
+
+bool TablePage::DeleteTuple(uint32_t slot) {
+  if (IsDeleted(slot)) {
+    return false;
+  }
+  Slot& s = Slots()[slot];
+  garbage_bytes_ += s.size;
+  s.size |= DELETED_FLAG;
+  return true;
+}
+
+TablePage::Slot* TablePage::Slots() {
+  return reinterpret_cast<Slot*>(Data() + HEADER_SIZE);
+}
+
+const TablePage::Slot* TablePage::Slots() const {
+  return reinterpret_cast<const Slot*>(Data() + HEADER_SIZE);
+}
+
+char* TablePage::Data() {
+  return reinterpret_cast<char*>(this);
+}
+
+const char* TablePage::Data() const {
+  return reinterpret_cast<const char*>(this);
+}
+
+size_t TablePage::ContiguousFreeSpace() const {
+  return free_space_offset_ - HEADER_SIZE - num_slots_ * SLOT_SIZE;
+}
+
+void TablePage::Compact() {
+  // Live tuples are moved towards the end of the page, furthest first so a
+  // move never overwrites a tuple that has not been moved yet.
+  std::vector<uint32_t> live;
+  for (uint32_t i = 0; i < num_slots_; i++) {
+    if (!IsDeleted(i)) {
+      live.push_back(i);
+    }
+  }
+  std::sort(live.begin(), live.end(), [&](uint32_t a, uint32_t b) {
+    return Slots()[a].offset > Slots()[b].offset;
+  });
+
+  uint16_t offset = DB_PAGE_SIZE;
+  for (uint32_t slot : live) {
+    Slot& s = Slots()[slot];
+    offset -= s.size;
+    memmove(Data() + offset, Data() + s.offset, s.size);
+    s.offset = offset;
+  }
+  while (num_slots_ > 0 && IsDeleted(num_slots_ - 1)) {
+    num_slots_--;
+  }
+  for (uint32_t i = 0; i < num_slots_; i++) {
+    if (IsDeleted(i)) {
+      Slots()[i] = {offset, DELETED_FLAG};
+    }
+  }
+  free_space_offset_ = offset;
+  garbage_bytes_ = 0;
+}
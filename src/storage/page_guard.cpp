@@ -1,6 +1,24 @@
 #include <buffer/buffer_pool_manager.hpp>
 #include <storage/page_guard.hpp>
 
+OptimisticPageGuard::OptimisticPageGuard(PageId_t page_id, FrameHeader* frame,
+                                         uint64_t version)
+    : page_id_(page_id), frame_(frame), version_(version) {}
+
+PageId_t OptimisticPageGuard::GetPageId() const {
+  return page_id_;
+}
+
+const char* OptimisticPageGuard::GetData() const {
+  return frame_->GetData();
+}
+
+bool OptimisticPageGuard::Validate() const {
+  // Orders the data reads before the version check
+  std::atomic_thread_fence(std::memory_order_acquire);
+  return frame_->version_.load(std::memory_order_relaxed) == version_;
+}
+
 ReadPageGuard::ReadPageGuard(ReadPageGuard&& other) noexcept
     : page_id_(other.page_id_),
       frame_(std::move(other.frame_)),
@@ -54,19 +72,18 @@ void ReadPageGuard::Flush() {
   }
 
   if (frame_->is_dirty_) {
-    DiskRequest req{.is_write = true,
-                    .data = frame_->GetDataMut(),
-                    .page_id = page_id_,
-                    .cb = disk_scheduler_->CreatePromise()};
-    auto fut = req.cb.get_future();
-    std::vector<DiskRequest> v;
-    v.push_back(std::move(req));
-    disk_scheduler_->Schedule(v);
-    fut.get();
+    auto fut = disk_scheduler_->ScheduleWriteCopy(page_id_, frame_->GetData());
     frame_->is_dirty_ = false;
+    fut.get();
   }
 }
 
+OptimisticPageGuard ReadPageGuard::Optimistic() const {
+  if (!is_valid_)
+    throw std::runtime_error("Error, tried to use an invalid read guard");
+  return OptimisticPageGuard(page_id_, frame_.get(), frame_->version_.load());
+}
+
 void ReadPageGuard::Drop() {
   if (!is_valid_)
     return;
@@ -159,16 +176,9 @@ void WritePageGuard::Flush() {
   }
 
   if (frame_->is_dirty_) {
-    DiskRequest req{.is_write = true,
-                    .data = frame_->GetDataMut(),
-                    .page_id = page_id_,
-                    .cb = disk_scheduler_->CreatePromise()};
-    auto fut = req.cb.get_future();
-    std::vector<DiskRequest> v;
-    v.push_back(std::move(req));
-    disk_scheduler_->Schedule(v);
-    fut.get();
+    auto fut = disk_scheduler_->ScheduleWriteCopy(page_id_, frame_->GetData());
     frame_->is_dirty_ = false;
+    fut.get();
   }
 }
 
@@ -176,6 +186,7 @@ void WritePageGuard::Drop() {
   if (!is_valid_)
     return;
 
+  frame_->version_.fetch_add(1, std::memory_order_release);
   rw_lock_.unlock();
 
   std::unique_lock<std::mutex> lk(*bpm_mutex_);
@@ -202,4 +213,7 @@ WritePageGuard::WritePageGuard(PageId_t page_id,
       replacer_(replacer),
       bpm_mutex_(mutex),
       disk_scheduler_(disk_scheduler),
-      rw_lock_(frame->rw_mutex_) {}
+      rw_lock_(frame->rw_mutex_) {
+  // Odd while latched, optimistic readers of the page fail to validate
+  frame_->version_.fetch_add(1, std::memory_order_acq_rel);
+}
@@ -0,0 +1,28 @@
+#include <storage/staging_buffer_pool.hpp>
+
+StagingBufferPool::StagingBufferPool(size_t num_buffers, size_t page_size)
+    : num_buffers_(num_buffers), data_(num_buffers * page_size, 0) {
+  free_buffers_.reserve(num_buffers_);
+  for (size_t i = 0; i < num_buffers_; i++) {
+    free_buffers_.push_back(data_.data() + i * page_size);
+  }
+}
+
+char* StagingBufferPool::Acquire() {
+  std::unique_lock<std::mutex> l(mutex_);
+  cv_.wait(l, [&]() { return !free_buffers_.empty(); });
+  char* buffer = free_buffers_.back();
+  free_buffers_.pop_back();
+  return buffer;
+}
+
+void StagingBufferPool::Release(char* buffer) {
+  std::unique_lock<std::mutex> l(mutex_);
+  free_buffers_.push_back(buffer);
+  l.unlock();
+  cv_.notify_one();
+}
+
+size_t StagingBufferPool::Size() const {
+  return num_buffers_;
+}
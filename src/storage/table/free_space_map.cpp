@@ -0,0 +1,62 @@
+#include <storage/table/free_space_map.hpp>
+
+#include <algorithm>
+
+uint32_t FreeSpaceMap::AddPage(size_t free_space) {
+  uint32_t ordinal = categories_.size();
+  categories_.push_back(0);
+  positions_.push_back(0);
+  Insert_(ordinal, Category_(free_space));
+  return ordinal;
+}
+
+void FreeSpaceMap::Update(uint32_t ordinal, size_t free_space) {
+  uint8_t category = Category_(free_space);
+  if (categories_[ordinal] == category) {
+    return;
+  }
+  Erase_(ordinal);
+  Insert_(ordinal, category);
+}
+
+std::optional<uint32_t> FreeSpaceMap::FindPage(size_t needed) const {
+  // Every page in a category holds at least category * CATEGORY_SIZE bytes,
+  // so round up to the first category that is guaranteed to fit.
+  size_t category = (needed + CATEGORY_SIZE - 1) / CATEGORY_SIZE;
+  if (category >= NUM_CATEGORIES) {
+    return std::nullopt;
+  }
+  uint64_t candidates = non_empty_ & (~uint64_t{0} << category);
+  if (candidates == 0) {
+    return std::nullopt;
+  }
+  return buckets_[__builtin_ctzll(candidates)].back();
+}
+
+size_t FreeSpaceMap::NumPages() const {
+  return categories_.size();
+}
+
+uint8_t FreeSpaceMap::Category_(size_t free_space) {
+  return std::min(free_space / CATEGORY_SIZE, NUM_CATEGORIES - 1);
+}
+
+void FreeSpaceMap::Insert_(uint32_t ordinal, uint8_t category) {
+  auto& bucket = buckets_[category];
+  categories_[ordinal] = category;
+  positions_[ordinal] = bucket.size();
+  bucket.push_back(ordinal);
+  non_empty_ |= uint64_t{1} << category;
+}
+
+void FreeSpaceMap::Erase_(uint32_t ordinal) {
+  uint8_t category = categories_[ordinal];
+  auto& bucket = buckets_[category];
+  uint32_t last = bucket.back();
+  bucket[positions_[ordinal]] = last;
+  positions_[last] = positions_[ordinal];
+  bucket.pop_back();
+  if (bucket.empty()) {
+    non_empty_ &= ~(uint64_t{1} << category);
+  }
+}
@@ -0,0 +1,162 @@
+#include <storage/page/pax_page.hpp>
+#include <storage/table/pax_table.hpp>
+
+#include <stdexcept>
+#include <utility>
+
+PaxTable::PaxTable(BufferPoolManager* bpm, Schema schema)
+    : bpm_(bpm), schema_(std::move(schema)), zone_map_(schema_) {
+  if (PaxPage::Capacity(schema_, bpm_->GetPageSize()) == 0) {
+    throw std::runtime_error("Schema does not fit in a PAX page");
+  }
+  first_page_id_ = last_page_id_ = NewPage_();
+  bpm_->WritePage(first_page_id_)
+      .AsMut<PaxPage>()
+      ->Init(schema_, 0, bpm_->GetPageSize());
+  page_ids_.push_back(first_page_id_);
+}
+
+PaxTable::PaxTable(BufferPoolManager* bpm, Schema schema,
+                   PageId_t first_page_id)
+    : bpm_(bpm),
+      schema_(std::move(schema)),
+      first_page_id_(first_page_id),
+      zone_map_(schema_) {
+  PageId_t page_id = first_page_id_;
+  while (page_id != INVALID_PAGE_ID) {
+    auto guard = bpm_->ReadPage(page_id, AccessType::Scan);
+    const auto* page = guard.As<PaxPage>();
+    if (page->GetOrdinal() != page_ids_.size() ||
+        page->GetCapacity() !=
+            PaxPage::Capacity(schema_, bpm_->GetPageSize())) {
+      throw std::runtime_error("PAX table page list is corrupted");
+    }
+    page_ids_.push_back(page_id);
+    last_page_id_ = page_id;
+    page_id = page->GetNextPageId();
+  }
+}
+
+const Schema& PaxTable::GetSchema() const {
+  return schema_;
+}
+
+PageId_t PaxTable::GetFirstPageId() const {
+  return first_page_id_;
+}
+
+std::vector<PageId_t> PaxTable::GetPageIds() {
+  std::scoped_lock lock(mutex_);
+  return page_ids_;
+}
+
+std::vector<PageId_t> PaxTable::GetPageIds(size_t column, const char* low,
+                                           const char* high) {
+  CheckColumns_({column});
+  std::scoped_lock lock(mutex_);
+  std::vector<PageId_t> page_ids;
+  for (size_t i = 0; i < page_ids_.size(); i++) {
+    if (zone_map_.MayContain(i, column, low, high)) {
+      page_ids.push_back(page_ids_[i]);
+    }
+  }
+  return page_ids;
+}
+
+void PaxTable::AddZoneMap(size_t column) {
+  CheckColumns_({column});
+  std::scoped_lock lock(mutex_);
+  if (zone_map_.HasColumn(column)) {
+    return;
+  }
+  zone_map_.AddColumn(column);
+  const size_t size = schema_.GetColumn(column).size;
+  for (size_t i = 0; i < page_ids_.size(); i++) {
+    auto guard = bpm_->ReadPage(page_ids_[i], AccessType::Scan);
+    const auto* page = guard.As<PaxPage>();
+    const char* values = page->GetMinipage(column);
+    for (uint32_t row = 0; row < page->GetNumRows(); row++) {
+      zone_map_.Update(i, column, values + row * size);
+    }
+  }
+}
+
+std::optional<RID> PaxTable::InsertTuple(const Tuple& tuple) {
+  if (tuple.GetSize() != schema_.GetTupleSize()) {
+    return std::nullopt;
+  }
+
+  std::scoped_lock lock(mutex_);
+  {
+    auto guard = bpm_->WritePage(last_page_id_);
+    auto row = guard.AsMut<PaxPage>()->InsertTuple(schema_, tuple.GetData());
+    if (row.has_value()) {
+      UpdateZones_(page_ids_.size() - 1, tuple);
+      return RID{last_page_id_, *row};
+    }
+  }
+
+  PageId_t page_id = NewPage_();
+  auto guard = bpm_->WritePage(page_id);
+  auto* page = guard.AsMut<PaxPage>();
+  page->Init(schema_, page_ids_.size(), bpm_->GetPageSize());
+  auto row = page->InsertTuple(schema_, tuple.GetData());
+  UpdateZones_(page_ids_.size(), tuple);
+
+  // The new page is fully set up before it becomes reachable by scans
+  bpm_->WritePage(last_page_id_).AsMut<PaxPage>()->SetNextPageId(page_id);
+  last_page_id_ = page_id;
+  page_ids_.push_back(page_id);
+  return RID{page_id, *row};
+}
+
+PageId_t PaxTable::NewPage_() {
+  if (extent_pages_left_ == 0) {
+    next_page_id_ = bpm_->NewPages(TABLE_EXTENT_PAGES, first_page_id_);
+    extent_pages_left_ = TABLE_EXTENT_PAGES;
+  }
+  extent_pages_left_--;
+  return next_page_id_++;
+}
+
+std::optional<Tuple> PaxTable::GetTuple(RID rid) {
+  auto guard = bpm_->ReadPage(rid.page_id);
+  const auto* page = guard.As<PaxPage>();
+  if (rid.slot >= page->GetNumRows()) {
+    return std::nullopt;
+  }
+  std::vector<char> data(schema_.GetTupleSize());
+  page->GetTuple(schema_, rid.slot, data.data());
+  return Tuple(data.data(), data.size(), rid);
+}
+
+PaxTableIterator PaxTable::Scan(std::vector<size_t> columns) {
+  CheckColumns_(columns);
+  return PaxTableIterator(bpm_, &schema_, std::move(columns),
+                          bpm_->ReadPage(first_page_id_, AccessType::Scan));
+}
+
+PaxTableIterator PaxTable::Scan(std::vector<size_t> columns,
+                                std::vector<PageId_t> page_ids) {
+  CheckColumns_(columns);
+  if (page_ids.empty()) {
+    return PaxTableIterator();
+  }
+  return PaxTableIterator(bpm_, &schema_, std::move(columns),
+                          std::move(page_ids));
+}
+
+void PaxTable::CheckColumns_(const std::vector<size_t>& columns) const {
+  for (size_t column : columns) {
+    if (column >= schema_.GetColumnCount()) {
+      throw std::runtime_error("Projected column out of range");
+    }
+  }
+}
+
+void PaxTable::UpdateZones_(uint32_t ordinal, const Tuple& tuple) {
+  for (size_t column : zone_map_.GetColumns()) {
+    zone_map_.Update(ordinal, column,
+                     tuple.GetData() + schema_.GetOffset(column));
+  }
+}
@@ -0,0 +1,115 @@
+#include <storage/page/pax_page.hpp>
+#include <storage/table/pax_table_iterator.hpp>
+
+#include <algorithm>
+#include <utility>
+
+PaxTableIterator::PaxTableIterator(BufferPoolManager* bpm,
+                                   const Schema* schema,
+                                   std::vector<size_t> columns,
+                                   ReadPageGuard guard)
+    : bpm_(bpm),
+      schema_(schema),
+      columns_(std::move(columns)),
+      minipages_(columns_.size()),
+      guard_(std::move(guard)) {
+  for (size_t column : columns_) {
+    sizes_.push_back(schema_->GetColumn(column).size);
+  }
+  LoadPage_();
+}
+
+PaxTableIterator::PaxTableIterator(BufferPoolManager* bpm,
+                                   const Schema* schema,
+                                   std::vector<size_t> columns,
+                                   std::vector<PageId_t> page_ids)
+    : bpm_(bpm),
+      schema_(schema),
+      columns_(std::move(columns)),
+      minipages_(columns_.size()),
+      page_ids_(std::move(page_ids)) {
+  for (size_t column : columns_) {
+    sizes_.push_back(schema_->GetColumn(column).size);
+  }
+  ReadPage_(page_ids_.front());
+  LoadPage_();
+}
+
+bool PaxTableIterator::IsEnd() const {
+  return !guard_.has_value();
+}
+
+RID PaxTableIterator::GetRid() const {
+  if (IsEnd()) {
+    return RID{};
+  }
+  return RID{guard_->GetPageId(), row_};
+}
+
+uint32_t PaxTableIterator::GetPageRows() const {
+  return num_rows_;
+}
+
+const char* PaxTableIterator::GetMinipage(size_t index) const {
+  return minipages_[index];
+}
+
+PaxTableIterator& PaxTableIterator::operator++() {
+  if (++row_ >= num_rows_) {
+    NextPage();
+  }
+  return *this;
+}
+
+PaxTableIterator& PaxTableIterator::NextPage() {
+  PageId_t next = NextPageId_();
+  if (next == INVALID_PAGE_ID) {
+    guard_.reset();
+    return *this;
+  }
+  ReadPage_(next);
+  LoadPage_();
+  return *this;
+}
+
+PageId_t PaxTableIterator::NextPageId_() const {
+  if (page_ids_.empty()) {
+    return guard_->As<PaxPage>()->GetNextPageId();
+  }
+  return next_page_ < page_ids_.size() ? page_ids_[next_page_]
+                                       : INVALID_PAGE_ID;
+}
+
+void PaxTableIterator::ReadPage_(PageId_t page_id) {
+  if (!page_ids_.empty()) {
+    if (next_page_ % READ_AHEAD_PAGES == 0) {
+      auto end = page_ids_.begin() +
+                 std::min(page_ids_.size(), next_page_ + READ_AHEAD_PAGES);
+      bpm_->PrefetchPages({page_ids_.begin() + next_page_, end});
+    }
+    next_page_++;
+  }
+  guard_ = bpm_->ReadPage(page_id, AccessType::Scan);
+}
+
+// Empty pages only happen for a new table, they are skipped
+void PaxTableIterator::LoadPage_() {
+  while (true) {
+    const auto* page = guard_->As<PaxPage>();
+    num_rows_ = page->GetNumRows();
+    row_ = 0;
+    if (num_rows_ > 0) {
+      for (size_t i = 0; i < columns_.size(); i++) {
+        minipages_[i] = page->GetMinipage(columns_[i]);
+      }
+      return;
+    }
+
+    PageId_t next = NextPageId_();
+    if (next == INVALID_PAGE_ID) {
+      guard_.reset();
+      return;
+    }
+    ReadPage_(next);
+  }
+}
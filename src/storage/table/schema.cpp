@@ -0,0 +1,89 @@
+#include <storage/table/schema.hpp>
+
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+Column::Column(std::string name, TypeId type, uint16_t length)
+    : name(std::move(name)), type(type) {
+  switch (type) {
+    case TypeId::Int32:
+    case TypeId::Date:
+      size = sizeof(int32_t);
+      break;
+    case TypeId::Int64:
+      size = sizeof(int64_t);
+      break;
+    case TypeId::Float64:
+      size = sizeof(double);
+      break;
+    case TypeId::Char:
+      if (length == 0) {
+        throw std::runtime_error("Char column needs a length");
+      }
+      size = length;
+      break;
+  }
+}
+
+Schema::Schema(std::vector<Column> columns) : columns_(std::move(columns)) {
+  for (const auto& column : columns_) {
+    offsets_.push_back(tuple_size_);
+    tuple_size_ += column.size;
+  }
+}
+
+size_t Schema::GetColumnCount() const {
+  return columns_.size();
+}
+
+const Column& Schema::GetColumn(size_t index) const {
+  return columns_[index];
+}
+
+std::optional<size_t> Schema::GetColumnIndex(std::string_view name) const {
+  for (size_t i = 0; i < columns_.size(); i++) {
+    if (columns_[i].name == name) {
+      return i;
+    }
+  }
+  return std::nullopt;
+}
+
+size_t Schema::GetOffset(size_t index) const {
+  return offsets_[index];
+}
+
+size_t Schema::GetTupleSize() const {
+  return tuple_size_;
+}
+
+uint64_t NormalizeKey(TypeId type, const char* value, size_t width) {
+  switch (type) {
+    case TypeId::Int32:
+    case TypeId::Date: {
+      int32_t key;
+      memcpy(&key, value, sizeof(key));
+      return static_cast<uint32_t>(key) ^ (uint32_t{1} << 31);
+    }
+    case TypeId::Int64: {
+      int64_t key;
+      memcpy(&key, value, sizeof(key));
+      return static_cast<uint64_t>(key) ^ (uint64_t{1} << 63);
+    }
+    case TypeId::Float64: {
+      uint64_t bits;
+      memcpy(&bits, value, sizeof(bits));
+      return bits >> 63 ? ~bits : bits | uint64_t{1} << 63;
+    }
+    case TypeId::Char: {
+      // Big endian, so bytes compare in order
+      uint64_t key = 0;
+      for (size_t i = 0; i < sizeof(key); i++) {
+        key = key << 8 | (i < width ? static_cast<uint8_t>(value[i]) : 0);
+      }
+      return key;
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,115 @@
+#include <storage/page/table_page.hpp>
+#include <storage/table/table_heap.hpp>
+
+#include <stdexcept>
+
+TableHeap::TableHeap(BufferPoolManager* bpm) : bpm_(bpm) {
+  RequireDefaultPageSize(bpm_->GetPageSize(), "Table heap");
+  first_page_id_ = last_page_id_ = NewPage_();
+  auto guard = bpm_->WritePage(first_page_id_);
+  auto* page = guard.AsMut<TablePage>();
+  page->Init(0);
+  free_space_map_.AddPage(page->GetFreeSpace());
+  page_ids_.push_back(first_page_id_);
+}
+
+TableHeap::TableHeap(BufferPoolManager* bpm, PageId_t first_page_id)
+    : bpm_(bpm), first_page_id_(first_page_id) {
+  RequireDefaultPageSize(bpm_->GetPageSize(), "Table heap");
+  PageId_t page_id = first_page_id_;
+  while (page_id != INVALID_PAGE_ID) {
+    auto guard = bpm_->ReadPage(page_id, AccessType::Scan);
+    const auto* page = guard.As<TablePage>();
+    if (page->GetOrdinal() != free_space_map_.NumPages()) {
+      throw std::runtime_error("Table heap page list is corrupted");
+    }
+    free_space_map_.AddPage(page->GetFreeSpace());
+    page_ids_.push_back(page_id);
+    last_page_id_ = page_id;
+    page_id = page->GetNextPageId();
+  }
+}
+
+PageId_t TableHeap::GetFirstPageId() const {
+  return first_page_id_;
+}
+
+std::optional<RID> TableHeap::InsertTuple(const Tuple& tuple) {
+  if (tuple.GetSize() == 0 || tuple.GetSize() > TablePage::MAX_TUPLE_SIZE) {
+    return std::nullopt;
+  }
+
+  std::scoped_lock lock(mutex_);
+  std::optional<uint32_t> ordinal;
+  while ((ordinal = free_space_map_.FindPage(tuple.GetSize()))) {
+    PageId_t page_id = page_ids_[*ordinal];
+    auto guard = bpm_->WritePage(page_id);
+    auto* page = guard.AsMut<TablePage>();
+    auto slot = page->InsertTuple(tuple.GetData(), tuple.GetSize());
+    free_space_map_.Update(*ordinal, page->GetFreeSpace());
+    if (slot.has_value()) {
+      return RID{page_id, *slot};
+    }
+  }
+
+  PageId_t page_id = NewPage_();
+  auto guard = bpm_->WritePage(page_id);
+  auto* page = guard.AsMut<TablePage>();
+  page->Init(page_ids_.size());
+  auto slot = page->InsertTuple(tuple.GetData(), tuple.GetSize());
+  free_space_map_.AddPage(page->GetFreeSpace());
+  page_ids_.push_back(page_id);
+
+  // The new page is fully set up before it becomes reachable by scans
+  bpm_->WritePage(last_page_id_).AsMut<TablePage>()->SetNextPageId(page_id);
+  last_page_id_ = page_id;
+  return RID{page_id, *slot};
+}
+
+PageId_t TableHeap::NewPage_() {
+  if (extent_pages_left_ == 0) {
+    next_page_id_ = bpm_->NewPages(TABLE_EXTENT_PAGES, first_page_id_);
+    extent_pages_left_ = TABLE_EXTENT_PAGES;
+  }
+  extent_pages_left_--;
+  return next_page_id_++;
+}
+
+std::optional<Tuple> TableHeap::GetTuple(RID rid) {
+  auto guard = bpm_->ReadPage(rid.page_id);
+  auto tuple = guard.As<TablePage>()->GetTuple(rid.slot);
+  if (!tuple.has_value()) {
+    return std::nullopt;
+  }
+  return Tuple(tuple->first, tuple->second, rid);
+}
+
+bool TableHeap::UpdateTuple(RID rid, const Tuple& tuple) {
+  std::scoped_lock lock(mutex_);
+  auto guard = bpm_->WritePage(rid.page_id);
+  auto* page = guard.AsMut<TablePage>();
+  if (!page->UpdateTuple(rid.slot, tuple.GetData(), tuple.GetSize())) {
+    return false;
+  }
+  free_space_map_.Update(page->GetOrdinal(), page->GetFreeSpace());
+  return true;
+}
+
+bool TableHeap::DeleteTuple(RID rid) {
+  std::scoped_lock lock(mutex_);
+  auto guard = bpm_->WritePage(rid.page_id);
+  auto* page = guard.AsMut<TablePage>();
+  if (!page->DeleteTuple(rid.slot)) {
+    return false;
+  }
+  free_space_map_.Update(page->GetOrdinal(), page->GetFreeSpace());
+  return true;
+}
+
+TableIterator TableHeap::Begin() {
+  return TableIterator(bpm_, bpm_->ReadPage(first_page_id_, AccessType::Scan));
+}
+
+TableIterator TableHeap::End() {
+  return TableIterator();
+}
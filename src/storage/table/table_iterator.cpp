@@ -0,0 +1,58 @@
+#include <storage/page/table_page.hpp>
+#include <storage/table/table_iterator.hpp>
+
+TableIterator::TableIterator(BufferPoolManager* bpm, ReadPageGuard guard)
+    : bpm_(bpm), guard_(std::move(guard)), rid_{guard_->GetPageId(), 0} {
+  SkipDeleted_();
+}
+
+bool TableIterator::IsEnd() const {
+  return !guard_.has_value();
+}
+
+Tuple TableIterator::operator*() const {
+  auto tuple = guard_->As<TablePage>()->GetTuple(rid_.slot);
+  return Tuple(tuple->first, tuple->second, rid_);
+}
+
+RID TableIterator::GetRid() const {
+  return rid_;
+}
+
+TableIterator& TableIterator::operator++() {
+  rid_.slot++;
+  SkipDeleted_();
+  return *this;
+}
+
+bool TableIterator::operator==(const TableIterator& other) const {
+  if (IsEnd() || other.IsEnd()) {
+    return IsEnd() == other.IsEnd();
+  }
+  return rid_ == other.rid_;
+}
+
+bool TableIterator::operator!=(const TableIterator& other) const {
+  return !(*this == other);
+}
+
+void TableIterator::SkipDeleted_() {
+  while (guard_.has_value()) {
+    const auto* page = guard_->As<TablePage>();
+    while (rid_.slot < page->GetNumSlots() && page->IsDeleted(rid_.slot)) {
+      rid_.slot++;
+    }
+    if (rid_.slot < page->GetNumSlots()) {
+      return;
+    }
+
+    PageId_t next = page->GetNextPageId();
+    if (next == INVALID_PAGE_ID) {
+      guard_.reset();
+      rid_ = RID{};
+      return;
+    }
+    guard_ = bpm_->ReadPage(next, AccessType::Scan);
+    rid_ = RID{next, 0};
+  }
+}
@@ -0,0 +1,55 @@
+#include <storage/table/zone_map.hpp>
+
+#include <algorithm>
+
+ZoneMap::ZoneMap(const Schema& schema) : schema_(schema) {}
+
+void ZoneMap::AddColumn(size_t column) {
+  if (!HasColumn(column)) {
+    columns_.push_back(column);
+    zones_.emplace_back();
+  }
+}
+
+bool ZoneMap::HasColumn(size_t column) const {
+  return std::find(columns_.begin(), columns_.end(), column) !=
+         columns_.end();
+}
+
+const std::vector<size_t>& ZoneMap::GetColumns() const {
+  return columns_;
+}
+
+void ZoneMap::Update(uint32_t ordinal, size_t column, const char* value) {
+  size_t i = std::find(columns_.begin(), columns_.end(), column) -
+             columns_.begin();
+  if (i == columns_.size()) {
+    return;
+  }
+  if (zones_[i].size() <= ordinal) {
+    zones_[i].resize(ordinal + 1);
+  }
+  uint64_t key = Key_(column, value);
+  Zone& zone = zones_[i][ordinal];
+  zone.min = std::min(zone.min, key);
+  zone.max = std::max(zone.max, key);
+}
+
+bool ZoneMap::MayContain(uint32_t ordinal, size_t column, const char* low,
+                         const char* high) const {
+  size_t i = std::find(columns_.begin(), columns_.end(), column) -
+             columns_.begin();
+  if (i == columns_.size()) {
+    return true;
+  }
+  if (zones_[i].size() <= ordinal) {
+    return false;
+  }
+  const Zone& zone = zones_[i][ordinal];
+  return zone.min <= Key_(column, high) && Key_(column, low) <= zone.max;
+}
+
+uint64_t ZoneMap::Key_(size_t column, const char* value) const {
+  const Column& col = schema_.GetColumn(column);
+  return NormalizeKey(col.type, value, col.size);
+}
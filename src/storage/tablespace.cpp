@@ -0,0 +1,192 @@
+#include <storage/tablespace.hpp>
+
+#include <set>
+#include <stdexcept>
+
+Tablespace::Tablespace(const std::filesystem::path& file_name,
+                       const std::vector<std::filesystem::path>& directories,
+                       TablespacePlacement placement, size_t page_size)
+    : DiskManager(directories.empty() ? file_name
+                                      : directories[0] / file_name,
+                  page_size),
+      placement_(placement) {
+  if (directories.empty()) {
+    throw std::runtime_error("Tablespace needs a directory");
+  }
+  std::set<std::filesystem::path> seen;
+  for (const auto& directory : directories) {
+    if (!seen.insert(std::filesystem::absolute(directory).lexically_normal())
+             .second) {
+      throw std::runtime_error("Tablespace directories must differ");
+    }
+  }
+
+  file_names_.push_back(directories[0] / file_name);
+  files_.emplace_back();
+  for (size_t i = 1; i < directories.size(); i++) {
+    file_names_.push_back(directories[i] / file_name);
+    files_.push_back(std::make_unique<DiskManager>(file_names_.back(),
+                                                   page_size_, false));
+  }
+}
+
+Tablespace::~Tablespace() = default;
+
+void Tablespace::ShutDown() {
+  for (size_t i = 1; i < files_.size(); i++) {
+    files_[i]->ShutDown();
+  }
+  DiskManager::ShutDown();
+}
+
+void Tablespace::WritePage(PageId_t page_id, const char* data) {
+  size_t file = GetFile(page_id);
+  if (file == 0) {
+    DiskManager::WritePage(page_id, data);
+  } else {
+    files_[file]->WritePage(page_id, data);
+  }
+}
+
+void Tablespace::ReadPage(PageId_t page_id, char* data) {
+  size_t file = GetFile(page_id);
+  if (file == 0) {
+    DiskManager::ReadPage(page_id, data);
+  } else {
+    files_[file]->ReadPage(page_id, data);
+  }
+}
+
+void Tablespace::DeletePage(PageId_t page_id) {
+  size_t file = GetFile(page_id);
+  bool live = GetPageOffset(page_id).has_value();
+  if (file == 0) {
+    DiskManager::DeletePage(page_id);
+  } else {
+    files_[file]->DeletePage(page_id);
+  }
+  if (live) {
+    ReleaseExtentPage_(page_id);
+  }
+}
+
+void Tablespace::AllocateExtent(PageId_t first_page_id, size_t count,
+                                PageId_t owner) {
+  size_t file;
+  {
+    std::scoped_lock lock(mutex_);
+    PageId_t key = INVALID_PAGE_ID;
+    auto object = objects_.find(owner);
+    if (placement_ == TablespacePlacement::PerObject &&
+        object != objects_.end()) {
+      file = object->second.file;
+      object->second.extents++;
+      key = owner;
+    } else {
+      file = next_file_;
+      next_file_ = (next_file_ + 1) % files_.size();
+      if (placement_ == TablespacePlacement::PerObject &&
+          owner == INVALID_PAGE_ID) {
+        objects_[first_page_id] = Object{file, 1};
+        key = first_page_id;
+      }
+    }
+    extents_[first_page_id] = Extent{count, file, count, key};
+  }
+
+  if (file == 0) {
+    DiskManager::AllocateExtent(first_page_id, count, owner);
+  } else {
+    files_[file]->AllocateExtent(first_page_id, count, owner);
+  }
+}
+
+void Tablespace::WritePages(
+    const std::vector<std::pair<PageId_t, const char*>>& pages) {
+  std::vector<std::vector<std::pair<PageId_t, const char*>>> batches(
+      files_.size());
+  for (const auto& page : pages) {
+    batches[GetFile(page.first)].push_back(page);
+  }
+
+  if (!batches[0].empty()) {
+    DiskManager::WritePages(batches[0]);
+  }
+  for (size_t i = 1; i < files_.size(); i++) {
+    if (!batches[i].empty()) {
+      files_[i]->WritePages(batches[i]);
+    }
+  }
+}
+
+void Tablespace::Sync() {
+  DiskManager::Sync();
+  for (size_t i = 1; i < files_.size(); i++) {
+    files_[i]->Sync();
+  }
+}
+
+CompactionResult Tablespace::Compact(size_t max_pages,
+                                     size_t pages_per_second) {
+  CompactionResult total = DiskManager::Compact(max_pages, pages_per_second);
+  for (size_t i = 1; i < files_.size(); i++) {
+    auto result = files_[i]->Compact(max_pages, pages_per_second);
+    total.pages_moved += result.pages_moved;
+    total.bytes_copied += result.bytes_copied;
+    total.file_size_before += result.file_size_before;
+    total.file_size_after += result.file_size_after;
+    total.bytes_punched += result.bytes_punched;
+  }
+  return total;
+}
+
+size_t Tablespace::GetFileCount() const {
+  return files_.size();
+}
+
+size_t Tablespace::GetFile(PageId_t page_id) const {
+  {
+    std::scoped_lock lock(mutex_);
+    auto it = extents_.upper_bound(page_id);
+    if (it != extents_.begin()) {
+      --it;
+      if (page_id < it->first + static_cast<PageId_t>(it->second.count)) {
+        return it->second.file;
+      }
+    }
+  }
+  return (page_id / TABLESPACE_STRIPE_PAGES) % files_.size();
+}
+
+std::optional<size_t> Tablespace::GetPageOffset(PageId_t page_id) {
+  size_t file = GetFile(page_id);
+  if (file == 0) {
+    return DiskManager::GetPageOffset(page_id);
+  }
+  return files_[file]->GetPageOffset(page_id);
+}
+
+std::filesystem::path Tablespace::GetFileName(size_t file) const {
+  return file_names_[file];
+}
+
+// An emptied extent no longer pins its pages' file, and an object without
+// extents no longer has one
+void Tablespace::ReleaseExtentPage_(PageId_t page_id) {
+  std::scoped_lock lock(mutex_);
+  auto it = extents_.upper_bound(page_id);
+  if (it == extents_.begin()) {
+    return;
+  }
+  --it;
+  Extent& extent = it->second;
+  if (page_id >= it->first + static_cast<PageId_t>(extent.count) ||
+      --extent.live > 0) {
+    return;
+  }
+  auto object = objects_.find(extent.object);
+  if (object != objects_.end() && --object->second.extents == 0) {
+    objects_.erase(object);
+  }
+  extents_.erase(it);
+}
@@ -0,0 +1,464 @@
+#include <storage/tiered_disk_manager.hpp>
+
+#include <storage/file_io.hpp>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <algorithm>
+#include <fstream>
+#include <stdexcept>
+
+namespace {
+
+// Share of the fast tier the migration keeps free for new pages
+const size_t FAST_HEADROOM_FRACTION = 8;
+const uint64_t CHECKPOINT_MAGIC = 0x5449455244504753;
+
+struct CheckpointEntry {
+  PageId_t page_id;
+  uint64_t slot;
+  uint32_t tier;
+  uint32_t heat;
+};
+
+}  // namespace
+
+TieredDiskManager::TieredDiskManager(
+    const std::filesystem::path& file_name,
+    const std::filesystem::path& fast_directory,
+    const std::filesystem::path& slow_directory, size_t fast_pages,
+    size_t pages_per_second, std::chrono::microseconds slow_latency,
+    size_t page_size)
+    : DiskManager(fast_directory / file_name, page_size),
+      fast_file_name_(fast_directory / file_name),
+      slow_file_name_(slow_directory / file_name),
+      checkpoint_file_name_(file_name.stem().string() + ".map"),
+      fast_pages_(fast_pages),
+      pages_per_second_(pages_per_second),
+      slow_latency_(slow_latency) {
+  fast_.fd = open(fast_file_name_.c_str(), O_RDWR);
+  if (fast_.fd < 0) {
+    throw std::runtime_error("Can't open db file");
+  }
+  slow_.fd = open(slow_file_name_.c_str(), O_RDWR | O_CREAT, 0644);
+  if (slow_.fd < 0) {
+    close(fast_.fd);
+    throw std::runtime_error("Can't open slow tier file");
+  }
+  LoadCheckpoint_();
+  if (pages_per_second_ > 0) {
+    migrator_ = std::thread(&TieredDiskManager::MigratorWork_, this);
+  }
+}
+
+TieredDiskManager::~TieredDiskManager() {
+  ShutDown();
+}
+
+void TieredDiskManager::ShutDown() {
+  {
+    std::scoped_lock lock(migrator_mutex_);
+    if (stop_) {
+      return;
+    }
+    stop_ = true;
+  }
+  migrator_cv_.notify_one();
+  if (migrator_.joinable()) {
+    migrator_.join();
+  }
+
+  {
+    std::scoped_lock lock(mutex_);
+    Checkpoint_();
+    close(fast_.fd);
+    close(slow_.fd);
+    fast_.fd = slow_.fd = -1;
+  }
+  DiskManager::ShutDown();
+}
+
+void TieredDiskManager::WritePage(PageId_t page_id, const char* data) {
+  std::shared_lock latch(io_latch_);
+  Tier tier;
+  size_t slot;
+  {
+    std::scoped_lock lock(mutex_);
+    auto it = locations_.find(page_id);
+    if (it == locations_.end()) {
+      tier = NewPageTier_();
+      it = locations_.emplace(page_id, Location{tier, AllocateSlot_(tier)})
+               .first;
+    }
+    Touch_(it->second);
+    tier = it->second.tier;
+    slot = it->second.slot;
+    num_writes_ += 1;
+  }
+  Delay_(tier);
+  WriteFully(File_(tier).fd, data, page_size_, slot * page_size_);
+
+  // Bumped once the data is in the slot, a move that copied the slot before
+  // then sees the new version when it installs its copy and drops it
+  std::scoped_lock lock(mutex_);
+  auto it = locations_.find(page_id);
+  if (it != locations_.end()) {
+    it->second.version++;
+  }
+}
+
+void TieredDiskManager::ReadPage(PageId_t page_id, char* buffer) {
+  std::shared_lock latch(io_latch_);
+  Tier tier;
+  size_t slot;
+  {
+    std::scoped_lock lock(mutex_);
+    num_reads_ += 1;
+    auto it = locations_.find(page_id);
+    if (it == locations_.end()) {
+      ZeroPage(buffer, page_size_);
+      return;
+    }
+    Touch_(it->second);
+    tier = it->second.tier;
+    slot = it->second.slot;
+  }
+  Delay_(tier);
+  ReadFully(File_(tier).fd, buffer, page_size_, slot * page_size_);
+}
+
+void TieredDiskManager::DeletePage(PageId_t page_id) {
+  std::scoped_lock lock(mutex_);
+  auto it = locations_.find(page_id);
+  if (it == locations_.end()) {
+    return;
+  }
+  FreeSlot_(it->second.tier, it->second.slot);
+  locations_.erase(it);
+  num_deletes_ += 1;
+}
+
+void TieredDiskManager::AllocateExtent(PageId_t first_page_id, size_t count,
+                                       PageId_t) {
+  std::scoped_lock lock(mutex_);
+  Tier tier = fast_.used + count <= fast_pages_ ? Tier::Fast : Tier::Slow;
+  TierFile& file = File_(tier);
+  size_t first_slot = file.num_slots;
+  file.num_slots += count;
+  for (size_t i = 0; i < count; i++) {
+    if (locations_.emplace(first_page_id + i, Location{tier, first_slot + i})
+            .second) {
+      file.used++;
+    } else {
+      file.free_slots.insert(first_slot + i);
+    }
+  }
+}
+
+void TieredDiskManager::WritePages(
+    const std::vector<std::pair<PageId_t, const char*>>& pages) {
+  for (const auto& [page_id, data] : pages) {
+    WritePage(page_id, data);
+  }
+}
+
+void TieredDiskManager::Sync() {
+  std::scoped_lock lock(mutex_);
+  if (fast_.fd >= 0) {
+    Checkpoint_();
+  }
+}
+
+CompactionResult TieredDiskManager::Compact(size_t, size_t) {
+  CompactionResult result;
+  std::scoped_lock lock(mutex_);
+  for (Tier tier : {Tier::Fast, Tier::Slow}) {
+    TierFile& file = File_(tier);
+    size_t size = std::filesystem::file_size(
+        tier == Tier::Fast ? fast_file_name_ : slow_file_name_);
+    result.file_size_before += size;
+    while (!file.free_slots.empty() &&
+           *file.free_slots.rbegin() == file.num_slots - 1) {
+      file.free_slots.erase(std::prev(file.free_slots.end()));
+      file.num_slots--;
+    }
+    size_t end = file.num_slots * page_size_;
+    if (size > end && ftruncate(file.fd, end) != 0) {
+      throw std::runtime_error("Error truncating db file");
+    }
+    result.file_size_after += std::min(size, end);
+  }
+  return result;
+}
+
+std::optional<size_t> TieredDiskManager::GetPageOffset(PageId_t page_id) {
+  std::scoped_lock lock(mutex_);
+  auto it = locations_.find(page_id);
+  if (it == locations_.end()) {
+    return std::nullopt;
+  }
+  return it->second.slot * page_size_;
+}
+
+// Demotes the coldest fast pages until the fast tier has its headroom, then
+// promotes the hottest slow pages, in exchange for a fast page of less than
+// half their heat once the headroom is used up
+size_t TieredDiskManager::Migrate(size_t max_pages) {
+  std::vector<std::pair<uint32_t, PageId_t>> fast_pages;
+  std::vector<std::pair<uint32_t, PageId_t>> slow_pages;
+  {
+    std::scoped_lock lock(mutex_);
+    round_++;
+    for (auto& [page_id, location] : locations_) {
+      uint32_t heat = Heat_(location);
+      if (location.tier == Tier::Fast) {
+        fast_pages.emplace_back(heat, page_id);
+      } else if (heat >= TIER_PROMOTE_HEAT) {
+        slow_pages.emplace_back(heat, page_id);
+      }
+    }
+  }
+  std::sort(fast_pages.begin(), fast_pages.end());
+  std::sort(slow_pages.rbegin(), slow_pages.rend());
+
+  const size_t target = fast_pages_ - fast_pages_ / FAST_HEADROOM_FRACTION;
+  std::vector<char> buffer(page_size_);
+  size_t fast_used = fast_pages.size();
+  size_t moved = 0;
+  size_t victim = 0;
+  while (moved < max_pages && fast_used > target &&
+         victim < fast_pages.size()) {
+    if (Move_(fast_pages[victim++].second, Tier::Slow, buffer.data())) {
+      moved++;
+      fast_used--;
+    }
+  }
+
+  for (const auto& [heat, page_id] : slow_pages) {
+    if (moved >= max_pages) {
+      break;
+    }
+    if (fast_used >= target) {
+      if (moved + 2 > max_pages || victim >= fast_pages.size() ||
+          fast_pages[victim].first * 2 >= heat) {
+        break;
+      }
+      if (Move_(fast_pages[victim++].second, Tier::Slow, buffer.data())) {
+        moved++;
+        fast_used--;
+      }
+      if (fast_used >= target) {
+        continue;
+      }
+    }
+    if (Move_(page_id, Tier::Fast, buffer.data())) {
+      moved++;
+      fast_used++;
+    }
+  }
+  return moved;
+}
+
+std::optional<Tier> TieredDiskManager::GetTier(PageId_t page_id) const {
+  std::scoped_lock lock(mutex_);
+  auto it = locations_.find(page_id);
+  if (it == locations_.end()) {
+    return std::nullopt;
+  }
+  return it->second.tier;
+}
+
+size_t TieredDiskManager::GetTierPages(Tier tier) const {
+  std::scoped_lock lock(mutex_);
+  return tier == Tier::Fast ? fast_.used : slow_.used;
+}
+
+int TieredDiskManager::GetNumPromotions() const {
+  std::scoped_lock lock(mutex_);
+  return num_promotions_;
+}
+
+int TieredDiskManager::GetNumDemotions() const {
+  std::scoped_lock lock(mutex_);
+  return num_demotions_;
+}
+
+std::filesystem::path TieredDiskManager::GetCheckpointFileName() const {
+  return checkpoint_file_name_;
+}
+
+std::filesystem::path TieredDiskManager::GetSlowFileName() const {
+  return slow_file_name_;
+}
+
+TieredDiskManager::TierFile& TieredDiskManager::File_(Tier tier) {
+  return tier == Tier::Fast ? fast_ : slow_;
+}
+
+size_t TieredDiskManager::AllocateSlot_(Tier tier) {
+  TierFile& file = File_(tier);
+  file.used++;
+  if (file.free_slots.empty()) {
+    return file.num_slots++;
+  }
+  size_t slot = *file.free_slots.begin();
+  file.free_slots.erase(file.free_slots.begin());
+  return slot;
+}
+
+void TieredDiskManager::FreeSlot_(Tier tier, size_t slot) {
+  TierFile& file = File_(tier);
+  file.used--;
+  file.free_slots.insert(slot);
+}
+
+Tier TieredDiskManager::NewPageTier_() const {
+  return fast_.used < fast_pages_ ? Tier::Fast : Tier::Slow;
+}
+
+uint32_t TieredDiskManager::Heat_(Location& location) const {
+  uint64_t epoch = round_ / TIER_HEAT_HALF_LIFE;
+  uint64_t halvings = epoch - location.epoch;
+  location.heat = halvings >= 32 ? 0 : location.heat >> halvings;
+  location.epoch = epoch;
+  return location.heat;
+}
+
+void TieredDiskManager::Touch_(Location& location) const {
+  if (Heat_(location) < UINT32_MAX) {
+    location.heat++;
+  }
+}
+
+void TieredDiskManager::Delay_(Tier tier) const {
+  if (tier == Tier::Slow && slow_latency_.count() > 0) {
+    std::this_thread::sleep_for(slow_latency_);
+  }
+}
+
+bool TieredDiskManager::Move_(PageId_t page_id, Tier to, char* buffer) {
+  Location from;
+  size_t slot;
+  {
+    std::scoped_lock lock(mutex_);
+    auto it = locations_.find(page_id);
+    if (it == locations_.end() || it->second.tier == to) {
+      return false;
+    }
+    from = it->second;
+    slot = AllocateSlot_(to);
+  }
+
+  // The source slot can only be freed by a delete of the page, the copy is
+  // then dropped below
+  Delay_(from.tier);
+  ReadFully(File_(from.tier).fd, buffer, page_size_, from.slot * page_size_);
+  Delay_(to);
+  WriteFully(File_(to).fd, buffer, page_size_, slot * page_size_);
+
+  std::unique_lock latch(io_latch_);
+  std::scoped_lock lock(mutex_);
+  auto it = locations_.find(page_id);
+  if (it == locations_.end() || it->second.version != from.version ||
+      it->second.tier != from.tier || it->second.slot != from.slot) {
+    FreeSlot_(to, slot);
+    return false;
+  }
+  FreeSlot_(from.tier, from.slot);
+  it->second.tier = to;
+  it->second.slot = slot;
+  if (to == Tier::Fast) {
+    num_promotions_++;
+  } else {
+    num_demotions_++;
+  }
+  return true;
+}
+
+void TieredDiskManager::MigratorWork_() {
+  const size_t budget = std::max<size_t>(
+      1, pages_per_second_ * TIER_MIGRATION_INTERVAL_MS / 1000);
+  std::unique_lock lock(migrator_mutex_);
+  while (!migrator_cv_.wait_for(
+      lock, std::chrono::milliseconds(TIER_MIGRATION_INTERVAL_MS),
+      [this]() { return stop_; })) {
+    lock.unlock();
+    Migrate(budget);
+    lock.lock();
+  }
+}
+
+// The page map is written to a new file that replaces the checkpoint once
+// it is durable, after the pages it refers to
+void TieredDiskManager::Checkpoint_() {
+  if (fsync(fast_.fd) != 0 || fsync(slow_.fd) != 0) {
+    throw std::runtime_error("Error syncing file");
+  }
+
+  std::vector<CheckpointEntry> entries;
+  entries.reserve(locations_.size());
+  for (auto& [page_id, location] : locations_) {
+    entries.push_back({page_id, location.slot,
+                       static_cast<uint32_t>(location.tier),
+                       Heat_(location)});
+  }
+  uint64_t header[3] = {CHECKPOINT_MAGIC, page_size_, entries.size()};
+  std::filesystem::path temp_name = checkpoint_file_name_.string() + ".new";
+  int fd = open(temp_name.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0) {
+    throw std::runtime_error("Can't open checkpoint file");
+  }
+  WriteFully(fd, reinterpret_cast<const char*>(header), sizeof(header), 0);
+  WriteFully(fd, reinterpret_cast<const char*>(entries.data()),
+             entries.size() * sizeof(entries[0]), sizeof(header));
+  if (fsync(fd) != 0) {
+    close(fd);
+    throw std::runtime_error("Error syncing file");
+  }
+  close(fd);
+  std::filesystem::rename(temp_name, checkpoint_file_name_);
+}
+
+// Slots of the files that the checkpoint does not refer to are free. A
+// checkpoint of another page size belongs to another db file and is ignored.
+void TieredDiskManager::LoadCheckpoint_() {
+  std::ifstream in(checkpoint_file_name_, std::ios::binary);
+  if (!in.is_open()) {
+    return;
+  }
+  uint64_t header[3];
+  in.read(reinterpret_cast<char*>(header), sizeof(header));
+  if (!in || header[0] != CHECKPOINT_MAGIC || header[1] != page_size_) {
+    return;
+  }
+  std::vector<CheckpointEntry> entries(header[2]);
+  in.read(reinterpret_cast<char*>(entries.data()),
+          entries.size() * sizeof(entries[0]));
+  if (!in) {
+    return;
+  }
+
+  std::vector<bool> fast_used;
+  std::vector<bool> slow_used;
+  for (const auto& entry : entries) {
+    Tier tier = static_cast<Tier>(entry.tier);
+    TierFile& file = File_(tier);
+    auto& used = tier == Tier::Fast ? fast_used : slow_used;
+    file.num_slots = std::max<size_t>(file.num_slots, entry.slot + 1);
+    file.used++;
+    if (used.size() <= entry.slot) {
+      used.resize(entry.slot + 1);
+    }
+    used[entry.slot] = true;
+    locations_[entry.page_id] = Location{tier, entry.slot, entry.heat};
+  }
+  for (Tier tier : {Tier::Fast, Tier::Slow}) {
+    TierFile& file = File_(tier);
+    const auto& used = tier == Tier::Fast ? fast_used : slow_used;
+    for (size_t slot = 1; slot < file.num_slots; slot++) {
+      if (!used[slot]) {
+        file.free_slots.insert(slot);
+      }
+    }
+  }
+}
@@ -364,3 +364,311 @@ TEST(BufferPoolManagerTest, EvictableTest) {
   remove(db_filename);
   remove(disk_manager->GetLogFileName());
 }
+
+TEST(BufferPoolManagerTest, FlushAllPagesTest) {
+  auto disk_manager = std::make_shared<DiskManager>(db_filename);
+  auto bpm = std::make_shared<BufferPoolManager>(FRAMES, disk_manager.get());
+
+  std::vector<PageId_t> pids;
+  for (size_t i = 0; i < FRAMES; i++) {
+    const auto pid = bpm->NewPage();
+    auto guard = bpm->WritePage(pid);
+    snprintf(guard.GetDataMut(), DB_PAGE_SIZE, "%s", std::to_string(i).c_str());
+    pids.push_back(pid);
+  }
+
+  bpm->FlushAllPages();
+  ASSERT_EQ(FRAMES, disk_manager->GetNumWrites());
+
+  for (const auto pid : pids) {
+    ASSERT_EQ(0, bpm->GetPinCount(pid));
+    const auto guard = bpm->ReadPage(pid);
+    EXPECT_FALSE(guard.IsDirty());
+  }
+
+  bpm->FlushAllPages();
+  ASSERT_EQ(FRAMES, disk_manager->GetNumWrites());
+
+  for (size_t i = 0; i < FRAMES; i++) {
+    const auto pid = bpm->NewPage();
+    auto guard = bpm->WritePage(pid);
+  }
+
+  for (size_t i = 0; i < FRAMES; i++) {
+    const auto guard = bpm->ReadPage(pids[i]);
+    EXPECT_STREQ(guard.GetData(), std::to_string(i).c_str());
+  }
+
+  disk_manager->ShutDown();
+  remove(db_filename);
+  remove(disk_manager->GetLogFileName());
+}
+
+TEST(BufferPoolManagerTest, FlushAllPagesAsyncTest) {
+  auto disk_manager = std::make_shared<DiskManager>(db_filename);
+  auto bpm = std::make_shared<BufferPoolManager>(FRAMES, disk_manager.get());
+
+  std::vector<PageId_t> pids;
+  for (size_t i = 0; i < FRAMES; i++) {
+    const auto pid = bpm->NewPage();
+    auto guard = bpm->WritePage(pid);
+    snprintf(guard.GetDataMut(), DB_PAGE_SIZE, "%s", std::to_string(i).c_str());
+    pids.push_back(pid);
+  }
+
+  auto read_guard = bpm->ReadPage(pids[0]);
+  auto fut = bpm->FlushAllPagesAsync();
+  read_guard.Drop();
+  fut.get();
+
+  ASSERT_EQ(FRAMES, disk_manager->GetNumWrites());
+  for (const auto pid : pids) {
+    ASSERT_EQ(0, bpm->GetPinCount(pid));
+  }
+
+  disk_manager->ShutDown();
+  remove(db_filename);
+  remove(disk_manager->GetLogFileName());
+}
+
+class SlowDiskManager : public DiskManager {
+ public:
+  SlowDiskManager(const std::filesystem::path& p) : DiskManager(p) {}
+
+  void WritePage(PageId_t page_id, const char* data) override {
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    DiskManager::WritePage(page_id, data);
+  }
+};
+
+TEST(BufferPoolManagerTest, FlushPageCopyTest) {
+  auto disk_manager = std::make_shared<SlowDiskManager>(db_filename);
+  auto bpm = std::make_shared<BufferPoolManager>(FRAMES, disk_manager.get());
+
+  const auto pid = bpm->NewPage();
+  {
+    auto guard = bpm->WritePage(pid);
+    snprintf(guard.GetDataMut(), DB_PAGE_SIZE, "%s", "old");
+  }
+
+  auto flusher = std::thread([&]() { ASSERT_TRUE(bpm->FlushPage(pid)); });
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+  auto start_time = std::chrono::steady_clock::now();
+  {
+    auto guard = bpm->WritePage(pid);
+    snprintf(guard.GetDataMut(), DB_PAGE_SIZE, "%s", "new");
+  }
+  auto waited = std::chrono::steady_clock::now() - start_time;
+  EXPECT_LT(waited, std::chrono::milliseconds(100));
+
+  flusher.join();
+
+  char buf[DB_PAGE_SIZE];
+  disk_manager->ReadPage(pid, buf);
+  EXPECT_STREQ(buf, "old");
+
+  {
+    const auto guard = bpm->ReadPage(pid);
+    EXPECT_TRUE(guard.IsDirty());
+    EXPECT_STREQ(guard.GetData(), "new");
+  }
+
+  disk_manager->ShutDown();
+  remove(db_filename);
+  remove(disk_manager->GetLogFileName());
+}
+
+TEST(BufferPoolManagerTest, OptimisticReadTest) {
+  auto disk_manager = std::make_shared<DiskManager>(db_filename);
+  auto bpm = std::make_shared<BufferPoolManager>(1, disk_manager.get());
+
+  const PageId_t pid0 = bpm->NewPage();
+  const PageId_t pid1 = bpm->NewPage();
+
+  EXPECT_FALSE(bpm->OptimisticReadPage(pid0).has_value());
+  {
+    auto guard = bpm->WritePage(pid0);
+    snprintf(guard.GetDataMut(), DB_PAGE_SIZE, "%s", "page0");
+    EXPECT_FALSE(bpm->OptimisticReadPage(pid0).has_value());
+  }
+
+  auto opt = bpm->OptimisticReadPage(pid0);
+  ASSERT_TRUE(opt.has_value());
+  EXPECT_STREQ(opt->GetData(), "page0");
+  EXPECT_TRUE(opt->Validate());
+  EXPECT_EQ(bpm->GetPinCount(pid0), 0);
+
+  // Read latches leave the version alone, write latches bump it
+  { auto guard = bpm->ReadPage(pid0); }
+  EXPECT_TRUE(opt->Validate());
+  { auto guard = bpm->WritePage(pid0); }
+  EXPECT_FALSE(opt->Validate());
+
+  opt = bpm->ReadPage(pid0).Optimistic();
+  EXPECT_TRUE(opt->Validate());
+
+  // Evicting the page invalidates the guard
+  { auto guard = bpm->ReadPage(pid1); }
+  EXPECT_FALSE(opt->Validate());
+  EXPECT_FALSE(bpm->OptimisticReadPage(pid0).has_value());
+
+  ASSERT_TRUE(bpm->DeletePage(pid1));
+  EXPECT_FALSE(bpm->CheckedReadPage(pid1).has_value());
+
+  disk_manager->ShutDown();
+  remove(db_filename);
+  remove(disk_manager->GetLogFileName());
+}
+
+TEST(BufferPoolManagerTest, OptimisticAccessTest) {
+  auto disk_manager = std::make_shared<DiskManager>(db_filename);
+  auto bpm = std::make_shared<BufferPoolManager>(3, disk_manager.get());
+
+  std::vector<PageId_t> pids;
+  for (int i = 0; i < 3; i++) {
+    pids.push_back(bpm->NewPage());
+    bpm->ReadPage(pids.back());
+  }
+
+  // The oldest page was read optimistically since, the next one goes
+  ASSERT_TRUE(bpm->OptimisticReadPage(pids[0]).has_value());
+  bpm->ReadPage(bpm->NewPage());
+  EXPECT_TRUE(bpm->GetPinCount(pids[0]).has_value());
+  EXPECT_FALSE(bpm->GetPinCount(pids[1]).has_value());
+
+  disk_manager->ShutDown();
+  remove(db_filename);
+  remove(disk_manager->GetLogFileName());
+}
+
+TEST(BufferPoolManagerTest, PrefetchTest) {
+  auto disk_manager = std::make_shared<DiskManager>(db_filename);
+  auto bpm = std::make_shared<BufferPoolManager>(4, disk_manager.get());
+
+  std::vector<PageId_t> pids;
+  for (int i = 0; i < 8; i++) {
+    pids.push_back(bpm->NewPage());
+    auto guard = bpm->WritePage(pids.back());
+    snprintf(guard.GetDataMut(), DB_PAGE_SIZE, "page%d", i);
+  }
+  bpm->FlushAllPages();
+
+  // Prefetched pages are resident and unpinned, the batch stops once every
+  // frame holds one of its pages
+  bpm->PrefetchPages(pids);
+  for (int i = 0; i < 4; i++) {
+    EXPECT_EQ(bpm->GetPinCount(pids[i]), 0);
+  }
+  for (int i = 4; i < 8; i++) {
+    EXPECT_FALSE(bpm->GetPinCount(pids[i]).has_value());
+  }
+
+  // Later batches evict them again
+  bpm->PrefetchPages({pids[6], pids[7]});
+  EXPECT_EQ(bpm->GetPinCount(pids[6]), 0);
+  EXPECT_EQ(bpm->GetPinCount(pids[7]), 0);
+  for (int i = 0; i < 8; i++) {
+    auto guard = bpm->ReadPage(pids[i]);
+    EXPECT_STREQ(guard.GetData(), ("page" + std::to_string(i)).c_str());
+  }
+
+  // Pinned pages cannot be evicted for a prefetch
+  std::vector<ReadPageGuard> guards;
+  for (int i = 0; i < 4; i++) {
+    guards.push_back(bpm->ReadPage(pids[i]));
+  }
+  bpm->PrefetchPages({pids[4]});
+  EXPECT_FALSE(bpm->GetPinCount(pids[4]).has_value());
+
+  guards.clear();
+  disk_manager->ShutDown();
+  remove(db_filename);
+  remove(disk_manager->GetLogFileName());
+}
+
+TEST(BufferPoolManagerTest, TempPageTest) {
+  auto disk_manager = std::make_shared<DiskManager>(db_filename);
+  auto bpm = std::make_shared<BufferPoolManager>(4, disk_manager.get());
+
+  // Deleted dirty pages are dropped without a write
+  const PageId_t pid = bpm->NewPage();
+  bpm->WritePage(pid).GetDataMut()[0] = 'x';
+  ASSERT_TRUE(bpm->DeletePage(pid));
+  const PageId_t temp = bpm->NewTempPage();
+  bpm->WritePage(temp).GetDataMut()[0] = 'x';
+  EXPECT_EQ('x', bpm->ReadPage(temp).GetData()[0]);
+  ASSERT_TRUE(bpm->DeletePage(temp));
+  EXPECT_FALSE(bpm->CheckedReadPage(temp).has_value());
+
+  // Temporary pages are not flushed, they spill to the scratch file when
+  // evicted and are read back from it
+  std::vector<PageId_t> pids;
+  for (int i = 0; i < 8; i++) {
+    pids.push_back(bpm->NewTempPage());
+    auto guard = bpm->WritePage(pids.back());
+    snprintf(guard.GetDataMut(), DB_PAGE_SIZE, "temp%d", i);
+  }
+  bpm->FlushAllPages();
+  EXPECT_FALSE(bpm->FlushPage(pids[0]));
+  EXPECT_TRUE(bpm->FlushPage(pids[7]));
+  EXPECT_EQ(0, disk_manager->GetNumWrites());
+  EXPECT_EQ(4, disk_manager->GetNumTempWrites());
+  for (int i = 0; i < 8; i++) {
+    auto guard = bpm->ReadPage(pids[i]);
+    EXPECT_STREQ(guard.GetData(), ("temp" + std::to_string(i)).c_str());
+  }
+  EXPECT_EQ(0, disk_manager->GetNumWrites());
+
+  // A temporary page that was never written reads as zeros
+  const PageId_t fresh = bpm->NewTempPage();
+  EXPECT_EQ(0, bpm->ReadPage(fresh).GetData()[0]);
+
+  for (PageId_t temp_pid : pids) {
+    ASSERT_TRUE(bpm->DeletePage(temp_pid));
+  }
+  EXPECT_EQ(0, disk_manager->GetNumWrites());
+
+  disk_manager->ShutDown();
+  remove(db_filename);
+  remove(disk_manager->GetLogFileName());
+}
+
+TEST(BufferPoolManagerTest, DeletePinnedPageTest) {
+  auto disk_manager = std::make_shared<DiskManager>(db_filename);
+  auto bpm = std::make_shared<BufferPoolManager>(4, disk_manager.get());
+
+  EXPECT_FALSE(bpm->DeletePage(INVALID_PAGE_ID));
+  EXPECT_FALSE(bpm->DeletePage(PageId_t{1} << 40));
+
+  // A pinned page stays readable and is dropped by the next delete
+  const PageId_t pid = bpm->NewPage();
+  bpm->WritePage(pid).GetDataMut()[0] = 'x';
+  auto guard = bpm->ReadPage(pid);
+  ASSERT_TRUE(bpm->DeletePage(pid));
+  EXPECT_EQ('x', guard.GetData()[0]);
+  EXPECT_TRUE(bpm->GetPinCount(pid).has_value());
+  guard.Drop();
+  ASSERT_TRUE(bpm->DeletePage(bpm->NewPage()));
+  EXPECT_FALSE(bpm->GetPinCount(pid).has_value());
+  EXPECT_FALSE(bpm->CheckedReadPage(pid).has_value());
+  EXPECT_FALSE(bpm->DeletePage(pid));
+
+  // Or by its eviction, without a write back
+  const PageId_t other = bpm->NewPage();
+  {
+    auto write_guard = bpm->WritePage(other);
+    write_guard.GetDataMut()[0] = 'y';
+    ASSERT_TRUE(bpm->DeletePage(other));
+  }
+  bpm->FlushAllPages();
+  for (int i = 0; i < 4; i++) {
+    bpm->ReadPage(bpm->NewPage());
+  }
+  EXPECT_EQ(0, disk_manager->GetNumWrites());
+  EXPECT_FALSE(bpm->CheckedReadPage(other).has_value());
+
+  disk_manager->ShutDown();
+  remove(db_filename);
+  remove(disk_manager->GetLogFileName());
+}
@@ -0,0 +1,167 @@
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include <buffer/buffer_pool_manager.hpp>
+#include <buffer/page_codec.hpp>
+#include <buffer/victim_cache.hpp>
+
+static std::filesystem::path db_filename("victim_cache_test.db");
+
+// Rows of text with a counter, compressible like a slotted page
+static std::vector<char> MakePage(size_t page_size, int seed) {
+  std::vector<char> page(page_size);
+  std::string text;
+  for (int i = 0; text.size() < page_size; i++) {
+    text += "customer#" + std::to_string(seed * 1000 + i) + "|regular|";
+  }
+  memcpy(page.data(), text.data(), page_size);
+  return page;
+}
+
+static std::vector<char> RoundTrip(const std::vector<char>& page,
+                                   size_t& size) {
+  std::vector<char> compressed;
+  size = CompressPage(page.data(), page.size(), compressed);
+  EXPECT_EQ(size, compressed.size());
+  std::vector<char> result(page.size());
+  DecompressPage(compressed.data(), compressed.size(), result.data(),
+                 result.size());
+  return result;
+}
+
+TEST(VictimCacheTest, CodecTest) {
+  size_t size;
+  std::vector<char> zeros(DB_PAGE_SIZE);
+  EXPECT_EQ(zeros, RoundTrip(zeros, size));
+  EXPECT_EQ(9, size);
+
+  std::vector<char> pattern(DB_PAGE_SIZE);
+  for (size_t i = 0; i < pattern.size(); i++) {
+    pattern[i] = static_cast<char>(i % 8 + 1);
+  }
+  EXPECT_EQ(pattern, RoundTrip(pattern, size));
+  EXPECT_EQ(9, size);
+
+  for (size_t page_size : {DB_PAGE_SIZE, DB_MAX_PAGE_SIZE}) {
+    auto text = MakePage(page_size, 1);
+    EXPECT_EQ(text, RoundTrip(text, size));
+    EXPECT_LT(size, page_size / 2);
+  }
+
+  // Long runs need extended lengths, random bytes are stored as they are
+  std::mt19937 rng(0);
+  std::vector<char> mixed(DB_PAGE_SIZE);
+  for (size_t i = 0; i < mixed.size(); i++) {
+    mixed[i] = i < 1000 || i > 3000 ? static_cast<char>(rng()) : 'x';
+  }
+  EXPECT_EQ(mixed, RoundTrip(mixed, size));
+  EXPECT_LT(size, DB_PAGE_SIZE);
+
+  std::vector<char> random(DB_PAGE_SIZE);
+  for (auto& c : random) {
+    c = static_cast<char>(rng());
+  }
+  EXPECT_EQ(random, RoundTrip(random, size));
+  EXPECT_EQ(DB_PAGE_SIZE + 1, size);
+}
+
+TEST(VictimCacheTest, CacheTest) {
+  VictimCache cache(4 * DB_PAGE_SIZE, DB_PAGE_SIZE);
+  std::vector<char> buffer(DB_PAGE_SIZE);
+  EXPECT_FALSE(cache.Get(0, buffer.data()));
+
+  // A hit takes the page out of the cache
+  cache.Put(0, MakePage(DB_PAGE_SIZE, 0).data());
+  EXPECT_EQ(1, cache.GetPageCount());
+  EXPECT_TRUE(cache.Get(0, buffer.data()));
+  EXPECT_EQ(MakePage(DB_PAGE_SIZE, 0), buffer);
+  EXPECT_EQ(0, cache.GetPageCount());
+  EXPECT_EQ(0, cache.GetSize());
+
+  // Random pages take a page each, the least recently put ones are dropped
+  std::mt19937 rng(0);
+  for (PageId_t page_id = 0; page_id < 6; page_id++) {
+    for (auto& c : buffer) {
+      c = static_cast<char>(rng());
+    }
+    cache.Put(page_id, buffer.data());
+  }
+  EXPECT_EQ(3, cache.GetPageCount());
+  EXPECT_LE(cache.GetSize(), cache.GetBudget());
+  EXPECT_FALSE(cache.Get(2, buffer.data()));
+  cache.Erase(5);
+  EXPECT_FALSE(cache.Get(5, buffer.data()));
+  EXPECT_TRUE(cache.Get(4, buffer.data()));
+
+  EXPECT_EQ(2, cache.GetHits());
+  EXPECT_EQ(3, cache.GetMisses());
+  EXPECT_DOUBLE_EQ(0.4, cache.GetHitRatio());
+  EXPECT_GT(cache.GetCompressionRatio(), 0.9);
+}
+
+TEST(VictimCacheTest, BufferPoolTest) {
+  auto disk_manager = std::make_shared<DiskManager>(db_filename);
+  auto bpm = std::make_shared<BufferPoolManager>(8, disk_manager.get(),
+                                                 64 * DB_PAGE_SIZE);
+  const PageId_t num_pages = 64;
+  for (PageId_t page_id = 0; page_id < num_pages; page_id++) {
+    ASSERT_EQ(page_id, bpm->NewPage());
+    auto page = MakePage(DB_PAGE_SIZE, page_id);
+    memcpy(bpm->WritePage(page_id).GetDataMut(), page.data(), DB_PAGE_SIZE);
+  }
+
+  // Evicted pages, dirty ones included, come back from the cache
+  int reads = disk_manager->GetNumReads();
+  for (int round = 0; round < 2; round++) {
+    for (PageId_t page_id = 0; page_id < num_pages; page_id++) {
+      auto guard = bpm->ReadPage(page_id);
+      EXPECT_EQ(0, memcmp(MakePage(DB_PAGE_SIZE, page_id).data(),
+                          guard.GetData(), DB_PAGE_SIZE))
+          << page_id;
+    }
+  }
+  EXPECT_EQ(reads, disk_manager->GetNumReads());
+  const VictimCache* cache = bpm->GetVictimCache();
+  ASSERT_NE(nullptr, cache);
+  EXPECT_GT(cache->GetHits(), num_pages);
+  EXPECT_GT(cache->GetCompressionRatio(), 2);
+
+  // A deleted page is not served from the cache
+  size_t cached = cache->GetPageCount();
+  ASSERT_TRUE(bpm->DeletePage(0));
+  EXPECT_EQ(cached - 1, cache->GetPageCount());
+
+  disk_manager->ShutDown();
+  remove(db_filename);
+  remove(disk_manager->GetLogFileName());
+}
+
+TEST(VictimCacheTest, TempPageTest) {
+  auto disk_manager = std::make_shared<DiskManager>(db_filename);
+  auto bpm = std::make_shared<BufferPoolManager>(4, disk_manager.get(),
+                                                 64 * DB_PAGE_SIZE);
+
+  // Every dirty eviction is staged, more of them than there are staging
+  // buffers. Temporary pages spill to the scratch file, not to the cache.
+  std::vector<PageId_t> pids;
+  for (size_t i = 0; i < 2 * DB_STAGING_BUFFERS; i++) {
+    pids.push_back(bpm->NewTempPage());
+    bpm->WritePage(pids.back()).GetDataMut()[0] = static_cast<char>(i);
+  }
+  for (size_t i = 0; i < pids.size(); i++) {
+    EXPECT_EQ(static_cast<char>(i), bpm->ReadPage(pids[i]).GetData()[0]);
+  }
+  EXPECT_EQ(0, bpm->GetVictimCache()->GetPageCount());
+  EXPECT_GT(disk_manager->GetNumTempWrites(), DB_STAGING_BUFFERS);
+
+  disk_manager->ShutDown();
+  remove(db_filename);
+  remove(disk_manager->GetLogFileName());
+}
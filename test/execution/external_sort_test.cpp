@@ -0,0 +1,137 @@
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <random>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include <buffer/buffer_pool_manager.hpp>
+#include <execution/external_sort.hpp>
+#include <execution/filter.hpp>
+#include <execution/pax_scan.hpp>
+#include <storage/table/pax_table.hpp>
+
+static std::filesystem::path db_filename("external_sort_test.db");
+
+using Row = std::tuple<int32_t, double, int64_t, std::string>;
+
+// Rows of a table with an int32, a float64, a sequence number and a char(3)
+static std::vector<Row> Fill(PaxTable& table, size_t num_rows) {
+  std::mt19937 rng(42);
+  std::vector<Row> rows;
+  for (size_t i = 0; i < num_rows; i++) {
+    int32_t a = static_cast<int32_t>(rng() % 2000) - 1000;
+    double b = (static_cast<double>(rng() % 20001) - 10000) / 8;
+    int64_t seq = i;
+    std::string c = {static_cast<char>('a' + rng() % 3),
+                     static_cast<char>('a' + rng() % 26),
+                     static_cast<char>('a' + rng() % 26)};
+    char data[23];
+    memcpy(data, &a, 4);
+    memcpy(data + 4, &b, 8);
+    memcpy(data + 12, &seq, 8);
+    memcpy(data + 20, c.data(), 3);
+    table.InsertTuple(Tuple(data, sizeof(data)));
+    rows.emplace_back(a, b, seq, c);
+  }
+  return rows;
+}
+
+static Schema MakeSchema() {
+  return Schema({Column("a", TypeId::Int32), Column("b", TypeId::Float64),
+                 Column("seq", TypeId::Int64), Column("c", TypeId::Char, 3)});
+}
+
+static std::vector<Row> Drain(VectorOperator& sort) {
+  std::vector<Row> rows;
+  Batch batch(sort.GetColumns());
+  while (sort.Next(batch)) {
+    EXPECT_FALSE(batch.IsFiltered());
+    for (size_t i = 0; i < batch.GetSize(); i++) {
+      rows.emplace_back(batch.GetColumn(0).Data<int32_t>()[i],
+                        batch.GetColumn(1).Data<double>()[i],
+                        batch.GetColumn(2).Data<int64_t>()[i],
+                        std::string(batch.GetColumn(3).GetData() + 3 * i, 3));
+    }
+  }
+  return rows;
+}
+
+TEST(ExternalSortTest, InMemoryTest) {
+  auto disk_manager = std::make_shared<DiskManager>(db_filename);
+  auto bpm = std::make_shared<BufferPoolManager>(64, disk_manager.get());
+  PaxTable table(bpm.get(), MakeSchema());
+  auto expected = Fill(table, 3000);
+
+  // Filtered input, on the int32 column
+  std::unique_ptr<VectorOperator> scan =
+      std::make_unique<PaxScan>(&table, std::vector<size_t>{0, 1, 2, 3});
+  scan = std::make_unique<Filter<double, CompareOp::Ge>>(std::move(scan), 1,
+                                                         0.0);
+  ExternalSort sort(std::move(scan), bpm.get(), 0);
+  auto rows = Drain(sort);
+  EXPECT_EQ(0, sort.GetRunCount());
+
+  expected.erase(std::remove_if(expected.begin(), expected.end(),
+                                [](const Row& row) {
+                                  return std::get<1>(row) < 0;
+                                }),
+                 expected.end());
+  std::stable_sort(expected.begin(), expected.end(),
+                   [](const Row& a, const Row& b) {
+                     return std::get<0>(a) < std::get<0>(b);
+                   });
+  EXPECT_EQ(expected, rows);
+
+  disk_manager->ShutDown();
+  remove(db_filename);
+  remove(disk_manager->GetLogFileName());
+}
+
+TEST(ExternalSortTest, SpillTest) {
+  auto disk_manager = std::make_shared<DiskManager>(db_filename);
+  auto bpm = std::make_shared<BufferPoolManager>(32, disk_manager.get());
+  PaxTable table(bpm.get(), MakeSchema());
+  auto expected = Fill(table, 20000);
+
+  // Descending on the float64 column, 6 frames give runs of about 800 rows
+  // and merges of 2 runs
+  ExternalSort sort(
+      std::make_unique<PaxScan>(&table, std::vector<size_t>{0, 1, 2, 3}),
+      bpm.get(), 1, true, 6);
+  auto rows = Drain(sort);
+  EXPECT_GT(sort.GetRunCount(), 16);
+  EXPECT_GE(sort.GetMergePasses(), 3);
+
+  std::stable_sort(expected.begin(), expected.end(),
+                   [](const Row& a, const Row& b) {
+                     return std::get<1>(a) > std::get<1>(b);
+                   });
+  EXPECT_EQ(expected, rows);
+
+  // Char keys, merged in a single pass
+  ExternalSort by_char(
+      std::make_unique<PaxScan>(&table, std::vector<size_t>{0, 1, 2, 3}),
+      bpm.get(), 3, false, 30);
+  rows = Drain(by_char);
+  EXPECT_GT(by_char.GetRunCount(), 1);
+  EXPECT_EQ(0, by_char.GetMergePasses());
+  std::sort(expected.begin(), expected.end(),
+            [](const Row& a, const Row& b) {
+              return std::get<2>(a) < std::get<2>(b);
+            });
+  std::stable_sort(expected.begin(), expected.end(),
+                   [](const Row& a, const Row& b) {
+                     return std::get<3>(a) < std::get<3>(b);
+                   });
+  EXPECT_EQ(expected, rows);
+
+  disk_manager->ShutDown();
+  remove(db_filename);
+  remove(disk_manager->GetLogFileName());
+}
@@ -0,0 +1,149 @@
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <random>
+#include <tuple>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include <buffer/buffer_pool_manager.hpp>
+#include <execution/filter.hpp>
+#include <execution/hash_join.hpp>
+#include <execution/pax_scan.hpp>
+#include <storage/table/pax_table.hpp>
+
+static std::filesystem::path db_filename("hash_join_test.db");
+
+// Probe key and sequence number followed by build key and sequence number
+using Row = std::tuple<int64_t, int64_t, int64_t, int64_t>;
+
+static Schema MakeSchema() {
+  return Schema({Column("key", TypeId::Int64), Column("seq", TypeId::Int64)});
+}
+
+// Rows of keys drawn from [0, num_keys) and their sequence numbers
+static std::vector<std::pair<int64_t, int64_t>> Fill(PaxTable& table,
+                                                     size_t num_rows,
+                                                     size_t num_keys,
+                                                     uint32_t seed) {
+  std::mt19937 rng(seed);
+  std::vector<std::pair<int64_t, int64_t>> rows;
+  for (size_t i = 0; i < num_rows; i++) {
+    int64_t key = rng() % num_keys;
+    int64_t seq = i;
+    char data[16];
+    memcpy(data, &key, 8);
+    memcpy(data + 8, &seq, 8);
+    table.InsertTuple(Tuple(data, sizeof(data)));
+    rows.emplace_back(key, seq);
+  }
+  return rows;
+}
+
+static std::vector<Row> Expected(
+    const std::vector<std::pair<int64_t, int64_t>>& build,
+    const std::vector<std::pair<int64_t, int64_t>>& probe) {
+  std::multimap<int64_t, int64_t> table(build.begin(), build.end());
+  std::vector<Row> rows;
+  for (const auto& [key, seq] : probe) {
+    auto [begin, end] = table.equal_range(key);
+    for (auto it = begin; it != end; ++it) {
+      rows.emplace_back(key, seq, it->first, it->second);
+    }
+  }
+  std::sort(rows.begin(), rows.end());
+  return rows;
+}
+
+static std::vector<Row> Drain(VectorOperator& join) {
+  std::vector<Row> rows;
+  Batch batch(join.GetColumns());
+  while (join.Next(batch)) {
+    EXPECT_FALSE(batch.IsFiltered());
+    for (size_t i = 0; i < batch.GetSize(); i++) {
+      rows.emplace_back(batch.GetColumn(0).Data<int64_t>()[i],
+                        batch.GetColumn(1).Data<int64_t>()[i],
+                        batch.GetColumn(2).Data<int64_t>()[i],
+                        batch.GetColumn(3).Data<int64_t>()[i]);
+    }
+  }
+  std::sort(rows.begin(), rows.end());
+  return rows;
+}
+
+TEST(HashJoinTest, InMemoryTest) {
+  auto disk_manager = std::make_shared<DiskManager>(db_filename);
+  auto bpm = std::make_shared<BufferPoolManager>(64, disk_manager.get());
+  PaxTable build_table(bpm.get(), MakeSchema());
+  PaxTable probe_table(bpm.get(), MakeSchema());
+  auto build = Fill(build_table, 2000, 1500, 1);
+  auto probe = Fill(probe_table, 5000, 3000, 2);
+
+  // Filtered build input
+  std::unique_ptr<VectorOperator> build_scan =
+      std::make_unique<PaxScan>(&build_table, std::vector<size_t>{0, 1});
+  build_scan = std::make_unique<Filter<int64_t, CompareOp::Lt>>(
+      std::move(build_scan), 1, 1000);
+  HashJoin join(std::move(build_scan),
+                std::make_unique<PaxScan>(&probe_table,
+                                          std::vector<size_t>{0, 1}),
+                0, 0, bpm.get());
+  auto rows = Drain(join);
+  EXPECT_EQ(0, join.GetPartitionCount());
+
+  build.resize(1000);
+  EXPECT_EQ(Expected(build, probe), rows);
+
+  // Empty build input
+  HashJoin empty(
+      std::make_unique<Filter<int64_t, CompareOp::Lt>>(
+          std::make_unique<PaxScan>(&build_table, std::vector<size_t>{0, 1}),
+          1, 0),
+      std::make_unique<PaxScan>(&probe_table, std::vector<size_t>{0, 1}), 0,
+      0, bpm.get());
+  EXPECT_TRUE(Drain(empty).empty());
+
+  disk_manager->ShutDown();
+  remove(db_filename);
+  remove(disk_manager->GetLogFileName());
+}
+
+TEST(HashJoinTest, SpillTest) {
+  auto disk_manager = std::make_shared<DiskManager>(db_filename);
+  auto bpm = std::make_shared<BufferPoolManager>(32, disk_manager.get());
+  PaxTable build_table(bpm.get(), MakeSchema());
+  PaxTable probe_table(bpm.get(), MakeSchema());
+  auto build = Fill(build_table, 30000, 20000, 3);
+  auto probe = Fill(probe_table, 30000, 25000, 4);
+
+  // 2 frames hold about 340 build rows, 2 partitions per level need several
+  // levels
+  HashJoin join(
+      std::make_unique<PaxScan>(&build_table, std::vector<size_t>{0, 1}),
+      std::make_unique<PaxScan>(&probe_table, std::vector<size_t>{0, 1}), 0,
+      0, bpm.get(), 2);
+  auto rows = Drain(join);
+  EXPECT_GT(join.GetPartitionCount(), 4);
+  EXPECT_GE(join.GetMaxLevel(), 3);
+  EXPECT_EQ(Expected(build, probe), rows);
+
+  // A hot key, its partition is joined beyond the budget
+  PaxTable hot_table(bpm.get(), MakeSchema());
+  auto hot = Fill(hot_table, 3000, 1, 5);
+  HashJoin hot_join(
+      std::make_unique<PaxScan>(&hot_table, std::vector<size_t>{0, 1}),
+      std::make_unique<PaxScan>(&probe_table, std::vector<size_t>{0, 1}), 0,
+      0, bpm.get(), 2);
+  rows = Drain(hot_join);
+  EXPECT_EQ(1, hot_join.GetPartitionCount());
+  EXPECT_FALSE(rows.empty());
+  EXPECT_EQ(Expected(hot, probe), rows);
+
+  disk_manager->ShutDown();
+  remove(db_filename);
+  remove(disk_manager->GetLogFileName());
+}
@@ -0,0 +1,128 @@
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include <execution/kernels.hpp>
+
+template <typename T, CompareOp OP>
+static bool Reference(T a, T b) {
+  switch (OP) {
+    case CompareOp::Eq:
+      return a == b;
+    case CompareOp::Ne:
+      return a != b;
+    case CompareOp::Lt:
+      return a < b;
+    case CompareOp::Le:
+      return a <= b;
+    case CompareOp::Gt:
+      return a > b;
+    default:
+      return a >= b;
+  }
+}
+
+template <typename T, CompareOp OP>
+static void CheckSelect(VectorKernel kernel, const std::vector<T>& values,
+                        T constant) {
+  std::vector<uint32_t> expected;
+  for (size_t i = 0; i < values.size(); i++) {
+    if (Reference<T, OP>(values[i], constant)) {
+      expected.push_back(i);
+    }
+  }
+
+  std::vector<uint32_t> out(values.size());
+  size_t count = SelectCompare<T, OP>(values.data(), values.size(), constant,
+                                      out.data(), kernel);
+  out.resize(count);
+  ASSERT_EQ(expected, out) << VectorKernelName(kernel);
+
+  // Selecting again from every other row
+  std::vector<uint32_t> selection;
+  for (size_t i = 0; i < values.size(); i += 2) {
+    selection.push_back(i);
+  }
+  std::vector<uint32_t> expected_odd;
+  for (uint32_t row : expected) {
+    if (row % 2 == 0) {
+      expected_odd.push_back(row);
+    }
+  }
+  out.assign(values.size(), 0);
+  count = SelectCompare<T, OP>(values.data(), selection.data(),
+                               selection.size(), constant, out.data());
+  out.resize(count);
+  ASSERT_EQ(expected_odd, out);
+}
+
+template <typename T>
+static void CheckType(VectorKernel kernel) {
+  std::mt19937_64 rng(static_cast<int>(kernel));
+  for (size_t size : {0, 1, 7, 16, 33, 1000, 1024}) {
+    std::vector<T> values(size);
+    for (auto& value : values) {
+      value = static_cast<T>(rng() % 16) - 8;
+    }
+    for (T constant : {T(-9), T(0), T(3), T(8)}) {
+      CheckSelect<T, CompareOp::Eq>(kernel, values, constant);
+      CheckSelect<T, CompareOp::Ne>(kernel, values, constant);
+      CheckSelect<T, CompareOp::Lt>(kernel, values, constant);
+      CheckSelect<T, CompareOp::Le>(kernel, values, constant);
+      CheckSelect<T, CompareOp::Gt>(kernel, values, constant);
+      CheckSelect<T, CompareOp::Ge>(kernel, values, constant);
+    }
+
+    std::vector<T> out(size);
+    Arithmetic<T, ArithOp::Sub>(T(10), values.data(), out.data(), size,
+                                kernel);
+    for (size_t i = 0; i < size; i++) {
+      ASSERT_EQ(T(10) - values[i], out[i]);
+    }
+    Arithmetic<T, ArithOp::Mul>(values.data(), out.data(), out.data(), size,
+                                kernel);
+    for (size_t i = 0; i < size; i++) {
+      ASSERT_EQ(values[i] * (T(10) - values[i]), out[i]);
+    }
+
+    SumType<T> sum = 0;
+    for (T value : values) {
+      sum += value;
+    }
+    EXPECT_EQ(sum, Sum(values.data(), size, kernel));
+  }
+}
+
+TEST(KernelsTest, KernelsMatchScalarTest) {
+  for (int kernel = 0; kernel <= static_cast<int>(DetectVectorKernel());
+       kernel++) {
+    CheckType<int32_t>(static_cast<VectorKernel>(kernel));
+    CheckType<int64_t>(static_cast<VectorKernel>(kernel));
+    CheckType<double>(static_cast<VectorKernel>(kernel));
+  }
+}
+
+TEST(KernelsTest, EdgeValuesTest) {
+  const double nan = std::numeric_limits<double>::quiet_NaN();
+  std::vector<double> floats = {nan, 1.0, -0.0, 0.0, nan};
+  std::vector<uint32_t> out(floats.size());
+  EXPECT_EQ(0, (SelectCompare<double, CompareOp::Eq>(floats.data(), 5, nan,
+                                                     out.data())));
+  EXPECT_EQ(2, (SelectCompare<double, CompareOp::Eq>(floats.data(), 5, 0.0,
+                                                     out.data())));
+  EXPECT_EQ(3, (SelectCompare<double, CompareOp::Ne>(floats.data(), 5, 0.0,
+                                                     out.data())));
+
+  // Integer sums do not overflow at 32 bits
+  std::vector<int32_t> ints(1000, std::numeric_limits<int32_t>::max());
+  EXPECT_EQ(int64_t{1000} * std::numeric_limits<int32_t>::max(),
+            Sum(ints.data(), ints.size()));
+  std::vector<int64_t> longs = {std::numeric_limits<int64_t>::min(), 5,
+                                std::numeric_limits<int64_t>::max()};
+  EXPECT_EQ(2, (SelectCompare<int64_t, CompareOp::Gt>(
+                   longs.data(), longs.size(),
+                   std::numeric_limits<int64_t>::min(), out.data())));
+}
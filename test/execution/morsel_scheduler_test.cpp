@@ -0,0 +1,117 @@
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include <buffer/buffer_pool_manager.hpp>
+#include <execution/aggregate.hpp>
+#include <execution/filter.hpp>
+#include <execution/morsel_scan.hpp>
+#include <execution/morsel_scheduler.hpp>
+#include <execution/pax_scan.hpp>
+#include <storage/table/pax_table.hpp>
+
+static std::filesystem::path db_filename("morsel_scheduler_test.db");
+
+TEST(MorselSchedulerTest, StealingTest) {
+  MorselScheduler scheduler(4);
+  ASSERT_EQ(4, scheduler.GetWorkerCount());
+
+  const size_t num_morsels = 400;
+  std::vector<std::atomic<int>> runs(num_morsels);
+  std::vector<size_t> taken(scheduler.GetWorkerCount());
+  scheduler.Run(num_morsels, [&](size_t worker) {
+    while (auto morsel = scheduler.NextMorsel(worker)) {
+      runs[*morsel]++;
+      taken[worker]++;
+      // Worker 0 is slow, the others steal most of its range
+      if (worker == 0) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+      }
+    }
+  });
+
+  for (size_t i = 0; i < num_morsels; i++) {
+    EXPECT_EQ(1, runs[i]) << "morsel " << i;
+  }
+  EXPECT_LT(taken[0], num_morsels / 4);
+
+  // The pool is reused by the next job, errors reach the caller
+  auto fail = [&](size_t worker) {
+    while (auto morsel = scheduler.NextMorsel(worker)) {
+      if (*morsel == 3) {
+        throw std::runtime_error("morsel 3");
+      }
+    }
+  };
+  EXPECT_THROW(scheduler.Run(8, fail), std::runtime_error);
+  std::atomic<size_t> count = 0;
+  scheduler.Run(10, [&](size_t worker) {
+    while (scheduler.NextMorsel(worker)) {
+      count++;
+    }
+  });
+  EXPECT_EQ(10, count);
+}
+
+TEST(MorselSchedulerTest, ParallelAggregateTest) {
+  auto disk_manager = std::make_shared<DiskManager>(db_filename);
+  auto bpm = std::make_shared<BufferPoolManager>(16, disk_manager.get());
+  PaxTable table(bpm.get(), Schema({Column("id", TypeId::Int64),
+                                    Column("group", TypeId::Int32),
+                                    Column("value", TypeId::Float64)}));
+
+  const int64_t num_rows = 20000;
+  std::map<int32_t, std::pair<int64_t, double>> expected;
+  for (int64_t i = 0; i < num_rows; i++) {
+    char row[20];
+    int32_t group = i * 7 % 13;
+    double value = i % 100 * 0.5;
+    memcpy(row, &i, 8);
+    memcpy(row + 8, &group, 4);
+    memcpy(row + 12, &value, 8);
+    table.InsertTuple(Tuple(row, sizeof(row)));
+    if (value > 10) {
+      expected[group].first = std::max(expected[group].first, i);
+      expected[group].second += value;
+    }
+  }
+  // More pages than frames, the workers read ahead and evict
+  ASSERT_GT(table.GetPageIds().size(), 16 * 4);
+
+  MorselScheduler scheduler(3);
+  auto result = ParallelAggregate(
+      &scheduler, &table, {1, 0, 2},
+      [](std::unique_ptr<VectorOperator> scan) {
+        scan = std::make_unique<Filter<double, CompareOp::Gt>>(std::move(scan),
+                                                               2, 10.0);
+        return std::make_unique<Aggregate>(
+            std::move(scan), std::vector<size_t>{0},
+            std::vector<AggregateExpr>{{AggregateType::Max, 1, "max_id"},
+                                       {AggregateType::Sum, 2, "sum"}});
+      },
+      4);
+
+  std::map<int32_t, std::pair<int64_t, double>> groups;
+  Batch batch(result->GetColumns());
+  while (result->Next(batch)) {
+    for (size_t i = 0; i < batch.GetSize(); i++) {
+      groups[batch.GetColumn(0).Data<int32_t>()[i]] = {
+          batch.GetColumn(1).Data<int64_t>()[i],
+          batch.GetColumn(2).Data<double>()[i]};
+    }
+  }
+  EXPECT_EQ(expected, groups);
+
+  disk_manager->ShutDown();
+  remove(db_filename);
+  remove(disk_manager->GetLogFileName());
+}
@@ -0,0 +1,211 @@
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include <buffer/buffer_pool_manager.hpp>
+#include <execution/aggregate.hpp>
+#include <execution/filter.hpp>
+#include <execution/pax_scan.hpp>
+#include <execution/projection.hpp>
+#include <storage/table/pax_table.hpp>
+
+static std::filesystem::path db_filename("vector_executor_test.db");
+
+struct Row {
+  int64_t id;
+  char flag;
+  double qty;
+  double price;
+  int32_t day;
+};
+
+static Schema MakeSchema() {
+  return Schema({Column("id", TypeId::Int64), Column("flag", TypeId::Char, 1),
+                 Column("qty", TypeId::Float64),
+                 Column("price", TypeId::Float64),
+                 Column("day", TypeId::Date)});
+}
+
+static Row MakeRow(int64_t i) {
+  return Row{i, "ANR"[i % 3], static_cast<double>(i % 50),
+             100.0 + i % 7 * 0.5, static_cast<int32_t>(i % 400)};
+}
+
+static void Insert(PaxTable& table, const Row& row) {
+  const Schema& schema = table.GetSchema();
+  std::vector<char> data(schema.GetTupleSize());
+  memcpy(data.data() + schema.GetOffset(0), &row.id, sizeof(row.id));
+  memcpy(data.data() + schema.GetOffset(1), &row.flag, 1);
+  memcpy(data.data() + schema.GetOffset(2), &row.qty, sizeof(row.qty));
+  memcpy(data.data() + schema.GetOffset(3), &row.price, sizeof(row.price));
+  memcpy(data.data() + schema.GetOffset(4), &row.day, sizeof(row.day));
+  table.InsertTuple(Tuple(data.data(), data.size()));
+}
+
+TEST(VectorExecutorTest, FilterProjectAggregateTest) {
+  auto disk_manager = std::make_shared<DiskManager>(db_filename);
+  auto bpm = std::make_shared<BufferPoolManager>(64, disk_manager.get());
+  PaxTable table(bpm.get(), MakeSchema());
+  const int64_t num_rows = 10000;
+
+  struct Expected {
+    int64_t count = 0;
+    double revenue = 0;
+    int32_t min_day = INT32_MAX;
+    int64_t max_id = INT64_MIN;
+    double qty = 0;
+  };
+  std::map<char, Expected> expected;
+  for (int64_t i = 0; i < num_rows; i++) {
+    Row row = MakeRow(i);
+    Insert(table, row);
+    if (row.day >= 100 && row.qty < 25) {
+      Expected& group = expected[row.flag];
+      group.count++;
+      group.revenue += row.price * row.qty;
+      group.min_day = std::min(group.min_day, row.day);
+      group.max_id = std::max(group.max_id, row.id);
+      group.qty += row.qty;
+    }
+  }
+
+  // Scan columns: id, flag, qty, price, day, then price * qty
+  std::unique_ptr<VectorOperator> plan =
+      std::make_unique<PaxScan>(&table, std::vector<size_t>{0, 1, 2, 3, 4});
+  plan = std::make_unique<Filter<int32_t, CompareOp::Ge>>(std::move(plan), 4,
+                                                          100);
+  plan = std::make_unique<Filter<double, CompareOp::Lt>>(std::move(plan), 2,
+                                                         25.0);
+  plan = std::make_unique<Projection<double, ArithOp::Mul>>(
+      std::move(plan), Operand<double>::OfColumn(3),
+      Operand<double>::OfColumn(2), "revenue");
+  plan = std::make_unique<Aggregate>(
+      std::move(plan), std::vector<size_t>{1},
+      std::vector<AggregateExpr>{{AggregateType::Count, 0, "count"},
+                                 {AggregateType::Sum, 5, "revenue"},
+                                 {AggregateType::Min, 4, "min_day"},
+                                 {AggregateType::Max, 0, "max_id"},
+                                 {AggregateType::Avg, 2, "avg_qty"}});
+
+  const auto& columns = plan->GetColumns();
+  ASSERT_EQ(6, columns.size());
+  EXPECT_EQ(TypeId::Char, columns[0].type);
+  EXPECT_EQ(TypeId::Int64, columns[1].type);
+  EXPECT_EQ(TypeId::Float64, columns[2].type);
+  EXPECT_EQ(TypeId::Date, columns[3].type);
+  EXPECT_EQ(TypeId::Int64, columns[4].type);
+  EXPECT_EQ(TypeId::Float64, columns[5].type);
+
+  Batch batch(columns);
+  ASSERT_TRUE(plan->Next(batch));
+  ASSERT_EQ(expected.size(), batch.GetSize());
+  for (size_t i = 0; i < batch.GetSize(); i++) {
+    char flag = batch.GetColumn(0).GetData()[i];
+    ASSERT_TRUE(expected.count(flag));
+    const Expected& group = expected[flag];
+    EXPECT_EQ(group.count, batch.GetColumn(1).Data<int64_t>()[i]);
+    EXPECT_DOUBLE_EQ(group.revenue, batch.GetColumn(2).Data<double>()[i]);
+    EXPECT_EQ(group.min_day, batch.GetColumn(3).Data<int32_t>()[i]);
+    EXPECT_EQ(group.max_id, batch.GetColumn(4).Data<int64_t>()[i]);
+    EXPECT_DOUBLE_EQ(group.qty / group.count,
+                     batch.GetColumn(5).Data<double>()[i]);
+  }
+  EXPECT_FALSE(plan->Next(batch));
+
+  disk_manager->ShutDown();
+  remove(db_filename);
+  remove(disk_manager->GetLogFileName());
+}
+
+TEST(VectorExecutorTest, ManyGroupsTest) {
+  auto disk_manager = std::make_shared<DiskManager>(db_filename);
+  auto bpm = std::make_shared<BufferPoolManager>(64, disk_manager.get());
+  PaxTable table(bpm.get(), MakeSchema());
+  for (int64_t i = 0; i < 8000; i++) {
+    Insert(table, MakeRow(i));
+  }
+
+  // 400 days with 20 rows each, more groups than fit in one output batch
+  // when grouped by day and flag
+  std::unique_ptr<VectorOperator> plan =
+      std::make_unique<PaxScan>(&table, std::vector<size_t>{4, 1, 0});
+  plan = std::make_unique<Aggregate>(
+      std::move(plan), std::vector<size_t>{0, 1},
+      std::vector<AggregateExpr>{{AggregateType::Count, 0, "count"},
+                                 {AggregateType::Min, 2, "min_id"}});
+
+  std::map<std::pair<int32_t, char>, std::pair<int64_t, int64_t>> groups;
+  Batch batch(plan->GetColumns());
+  while (plan->Next(batch)) {
+    for (size_t i = 0; i < batch.GetSize(); i++) {
+      auto key = std::make_pair(batch.GetColumn(0).Data<int32_t>()[i],
+                                batch.GetColumn(1).GetData()[i]);
+      EXPECT_TRUE(groups
+                      .emplace(key,
+                               std::make_pair(
+                                   batch.GetColumn(2).Data<int64_t>()[i],
+                                   batch.GetColumn(3).Data<int64_t>()[i]))
+                      .second);
+    }
+  }
+
+  ASSERT_EQ(1200, groups.size());
+  for (const auto& [key, value] : groups) {
+    Row first = MakeRow(value.second);
+    EXPECT_EQ(key.first, first.day);
+    EXPECT_EQ(key.second, first.flag);
+    EXPECT_LT(value.second, 1200);
+    EXPECT_EQ(8000 / 1200 + (value.second < 8000 % 1200), value.first);
+  }
+
+  disk_manager->ShutDown();
+  remove(db_filename);
+  remove(disk_manager->GetLogFileName());
+}
+
+TEST(VectorExecutorTest, UngroupedAggregateTest) {
+  auto disk_manager = std::make_shared<DiskManager>(db_filename);
+  auto bpm = std::make_shared<BufferPoolManager>(64, disk_manager.get());
+  PaxTable table(bpm.get(), MakeSchema());
+  for (int64_t i = 0; i < 5000; i++) {
+    Insert(table, MakeRow(i));
+  }
+
+  auto run = [&](double max_qty) {
+    std::unique_ptr<VectorOperator> plan =
+        std::make_unique<PaxScan>(&table, std::vector<size_t>{2, 0});
+    plan = std::make_unique<Filter<double, CompareOp::Lt>>(std::move(plan), 0,
+                                                           max_qty);
+    plan = std::make_unique<Aggregate>(
+        std::move(plan), std::vector<size_t>{},
+        std::vector<AggregateExpr>{{AggregateType::Count, 0, "count"},
+                                   {AggregateType::Sum, 1, "ids"}});
+    Batch batch(plan->GetColumns());
+    EXPECT_TRUE(plan->Next(batch));
+    EXPECT_EQ(1, batch.GetSize());
+    auto result = std::make_pair(batch.GetColumn(0).Data<int64_t>()[0],
+                                 batch.GetColumn(1).Data<int64_t>()[0]);
+    EXPECT_FALSE(plan->Next(batch));
+    return result;
+  };
+
+  EXPECT_EQ(std::make_pair(int64_t{5000}, int64_t{4999 * 5000 / 2}),
+            run(1000.0));
+  EXPECT_EQ(std::make_pair(int64_t{0}, int64_t{0}), run(-1.0));
+
+  // The scanned column holds doubles
+  using Int64Filter = Filter<int64_t, CompareOp::Eq>;
+  EXPECT_THROW(Int64Filter(std::make_unique<PaxScan>(
+                               &table, std::vector<size_t>{2}),
+                           0, 1),
+               std::runtime_error);
+
+  disk_manager->ShutDown();
+  remove(db_filename);
+  remove(disk_manager->GetLogFileName());
+}
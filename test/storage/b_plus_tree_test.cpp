@@ -0,0 +1,211 @@
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <random>
+#include <thread>
+
+#include "gtest/gtest.h"
+
+#include <buffer/buffer_pool_manager.hpp>
+#include <storage/index/b_plus_tree.hpp>
+
+static std::filesystem::path db_filename("b_plus_tree_test.db");
+
+TEST(BPlusTreeTest, InsertLookupTest) {
+  auto disk_manager = std::make_shared<DiskManager>(db_filename);
+  auto bpm = std::make_shared<BufferPoolManager>(64, disk_manager.get());
+  BPlusTree<int64_t, int64_t> tree(bpm->NewPage(), bpm.get(), {}, 4, 4);
+
+  ASSERT_TRUE(tree.IsEmpty());
+  ASSERT_FALSE(tree.GetValue(1).has_value());
+
+  std::vector<int64_t> keys(500);
+  std::iota(keys.begin(), keys.end(), 0);
+  std::shuffle(keys.begin(), keys.end(), std::mt19937(42));
+
+  for (const auto key : keys) {
+    ASSERT_TRUE(tree.Insert(key, key * 10));
+  }
+  ASSERT_FALSE(tree.Insert(keys[0], 0));
+
+  for (int64_t key = 0; key < 500; key++) {
+    auto value = tree.GetValue(key);
+    ASSERT_TRUE(value.has_value());
+    EXPECT_EQ(key * 10, value.value());
+  }
+  EXPECT_FALSE(tree.GetValue(500).has_value());
+
+  disk_manager->ShutDown();
+  remove(db_filename);
+  remove(disk_manager->GetLogFileName());
+}
+
+TEST(BPlusTreeTest, RemoveTest) {
+  auto disk_manager = std::make_shared<DiskManager>(db_filename);
+  auto bpm = std::make_shared<BufferPoolManager>(64, disk_manager.get());
+  BPlusTree<int64_t, int64_t> tree(bpm->NewPage(), bpm.get(), {}, 3, 3);
+
+  std::vector<int64_t> keys(300);
+  std::iota(keys.begin(), keys.end(), 0);
+  std::shuffle(keys.begin(), keys.end(), std::mt19937(7));
+  for (const auto key : keys) {
+    ASSERT_TRUE(tree.Insert(key, key));
+  }
+
+  std::shuffle(keys.begin(), keys.end(), std::mt19937(8));
+  for (size_t i = 0; i < keys.size(); i++) {
+    tree.Remove(keys[i]);
+    ASSERT_FALSE(tree.GetValue(keys[i]).has_value());
+    if (i % 25 == 0) {
+      for (size_t j = i + 1; j < keys.size(); j++) {
+        ASSERT_TRUE(tree.GetValue(keys[j]).has_value());
+      }
+    }
+  }
+
+  ASSERT_TRUE(tree.IsEmpty());
+  tree.Remove(1);
+  ASSERT_TRUE(tree.Insert(1, 1));
+  ASSERT_EQ(1, tree.GetValue(1));
+
+  disk_manager->ShutDown();
+  remove(db_filename);
+  remove(disk_manager->GetLogFileName());
+}
+
+TEST(BPlusTreeTest, IteratorTest) {
+  auto disk_manager = std::make_shared<DiskManager>(db_filename);
+  auto bpm = std::make_shared<BufferPoolManager>(64, disk_manager.get());
+  BPlusTree<int64_t, int64_t> tree(bpm->NewPage(), bpm.get(), {}, 5, 4);
+
+  ASSERT_TRUE(tree.Begin() == tree.End());
+
+  for (int64_t key = 0; key < 1000; key += 2) {
+    ASSERT_TRUE(tree.Insert(key, -key));
+  }
+
+  int64_t expected = 0;
+  for (auto it = tree.Begin(); it != tree.End(); ++it) {
+    EXPECT_EQ(expected, (*it).first);
+    EXPECT_EQ(-expected, (*it).second);
+    expected += 2;
+  }
+  EXPECT_EQ(1000, expected);
+
+  expected = 502;
+  for (auto it = tree.Begin(501); !it.IsEnd(); ++it) {
+    EXPECT_EQ(expected, it.GetKey());
+    expected += 2;
+  }
+  EXPECT_EQ(1000, expected);
+
+  EXPECT_TRUE(tree.Begin(999).IsEnd());
+
+  disk_manager->ShutDown();
+  remove(db_filename);
+  remove(disk_manager->GetLogFileName());
+}
+
+TEST(BPlusTreeTest, BulkLoadTest) {
+  const int64_t num_keys = 50000;
+
+  for (const double fill_factor : {1.0, 0.6}) {
+    auto disk_manager = std::make_shared<DiskManager>(db_filename);
+    auto bpm = std::make_shared<BufferPoolManager>(64, disk_manager.get());
+    BPlusTree<int64_t, int64_t> tree(bpm->NewPage(), bpm.get(), {}, 8, 6);
+
+    // Even keys only, duplicates come last and must lose
+    std::vector<std::pair<int64_t, int64_t>> entries;
+    for (int64_t key = 0; key < num_keys; key++) {
+      entries.emplace_back(key * 2, key);
+    }
+    std::shuffle(entries.begin(), entries.end(), std::mt19937(11));
+    for (int64_t key = 0; key < 1000; key++) {
+      entries.emplace_back(key * 2, -1);
+    }
+    ASSERT_TRUE(tree.BulkLoad(entries, fill_factor, 4));
+    ASSERT_FALSE(tree.BulkLoad(entries, fill_factor, 4));
+
+    int64_t expected = 0;
+    for (auto it = tree.Begin(); it != tree.End(); ++it, expected++) {
+      ASSERT_EQ(expected * 2, it.GetKey());
+      ASSERT_EQ(expected, it.GetValue());
+    }
+    EXPECT_EQ(num_keys, expected);
+
+    // The loaded tree keeps working with regular inserts and removes
+    for (int64_t key = 0; key < num_keys; key += 7) {
+      ASSERT_TRUE(tree.Insert(key * 2 + 1, key));
+      tree.Remove(key * 2);
+    }
+    for (int64_t key = 0; key < num_keys; key++) {
+      auto value = tree.GetValue(key * 2);
+      ASSERT_EQ(key % 7 != 0, value.has_value());
+      if (key % 7 == 0) {
+        EXPECT_EQ(key, tree.GetValue(key * 2 + 1).value());
+      }
+    }
+
+    disk_manager->ShutDown();
+    remove(db_filename);
+    remove(disk_manager->GetLogFileName());
+  }
+}
+
+TEST(BPlusTreeTest, ConcurrentInsertRemoveTest) {
+  const int64_t keys_per_thread = 2000;
+  const size_t num_threads = 4;
+
+  auto disk_manager = std::make_shared<DiskManager>(db_filename);
+  auto bpm = std::make_shared<BufferPoolManager>(256, disk_manager.get());
+  BPlusTree<int64_t, int64_t> tree(bpm->NewPage(), bpm.get(), {}, 8, 8);
+
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < num_threads; t++) {
+    threads.emplace_back([&, t]() {
+      for (int64_t i = 0; i < keys_per_thread; i++) {
+        int64_t key = i * num_threads + t;
+        tree.Insert(key, key);
+        tree.GetValue(key);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  threads.clear();
+
+  for (size_t t = 0; t < num_threads; t++) {
+    threads.emplace_back([&, t]() {
+      for (int64_t i = 0; i < keys_per_thread; i++) {
+        int64_t key = i * num_threads + t;
+        if (key % 2 == 0) {
+          tree.Remove(key);
+        }
+      }
+    });
+  }
+  threads.emplace_back([&]() {
+    for (int round = 0; round < 5; round++) {
+      int64_t last = -1;
+      for (auto it = tree.Begin(); !it.IsEnd(); ++it) {
+        EXPECT_LT(last, it.GetKey());
+        last = it.GetKey();
+      }
+    }
+  });
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  int64_t expected = 1;
+  for (auto it = tree.Begin(); !it.IsEnd(); ++it) {
+    EXPECT_EQ(expected, it.GetKey());
+    expected += 2;
+  }
+  EXPECT_EQ(static_cast<int64_t>(keys_per_thread * num_threads) + 1, expected);
+
+  disk_manager->ShutDown();
+  remove(db_filename);
+  remove(disk_manager->GetLogFileName());
+}
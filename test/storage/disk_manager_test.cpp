@@ -0,0 +1,202 @@
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include <buffer/buffer_pool_manager.hpp>
+#include <storage/disk_manager.hpp>
+
+static std::filesystem::path db_filename("disk_manager_test.db");
+
+static std::vector<char> MakePage(PageId_t page_id) {
+  return std::vector<char>(DB_PAGE_SIZE, static_cast<char>(page_id * 7 + 1));
+}
+
+TEST(DiskManagerTest, CompactionTest) {
+  auto disk_manager = std::make_shared<DiskManager>(db_filename);
+  const PageId_t num_pages = 1000;
+  for (PageId_t page_id = 0; page_id < num_pages; page_id++) {
+    disk_manager->WritePage(page_id, MakePage(page_id).data());
+  }
+  // Keep every tenth page
+  for (PageId_t page_id = 0; page_id < num_pages; page_id++) {
+    if (page_id % 10 != 0) {
+      disk_manager->DeletePage(page_id);
+    }
+  }
+  size_t file_size = disk_manager->GetDbFileSize();
+  EXPECT_GE(file_size, num_pages * DB_PAGE_SIZE);
+
+  // A limited compaction leaves holes below the last used slot
+  CompactionResult partial = disk_manager->Compact(30);
+  EXPECT_EQ(30, partial.pages_moved);
+  EXPECT_EQ(2 * 30 * DB_PAGE_SIZE, partial.bytes_copied);
+  EXPECT_EQ(file_size, partial.file_size_before);
+  // Holes punched once are not counted again
+  EXPECT_EQ(0, disk_manager->Compact(0).bytes_punched);
+
+  CompactionResult result = disk_manager->Compact();
+  EXPECT_EQ(100 - 10 - 30, result.pages_moved);
+  // The pages follow the header slot
+  EXPECT_EQ(101 * DB_PAGE_SIZE, result.file_size_after);
+  EXPECT_EQ(result.file_size_after, disk_manager->GetDbFileSize());
+  EXPECT_EQ(0, result.bytes_punched);
+  EXPECT_EQ(0, disk_manager->Compact().pages_moved);
+
+  std::vector<char> buffer(DB_PAGE_SIZE);
+  for (PageId_t page_id = 0; page_id < num_pages; page_id += 10) {
+    disk_manager->ReadPage(page_id, buffer.data());
+    EXPECT_EQ(MakePage(page_id), buffer) << page_id;
+  }
+
+  // New pages go after the compacted ones
+  for (PageId_t page_id = num_pages; page_id < num_pages + 50; page_id++) {
+    disk_manager->WritePage(page_id, MakePage(page_id).data());
+  }
+  EXPECT_LE(disk_manager->GetDbFileSize(),
+            2 * 150 * DB_PAGE_SIZE + DB_PAGE_SIZE);
+  for (PageId_t page_id = 0; page_id < num_pages + 50;
+       page_id += page_id < num_pages ? 10 : 1) {
+    disk_manager->ReadPage(page_id, buffer.data());
+    EXPECT_EQ(MakePage(page_id), buffer) << page_id;
+  }
+
+  disk_manager->ShutDown();
+  remove(db_filename);
+  remove(disk_manager->GetLogFileName());
+}
+
+// Compaction runs while the buffer pool holds some of the moved pages, dirty
+// or not
+TEST(DiskManagerTest, ResidentPageCompactionTest) {
+  auto disk_manager = std::make_shared<DiskManager>(db_filename);
+  auto bpm = std::make_shared<BufferPoolManager>(16, disk_manager.get());
+  std::vector<PageId_t> page_ids;
+  for (int i = 0; i < 200; i++) {
+    page_ids.push_back(bpm->NewPage());
+    auto guard = bpm->WritePage(page_ids.back());
+    memset(guard.GetDataMut(), i, DB_PAGE_SIZE);
+  }
+  bpm->FlushAllPages();
+  for (int i = 0; i < 150; i++) {
+    ASSERT_TRUE(bpm->DeletePage(page_ids[i]));
+  }
+
+  // The last pages are resident, two of them dirty
+  for (int i = 190; i < 200; i++) {
+    auto guard = bpm->WritePage(page_ids[i]);
+    if (i % 5 == 0) {
+      guard.GetDataMut()[0] = 'x';
+    }
+  }
+  CompactionResult result = disk_manager->Compact(SIZE_MAX, 100000);
+  EXPECT_EQ(50, result.pages_moved);
+  EXPECT_GT(result.file_size_before, result.file_size_after);
+
+  bpm->FlushAllPages();
+  // Reading everything through a second pool checks the disk copies
+  auto check = std::make_shared<BufferPoolManager>(8, disk_manager.get());
+  for (int i = 150; i < 200; i++) {
+    auto guard = check->ReadPage(page_ids[i]);
+    EXPECT_EQ(i % 5 == 0 && i >= 190 ? 'x' : static_cast<char>(i),
+              guard.GetData()[0])
+        << i;
+    EXPECT_EQ(static_cast<char>(i), guard.GetData()[1]) << i;
+  }
+
+  disk_manager->ShutDown();
+  remove(db_filename);
+  remove(disk_manager->GetLogFileName());
+}
+
+TEST(DiskManagerTest, ExtentTest) {
+  auto disk_manager = std::make_shared<DiskManager>(db_filename);
+  auto bpm = std::make_shared<BufferPoolManager>(16, disk_manager.get());
+
+  // Every other one of the first 64 slots after the header is free
+  std::vector<PageId_t> page_ids;
+  for (int i = 0; i < 64; i++) {
+    page_ids.push_back(bpm->NewPage());
+    bpm->WritePage(page_ids.back());
+  }
+  bpm->FlushAllPages();
+  for (int i = 0; i < 64; i += 2) {
+    ASSERT_TRUE(bpm->DeletePage(page_ids[i]));
+  }
+
+  // Single pages fill the holes, extents go where they fit whole
+  PageId_t single = bpm->NewPage();
+  bpm->WritePage(single).GetDataMut()[0] = 's';
+  PageId_t first = bpm->NewPages(10);
+  for (PageId_t page_id = first; page_id < first + 10; page_id++) {
+    EXPECT_EQ(*disk_manager->GetPageOffset(first) +
+                  (page_id - first) * DB_PAGE_SIZE,
+              disk_manager->GetPageOffset(page_id));
+    bpm->WritePage(page_id).GetDataMut()[0] = static_cast<char>(page_id);
+  }
+  EXPECT_GE(*disk_manager->GetPageOffset(first), 64 * DB_PAGE_SIZE);
+  bpm->FlushAllPages();
+  EXPECT_EQ(DB_PAGE_SIZE, disk_manager->GetPageOffset(single));
+
+  // Once freed the extent is a run that a later extent reuses
+  size_t offset = *disk_manager->GetPageOffset(first + 9) + DB_PAGE_SIZE;
+  for (PageId_t page_id = first; page_id < first + 10; page_id++) {
+    ASSERT_TRUE(bpm->DeletePage(page_id));
+  }
+  PageId_t second = bpm->NewPages(8);
+  EXPECT_LT(*disk_manager->GetPageOffset(second), offset);
+
+  auto check = std::make_shared<BufferPoolManager>(8, disk_manager.get());
+  EXPECT_EQ('s', check->ReadPage(single).GetData()[0]);
+
+  disk_manager->ShutDown();
+  remove(db_filename);
+  remove(disk_manager->GetLogFileName());
+}
+
+TEST(DiskManagerTest, LargeFileTest) {
+  auto disk_manager = std::make_shared<DiskManager>(db_filename);
+  auto bpm = std::make_shared<BufferPoolManager>(16, disk_manager.get());
+
+  // An extent that ends past 4 GB, its slots are preallocated but not written
+  const size_t extent_pages = (size_t{4} << 30) / DB_PAGE_SIZE + 16;
+  PageId_t first = bpm->NewPages(extent_pages);
+  PageId_t last = first + extent_pages - 1;
+  EXPECT_GT(*disk_manager->GetPageOffset(last), size_t{4} << 30);
+  for (PageId_t page_id = last - 15; page_id <= last; page_id++) {
+    bpm->WritePage(page_id).GetDataMut()[0] = static_cast<char>(page_id);
+  }
+  bpm->FlushAllPages();
+  EXPECT_GT(disk_manager->GetDbFileSize(), size_t{4} << 30);
+
+  // Page ids past 32 bits, written straight to the disk manager
+  const PageId_t high_page_id = PageId_t{1} << 40;
+  auto high_page = MakePage(high_page_id);
+  disk_manager->WritePage(high_page_id, high_page.data());
+
+  auto check = std::make_shared<BufferPoolManager>(8, disk_manager.get());
+  for (PageId_t page_id = last - 15; page_id <= last; page_id++) {
+    EXPECT_EQ(static_cast<char>(page_id),
+              check->ReadPage(page_id).GetData()[0]);
+  }
+  std::vector<char> buffer(DB_PAGE_SIZE);
+  disk_manager->ReadPage(high_page_id, buffer.data());
+  EXPECT_EQ(high_page, buffer);
+
+  // Dropping the extent compacts the file back under 4 GB
+  check.reset();
+  for (PageId_t page_id = first; page_id <= last; page_id++) {
+    ASSERT_TRUE(bpm->DeletePage(page_id));
+  }
+  disk_manager->Compact();
+  EXPECT_LT(disk_manager->GetDbFileSize(), size_t{1} << 20);
+  disk_manager->ReadPage(high_page_id, buffer.data());
+  EXPECT_EQ(high_page, buffer);
+
+  disk_manager->ShutDown();
+  remove(db_filename);
+  remove(disk_manager->GetLogFileName());
+}
@@ -0,0 +1,137 @@
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <random>
+#include <thread>
+
+#include "gtest/gtest.h"
+
+#include <buffer/buffer_pool_manager.hpp>
+#include <storage/index/extendible_hash_table.hpp>
+
+static std::filesystem::path db_filename("extendible_hash_table_test.db");
+
+TEST(ExtendibleHashTableTest, InsertLookupTest) {
+  auto disk_manager = std::make_shared<DiskManager>(db_filename);
+  auto bpm = std::make_shared<BufferPoolManager>(64, disk_manager.get());
+  DiskExtendibleHashTable<int64_t, int64_t> ht(bpm->NewPage(), bpm.get(), 1,
+                                               8, 8);
+
+  ASSERT_FALSE(ht.GetValue(1).has_value());
+
+  for (int64_t key = 0; key < 1000; key++) {
+    ASSERT_TRUE(ht.Insert(key, key * 3));
+  }
+  ASSERT_FALSE(ht.Insert(10, 0));
+
+  for (int round = 0; round < 2; round++) {
+    for (int64_t key = 0; key < 1000; key++) {
+      auto value = ht.GetValue(key);
+      ASSERT_TRUE(value.has_value());
+      EXPECT_EQ(key * 3, value.value());
+    }
+  }
+  EXPECT_FALSE(ht.GetValue(1000).has_value());
+  EXPECT_GT(ht.GetGlobalDepth(0), 0);
+
+  disk_manager->ShutDown();
+  remove(db_filename);
+  remove(disk_manager->GetLogFileName());
+}
+
+TEST(ExtendibleHashTableTest, RemoveMergeTest) {
+  auto disk_manager = std::make_shared<DiskManager>(db_filename);
+  auto bpm = std::make_shared<BufferPoolManager>(64, disk_manager.get());
+  DiskExtendibleHashTable<int64_t, int64_t> ht(bpm->NewPage(), bpm.get(), 1,
+                                               8, 4);
+
+  std::vector<int64_t> keys(200);
+  std::iota(keys.begin(), keys.end(), 0);
+  for (const auto key : keys) {
+    ASSERT_TRUE(ht.Insert(key, key));
+  }
+  for (const auto key : keys) {
+    ASSERT_TRUE(ht.GetValue(key).has_value());
+  }
+  ASSERT_GT(ht.GetGlobalDepth(0), 2);
+
+  std::shuffle(keys.begin(), keys.end(), std::mt19937(3));
+  for (size_t i = 0; i < keys.size(); i++) {
+    ASSERT_TRUE(ht.Remove(keys[i]));
+    ASSERT_FALSE(ht.Remove(keys[i]));
+    ASSERT_FALSE(ht.GetValue(keys[i]).has_value());
+    if (i % 50 == 0) {
+      for (size_t j = i + 1; j < keys.size(); j++) {
+        ASSERT_EQ(keys[j], ht.GetValue(keys[j]));
+      }
+    }
+  }
+  EXPECT_EQ(0, ht.GetGlobalDepth(0));
+
+  for (const auto key : keys) {
+    ASSERT_TRUE(ht.Insert(key, key + 1));
+  }
+  for (const auto key : keys) {
+    ASSERT_EQ(key + 1, ht.GetValue(key));
+  }
+
+  disk_manager->ShutDown();
+  remove(db_filename);
+  remove(disk_manager->GetLogFileName());
+}
+
+TEST(ExtendibleHashTableTest, MaxDepthTest) {
+  auto disk_manager = std::make_shared<DiskManager>(db_filename);
+  auto bpm = std::make_shared<BufferPoolManager>(16, disk_manager.get());
+  DiskExtendibleHashTable<int64_t, int64_t> ht(bpm->NewPage(), bpm.get(), 0,
+                                               1, 2);
+
+  size_t inserted = 0;
+  for (int64_t key = 0; key < 10; key++) {
+    inserted += ht.Insert(key, key);
+  }
+  EXPECT_LE(inserted, 4);
+  EXPECT_GE(inserted, 2);
+  EXPECT_EQ(1, ht.GetGlobalDepth(0));
+
+  disk_manager->ShutDown();
+  remove(db_filename);
+  remove(disk_manager->GetLogFileName());
+}
+
+TEST(ExtendibleHashTableTest, ConcurrentTest) {
+  const int64_t keys_per_thread = 2000;
+  const int64_t num_threads = 4;
+
+  auto disk_manager = std::make_shared<DiskManager>(db_filename);
+  auto bpm = std::make_shared<BufferPoolManager>(128, disk_manager.get());
+  DiskExtendibleHashTable<int64_t, int64_t> ht(bpm->NewPage(), bpm.get(), 3,
+                                               8, 16);
+
+  std::vector<std::thread> threads;
+  for (int64_t t = 0; t < num_threads; t++) {
+    threads.emplace_back([&, t]() {
+      for (int64_t i = 0; i < keys_per_thread; i++) {
+        int64_t key = i * num_threads + t;
+        EXPECT_TRUE(ht.Insert(key, key));
+        EXPECT_EQ(key, ht.GetValue(key));
+      }
+      for (int64_t i = 0; i < keys_per_thread; i += 2) {
+        int64_t key = i * num_threads + t;
+        EXPECT_TRUE(ht.Remove(key));
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  for (int64_t key = 0; key < keys_per_thread * num_threads; key++) {
+    bool removed = (key / num_threads) % 2 == 0;
+    EXPECT_EQ(!removed, ht.GetValue(key).has_value());
+  }
+
+  disk_manager->ShutDown();
+  remove(db_filename);
+  remove(disk_manager->GetLogFileName());
+}
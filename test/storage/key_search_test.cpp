@@ -0,0 +1,77 @@
+#include <algorithm>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include <storage/index/key_search.hpp>
+
+template <typename T>
+static void CheckKernel(SearchKernel kernel) {
+  std::mt19937_64 rng(static_cast<int>(kernel));
+  for (int size = 0; size < 600; size += 1 + size / 8) {
+    // A narrow value range gives long runs of duplicates
+    for (const T range : {T{8}, std::numeric_limits<T>::max()}) {
+      std::vector<T> keys(size);
+      for (auto& key : keys) {
+        key = static_cast<T>(rng()) % range;
+      }
+      keys.push_back(std::numeric_limits<T>::min());
+      keys.push_back(std::numeric_limits<T>::max());
+      std::sort(keys.begin(), keys.end());
+
+      std::vector<T> probes(keys.begin(), keys.end());
+      for (int i = 0; i < 20; i++) {
+        probes.push_back(static_cast<T>(rng()) % range);
+      }
+      for (const T probe : probes) {
+        int n = keys.size();
+        ASSERT_EQ(std::lower_bound(keys.begin(), keys.end(), probe) -
+                      keys.begin(),
+                  KeyLowerBound(keys.data(), n, probe, kernel))
+            << SearchKernelName(kernel) << " size " << n;
+        ASSERT_EQ(std::upper_bound(keys.begin(), keys.end(), probe) -
+                      keys.begin(),
+                  KeyUpperBound(keys.data(), n, probe, kernel))
+            << SearchKernelName(kernel) << " size " << n;
+      }
+    }
+  }
+}
+
+TEST(KeySearchTest, KernelsMatchStdTest) {
+  // Every kernel up to the best one the CPU supports
+  for (int kernel = 0; kernel <= static_cast<int>(DetectSearchKernel());
+       kernel++) {
+    CheckKernel<int32_t>(static_cast<SearchKernel>(kernel));
+    CheckKernel<int64_t>(static_cast<SearchKernel>(kernel));
+  }
+}
+
+TEST(KeySearchTest, PrefixLowerBoundTest) {
+  std::vector<std::string> keys = {"",          "a",        "ab",
+                                   "abcdefgh",  "abcdefgh", "abcdefghA",
+                                   "abcdefghz", "abd",      "b\xff",
+                                   "\xff\xff"};
+  std::vector<std::string> probes = keys;
+  for (const char* probe : {"aa", "abcdefgh0", "abcdefgi", "c", "\xff"}) {
+    probes.push_back(probe);
+  }
+
+  std::vector<int64_t> prefixes;
+  for (const auto& key : keys) {
+    prefixes.push_back(KeyPrefix(key));
+  }
+  ASSERT_TRUE(std::is_sorted(prefixes.begin(), prefixes.end()));
+
+  for (const auto& probe : probes) {
+    int expected =
+        std::lower_bound(keys.begin(), keys.end(), probe) - keys.begin();
+    EXPECT_EQ(expected,
+              PrefixLowerBound(prefixes.data(), prefixes.size(), probe,
+                               [&](int i) { return keys[i]; }))
+        << probe;
+  }
+}
@@ -0,0 +1,175 @@
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include <storage/log_structured_disk_manager.hpp>
+
+static std::filesystem::path db_filename("log_structured_test.db");
+
+// Page filled with a byte derived from the page id and its version
+static std::vector<char> MakePage(PageId_t page_id, int version) {
+  return std::vector<char>(DB_PAGE_SIZE,
+                           static_cast<char>(page_id * 31 + version));
+}
+
+static void Cleanup(LogStructuredDiskManager& disk_manager) {
+  disk_manager.ShutDown();
+  remove(db_filename);
+  remove(disk_manager.GetLogFileName());
+  remove(disk_manager.GetCheckpointFileName());
+}
+
+TEST(LogStructuredDiskManagerTest, BasicTest) {
+  LogStructuredDiskManager disk_manager(db_filename);
+  std::vector<char> buffer(DB_PAGE_SIZE);
+
+  for (PageId_t page_id = 0; page_id < 10; page_id++) {
+    disk_manager.WritePage(page_id, MakePage(page_id, 0).data());
+  }
+  disk_manager.WritePage(3, MakePage(3, 1).data());
+
+  // The last write of a page in a batch wins
+  auto first = MakePage(5, 2);
+  auto second = MakePage(5, 3);
+  auto other = MakePage(11, 0);
+  disk_manager.WritePages(
+      {{5, first.data()}, {11, other.data()}, {5, second.data()}});
+
+  for (PageId_t page_id = 0; page_id < 10; page_id++) {
+    int version = page_id == 3 ? 1 : page_id == 5 ? 3 : 0;
+    disk_manager.ReadPage(page_id, buffer.data());
+    EXPECT_EQ(MakePage(page_id, version), buffer) << page_id;
+  }
+  disk_manager.ReadPage(11, buffer.data());
+  EXPECT_EQ(other, buffer);
+
+  // Deleted and unknown pages read as zeros
+  disk_manager.DeletePage(4);
+  disk_manager.ReadPage(4, buffer.data());
+  EXPECT_EQ(std::vector<char>(DB_PAGE_SIZE), buffer);
+  EXPECT_EQ(1, disk_manager.GetNumDeletes());
+  EXPECT_EQ(13, disk_manager.GetNumWrites());
+
+  Cleanup(disk_manager);
+}
+
+TEST(LogStructuredDiskManagerTest, CleaningTest) {
+  auto disk_manager = std::make_unique<LogStructuredDiskManager>(db_filename);
+  const PageId_t num_pages = 16 * LOG_SEGMENT_PAGES;
+  std::vector<int> versions(num_pages);
+  for (PageId_t page_id = 0; page_id < num_pages; page_id++) {
+    disk_manager->WritePage(page_id, MakePage(page_id, 0).data());
+  }
+
+  // Ten times the data in random overwrites, in batches like the ones the
+  // disk scheduler hands out
+  std::mt19937 rng(0);
+  const size_t batch_size = 64;
+  std::vector<std::vector<char>> pages(batch_size);
+  std::vector<std::pair<PageId_t, const char*>> batch(batch_size);
+  for (size_t round = 0; round < 10 * num_pages / batch_size; round++) {
+    for (size_t i = 0; i < batch_size; i++) {
+      PageId_t page_id = rng() % num_pages;
+      pages[i] = MakePage(page_id, ++versions[page_id]);
+      batch[i] = {page_id, pages[i].data()};
+    }
+    disk_manager->WritePages(batch);
+  }
+
+  // Appending alone would need 11 times the live segments
+  EXPECT_GT(disk_manager->GetNumCleanerWrites(), 0);
+  EXPECT_LT(disk_manager->GetSegmentCount(), 4 * 16 + 2);
+
+  std::vector<char> buffer(DB_PAGE_SIZE);
+  for (PageId_t page_id = 0; page_id < num_pages; page_id++) {
+    disk_manager->ReadPage(page_id, buffer.data());
+    ASSERT_EQ(MakePage(page_id, versions[page_id]), buffer) << page_id;
+  }
+
+  // Reopened from the checkpoint written at shutdown
+  disk_manager->ShutDown();
+  disk_manager = std::make_unique<LogStructuredDiskManager>(db_filename);
+  for (PageId_t page_id = 0; page_id < num_pages; page_id += 7) {
+    disk_manager->ReadPage(page_id, buffer.data());
+    ASSERT_EQ(MakePage(page_id, versions[page_id]), buffer) << page_id;
+  }
+
+  // Segments freed before the restart are reused
+  size_t segments = disk_manager->GetSegmentCount();
+  for (PageId_t page_id = 0; page_id < num_pages / 16; page_id++) {
+    disk_manager->WritePage(page_id, MakePage(page_id, 0).data());
+  }
+  EXPECT_EQ(segments, disk_manager->GetSegmentCount());
+  disk_manager->Sync();
+  disk_manager->ReadPage(1, buffer.data());
+  EXPECT_EQ(MakePage(1, 0), buffer);
+
+  Cleanup(*disk_manager);
+}
+
+// Writers append, readers read and Sync checkpoints while the cleaner moves
+// pages, each writer owns a range of pages so their last versions are known
+TEST(LogStructuredDiskManagerTest, ConcurrentTest) {
+  auto disk_manager = std::make_unique<LogStructuredDiskManager>(db_filename);
+  const int num_writers = 4;
+  const PageId_t pages_per_writer = 2 * LOG_SEGMENT_PAGES;
+  std::vector<std::vector<int>> versions(num_writers,
+                                         std::vector<int>(pages_per_writer));
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < num_writers; t++) {
+    threads.emplace_back([&, t]() {
+      std::mt19937 rng(t);
+      const PageId_t first = t * pages_per_writer;
+      for (int i = 0; i < 8 * pages_per_writer; i++) {
+        PageId_t page_id = first + rng() % pages_per_writer;
+        auto page = MakePage(page_id, ++versions[t][page_id - first]);
+        disk_manager->WritePage(page_id, page.data());
+        if (i % 500 == 0) {
+          disk_manager->DeletePage(page_id);
+          versions[t][page_id - first] = -1;
+        }
+      }
+    });
+  }
+  threads.emplace_back([&]() {
+    std::vector<char> buffer(DB_PAGE_SIZE);
+    std::mt19937 rng(num_writers);
+    for (int i = 0; i < 2000; i++) {
+      disk_manager->ReadPage(rng() % (num_writers * pages_per_writer),
+                             buffer.data());
+      if (i % 200 == 0) {
+        disk_manager->Sync();
+      }
+    }
+  });
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  EXPECT_GT(disk_manager->GetNumCleanerWrites(), 0);
+
+  auto check = [&]() {
+    std::vector<char> buffer(DB_PAGE_SIZE);
+    for (int t = 0; t < num_writers; t++) {
+      for (PageId_t i = 0; i < pages_per_writer; i++) {
+        PageId_t page_id = t * pages_per_writer + i;
+        disk_manager->ReadPage(page_id, buffer.data());
+        auto expected = versions[t][i] < 0 ? std::vector<char>(DB_PAGE_SIZE)
+                                           : MakePage(page_id, versions[t][i]);
+        ASSERT_EQ(expected, buffer) << page_id;
+      }
+    }
+  };
+  check();
+  disk_manager->ShutDown();
+  disk_manager = std::make_unique<LogStructuredDiskManager>(db_filename);
+  check();
+
+  Cleanup(*disk_manager);
+}
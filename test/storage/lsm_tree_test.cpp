@@ -0,0 +1,197 @@
+#include <cstdio>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include <buffer/buffer_pool_manager.hpp>
+#include <storage/lsm/lsm_tree.hpp>
+#include <storage/lsm/skip_list.hpp>
+#include <storage/lsm/sorted_run.hpp>
+
+static std::filesystem::path db_filename("lsm_tree_test.db");
+
+static std::string MakeKey(uint64_t i) {
+  char key[16];
+  snprintf(key, sizeof(key), "key%08lu", static_cast<unsigned long>(i));
+  return key;
+}
+
+TEST(LsmTreeTest, SkipListTest) {
+  SkipList list;
+  EXPECT_TRUE(list.IsEmpty());
+  list.Put("b", "1");
+  list.Put("a", "2");
+  list.Put("b", "3");
+  list.Delete("c");
+  EXPECT_EQ("3", list.Get("b")->value);
+  EXPECT_EQ("2", list.Get("a")->value);
+  EXPECT_TRUE(list.Get("c")->deleted);
+  EXPECT_FALSE(list.Get("d").has_value());
+
+  std::vector<std::string> keys;
+  for (auto it = list.Begin(); !it.IsEnd(); ++it) {
+    keys.emplace_back(it.Key());
+  }
+  EXPECT_EQ((std::vector<std::string>{"a", "b", "c"}), keys);
+
+  // Readers run against a writer
+  SkipList concurrent;
+  const size_t num_keys = 20000;
+  std::thread writer([&]() {
+    for (size_t i = 0; i < num_keys; i++) {
+      concurrent.Put(MakeKey(i * 7919 % num_keys), std::to_string(i));
+    }
+  });
+  std::vector<std::thread> readers;
+  for (int t = 0; t < 2; t++) {
+    readers.emplace_back([&, t]() {
+      std::mt19937 rng(t);
+      for (size_t i = 0; i < num_keys; i++) {
+        auto value = concurrent.Get(MakeKey(rng() % num_keys));
+        if (value.has_value()) {
+          EXPECT_FALSE(value->deleted);
+          EXPECT_FALSE(value->value.empty());
+        }
+      }
+    });
+  }
+  writer.join();
+  for (auto& reader : readers) {
+    reader.join();
+  }
+  size_t count = 0;
+  for (auto it = concurrent.Begin(); !it.IsEnd(); ++it) {
+    count++;
+  }
+  EXPECT_EQ(num_keys, count);
+}
+
+TEST(LsmTreeTest, SortedRunTest) {
+  auto disk_manager = std::make_shared<DiskManager>(db_filename);
+  auto bpm = std::make_shared<BufferPoolManager>(16, disk_manager.get());
+
+  SortedRun::Builder builder(bpm.get(), disk_manager.get(), 10);
+  const size_t num_keys = 5000;
+  for (size_t i = 0; i < num_keys; i++) {
+    std::string value(i % 50, 'v');
+    builder.Add(MakeKey(2 * i), {i % 10 == 0, value});
+  }
+  EXPECT_THROW(builder.Add(MakeKey(0), {false, "x"}), std::runtime_error);
+  auto run = builder.Finish();
+  EXPECT_GT(run->GetPageCount(), 16);
+  EXPECT_EQ(MakeKey(0), run->GetFirstKey());
+  EXPECT_EQ(MakeKey(2 * (num_keys - 1)), run->GetLastKey());
+
+  std::string buffer;
+  size_t false_positives = 0;
+  for (size_t i = 0; i < num_keys; i++) {
+    EXPECT_TRUE(run->MayContain(MakeKey(2 * i)));
+    auto value = run->Get(MakeKey(2 * i), buffer);
+    ASSERT_TRUE(value.has_value());
+    EXPECT_EQ(i % 10 == 0, value->deleted);
+    if (!value->deleted) {
+      EXPECT_EQ(std::string(i % 50, 'v'), value->value);
+    }
+    if (run->MayContain(MakeKey(2 * i + 1))) {
+      false_positives++;
+      EXPECT_FALSE(run->Get(MakeKey(2 * i + 1), buffer).has_value());
+    }
+  }
+  EXPECT_LT(false_positives, num_keys / 20);
+  EXPECT_FALSE(run->MayContain(MakeKey(2 * num_keys)));
+
+  size_t count = 0;
+  for (SortedRun::Iterator it(run.get()); !it.IsEnd(); ++it) {
+    EXPECT_EQ(MakeKey(2 * count), it.Key());
+    count++;
+  }
+  EXPECT_EQ(num_keys, count);
+
+  disk_manager->ShutDown();
+  remove(db_filename);
+  remove(disk_manager->GetLogFileName());
+}
+
+TEST(LsmTreeTest, CompactionTest) {
+  auto disk_manager = std::make_shared<DiskManager>(db_filename);
+  auto bpm = std::make_shared<BufferPoolManager>(64, disk_manager.get());
+  // Small memtables and levels so that the data reaches several levels
+  LsmOptions options;
+  options.memtable_size = 64 << 10;
+  options.level0_runs = 2;
+  options.run_pages = 8;
+  options.base_level_pages = 32;
+  options.level_ratio = 4;
+  auto tree = std::make_unique<LsmTree>(bpm.get(), disk_manager.get(),
+                                        options);
+
+  std::map<std::string, std::string> expected;
+  std::mt19937 rng(1);
+  const size_t num_keys = 20000;
+  for (size_t i = 0; i < 100000; i++) {
+    std::string key = MakeKey(rng() % num_keys);
+    if (rng() % 5 == 0) {
+      tree->Delete(key);
+      expected.erase(key);
+    } else {
+      std::string value = std::to_string(i) + std::string(rng() % 40, 'x');
+      tree->Put(key, value);
+      expected[key] = value;
+    }
+  }
+
+  // Reads see the memtable and runs at any time
+  for (size_t i = 0; i < num_keys; i += 7) {
+    std::string key = MakeKey(i);
+    auto it = expected.find(key);
+    auto value = tree->Get(key);
+    ASSERT_EQ(it != expected.end(), value.has_value()) << key;
+    if (value.has_value()) {
+      EXPECT_EQ(it->second, *value);
+    }
+  }
+
+  tree->Flush();
+  EXPECT_GT(tree->GetCompactionCount(), 0);
+  EXPECT_LT(tree->GetRunCount(0), options.level0_runs);
+  EXPECT_GT(tree->GetRunCount(2), 0);
+  for (size_t level = 1; level < LsmTree::MAX_LEVELS; level++) {
+    EXPECT_LE(tree->GetPageCount(level),
+              level + 1 < LsmTree::MAX_LEVELS ? 32 * (1 << (2 * (level - 1)))
+                                              : SIZE_MAX);
+  }
+
+  size_t block_reads = tree->GetBlockReads();
+  for (size_t i = 0; i < num_keys; i++) {
+    std::string key = MakeKey(i);
+    auto it = expected.find(key);
+    auto value = tree->Get(key);
+    ASSERT_EQ(it != expected.end(), value.has_value()) << key;
+    if (value.has_value()) {
+      EXPECT_EQ(it->second, *value);
+    }
+  }
+  // Bloom filters keep most lookups to one page read
+  EXPECT_LT(tree->GetBlockReads() - block_reads, 2 * num_keys);
+
+  // Tombstones hide every older value through compactions
+  tree->Flush();
+  for (const auto& [key, value] : expected) {
+    tree->Delete(key);
+  }
+  tree->Flush();
+  for (const auto& [key, value] : expected) {
+    EXPECT_FALSE(tree->Get(key).has_value());
+  }
+
+  tree.reset();
+  disk_manager->ShutDown();
+  remove(db_filename);
+  remove(disk_manager->GetLogFileName());
+}
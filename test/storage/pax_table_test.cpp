@@ -0,0 +1,221 @@
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include <buffer/buffer_pool_manager.hpp>
+#include <storage/page/pax_page.hpp>
+#include <storage/table/pax_table.hpp>
+#include <storage/table/table_heap.hpp>
+
+static std::filesystem::path db_filename("pax_table_test.db");
+
+static Schema MakeSchema() {
+  return Schema({Column("id", TypeId::Int64), Column("name", TypeId::Char, 10),
+                 Column("price", TypeId::Float64),
+                 Column("day", TypeId::Date)});
+}
+
+static Tuple MakeTuple(const Schema& schema, int64_t id) {
+  std::vector<char> data(schema.GetTupleSize());
+  std::string name = "item" + std::to_string(id % 1000);
+  name.resize(10, ' ');
+  double price = id * 0.5;
+  int32_t day = id % 365;
+  memcpy(data.data() + schema.GetOffset(0), &id, sizeof(id));
+  memcpy(data.data() + schema.GetOffset(1), name.data(), name.size());
+  memcpy(data.data() + schema.GetOffset(2), &price, sizeof(price));
+  memcpy(data.data() + schema.GetOffset(3), &day, sizeof(day));
+  return Tuple(data.data(), data.size());
+}
+
+TEST(PaxTableTest, PageLayoutTest) {
+  Schema schema = MakeSchema();
+  EXPECT_EQ(30, schema.GetTupleSize());
+  EXPECT_EQ(18, schema.GetOffset(2));
+  EXPECT_EQ(2, schema.GetColumnIndex("price"));
+  EXPECT_FALSE(schema.GetColumnIndex("missing").has_value());
+
+  std::vector<char> buffer(DB_PAGE_SIZE);
+  auto* page = reinterpret_cast<PaxPage*>(buffer.data());
+  page->Init(schema, 0);
+  size_t capacity = page->GetCapacity();
+  EXPECT_EQ(PaxPage::Capacity(schema), capacity);
+  EXPECT_GE(capacity, 130);
+
+  for (size_t i = 0; i < schema.GetColumnCount(); i++) {
+    size_t offset = page->GetMinipage(i) - buffer.data();
+    EXPECT_EQ(0, offset % PaxPage::MINIPAGE_ALIGNMENT);
+    EXPECT_LE(offset + capacity * schema.GetColumn(i).size, DB_PAGE_SIZE);
+  }
+
+  for (size_t i = 0; i < capacity; i++) {
+    EXPECT_EQ(i, page->InsertTuple(schema, MakeTuple(schema, i).GetData()));
+  }
+  EXPECT_FALSE(
+      page->InsertTuple(schema, MakeTuple(schema, 0).GetData()).has_value());
+
+  std::vector<char> row(schema.GetTupleSize());
+  page->GetTuple(schema, 7, row.data());
+  Tuple expected = MakeTuple(schema, 7);
+  EXPECT_EQ(0, memcmp(expected.GetData(), row.data(), row.size()));
+
+  const auto* prices = reinterpret_cast<const double*>(page->GetMinipage(2));
+  EXPECT_EQ(3.5, prices[7]);
+
+  Schema too_wide({Column("blob", TypeId::Char, 4096)});
+  EXPECT_EQ(0, PaxPage::Capacity(too_wide));
+}
+
+TEST(PaxTableTest, InsertScanReopenTest) {
+  auto disk_manager = std::make_shared<DiskManager>(db_filename);
+  auto bpm = std::make_shared<BufferPoolManager>(16, disk_manager.get());
+  const int64_t num_rows = 5000;
+  PageId_t first_page_id;
+  std::vector<RID> rids;
+
+  {
+    PaxTable table(bpm.get(), MakeSchema());
+    first_page_id = table.GetFirstPageId();
+    EXPECT_TRUE(table.Scan({0}).IsEnd());
+    for (int64_t i = 0; i < num_rows; i++) {
+      auto rid = table.InsertTuple(MakeTuple(table.GetSchema(), i));
+      ASSERT_TRUE(rid.has_value());
+      rids.push_back(*rid);
+    }
+    EXPECT_FALSE(table.InsertTuple(Tuple("short", 5)).has_value());
+  }
+
+  PaxTable table(bpm.get(), MakeSchema(), first_page_id);
+  auto tuple = table.GetTuple(rids[1234]);
+  ASSERT_TRUE(tuple.has_value());
+  Tuple expected = MakeTuple(table.GetSchema(), 1234);
+  EXPECT_EQ(0, memcmp(expected.GetData(), tuple->GetData(),
+                      expected.GetSize()));
+
+  // Projection in a different order than the schema
+  int64_t count = 0;
+  for (auto it = table.Scan({3, 0}); !it.IsEnd(); ++it, count++) {
+    EXPECT_EQ(rids[count], it.GetRid());
+    EXPECT_EQ(count, it.Get<int64_t>(1));
+    EXPECT_EQ(count % 365, it.Get<int32_t>(0));
+  }
+  EXPECT_EQ(num_rows, count);
+
+  // A page at a time
+  double sum = 0;
+  count = 0;
+  for (auto it = table.Scan({2}); !it.IsEnd(); it.NextPage()) {
+    const auto* prices = reinterpret_cast<const double*>(it.GetMinipage(0));
+    for (uint32_t i = 0; i < it.GetPageRows(); i++) {
+      sum += prices[i];
+    }
+    count += it.GetPageRows();
+  }
+  EXPECT_EQ(num_rows, count);
+  EXPECT_EQ(0.5 * num_rows * (num_rows - 1) / 2, sum);
+
+  EXPECT_THROW(table.Scan({4}), std::runtime_error);
+
+  disk_manager->ShutDown();
+  remove(db_filename);
+  remove(disk_manager->GetLogFileName());
+}
+
+TEST(PaxTableTest, ZoneMapTest) {
+  auto disk_manager = std::make_shared<DiskManager>(db_filename);
+  auto bpm = std::make_shared<BufferPoolManager>(16, disk_manager.get());
+  PaxTable table(bpm.get(), MakeSchema());
+
+  // Ids grow with insertion order, days cycle through the year. The zone map
+  // of ids is filled from the existing pages half way through.
+  const int64_t num_rows = 20000;
+  for (int64_t i = 0; i < num_rows; i++) {
+    if (i == num_rows / 2) {
+      table.AddZoneMap(0);
+      table.AddZoneMap(3);
+    }
+    ASSERT_TRUE(table.InsertTuple(MakeTuple(table.GetSchema(), i)));
+  }
+  const size_t num_pages = table.GetPageIds().size();
+
+  // A selective id range only keeps the pages it overlaps
+  int64_t low = 15000;
+  int64_t high = 15099;
+  auto page_ids = table.GetPageIds(0, reinterpret_cast<const char*>(&low),
+                                   reinterpret_cast<const char*>(&high));
+  EXPECT_LE(page_ids.size(), 2);
+  int64_t count = 0;
+  for (auto it = table.Scan({0}, page_ids); !it.IsEnd(); ++it) {
+    int64_t id = it.Get<int64_t>(0);
+    count += id >= low && id <= high;
+  }
+  EXPECT_EQ(100, count);
+
+  // Ranges outside the data keep no page, the whole year keeps every page
+  low = -10;
+  high = -1;
+  EXPECT_TRUE(table
+                  .GetPageIds(0, reinterpret_cast<const char*>(&low),
+                              reinterpret_cast<const char*>(&high))
+                  .empty());
+  int32_t first_day = 0;
+  int32_t last_day = 364;
+  EXPECT_EQ(num_pages,
+            table
+                .GetPageIds(3, reinterpret_cast<const char*>(&first_day),
+                            reinterpret_cast<const char*>(&last_day))
+                .size());
+
+  // Columns without a zone map keep every page
+  double price = 1e9;
+  EXPECT_EQ(num_pages,
+            table
+                .GetPageIds(2, reinterpret_cast<const char*>(&price),
+                            reinterpret_cast<const char*>(&price))
+                .size());
+
+  disk_manager->ShutDown();
+  remove(db_filename);
+  remove(disk_manager->GetLogFileName());
+}
+
+TEST(PaxTableTest, PageSizeTest) {
+  const Schema schema = MakeSchema();
+  EXPECT_THROW(DiskManager(db_filename, 4096 + 512), std::runtime_error);
+  remove(db_filename);
+
+  for (size_t page_size : {size_t{16} << 10, size_t{64} << 10}) {
+    auto disk_manager = std::make_shared<DiskManager>(db_filename, page_size);
+    auto bpm = std::make_shared<BufferPoolManager>(16, disk_manager.get());
+    EXPECT_EQ(page_size, bpm->GetPageSize());
+    const size_t capacity = PaxPage::Capacity(schema, page_size);
+    EXPECT_GT(capacity, page_size / DB_PAGE_SIZE * PaxPage::Capacity(schema));
+    // Formats laid out for DB_PAGE_SIZE pages refuse the file
+    EXPECT_THROW(TableHeap(bpm.get()), std::runtime_error);
+
+    // Twice the rows the pool holds, pages are evicted and read back
+    const int64_t num_rows = 32 * capacity;
+    PaxTable table(bpm.get(), schema);
+    for (int64_t i = 0; i < num_rows; i++) {
+      ASSERT_TRUE(table.InsertTuple(MakeTuple(schema, i)).has_value());
+    }
+    EXPECT_EQ(32, table.GetPageIds().size());
+    int64_t count = 0;
+    for (auto it = table.Scan({0}); !it.IsEnd(); ++it, count++) {
+      ASSERT_EQ(count, it.Get<int64_t>(0));
+    }
+    EXPECT_EQ(num_rows, count);
+    disk_manager->ShutDown();
+
+    // The file keeps its page size whatever the reopening asks for
+    DiskManager reopened(db_filename);
+    EXPECT_EQ(page_size, reopened.GetPageSize());
+    reopened.ShutDown();
+    remove(db_filename);
+    remove(disk_manager->GetLogFileName());
+  }
+}
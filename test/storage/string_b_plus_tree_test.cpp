@@ -0,0 +1,169 @@
+#include <cstdio>
+#include <filesystem>
+#include <map>
+#include <random>
+#include <string>
+#include <thread>
+
+#include "gtest/gtest.h"
+
+#include <buffer/buffer_pool_manager.hpp>
+#include <storage/index/string_b_plus_tree.hpp>
+
+static std::filesystem::path db_filename("string_b_plus_tree_test.db");
+
+// URL like keys, long shared prefixes and some that break them
+static std::string MakeKey(std::mt19937& rng) {
+  static const char* hosts[] = {"https://www.example.com/",
+                                "https://shop.example.com/products/",
+                                "http://a.io/", ""};
+  std::string key = hosts[rng() % 4];
+  for (size_t i = rng() % 40; i > 0; i--) {
+    key.push_back("abcxyz/-\x01\xff"[rng() % 10]);
+  }
+  return key;
+}
+
+TEST(StringBPlusTreeTest, InsertLookupTest) {
+  for (const bool compress : {true, false}) {
+    auto disk_manager = std::make_shared<DiskManager>(db_filename);
+    auto bpm = std::make_shared<BufferPoolManager>(64, disk_manager.get());
+    StringBPlusTree<int64_t> tree(bpm->NewPage(), bpm.get(), compress);
+
+    ASSERT_TRUE(tree.IsEmpty());
+    ASSERT_FALSE(tree.GetValue("").has_value());
+
+    std::mt19937 rng(5);
+    std::map<std::string, int64_t> expected;
+    for (int64_t i = 0; i < 20000; i++) {
+      std::string key = MakeKey(rng);
+      bool inserted = expected.emplace(key, i).second;
+      ASSERT_EQ(inserted, tree.Insert(key, i)) << key;
+    }
+    EXPECT_THROW(tree.Insert(std::string(1000, 'x'), 0), std::runtime_error);
+
+    for (const auto& [key, value] : expected) {
+      auto found = tree.GetValue(key);
+      ASSERT_TRUE(found.has_value()) << key;
+      EXPECT_EQ(value, found.value());
+    }
+    EXPECT_FALSE(tree.GetValue("https://www.example.com").has_value());
+    EXPECT_FALSE(tree.GetValue("zzz").has_value());
+
+    auto expected_it = expected.begin();
+    for (auto it = tree.Begin(); it != tree.End(); ++it, ++expected_it) {
+      ASSERT_NE(expected.end(), expected_it);
+      ASSERT_EQ(expected_it->first, it.GetKey());
+      ASSERT_EQ(expected_it->second, it.GetValue());
+    }
+    EXPECT_EQ(expected.end(), expected_it);
+
+    auto it = tree.Begin("https://shop");
+    ASSERT_FALSE(it.IsEnd());
+    EXPECT_EQ(expected.lower_bound("https://shop")->first, it.GetKey());
+
+    disk_manager->ShutDown();
+    remove(db_filename);
+    remove(disk_manager->GetLogFileName());
+  }
+}
+
+TEST(StringBPlusTreeTest, CompressionTest) {
+  auto disk_manager = std::make_shared<DiskManager>(db_filename);
+  auto bpm = std::make_shared<BufferPoolManager>(256, disk_manager.get());
+  StringBPlusTree<int64_t> compressed(bpm->NewPage(), bpm.get(), true);
+  StringBPlusTree<int64_t> plain(bpm->NewPage(), bpm.get(), false);
+
+  // Long keys that only differ at the end compress well
+  const std::string prefix = "https://www.example.com/a/rather/long/path/";
+  for (int64_t i = 0; i < 20000; i++) {
+    std::string key = prefix + std::to_string(i * 7919 % 20000) + "/index";
+    ASSERT_TRUE(compressed.Insert(key, i));
+    ASSERT_TRUE(plain.Insert(key, i));
+  }
+  EXPECT_LT(compressed.GetHeight(), plain.GetHeight());
+  for (int64_t i = 0; i < 20000; i += 13) {
+    std::string key = prefix + std::to_string(i * 7919 % 20000) + "/index";
+    EXPECT_EQ(i, compressed.GetValue(key).value());
+  }
+
+  disk_manager->ShutDown();
+  remove(db_filename);
+  remove(disk_manager->GetLogFileName());
+}
+
+TEST(StringBPlusTreeTest, RemoveReinsertTest) {
+  auto disk_manager = std::make_shared<DiskManager>(db_filename);
+  auto bpm = std::make_shared<BufferPoolManager>(64, disk_manager.get());
+  StringBPlusTree<int64_t> tree(bpm->NewPage(), bpm.get());
+
+  std::mt19937 rng(9);
+  std::map<std::string, int64_t> expected;
+  for (int64_t i = 0; i < 5000; i++) {
+    std::string key = MakeKey(rng);
+    if (expected.emplace(key, i).second) {
+      ASSERT_TRUE(tree.Insert(key, i));
+    }
+  }
+  for (auto it = expected.begin(); it != expected.end();) {
+    if (rng() % 2 == 0) {
+      tree.Remove(it->first);
+      ASSERT_FALSE(tree.GetValue(it->first).has_value());
+      it = expected.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  for (int64_t i = 0; i < 5000; i++) {
+    std::string key = MakeKey(rng);
+    bool inserted = expected.emplace(key, i).second;
+    ASSERT_EQ(inserted, tree.Insert(key, i));
+  }
+
+  auto expected_it = expected.begin();
+  for (auto it = tree.Begin(); it != tree.End(); ++it, ++expected_it) {
+    ASSERT_NE(expected.end(), expected_it);
+    ASSERT_EQ(expected_it->first, it.GetKey());
+  }
+  EXPECT_EQ(expected.end(), expected_it);
+
+  disk_manager->ShutDown();
+  remove(db_filename);
+  remove(disk_manager->GetLogFileName());
+}
+
+TEST(StringBPlusTreeTest, ConcurrentInsertTest) {
+  const int num_threads = 4;
+  const int keys_per_thread = 3000;
+  auto disk_manager = std::make_shared<DiskManager>(db_filename);
+  auto bpm = std::make_shared<BufferPoolManager>(64, disk_manager.get());
+  StringBPlusTree<int64_t> tree(bpm->NewPage(), bpm.get());
+
+  auto key_of = [](int64_t i) {
+    return "https://www.example.com/item/" + std::to_string(i * 2654435761 %
+                                                            1000003);
+  };
+  std::vector<std::thread> threads;
+  for (int t = 0; t < num_threads; t++) {
+    threads.emplace_back([&, t]() {
+      for (int64_t i = t; i < num_threads * keys_per_thread;
+           i += num_threads) {
+        tree.Insert(key_of(i), i);
+        tree.GetValue(key_of(i / 2));
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  for (int64_t i = 0; i < num_threads * keys_per_thread; i++) {
+    auto value = tree.GetValue(key_of(i));
+    ASSERT_TRUE(value.has_value());
+    EXPECT_EQ(i, value.value());
+  }
+
+  disk_manager->ShutDown();
+  remove(db_filename);
+  remove(disk_manager->GetLogFileName());
+}
@@ -0,0 +1,189 @@
+#include <cstdio>
+#include <filesystem>
+#include <map>
+#include <random>
+#include <string>
+#include <thread>
+
+#include "gtest/gtest.h"
+
+#include <buffer/buffer_pool_manager.hpp>
+#include <storage/page/table_page.hpp>
+#include <storage/table/table_heap.hpp>
+
+static std::filesystem::path db_filename("table_heap_test.db");
+
+static Tuple MakeTuple(const std::string& value) {
+  return Tuple(value.data(), value.size());
+}
+
+static std::string AsString(const Tuple& tuple) {
+  return std::string(tuple.GetData(), tuple.GetSize());
+}
+
+TEST(TableHeapTest, InsertGetTest) {
+  auto disk_manager = std::make_shared<DiskManager>(db_filename);
+  auto bpm = std::make_shared<BufferPoolManager>(16, disk_manager.get());
+  TableHeap heap(bpm.get());
+
+  std::vector<RID> rids;
+  for (int i = 0; i < 2000; i++) {
+    auto rid =
+        heap.InsertTuple(MakeTuple(std::string(i % 100 + 1, 'a' + i % 26)));
+    ASSERT_TRUE(rid.has_value());
+    rids.push_back(*rid);
+  }
+  EXPECT_NE(rids.front().page_id, rids.back().page_id);
+
+  for (int i = 0; i < 2000; i++) {
+    auto tuple = heap.GetTuple(rids[i]);
+    ASSERT_TRUE(tuple.has_value());
+    EXPECT_EQ(std::string(i % 100 + 1, 'a' + i % 26), AsString(*tuple));
+    EXPECT_EQ(rids[i], tuple->GetRid());
+  }
+
+  std::string too_big(TablePage::MAX_TUPLE_SIZE + 1, 'x');
+  EXPECT_FALSE(heap.InsertTuple(MakeTuple(too_big)).has_value());
+  std::string largest(TablePage::MAX_TUPLE_SIZE, 'x');
+  auto rid = heap.InsertTuple(MakeTuple(largest));
+  ASSERT_TRUE(rid.has_value());
+  EXPECT_EQ(largest, AsString(*heap.GetTuple(*rid)));
+
+  disk_manager->ShutDown();
+  remove(db_filename);
+  remove(disk_manager->GetLogFileName());
+}
+
+TEST(TableHeapTest, UpdateDeleteReuseTest) {
+  auto disk_manager = std::make_shared<DiskManager>(db_filename);
+  auto bpm = std::make_shared<BufferPoolManager>(16, disk_manager.get());
+  TableHeap heap(bpm.get());
+
+  std::vector<RID> rids;
+  for (int i = 0; i < 400; i++) {
+    rids.push_back(*heap.InsertTuple(MakeTuple(std::string(100, 'a'))));
+  }
+  PageId_t first_page = rids.front().page_id;
+
+  // Shrinking, then growing back into the reclaimed space
+  ASSERT_TRUE(heap.UpdateTuple(rids[0], MakeTuple("short")));
+  EXPECT_EQ("short", AsString(*heap.GetTuple(rids[0])));
+  ASSERT_TRUE(heap.UpdateTuple(rids[0], MakeTuple(std::string(100, 'b'))));
+  EXPECT_EQ(std::string(100, 'b'), AsString(*heap.GetTuple(rids[0])));
+  EXPECT_EQ(std::string(100, 'a'), AsString(*heap.GetTuple(rids[1])));
+  EXPECT_FALSE(heap.UpdateTuple(rids[0], MakeTuple(std::string(2000, 'c'))));
+
+  // Freed space on the first page is found again by later inserts
+  for (const auto& rid : rids) {
+    if (rid.page_id == first_page) {
+      ASSERT_TRUE(heap.DeleteTuple(rid));
+    }
+  }
+  EXPECT_FALSE(heap.DeleteTuple(rids[0]));
+  EXPECT_FALSE(heap.GetTuple(rids[0]).has_value());
+  EXPECT_FALSE(heap.UpdateTuple(rids[0], MakeTuple("x")));
+
+  auto rid = heap.InsertTuple(MakeTuple(std::string(3500, 'd')));
+  ASSERT_TRUE(rid.has_value());
+  EXPECT_EQ(first_page, rid->page_id);
+  EXPECT_EQ(0, rid->slot);
+  EXPECT_EQ(std::string(3500, 'd'), AsString(*heap.GetTuple(*rid)));
+
+  disk_manager->ShutDown();
+  remove(db_filename);
+  remove(disk_manager->GetLogFileName());
+}
+
+TEST(TableHeapTest, IteratorReopenTest) {
+  auto disk_manager = std::make_shared<DiskManager>(db_filename);
+  auto bpm = std::make_shared<BufferPoolManager>(16, disk_manager.get());
+  PageId_t first_page_id;
+  std::map<RID, std::string, bool (*)(const RID&, const RID&)> expected(
+      [](const RID& a, const RID& b) {
+        return std::make_pair(a.page_id, a.slot) <
+               std::make_pair(b.page_id, b.slot);
+      });
+
+  {
+    TableHeap heap(bpm.get());
+    first_page_id = heap.GetFirstPageId();
+    EXPECT_TRUE(heap.Begin() == heap.End());
+
+    std::mt19937 rng(7);
+    for (int i = 0; i < 3000; i++) {
+      std::string value = std::to_string(i) + std::string(rng() % 64, 'z');
+      expected[*heap.InsertTuple(MakeTuple(value))] = value;
+    }
+    for (auto it = expected.begin(); it != expected.end();) {
+      if (rng() % 3 == 0) {
+        ASSERT_TRUE(heap.DeleteTuple(it->first));
+        it = expected.erase(it);
+      } else {
+        ++it;
+      }
+    }
+  }
+
+  TableHeap heap(bpm.get(), first_page_id);
+  auto check = [&]() {
+    auto expected_it = expected.begin();
+    for (auto it = heap.Begin(); it != heap.End(); ++it, ++expected_it) {
+      ASSERT_NE(expected.end(), expected_it);
+      EXPECT_EQ(expected_it->first, it.GetRid());
+      EXPECT_EQ(expected_it->second, AsString(*it));
+    }
+    EXPECT_EQ(expected.end(), expected_it);
+  };
+  check();
+
+  // The rebuilt free space map fills holes before growing the heap
+  auto rid = heap.InsertTuple(MakeTuple("refill"));
+  ASSERT_TRUE(rid.has_value());
+  expected[*rid] = "refill";
+  check();
+
+  disk_manager->ShutDown();
+  remove(db_filename);
+  remove(disk_manager->GetLogFileName());
+}
+
+TEST(TableHeapTest, ConcurrentInsertTest) {
+  auto disk_manager = std::make_shared<DiskManager>(db_filename);
+  auto bpm = std::make_shared<BufferPoolManager>(32, disk_manager.get());
+  TableHeap heap(bpm.get());
+  const int num_threads = 4;
+  const int per_thread = 1000;
+
+  std::vector<std::vector<RID>> rids(num_threads);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < num_threads; t++) {
+    threads.emplace_back([&, t]() {
+      for (int i = 0; i < per_thread; i++) {
+        std::string value = std::to_string(t * per_thread + i);
+        rids[t].push_back(*heap.InsertTuple(MakeTuple(value)));
+        if (i % 4 == 0) {
+          heap.DeleteTuple(rids[t][i / 2]);
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  size_t live = 0;
+  for (auto it = heap.Begin(); it != heap.End(); ++it) {
+    live++;
+  }
+  EXPECT_EQ(num_threads * (per_thread - per_thread / 4), live);
+  for (int t = 0; t < num_threads; t++) {
+    auto tuple = heap.GetTuple(rids[t][per_thread - 1]);
+    ASSERT_TRUE(tuple.has_value());
+    EXPECT_EQ(std::to_string(t * per_thread + per_thread - 1),
+              AsString(*tuple));
+  }
+
+  disk_manager->ShutDown();
+  remove(db_filename);
+  remove(disk_manager->GetLogFileName());
+}
@@ -0,0 +1,161 @@
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <set>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include <buffer/buffer_pool_manager.hpp>
+#include <storage/table/pax_table.hpp>
+#include <storage/tablespace.hpp>
+
+static std::filesystem::path db_filename("tablespace_test.db");
+
+static std::vector<std::filesystem::path> MakeDirectories(size_t count) {
+  std::vector<std::filesystem::path> directories;
+  for (size_t i = 0; i < count; i++) {
+    directories.push_back("tablespace_test_" + std::to_string(i));
+    std::filesystem::create_directories(directories.back());
+  }
+  return directories;
+}
+
+static void Cleanup(Tablespace& tablespace,
+                    const std::vector<std::filesystem::path>& directories) {
+  tablespace.ShutDown();
+  for (const auto& directory : directories) {
+    std::filesystem::remove_all(directory);
+  }
+  remove(tablespace.GetLogFileName());
+}
+
+static std::vector<char> MakePage(PageId_t page_id) {
+  return std::vector<char>(DB_PAGE_SIZE, static_cast<char>(page_id * 7 + 1));
+}
+
+TEST(TablespaceTest, PlacementTest) {
+  auto directories = MakeDirectories(3);
+  EXPECT_THROW(Tablespace(db_filename, {directories[0], directories[0]}),
+               std::runtime_error);
+
+  Tablespace tablespace(db_filename, directories);
+  EXPECT_EQ(3, tablespace.GetFileCount());
+  for (PageId_t first = 0; first < 64; first += 16) {
+    tablespace.AllocateExtent(first, 16);
+  }
+  EXPECT_EQ(0, tablespace.GetFile(0));
+  EXPECT_EQ(1, tablespace.GetFile(31));
+  EXPECT_EQ(2, tablespace.GetFile(32));
+  EXPECT_EQ(0, tablespace.GetFile(63));
+  // Single pages are striped
+  EXPECT_EQ(1000 / TABLESPACE_STRIPE_PAGES % 3, tablespace.GetFile(1000));
+
+  // Pages land in their files, each file starts with its header slot
+  std::vector<std::pair<PageId_t, const char*>> batch;
+  std::vector<std::vector<char>> pages;
+  for (PageId_t page_id : {0, 17, 40, 50, 1000}) {
+    pages.push_back(MakePage(page_id));
+  }
+  size_t i = 0;
+  for (PageId_t page_id : {0, 17, 40, 50, 1000}) {
+    batch.push_back({page_id, pages[i++].data()});
+  }
+  tablespace.WritePages(batch);
+  EXPECT_EQ(DB_PAGE_SIZE, tablespace.GetPageOffset(16));
+  EXPECT_EQ(DB_PAGE_SIZE, tablespace.GetPageOffset(32));
+  EXPECT_EQ(DB_PAGE_SIZE * (1 + 16 + 2), tablespace.GetPageOffset(50));
+
+  std::vector<char> buffer(DB_PAGE_SIZE);
+  for (const auto& [page_id, data] : batch) {
+    tablespace.ReadPage(page_id, buffer.data());
+    EXPECT_EQ(MakePage(page_id), buffer) << page_id;
+  }
+  tablespace.DeletePage(17);
+  EXPECT_FALSE(tablespace.GetPageOffset(17).has_value());
+
+  // An extent is dropped once all of its pages are deleted, a page deleted
+  // twice counts once
+  tablespace.AllocateExtent(100, 4);
+  EXPECT_EQ(1, tablespace.GetFile(100));
+  for (PageId_t page_id : {100, 101, 101, 102}) {
+    tablespace.DeletePage(page_id);
+  }
+  EXPECT_EQ(1, tablespace.GetFile(100));
+  tablespace.DeletePage(103);
+  EXPECT_EQ(100 / TABLESPACE_STRIPE_PAGES % 3, tablespace.GetFile(100));
+
+  Cleanup(tablespace, directories);
+}
+
+TEST(TablespaceTest, PerObjectTest) {
+  auto directories = MakeDirectories(2);
+  auto tablespace = std::make_unique<Tablespace>(
+      db_filename, directories, TablespacePlacement::PerObject);
+  auto bpm = std::make_shared<BufferPoolManager>(16, tablespace.get());
+  const Schema schema(
+      {Column("key", TypeId::Int64), Column("value", TypeId::Int64)});
+  PaxTable first(bpm.get(), schema);
+  PaxTable second(bpm.get(), schema);
+
+  char row[16];
+  for (int64_t i = 0; i < 20000; i++) {
+    memcpy(row, &i, 8);
+    memcpy(row + 8, &i, 8);
+    first.InsertTuple(Tuple(row, sizeof(row)));
+    second.InsertTuple(Tuple(row, sizeof(row)));
+  }
+  bpm->FlushAllPages();
+
+  // Every table lives in a file of its own
+  ASSERT_GT(first.GetPageIds().size(), TABLE_EXTENT_PAGES);
+  std::set<size_t> first_files;
+  std::set<size_t> second_files;
+  for (PageId_t page_id : first.GetPageIds()) {
+    first_files.insert(tablespace->GetFile(page_id));
+  }
+  for (PageId_t page_id : second.GetPageIds()) {
+    second_files.insert(tablespace->GetFile(page_id));
+  }
+  EXPECT_EQ(std::set<size_t>{0}, first_files);
+  EXPECT_EQ(std::set<size_t>{1}, second_files);
+
+  size_t count = 0;
+  for (auto it = second.Scan({0}); !it.IsEnd(); ++it) {
+    EXPECT_EQ(static_cast<int64_t>(count), it.Get<int64_t>(0));
+    count++;
+  }
+  EXPECT_EQ(20000, count);
+
+  Cleanup(*tablespace, directories);
+}
+
+TEST(TablespaceTest, TempPageTest) {
+  auto directories = MakeDirectories(2);
+  auto tablespace = std::make_unique<Tablespace>(db_filename, directories);
+  auto bpm = std::make_shared<BufferPoolManager>(4, tablespace.get());
+
+  // Evicting more dirty temporary pages than there are staging buffers
+  std::vector<PageId_t> pids;
+  for (size_t i = 0; i < 2 * DB_STAGING_BUFFERS; i++) {
+    pids.push_back(bpm->NewTempPage());
+    bpm->WritePage(pids.back()).GetDataMut()[0] = static_cast<char>(i);
+  }
+  for (size_t i = 0; i < pids.size(); i++) {
+    EXPECT_EQ(static_cast<char>(i), bpm->ReadPage(pids[i]).GetData()[0]);
+  }
+
+  // The other files have no log or scratch file of their own
+  DiskManager pages_only(directories[1] / "pages_only.db", DB_PAGE_SIZE,
+                         false);
+  EXPECT_TRUE(pages_only.GetLogFileName().empty());
+  std::vector<char> page(DB_PAGE_SIZE);
+  EXPECT_THROW(pages_only.WriteTempPage(0, page.data()), std::runtime_error);
+  EXPECT_THROW(pages_only.WriteLog(page.data(), page.size()),
+               std::runtime_error);
+  pages_only.ShutDown();
+
+  bpm.reset();
+  Cleanup(*tablespace, directories);
+}
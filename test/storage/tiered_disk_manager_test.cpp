@@ -0,0 +1,214 @@
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include <storage/tiered_disk_manager.hpp>
+
+static std::filesystem::path db_filename("tiered_test.db");
+static std::filesystem::path fast_directory("tiered_test_fast");
+static std::filesystem::path slow_directory("tiered_test_slow");
+
+static std::unique_ptr<TieredDiskManager> Open(size_t fast_pages,
+                                               size_t pages_per_second = 0) {
+  std::filesystem::create_directories(fast_directory);
+  std::filesystem::create_directories(slow_directory);
+  return std::make_unique<TieredDiskManager>(
+      db_filename, fast_directory, slow_directory, fast_pages,
+      pages_per_second, std::chrono::microseconds(50));
+}
+
+static void Cleanup(TieredDiskManager& disk_manager) {
+  disk_manager.ShutDown();
+  std::filesystem::remove_all(fast_directory);
+  std::filesystem::remove_all(slow_directory);
+  remove(disk_manager.GetLogFileName());
+  remove(disk_manager.GetCheckpointFileName());
+}
+
+static std::vector<char> MakePage(PageId_t page_id) {
+  return std::vector<char>(DB_PAGE_SIZE, static_cast<char>(page_id * 13 + 5));
+}
+
+static void ExpectPages(TieredDiskManager& disk_manager, PageId_t num_pages) {
+  std::vector<char> buffer(DB_PAGE_SIZE);
+  for (PageId_t page_id = 0; page_id < num_pages; page_id++) {
+    disk_manager.ReadPage(page_id, buffer.data());
+    EXPECT_EQ(MakePage(page_id), buffer) << page_id;
+  }
+}
+
+TEST(TieredDiskManagerTest, BasicTest) {
+  auto disk_manager = Open(8);
+  for (PageId_t page_id = 0; page_id < 20; page_id++) {
+    disk_manager->WritePage(page_id, MakePage(page_id).data());
+  }
+  // New pages fill the fast tier first
+  EXPECT_EQ(Tier::Fast, disk_manager->GetTier(7));
+  EXPECT_EQ(Tier::Slow, disk_manager->GetTier(8));
+  EXPECT_EQ(8, disk_manager->GetTierPages(Tier::Fast));
+  EXPECT_EQ(12, disk_manager->GetTierPages(Tier::Slow));
+  ExpectPages(*disk_manager, 20);
+
+  std::vector<char> buffer(DB_PAGE_SIZE);
+  disk_manager->DeletePage(3);
+  EXPECT_FALSE(disk_manager->GetTier(3).has_value());
+  disk_manager->ReadPage(3, buffer.data());
+  EXPECT_EQ(std::vector<char>(DB_PAGE_SIZE), buffer);
+  // The freed fast slot is reused
+  disk_manager->WritePage(100, MakePage(100).data());
+  EXPECT_EQ(Tier::Fast, disk_manager->GetTier(100));
+  EXPECT_EQ(4 * DB_PAGE_SIZE, disk_manager->GetPageOffset(100));
+
+  Cleanup(*disk_manager);
+}
+
+TEST(TieredDiskManagerTest, MigrationTest) {
+  auto disk_manager = Open(16);
+  const PageId_t num_pages = 64;
+  for (PageId_t page_id = 0; page_id < num_pages; page_id++) {
+    disk_manager->WritePage(page_id, MakePage(page_id).data());
+  }
+  std::vector<char> buffer(DB_PAGE_SIZE);
+  for (int i = 0; i < 10; i++) {
+    for (PageId_t page_id = 40; page_id < 48; page_id++) {
+      disk_manager->ReadPage(page_id, buffer.data());
+    }
+  }
+
+  // The budget bounds a round
+  EXPECT_EQ(1, disk_manager->Migrate(1));
+  EXPECT_EQ(15, disk_manager->GetTierPages(Tier::Fast));
+
+  // Cold pages make room on the fast tier and the hot pages are promoted
+  disk_manager->Migrate(SIZE_MAX);
+  for (PageId_t page_id = 40; page_id < 48; page_id++) {
+    EXPECT_EQ(Tier::Fast, disk_manager->GetTier(page_id)) << page_id;
+  }
+  EXPECT_EQ(8, disk_manager->GetNumPromotions());
+  EXPECT_EQ(10, disk_manager->GetNumDemotions());
+  EXPECT_EQ(14, disk_manager->GetTierPages(Tier::Fast));
+  ExpectPages(*disk_manager, num_pages);
+
+  // Nothing is left to move
+  EXPECT_EQ(0, disk_manager->Migrate(SIZE_MAX));
+
+  Cleanup(*disk_manager);
+}
+
+TEST(TieredDiskManagerTest, PersistenceTest) {
+  auto disk_manager = Open(16);
+  const PageId_t num_pages = 48;
+  for (PageId_t page_id = 0; page_id < num_pages; page_id++) {
+    disk_manager->WritePage(page_id, MakePage(page_id).data());
+  }
+  std::vector<char> buffer(DB_PAGE_SIZE);
+  for (int i = 0; i < 10; i++) {
+    disk_manager->ReadPage(30, buffer.data());
+  }
+  disk_manager->Migrate(SIZE_MAX);
+  ASSERT_EQ(Tier::Fast, disk_manager->GetTier(30));
+  disk_manager->DeletePage(31);
+  disk_manager->ShutDown();
+
+  // Tiers and slots come back from the checkpoint, free slots are not
+  // handed out twice
+  disk_manager = Open(16);
+  EXPECT_EQ(Tier::Fast, disk_manager->GetTier(30));
+  EXPECT_FALSE(disk_manager->GetTier(31).has_value());
+  EXPECT_EQ(num_pages - 1, disk_manager->GetTierPages(Tier::Fast) +
+                               disk_manager->GetTierPages(Tier::Slow));
+  for (PageId_t page_id = num_pages; page_id < num_pages + 8; page_id++) {
+    disk_manager->WritePage(page_id, MakePage(page_id).data());
+  }
+  for (PageId_t page_id = 0; page_id < num_pages + 8; page_id++) {
+    if (page_id == 31) {
+      continue;
+    }
+    disk_manager->ReadPage(page_id, buffer.data());
+    EXPECT_EQ(MakePage(page_id), buffer) << page_id;
+  }
+
+  Cleanup(*disk_manager);
+}
+
+TEST(TieredDiskManagerTest, BackgroundTest) {
+  auto disk_manager = Open(16, 10000);
+  for (PageId_t page_id = 0; page_id < 32; page_id++) {
+    disk_manager->WritePage(page_id, MakePage(page_id).data());
+  }
+  std::vector<char> buffer(DB_PAGE_SIZE);
+  for (int i = 0; i < 10; i++) {
+    disk_manager->ReadPage(20, buffer.data());
+  }
+
+  for (int i = 0; i < 100 && disk_manager->GetTier(20) != Tier::Fast; i++) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  }
+  EXPECT_EQ(Tier::Fast, disk_manager->GetTier(20));
+  ExpectPages(*disk_manager, 32);
+
+  Cleanup(*disk_manager);
+}
+
+TEST(TieredDiskManagerTest, WriteDuringMigrationTest) {
+  auto disk_manager = Open(8);
+  const PageId_t num_pages = 32;
+  auto make_page = [](PageId_t page_id, int round) {
+    return std::vector<char>(DB_PAGE_SIZE,
+                             static_cast<char>(page_id * 13 + round));
+  };
+  for (PageId_t page_id = 0; page_id < num_pages; page_id++) {
+    disk_manager->WritePage(page_id, make_page(page_id, 0).data());
+  }
+
+  // The hot set keeps moving, so pages are promoted and demoted each pass.
+  // Every page is rewritten while a pass moves pages.
+  std::atomic<int> passes{0};
+  std::atomic<bool> done{false};
+  std::thread migrator([&]() {
+    std::vector<char> buffer(DB_PAGE_SIZE);
+    for (int pass = 0; pass < 64; pass++) {
+      // Rounds without moves cool the earlier hot sets to a quarter
+      for (size_t i = 0; i < 2 * TIER_HEAT_HALF_LIFE; i++) {
+        disk_manager->Migrate(0);
+      }
+      PageId_t first = pass % 8 * 4;
+      for (int i = 0; i < 50; i++) {
+        for (PageId_t page_id = first; page_id < first + 4; page_id++) {
+          disk_manager->ReadPage(page_id, buffer.data());
+        }
+      }
+      passes.store(pass + 1);
+      disk_manager->Migrate(SIZE_MAX);
+    }
+    done.store(true);
+  });
+  int round = 0;
+  for (int seen = 0; !done.load();) {
+    if (passes.load() == seen) {
+      std::this_thread::yield();
+      continue;
+    }
+    seen = passes.load();
+    round++;
+    for (PageId_t page_id = 0; page_id < num_pages; page_id++) {
+      disk_manager->WritePage(page_id, make_page(page_id, round).data());
+    }
+  }
+  migrator.join();
+
+  EXPECT_GE(disk_manager->GetNumPromotions(), 32);
+  std::vector<char> buffer(DB_PAGE_SIZE);
+  for (PageId_t page_id = 0; page_id < num_pages; page_id++) {
+    disk_manager->ReadPage(page_id, buffer.data());
+    EXPECT_EQ(make_page(page_id, round), buffer) << page_id;
+  }
+
+  Cleanup(*disk_manager);
+}